@@ -0,0 +1,97 @@
+#pragma once
+#include "random"
+#include "benchmark/benchmark.h"
+#include "Memory/MemoryTracker.hpp"
+#include "Tools/Metrics.hpp"
+
+namespace Neo::Bench
+{
+    /// <summary>
+    /// Every benchmark draws its data from a generator seeded with this, so runs on different commits measure
+    /// exactly the same input.
+    /// </summary>
+    inline constexpr u32 kSeed = 0x4E454F;
+
+    [[nodiscard]] inline std::mt19937 MakeRandom() { return std::mt19937(kSeed); }
+
+    /// <summary>
+    /// Directory for the files benchmarks write, emptied once at the start of the run.
+    /// </summary>
+    [[nodiscard]] const std::filesystem::path& GetTempDirectory();
+
+    /// <summary>
+    /// Reports heap allocations per iteration and the peak heap growth of a benchmark as counters, when memory
+    /// tracking is built in. Create it right before the timed loop.
+    /// </summary>
+    class MemoryCounters
+    {
+    public:
+        explicit MemoryCounters(benchmark::State& state)
+            : mState(state), mAllocations(MemoryTracker::GetAllocationCount()),
+              mLiveBytes(MemoryTracker::GetSnapshot().LiveBytes)
+        {
+            MemoryTracker::ResetPeak();
+        }
+
+        ~MemoryCounters()
+        {
+#ifdef NEO_MEMORY_TRACKING
+            const auto snapshot = MemoryTracker::GetSnapshot();
+            mState.counters["Allocs"] = benchmark::Counter(
+                static_cast<double>(MemoryTracker::GetAllocationCount() - mAllocations),
+                benchmark::Counter::kAvgIterations);
+            mState.counters["PeakBytes"] = benchmark::Counter(
+                static_cast<double>(snapshot.PeakBytes - std::min(snapshot.PeakBytes, mLiveBytes)),
+                benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+#endif
+        }
+
+        MemoryCounters(const MemoryCounters&) = delete;
+        MemoryCounters& operator=(const MemoryCounters&) = delete;
+
+    private:
+        benchmark::State& mState;
+        u64 mAllocations;
+        u64 mLiveBytes;
+    };
+
+    /// <summary>
+    /// Reports every engine counter that moved during a benchmark, like Render/DrawCalls, per iteration, read
+    /// from the metrics registry the same way the editor does. Create it right before the timed loop.
+    /// </summary>
+    class MetricCounters
+    {
+    public:
+        explicit MetricCounters(benchmark::State& state) : mState(state)
+        {
+            // Closes whatever was counted before, so only the timed loop is measured
+            Metrics::BeginFrame();
+            for (const auto& sample : Metrics::GetSamples())
+            {
+                mTotals.emplace_back(sample.Total);
+            }
+        }
+
+        ~MetricCounters()
+        {
+            Metrics::BeginFrame();
+            const auto samples = Metrics::GetSamples();
+            for (size_t index = 0; index < samples.size(); index++)
+            {
+                const auto& sample = samples[index];
+                // Counters registered during the benchmark started from nothing
+                const auto total = sample.Total - (index < mTotals.size() ? mTotals[index] : 0);
+                if (sample.Type != MetricType::eCounter || total == 0) continue;
+                mState.counters[std::string(sample.Name)] = benchmark::Counter(
+                    static_cast<double>(total), benchmark::Counter::kAvgIterations);
+            }
+        }
+
+        MetricCounters(const MetricCounters&) = delete;
+        MetricCounters& operator=(const MetricCounters&) = delete;
+
+    private:
+        benchmark::State& mState;
+        std::vector<i64> mTotals;
+    };
+}
@@ -0,0 +1,114 @@
+#include "BenchmarkCommon.hpp"
+#include "Core/ECS.hpp"
+
+namespace
+{
+    // Every eighth entity starts a new parent, the ones after it become its children
+    void PopulateWorld(Neo::ECS& ecs, const i64 count)
+    {
+        auto random = Neo::Bench::MakeRandom();
+        std::uniform_real_distribution position(-1000.f, 1000.f);
+        Entity parent = NullEntity;
+        for (i64 index = 0; index < count; index++)
+        {
+            const auto entity = ecs.CreateEntity(fmt::format("Entity{}", index));
+            ecs.Modify<Neo::Transform>(entity, [&](Neo::Transform& transform)
+            {
+                transform.Position = glm::vec3(position(random), position(random), position(random));
+                transform.Scale = glm::vec3(1.f);
+            });
+            if (index % 8 == 0) parent = entity;
+            else ecs.AddChild(parent, entity);
+        }
+    }
+
+    void BM_ECS_CreateEntities(benchmark::State& state)
+    {
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            Neo::ECS ecs;
+            PopulateWorld(ecs, state.range(0));
+            benchmark::DoNotOptimize(ecs.GetWorld().storage<Entity>().size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ECS_CreateEntities)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+    void BM_ECS_IterateTransforms(benchmark::State& state)
+    {
+        Neo::ECS ecs;
+        PopulateWorld(ecs, state.range(0));
+        auto& world = ecs.GetWorld();
+        const auto view = world.view<Neo::Transform>();
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            for (auto [entity, transform] : view.each())
+            {
+                transform.Position += glm::vec3(0.f, -9.81f, 0.f) * (1.f / 60.f);
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ECS_IterateTransforms)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+    void BM_ECS_BinaryRoundTrip(benchmark::State& state)
+    {
+        Neo::ECS ecs;
+        PopulateWorld(ecs, state.range(0));
+        std::vector<char> buffer;
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            buffer.clear();
+            Neo::BinaryWriter writer(buffer);
+            ecs.Serialize(writer);
+            Neo::BinaryReader reader(buffer);
+            if (!ecs.Deserialize(reader)) state.SkipWithError("Deserialize failed");
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(buffer.size()));
+    }
+    BENCHMARK(BM_ECS_BinaryRoundTrip)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+    // Text scenes are what gets diffed in version control, so their throughput and peak memory are tracked up to
+    // a million entities
+    void BM_ECS_JsonSceneExport(benchmark::State& state)
+    {
+        Neo::ECS ecs;
+        PopulateWorld(ecs, state.range(0));
+        const auto path = (Neo::Bench::GetTempDirectory() / "Scene.json").string();
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            if (!ecs.ExportJson(path)) state.SkipWithError("ExportJson failed");
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(std::filesystem::file_size(path)));
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ECS_JsonSceneExport)->Arg(10'000)->Arg(1'000'000)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+    void BM_ECS_JsonSceneImport(benchmark::State& state)
+    {
+        const auto path = (Neo::Bench::GetTempDirectory() / "Scene.json").string();
+        {
+            Neo::ECS ecs;
+            PopulateWorld(ecs, state.range(0));
+            if (!ecs.ExportJson(path)) state.SkipWithError("ExportJson failed");
+        }
+
+        Neo::ECS ecs;
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            if (!ecs.ImportJson(path)) state.SkipWithError("ImportJson failed");
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(std::filesystem::file_size(path)));
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ECS_JsonSceneImport)->Arg(10'000)->Arg(1'000'000)->Iterations(3)->Unit(benchmark::kMillisecond);
+}
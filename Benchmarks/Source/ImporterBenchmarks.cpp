@@ -0,0 +1,33 @@
+#include "BenchmarkCommon.hpp"
+#include "Tools/Importer.hpp"
+
+namespace
+{
+    // Imports the sandbox model end to end: parsing, image decoding, mip generation, material dedup and writing
+    void BM_Importer_ImportGLTF(benchmark::State& state)
+    {
+        const auto input = std::filesystem::path(NEO_BENCHMARK_ASSETS) / "Models/Drift/Drift.gltf";
+        if (!std::filesystem::exists(input))
+        {
+            state.SkipWithError("Sandbox model not found");
+            return;
+        }
+        const auto output = Neo::Bench::GetTempDirectory() / "Drift";
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            // Start from an empty directory, so the asset registry does not grow with every import
+            state.PauseTiming();
+            std::filesystem::remove_all(output);
+            std::filesystem::create_directories(output);
+            state.ResumeTiming();
+
+            if (!Neo::Importer::ImportGLTF(input.generic_string(), output.generic_string()))
+            {
+                state.SkipWithError("ImportGLTF failed");
+            }
+        }
+    }
+    BENCHMARK(BM_Importer_ImportGLTF)->Iterations(3)->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,45 @@
+#include "BenchmarkCommon.hpp"
+
+namespace Neo::Bench
+{
+    const std::filesystem::path& GetTempDirectory()
+    {
+        static const auto directory = []
+        {
+            auto path = std::filesystem::temp_directory_path() / "NeoBenchmarks";
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+            return path;
+        }();
+        return directory;
+    }
+}
+
+// Results go to BenchmarkResults.json unless another output is given, ready for Scripts/Python/CompareBenchmarks.py
+int main(int argc, char** argv)
+{
+    std::vector<char*> args(argv, argv + argc);
+    std::string output = "--benchmark_out=BenchmarkResults.json";
+    std::string format = "--benchmark_out_format=json";
+    const auto hasOutput = std::ranges::any_of(args, [](const std::string_view arg)
+    {
+        return arg.starts_with("--benchmark_out=");
+    });
+    if (!hasOutput)
+    {
+        args.emplace_back(output.data());
+        args.emplace_back(format.data());
+    }
+
+    // The importer and serializers log every file, which would drown the results
+    spdlog::set_level(spdlog::level::warn);
+
+    auto count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+    benchmark::AddCustomContext("neo_commit", NEO_GIT_COMMIT);
+    benchmark::AddCustomContext("neo_seed", std::to_string(Neo::Bench::kSeed));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "BenchmarkCommon.hpp"
+#include "Core/Components.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace
+{
+    std::vector<Neo::Transform> MakeTransforms(const i64 count)
+    {
+        auto random = Neo::Bench::MakeRandom();
+        std::uniform_real_distribution position(-1000.f, 1000.f);
+        std::uniform_real_distribution angle(-glm::pi<float>(), glm::pi<float>());
+        std::uniform_real_distribution scale(0.5f, 2.f);
+        std::vector<Neo::Transform> transforms(static_cast<size_t>(count));
+        for (auto& transform : transforms)
+        {
+            transform.Position = glm::vec3(position(random), position(random), position(random));
+            transform.Rotation = glm::vec3(angle(random), angle(random), angle(random));
+            transform.Scale = glm::vec3(scale(random));
+        }
+        return transforms;
+    }
+
+    void BM_Math_WorldMatrices(benchmark::State& state)
+    {
+        const auto transforms = MakeTransforms(state.range(0));
+        std::vector<glm::mat4> matrices(transforms.size());
+        for (auto _ : state)
+        {
+            for (size_t index = 0; index < transforms.size(); index++)
+            {
+                const auto& [position, rotation, scale] = transforms[index];
+                matrices[index] = glm::translate(glm::mat4(1.f), position) * glm::mat4_cast(glm::quat(rotation)) *
+                    glm::scale(glm::mat4(1.f), scale);
+            }
+            benchmark::DoNotOptimize(matrices.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Math_WorldMatrices)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+    void BM_Math_TransformPoints(benchmark::State& state)
+    {
+        const auto transforms = MakeTransforms(state.range(0));
+        const auto matrix = glm::translate(glm::mat4(1.f), glm::vec3(1.f, 2.f, 3.f)) *
+            glm::mat4_cast(glm::quat(glm::vec3(0.3f, 0.2f, 0.1f)));
+        std::vector<glm::vec3> points(transforms.size());
+        for (auto _ : state)
+        {
+            for (size_t index = 0; index < transforms.size(); index++)
+            {
+                points[index] = glm::vec3(matrix * glm::vec4(transforms[index].Position, 1.f));
+            }
+            benchmark::DoNotOptimize(points.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Math_TransformPoints)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+    void BM_HashBytes(benchmark::State& state)
+    {
+        std::vector<u8> bytes(static_cast<size_t>(state.range(0)));
+        auto random = Neo::Bench::MakeRandom();
+        std::ranges::generate(bytes, [&] { return static_cast<u8>(random()); });
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(Neo::HashBytes(bytes.data(), bytes.size()));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_HashBytes)->Arg(64)->Arg(1 << 20);
+}
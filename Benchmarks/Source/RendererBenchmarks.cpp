@@ -0,0 +1,523 @@
+#include "BenchmarkCommon.hpp"
+#include "Core/Components.hpp"
+#include "Core/Renderer.hpp"
+#include "Render/Null/RenderContextNull.hpp"
+
+namespace
+{
+    constexpr Neo::RenderContextCreateInfo kNullCreateInfo{
+        .GpuPreference = Neo::DevicePreference::eHighPerformance,
+        .Backend = Neo::RenderBackend::eNull,
+        .Size = glm::uvec2(1920, 1080),
+    };
+
+    Neo::RenderContextNull& GetNullContext(Neo::Renderer& renderer)
+    {
+        return static_cast<Neo::RenderContextNull&>(*renderer.GetRenderContext());
+    }
+
+    constexpr u32 kObjectPasses = 8;
+
+    // Whole frames on the null backend, with passes issuing one push constant and draw per object. The second
+    // argument records the passes on worker threads
+    void BM_Renderer_Update(benchmark::State& state)
+    {
+        Neo::Renderer renderer(kNullCreateInfo);
+        renderer.SetParallelRecording(state.range(1) != 0);
+        const auto drawCount = static_cast<u32>(state.range(0)) / kObjectPasses;
+        for (u32 pass = 0; pass < kObjectPasses; pass++)
+        {
+            renderer.AddRenderPass({
+                .Name = fmt::format("Objects {}", pass),
+                .Setup = [&renderer](Neo::RenderGraphBuilder& builder)
+                {
+                    builder.Write(renderer.GetSceneResource());
+                },
+                .Execute = [&renderer, drawCount](const Neo::RenderGraph&, const Neo::CommandHandle command)
+                {
+                    const auto& context = renderer.GetRenderContext();
+                    const auto renderTarget = renderer.GetRenderTarget();
+                    const Neo::RenderPassInfo renderPassInfo{
+                        .RenderTargets = std::span(&renderTarget, 1),
+                        .RenderTargetLoadOp = Neo::RenderPassInfo::LoadOp::eLoad,
+                    };
+                    context->BeginRenderPass(command, renderPassInfo);
+                    for (u32 draw = 0; draw < drawCount; draw++)
+                    {
+                        context->PushConstant(command, 1, &draw);
+                        context->Draw(command, 36, 1, 0, 0);
+                    }
+                    context->EndRenderPass(command);
+                }
+            });
+        }
+
+        auto& context = GetNullContext(renderer);
+        context.ResetCallCounts();
+        Neo::FrameAllocator frameAllocator;
+        Neo::Bench::MemoryCounters memory(state);
+        Neo::Bench::MetricCounters metrics(state);
+        for (auto _ : state)
+        {
+            frameAllocator.BeginFrame();
+            renderer.Update(0.f, frameAllocator);
+        }
+        const auto frames = static_cast<double>(context.GetCallCount(Neo::NullCall::ePresent));
+        state.counters["Draws"] = static_cast<double>(context.GetCallCount(Neo::NullCall::eDraw)) / frames;
+        state.counters["CommandLists"] = static_cast<double>(context.GetSubmitted().size());
+        size_t recorded = 0;
+        for (const auto command : context.GetSubmitted())
+        {
+            recorded += context.GetCommands(command).size();
+        }
+        state.counters["Commands"] = static_cast<double>(recorded);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Renderer_Update)
+        ->ArgsProduct({{0, 1'000, 100'000}, {0, 1}})
+        ->ArgNames({"Draws", "Parallel"})
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    // A chain of full screen passes, each reading the previous transient target, ending in the backbuffer.
+    // Only neighbouring targets are live together, so the chain needs two physical targets however long it is
+    void DeclarePostChain(Neo::RenderGraph& graph, const Neo::RenderTargetHandle backbuffer, const i64 length)
+    {
+        graph.Reset();
+        const auto output = graph.Import("Backbuffer", backbuffer, Neo::ResourceState::ePresent,
+                                         Neo::ResourceState::ePresent);
+        auto previous = Neo::RenderGraphResource::eNull;
+        for (i64 pass = 0; pass < length; pass++)
+        {
+            graph.AddPass(fmt::format("Post {}", pass), [&](Neo::RenderGraphBuilder& builder)
+            {
+                if (previous != Neo::RenderGraphResource::eNull) builder.Read(previous);
+                previous = builder.Write(builder.CreateRenderTarget("Post", {.Size = kNullCreateInfo.Size}));
+            }, {});
+        }
+        // Never read, so culling drops it
+        graph.AddPass("Debug", [](Neo::RenderGraphBuilder& builder)
+        {
+            builder.Write(builder.CreateRenderTarget("Debug", {.Size = kNullCreateInfo.Size}));
+        }, {});
+        graph.AddPass("Composite", [&](Neo::RenderGraphBuilder& builder)
+        {
+            builder.Read(previous);
+            builder.Write(output);
+        }, {});
+    }
+
+    void BM_RenderGraph_Compile(benchmark::State& state)
+    {
+        Neo::RenderContextNull context(kNullCreateInfo);
+        Neo::RenderGraph graph;
+        const auto backbuffer = context.GetFrameData().RenderTargetHandle;
+        for (auto _ : state)
+        {
+            DeclarePostChain(graph, backbuffer, state.range(0));
+            // Releasing drops the compiled result, so every iteration pays for a full compile
+            state.PauseTiming();
+            graph.Release(context);
+            state.ResumeTiming();
+            graph.Compile(context);
+        }
+        state.counters["Passes"] = static_cast<double>(graph.GetExecutedPasses().size());
+        state.counters["Barriers"] = static_cast<double>(graph.GetBarriers().size());
+        state.counters["Transients"] = static_cast<double>(graph.GetTransientCount());
+        state.counters["PhysicalTargets"] = static_cast<double>(graph.GetPhysicalTargetCount());
+        graph.Release(context);
+    }
+    BENCHMARK(BM_RenderGraph_Compile)->Arg(8)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+    // The steady state: the same passes every frame, so compiling only hashes the declarations
+    void BM_RenderGraph_Cached(benchmark::State& state)
+    {
+        Neo::RenderContextNull context(kNullCreateInfo);
+        Neo::RenderGraph graph;
+        const auto backbuffer = context.GetFrameData().RenderTargetHandle;
+        for (auto _ : state)
+        {
+            DeclarePostChain(graph, backbuffer, state.range(0));
+            graph.Compile(context);
+        }
+        state.counters["Compiles"] = static_cast<double>(graph.GetCompileCount());
+        graph.Release(context);
+    }
+    BENCHMARK(BM_RenderGraph_Cached)->Arg(8)->Arg(64)->Unit(benchmark::kMicrosecond);
+
+    struct DrawInput
+    {
+        Neo::DrawPass Pass;
+        Neo::ShaderHandle Shader;
+        u32 Material;
+        Neo::AssetHandle<Neo::Mesh> Mesh;
+        glm::mat4 World;
+    };
+
+    // A scene with a few shaders, a few hundred materials and a thousand meshes, one draw in ten transparent
+    std::vector<DrawInput> MakeDraws(const i64 count)
+    {
+        auto random = Neo::Bench::MakeRandom();
+        std::uniform_real_distribution position(-1000.f, 1000.f);
+        std::uniform_int_distribution<u32> shader(0, 7);
+        std::uniform_int_distribution<u32> material(0, 255);
+        std::uniform_int_distribution<u32> mesh(0, 1023);
+        std::uniform_int_distribution<u32> transparent(0, 9);
+        std::vector<DrawInput> draws(static_cast<size_t>(count));
+        for (auto& draw : draws)
+        {
+            draw.Pass = transparent(random) == 0 ? Neo::DrawPass::eTransparent : Neo::DrawPass::eOpaque;
+            draw.Shader = std::bit_cast<Neo::ShaderHandle>(shader(random));
+            draw.Material = material(random);
+            draw.Mesh = Neo::AssetHandle<Neo::Mesh>(mesh(random), 0);
+            draw.World = glm::mat4(1.f);
+            draw.World[3] = glm::vec4(position(random), position(random), position(random), 1.f);
+        }
+        return draws;
+    }
+
+    // A frame of draws added, radix sorted by key and merged into instanced batches
+    void BM_DrawList_Build(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        Neo::DrawList drawList;
+        const Neo::DrawView view{.Far = 2000.f};
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            drawList.Begin(view);
+            for (const auto& draw : draws)
+            {
+                drawList.Add(draw.Pass, draw.Shader, draw.Material, draw.Mesh, 0, draw.World);
+            }
+            drawList.Finish();
+            benchmark::DoNotOptimize(drawList.GetBatches().data());
+        }
+        const auto& stats = drawList.GetStats();
+        state.counters["DrawCalls"] = static_cast<double>(stats.DrawCalls);
+        state.counters["StateChanges"] = static_cast<double>(stats.GetStateChanges());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_DrawList_Build)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    // The same keys sorted with std::sort, what the radix sort is measured against
+    void BM_DrawList_StdSort(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        std::vector<std::pair<u64, u32>> keys;
+        for (const auto& draw : draws)
+        {
+            const auto depth = draw.World[3].z / 2000.f;
+            keys.emplace_back(Neo::DrawList::MakeKey(draw.Pass, draw.Shader, draw.Material, draw.Mesh, 0, depth),
+                              static_cast<u32>(keys.size()));
+        }
+        std::vector<std::pair<u64, u32>> sorted;
+        for (auto _ : state)
+        {
+            sorted = keys;
+            std::ranges::sort(sorted, {}, &std::pair<u64, u32>::first);
+            benchmark::DoNotOptimize(sorted.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_DrawList_StdSort)->Arg(10'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    // A camera at the origin looking down -Z, seeing about a tenth of the scene from MakeDraws
+    Neo::DrawView MakeCameraView()
+    {
+        const Neo::Camera camera{.FieldOfView = 60.f, .Far = 1000.f};
+        return Neo::MakeDrawView(Neo::Transform{.Scale = glm::vec3(1.f)}, camera, glm::uvec2(1920, 1080));
+    }
+
+    // Unit cubes at the positions of the draws
+    Neo::FrustumCuller MakeCuller(const std::span<const DrawInput> draws)
+    {
+        constexpr Neo::Bounds cube{.Min = glm::vec3(-1.f), .Max = glm::vec3(1.f), .Radius = 1.7320508f};
+        Neo::FrustumCuller culler;
+        for (const auto& draw : draws)
+        {
+            culler.Add(Neo::TransformBounds(cube, draw.World));
+        }
+        return culler;
+    }
+
+    void BM_FrustumCuller_Cull(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        auto culler = MakeCuller(draws);
+        const auto view = MakeCameraView();
+        size_t visible = 0;
+        for (auto _ : state)
+        {
+            visible = culler.Cull(view.Frustum).size();
+            benchmark::DoNotOptimize(visible);
+        }
+        state.counters["Visible"] = static_cast<double>(visible);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_FrustumCuller_Cull)->Arg(100'000)->Arg(1'000'000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+    // BM_DrawList_Build with culling in front, so sorting and batching only pay for what the camera sees
+    void BM_DrawList_Culled(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        auto culler = MakeCuller(draws);
+        Neo::DrawList drawList;
+        const auto view = MakeCameraView();
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            drawList.Begin(view);
+            for (const auto index : culler.Cull(view.Frustum))
+            {
+                const auto& draw = draws[index];
+                drawList.Add(draw.Pass, draw.Shader, draw.Material, draw.Mesh, 0, draw.World);
+            }
+            drawList.Finish();
+            benchmark::DoNotOptimize(drawList.GetBatches().data());
+        }
+        const auto& stats = drawList.GetStats();
+        state.counters["Visible"] = static_cast<double>(stats.Draws);
+        state.counters["DrawCalls"] = static_cast<double>(stats.DrawCalls);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_DrawList_Culled)->Arg(100'000)->Arg(1'000'000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+    // Unit cubes at the positions of the draws, built with the surface area heuristic
+    Neo::BVH MakeBVH(const std::span<const DrawInput> draws)
+    {
+        Neo::BVH bvh;
+        for (u32 index = 0; index < draws.size(); index++)
+        {
+            const auto position = glm::vec3(draws[index].World[3]);
+            bvh.Insert({.Min = position - 1.f, .Max = position + 1.f}, index);
+        }
+        bvh.Build();
+        return bvh;
+    }
+
+    void BM_BVH_Build(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        auto bvh = MakeBVH(draws);
+        for (auto _ : state)
+        {
+            bvh.Build();
+            benchmark::DoNotOptimize(bvh.GetNodeCount());
+        }
+        state.counters["Nodes"] = static_cast<double>(bvh.GetNodeCount());
+        state.counters["Cost"] = static_cast<double>(bvh.GetCost());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BVH_Build)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    // The same scene and camera as BM_FrustumCuller_Cull, skipping whole subtrees instead of testing every box
+    void BM_BVH_QueryFrustum(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        const auto bvh = MakeBVH(draws);
+        const auto view = MakeCameraView();
+        std::vector<u32> visible;
+        for (auto _ : state)
+        {
+            visible.clear();
+            bvh.QueryFrustum(view.Frustum, visible);
+            benchmark::DoNotOptimize(visible.data());
+        }
+        state.counters["Visible"] = static_cast<double>(visible.size());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_BVH_QueryFrustum)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+    // Picking rays from the middle of the scene in random directions
+    void BM_BVH_Raycast(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        const auto bvh = MakeBVH(draws);
+        auto random = Neo::Bench::MakeRandom();
+        std::normal_distribution direction(0.f, 1.f);
+        std::vector<glm::vec3> rays(1024);
+        for (auto& ray : rays)
+        {
+            ray = glm::normalize(glm::vec3(direction(random), direction(random), direction(random)));
+        }
+
+        u32 ray = 0;
+        u32 hits = 0;
+        for (auto _ : state)
+        {
+            const auto hit = bvh.Raycast(glm::vec3(0.f), rays[ray++ % rays.size()], 2000.f);
+            hits += hit.has_value();
+            benchmark::DoNotOptimize(hit);
+        }
+        state.counters["HitRate"] = static_cast<double>(hits) / static_cast<double>(state.iterations());
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_BVH_Raycast)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMicrosecond);
+
+    // A hundredth of the objects nudged every frame and refitted in place
+    void BM_BVH_Refit(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        Neo::BVH bvh;
+        std::vector<Neo::BVHProxy> proxies;
+        for (u32 index = 0; index < draws.size(); index++)
+        {
+            const auto position = glm::vec3(draws[index].World[3]);
+            proxies.emplace_back(bvh.Insert({.Min = position - 1.f, .Max = position + 1.f}, index));
+        }
+        bvh.Build();
+
+        const auto moving = static_cast<u32>(draws.size() / 100);
+        float offset = 0.f;
+        for (auto _ : state)
+        {
+            offset = offset > 0.f ? -0.5f : 0.5f;
+            for (u32 index = 0; index < draws.size(); index += 100)
+            {
+                const auto position = glm::vec3(draws[index].World[3]) + offset;
+                bvh.Update(proxies[index], {.Min = position - 1.f, .Max = position + 1.f});
+            }
+        }
+        state.counters["Cost"] = static_cast<double>(bvh.GetCost());
+        state.SetItemsProcessed(state.iterations() * moving);
+    }
+    BENCHMARK(BM_BVH_Refit)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    // Box with its corners at min and max, as an occluder mesh
+    std::pair<std::vector<Neo::Vertex>, std::vector<u32>> MakeBox(const glm::vec3 min, const glm::vec3 max)
+    {
+        std::vector<Neo::Vertex> vertices(8);
+        for (u32 corner = 0; corner < 8; corner++)
+        {
+            vertices[corner].Position = glm::vec3(corner & 1 ? max.x : min.x, corner & 2 ? max.y : min.y,
+                                                  corner & 4 ? max.z : min.z);
+        }
+        std::vector<u32> indices{
+            0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1,
+            2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3,
+        };
+        return {std::move(vertices), std::move(indices)};
+    }
+
+    // Street level in a city: rows of buildings in front of the camera as occluders, and the objects of MakeDraws
+    // spread among and behind them. Rasterizes the buildings and tests every object in the frustum
+    void BM_OcclusionCuller(benchmark::State& state)
+    {
+        const auto draws = MakeDraws(state.range(0));
+        auto culler = MakeCuller(draws);
+        const auto view = MakeCameraView();
+        const auto visible = culler.Cull(view.Frustum);
+        std::vector<Neo::Bounds> bounds;
+        for (const auto index : visible)
+        {
+            const auto position = glm::vec3(draws[index].World[3]);
+            bounds.push_back({.Min = position - 1.f, .Max = position + 1.f, .Center = position, .Radius = 1.7320508f});
+        }
+
+        std::vector<std::pair<std::vector<Neo::Vertex>, std::vector<u32>>> buildings;
+        for (int row = 1; row <= 4; row++)
+        {
+            for (int column = -8; column <= 8; column++)
+            {
+                const glm::vec3 min(static_cast<float>(column) * 80.f - 20.f, -1000.f,
+                                    static_cast<float>(row) * -150.f);
+                buildings.emplace_back(MakeBox(min, min + glm::vec3(40.f, 1040.f, 40.f)));
+            }
+        }
+
+        Neo::OcclusionCuller occlusion;
+        u32 occluded = 0;
+        for (auto _ : state)
+        {
+            occlusion.Begin(view.ViewProjection);
+            for (const auto& [vertices, indices] : buildings)
+            {
+                occlusion.AddOccluder(vertices, indices, glm::mat4(1.f));
+            }
+            occlusion.Rasterize();
+            occluded = 0;
+            for (const auto& box : bounds)
+            {
+                occluded += !occlusion.IsVisible(box);
+            }
+            benchmark::DoNotOptimize(occluded);
+        }
+        state.counters["InFrustum"] = static_cast<double>(bounds.size());
+        state.counters["Occluded"] = static_cast<double>(occluded);
+        state.counters["Triangles"] = static_cast<double>(occlusion.GetTriangleCount());
+        state.SetItemsProcessed(state.iterations() * static_cast<i64>(bounds.size()));
+    }
+    BENCHMARK(BM_OcclusionCuller)->Arg(100'000)->Arg(1'000'000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+    void BM_Renderer_Resize(benchmark::State& state)
+    {
+        Neo::Renderer renderer(kNullCreateInfo);
+        Neo::FrameAllocator frameAllocator;
+        u32 frame = 0;
+        for (auto _ : state)
+        {
+            renderer.Resize(glm::uvec2(1280 + frame % 2 * 640, 720 + frame % 2 * 360));
+            frameAllocator.BeginFrame();
+            renderer.Update(0.f, frameAllocator);
+            frame++;
+        }
+    }
+    BENCHMARK(BM_Renderer_Resize);
+
+    // Frames of a bulk load on the null backend, uploads of 64 KiB each. The second argument submits and waits for
+    // every upload on its own through a staging buffer, the way uploads were done before the upload queue
+    void BM_UploadQueue(benchmark::State& state)
+    {
+        constexpr u32 kUploadSize = 64 * 1024;
+        const auto uploadCount = static_cast<u32>(state.range(0));
+        const bool oneTime = state.range(1) != 0;
+        Neo::RenderContextNull context(kNullCreateInfo);
+        const Neo::BufferCreateInfo destinationCreateInfo{
+            .FirstElement = 0,
+            .NumElements = kUploadSize / 4 * uploadCount,
+            .Stride = 4,
+            .Type = Neo::BufferType::eStorage,
+        };
+        const auto destination = context.CreateBuffer(destinationCreateInfo, "Destination");
+        const std::vector data(kUploadSize, std::byte{1});
+        const auto command = context.CreateCommand(Neo::QueueType::eTransfer, "Transfer");
+
+        Neo::UploadQueue uploads(context);
+        Neo::Bench::MetricCounters metrics(state);
+        for (auto _ : state)
+        {
+            for (u32 upload = 0; upload < uploadCount; upload++)
+            {
+                const u64 offset = static_cast<u64>(upload) * kUploadSize;
+                if (!oneTime)
+                {
+                    uploads.Upload(destination, offset, data);
+                    continue;
+                }
+                const auto staging = context.CreateBuffer(
+                    {.FirstElement = 0, .NumElements = kUploadSize, .Stride = 1, .Type = Neo::BufferType::eStaging},
+                    "Staging");
+                std::memcpy(context.MapBuffer(staging), data.data(), kUploadSize);
+                context.UnmapBuffer(staging);
+                context.BeginCommand(command);
+                context.CopyBuffer(command, staging, destination, 0, offset, kUploadSize);
+                context.EndCommand(command);
+                context.OneTimeSubmit(std::array{command}, Neo::QueueType::eTransfer);
+                context.DestroyBuffer(staging);
+            }
+            uploads.Submit();
+            context.Present();
+        }
+        const auto frames = static_cast<double>(context.GetCallCount(Neo::NullCall::ePresent));
+        state.counters["SubmitsPerFrame"] = static_cast<double>(context.GetCallCount(Neo::NullCall::eSubmit)) / frames;
+        state.counters["Pages"] = static_cast<double>(uploads.GetPageCount());
+        state.SetBytesProcessed(state.iterations() * state.range(0) * kUploadSize);
+    }
+    BENCHMARK(BM_UploadQueue)
+        ->ArgsProduct({{16, 256}, {0, 1}})
+        ->ArgNames({"Uploads", "OneTime"})
+        ->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,340 @@
+#include "BenchmarkCommon.hpp"
+#include "Core/Pool.hpp"
+#include "Core/Resources.hpp"
+#include "Memory/LinearAllocator.hpp"
+#include "Memory/OffsetAllocator.hpp"
+#include "Memory/RingAllocator.hpp"
+#include "Resources/MaterialTable.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Tools/Serializer.hpp"
+
+namespace
+{
+    constexpr i64 kDrawCount = 10'000;
+
+    // Materials that differ only in their color, drawn from a small palette so many of them end up identical
+    std::vector<Neo::MaterialParams> MakeMaterials(const i64 count, const i64 uniqueCount)
+    {
+        auto random = Neo::Bench::MakeRandom();
+        std::uniform_int_distribution<i64> pick(0, uniqueCount - 1);
+        std::vector<Neo::MaterialParams> materials(static_cast<size_t>(count));
+        for (auto& material : materials)
+        {
+            const auto shade = static_cast<float>(pick(random)) / static_cast<float>(uniqueCount);
+            material.BaseColorFactor = glm::vec4(shade, 1.f - shade, 0.5f, 1.f);
+        }
+        return materials;
+    }
+
+    void BM_MaterialTable_Add(benchmark::State& state)
+    {
+        const auto materials = MakeMaterials(kDrawCount, state.range(0));
+        for (auto _ : state)
+        {
+            Neo::MaterialTable table;
+            for (const auto& material : materials)
+            {
+                benchmark::DoNotOptimize(table.Add(material));
+            }
+            state.counters["Entries"] = static_cast<double>(table.GetCount());
+        }
+        state.SetItemsProcessed(state.iterations() * kDrawCount);
+    }
+    BENCHMARK(BM_MaterialTable_Add)->Arg(16)->Arg(kDrawCount)->Unit(benchmark::kMicrosecond);
+
+    // Every draw binding its own material object, the way draws were built before materials were deduplicated.
+    // Each change of material copies its parameters, like an upload to a constant buffer would
+    void BM_BuildDraws_PerObjectMaterials(benchmark::State& state)
+    {
+        const auto materials = MakeMaterials(kDrawCount, state.range(0));
+        Neo::MaterialParams bound{};
+        for (auto _ : state)
+        {
+            i64 switches = 0;
+            const Neo::MaterialParams* current = nullptr;
+            for (const auto& material : materials)
+            {
+                if (&material == current) continue;
+                current = &material;
+                std::memcpy(&bound, current, sizeof(bound));
+                switches++;
+            }
+            benchmark::DoNotOptimize(bound);
+            state.counters["Switches"] = static_cast<double>(switches);
+        }
+        state.SetItemsProcessed(state.iterations() * kDrawCount);
+    }
+    BENCHMARK(BM_BuildDraws_PerObjectMaterials)->Arg(16)->Arg(kDrawCount)->Unit(benchmark::kMicrosecond);
+
+    // Draws keyed by their MaterialTable index and sorted, so identical materials are bound once
+    void BM_BuildDraws_MaterialTable(benchmark::State& state)
+    {
+        const auto materials = MakeMaterials(kDrawCount, state.range(0));
+        Neo::MaterialTable table;
+        std::vector<u32> drawMaterials;
+        drawMaterials.reserve(materials.size());
+        for (const auto& material : materials)
+        {
+            drawMaterials.emplace_back(table.Add(material));
+        }
+
+        std::vector<u64> keys(drawMaterials.size());
+        Neo::MaterialParams bound{};
+        for (auto _ : state)
+        {
+            for (size_t draw = 0; draw < drawMaterials.size(); draw++)
+            {
+                keys[draw] = static_cast<u64>(drawMaterials[draw]) << 32 | draw;
+            }
+            std::ranges::sort(keys);
+
+            i64 switches = 0;
+            auto current = std::numeric_limits<u32>::max();
+            for (const auto key : keys)
+            {
+                const auto index = static_cast<u32>(key >> 32);
+                if (index == current) continue;
+                current = index;
+                std::memcpy(&bound, &table.Get(index), sizeof(bound));
+                switches++;
+            }
+            benchmark::DoNotOptimize(bound);
+            state.counters["Switches"] = static_cast<double>(switches);
+        }
+        state.SetItemsProcessed(state.iterations() * kDrawCount);
+    }
+    BENCHMARK(BM_BuildDraws_MaterialTable)->Arg(16)->Arg(kDrawCount)->Unit(benchmark::kMicrosecond);
+
+    enum class BenchmarkHandle : u32 {};
+
+    void BM_Pool_Churn(benchmark::State& state)
+    {
+        Neo::Pool<glm::vec4, BenchmarkHandle> pool;
+        std::vector<BenchmarkHandle> handles;
+        for (i64 index = 0; index < state.range(0); index++)
+        {
+            handles.emplace_back(pool.Emplace(glm::vec4(static_cast<float>(index))));
+        }
+
+        auto random = Neo::Bench::MakeRandom();
+        std::uniform_int_distribution<size_t> pick(0, handles.size() - 1);
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            // Replace one object and read a few others, the mix render objects see every frame
+            auto& handle = handles[pick(random)];
+            (void)pool.Remove(handle);
+            handle = pool.Emplace(glm::vec4(1.f));
+            for (int read = 0; read < 8; read++)
+            {
+                benchmark::DoNotOptimize(pool.Get(handles[pick(random)]));
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Pool_Churn)->Arg(1'000)->Arg(100'000);
+
+    void BM_GenerateMips(benchmark::State& state)
+    {
+        const auto size = static_cast<u32>(state.range(0));
+        std::vector<u8> pixels(static_cast<size_t>(size) * size * Neo::kTextureBytesPerPixel);
+        auto random = Neo::Bench::MakeRandom();
+        std::ranges::generate(pixels, [&] { return static_cast<u8>(random()); });
+
+        for (auto _ : state)
+        {
+            const auto mips = Neo::GenerateMips(pixels, size, size);
+            benchmark::DoNotOptimize(mips.data());
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(pixels.size()));
+    }
+    BENCHMARK(BM_GenerateMips)->Arg(256)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+    // Cooks the textures once per run, the same files for every benchmark that asks for the same count
+    std::vector<Neo::AssetID> CookTextures(Neo::Resources& resources, const u32 count)
+    {
+        constexpr u32 kTextureSize = 128;
+        auto random = Neo::Bench::MakeRandom();
+        std::vector<Neo::AssetID> ids;
+        for (u32 index = 0; index < count; index++)
+        {
+            const auto path = (Neo::Bench::GetTempDirectory() / fmt::format("Texture{}.asset", index)).string();
+            auto& id = ids.emplace_back(
+                uuids::uuid::from_string(fmt::format("00000000-0000-0000-0002-{:012}", index)).value());
+            if (!std::filesystem::exists(path))
+            {
+                std::vector<u8> image(static_cast<size_t>(kTextureSize) * kTextureSize * Neo::kTextureBytesPerPixel);
+                std::ranges::generate(image, [&] { return static_cast<u8>(random()); });
+
+                Neo::TextureDesc desc{};
+                desc.Name = fmt::format("Texture{}", index);
+                desc.ID = id;
+                desc.Width = kTextureSize;
+                desc.Height = kTextureSize;
+                desc.MipLevels = Neo::GetMipCount(kTextureSize, kTextureSize);
+                desc.Pixels = Neo::GenerateMips(image, kTextureSize, kTextureSize);
+                (void)Neo::BinarySerializer::Serialize(desc, path);
+            }
+            resources.RegisterAsset(id, path);
+        }
+        return ids;
+    }
+
+    // A level coming and going: every texture is loaded and finished, dropped, then evicted by the memory budget
+    // on the next update. The second argument streams the loads on the worker instead of reading them right away
+    void BM_Resources_LoadFinishEvict(benchmark::State& state)
+    {
+        const auto count = static_cast<u32>(state.range(0));
+        const bool streamed = state.range(1) != 0;
+        Neo::Resources resources;
+        resources.SetFrameBudget(std::chrono::seconds(10));
+        // Everything unreferenced goes on the update after it is released
+        resources.SetMemoryBudget(0);
+        const auto ids = CookTextures(resources, count);
+        std::vector<Neo::AssetHandle<Neo::Texture>> handles(ids.size());
+
+        Neo::Bench::MemoryCounters memory(state);
+        Neo::Bench::MetricCounters metrics(state);
+        for (auto _ : state)
+        {
+            for (size_t index = 0; index < ids.size(); index++)
+            {
+                handles[index] = streamed ? resources.RequestTexture(ids[index], 1.f)
+                                          : resources.LoadTexture(ids[index]);
+            }
+            while (!std::ranges::all_of(handles, [&](const auto handle) { return resources.IsLoaded(handle); }))
+            {
+                resources.Update();
+                // Leaves the core to the streaming worker on small machines
+                std::this_thread::yield();
+            }
+
+            for (const auto handle : handles)
+            {
+                resources.Release(handle);
+            }
+            resources.Update();
+            if (resources.GetResidentSize() != 0)
+            {
+                state.SkipWithError("Released textures were not evicted");
+                break;
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Resources_LoadFinishEvict)
+        ->ArgsProduct({{16, 256}, {0, 1}})
+        ->ArgNames({"Textures", "Streamed"})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+
+    struct Particle
+    {
+        glm::vec3 Position;
+        glm::vec3 Velocity;
+    };
+
+    void BM_Allocate_Heap(benchmark::State& state)
+    {
+        std::vector<Particle*> particles(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            for (auto& particle : particles) particle = new Particle{};
+            benchmark::DoNotOptimize(particles.data());
+            for (const auto* particle : particles) delete particle;
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Allocate_Heap)->Arg(10'000);
+
+    void BM_Allocate_Linear(benchmark::State& state)
+    {
+        Neo::LinearAllocator arena;
+        std::vector<Particle*> particles(static_cast<size_t>(state.range(0)));
+        for (auto _ : state)
+        {
+            for (auto& particle : particles) particle = arena.New<Particle>();
+            benchmark::DoNotOptimize(particles.data());
+            arena.Reset();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Allocate_Linear)->Arg(10'000);
+
+    // Frames cycling through the frames in flight, each writing its particles into a ring of mapped memory the
+    // way the renderer streams instances, one allocation per particle to measure the allocator itself
+    void BM_Allocate_Ring(benchmark::State& state)
+    {
+        const auto count = static_cast<u64>(state.range(0));
+        std::vector<std::byte> memory(count * sizeof(Particle) * (Neo::kFrameCount + 1));
+        Neo::RingAllocator ring(memory.size());
+        u32 frame = 0;
+        for (auto _ : state)
+        {
+            ring.BeginFrame(frame);
+            for (u64 i = 0; i < count; i++)
+            {
+                const auto offset = ring.Allocate(sizeof(Particle), alignof(Particle));
+                new (memory.data() + *offset) Particle{};
+            }
+            benchmark::DoNotOptimize(memory.data());
+            ring.EndFrame();
+            frame = (frame + 1) % Neo::kFrameCount;
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Allocate_Ring)->Arg(10'000);
+
+    // A randomized trace of buffers and textures coming and going in a 1 GiB heap with 64 KiB placement, an
+    // iteration per frame and a third of the frees deferred by kFrameCount frames the way destroyed GPU resources
+    // are. The argument is how many resources are live on average
+    void BM_Allocate_Offset(benchmark::State& state)
+    {
+        constexpr u64 kHeapSize = 1ull << 30;
+        constexpr u64 kGranularity = 64 * 1024;
+        constexpr u32 kOperationsPerFrame = 100;
+        const auto liveCount = static_cast<size_t>(state.range(0));
+        auto random = Neo::Bench::MakeRandom();
+        // Mostly small buffers, now and then a texture of several megabytes
+        std::uniform_int_distribution<u64> smallSize(1, 256 * 1024);
+        std::uniform_int_distribution<u64> largeSize(1024 * 1024, 16 * 1024 * 1024);
+        std::uniform_int_distribution<u32> kind(0, 15);
+
+        Neo::OffsetAllocator allocator(kHeapSize, kGranularity);
+        std::vector<Neo::OffsetAllocation> live;
+        u64 frame = 0;
+        u64 failures = 0;
+        for (auto _ : state)
+        {
+            for (u32 operation = 0; operation < kOperationsPerFrame; operation++)
+            {
+                if (live.size() < liveCount || kind(random) < 7)
+                {
+                    const bool large = kind(random) == 0;
+                    // Large ones are aligned like multisampled textures
+                    const auto allocation = large
+                        ? allocator.Allocate(largeSize(random), 4 * 1024 * 1024)
+                        : allocator.Allocate(smallSize(random), kGranularity);
+                    if (allocation) live.emplace_back(*allocation);
+                    else failures++;
+                    continue;
+                }
+                std::uniform_int_distribution<size_t> pick(0, live.size() - 1);
+                const auto index = pick(random);
+                if (kind(random) < 5) allocator.FreeDeferred(live[index], frame);
+                else allocator.Free(live[index]);
+                live[index] = live.back();
+                live.pop_back();
+            }
+            if (frame >= Neo::kFrameCount) allocator.Collect(frame - Neo::kFrameCount);
+            frame++;
+        }
+        const auto stats = allocator.GetStats();
+        state.counters["Fragmentation"] = stats.GetFragmentation();
+        state.counters["FreeRegions"] = static_cast<double>(stats.FreeRegions);
+        state.counters["UsedMiB"] = static_cast<double>(stats.Used) / (1024. * 1024.);
+        state.counters["Failures"] = static_cast<double>(failures);
+        state.SetItemsProcessed(state.iterations() * kOperationsPerFrame);
+    }
+    BENCHMARK(BM_Allocate_Offset)->Arg(100)->Arg(1'000);
+}
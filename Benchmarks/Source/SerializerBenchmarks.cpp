@@ -0,0 +1,99 @@
+#include "BenchmarkCommon.hpp"
+#include "Core/FileIO.hpp"
+#include "Resources/Resource.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Tools/Serializer.hpp"
+
+namespace
+{
+    // A gradient with noise on top compresses about as well as a real albedo texture
+    Neo::TextureDesc MakeTexture(const u32 size)
+    {
+        auto random = Neo::Bench::MakeRandom();
+        std::uniform_int_distribution noise(0, 15);
+        Neo::TextureDesc texture{};
+        texture.Name = "BenchmarkTexture";
+        texture.ID = Neo::AssetID{};
+        texture.Width = size;
+        texture.Height = size;
+        texture.Pixels.resize(static_cast<size_t>(size) * size * Neo::kTextureBytesPerPixel);
+        for (u32 y = 0; y < size; y++)
+        {
+            for (u32 x = 0; x < size; x++)
+            {
+                auto* pixel = &texture.Pixels[(static_cast<size_t>(y) * size + x) * Neo::kTextureBytesPerPixel];
+                pixel[0] = static_cast<u8>(x * 255 / size + noise(random));
+                pixel[1] = static_cast<u8>(y * 255 / size + noise(random));
+                pixel[2] = static_cast<u8>(noise(random) * 8);
+                pixel[3] = 255;
+            }
+        }
+        return texture;
+    }
+
+    void BM_Serializer_WriteTexture(benchmark::State& state)
+    {
+        auto texture = MakeTexture(1024);
+        const auto compression = static_cast<Neo::Compression>(state.range(0));
+        const auto path = (Neo::Bench::GetTempDirectory() / "Texture.asset").string();
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            if (!Neo::BinarySerializer::Serialize(texture, path, compression)) state.SkipWithError("Serialize failed");
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(texture.Pixels.size()));
+        state.counters["FileBytes"] = static_cast<double>(std::filesystem::file_size(path));
+        state.SetLabel(std::string(magic_enum::enum_name(compression)));
+    }
+    BENCHMARK(BM_Serializer_WriteTexture)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+    void BM_Serializer_ReadTexture(benchmark::State& state)
+    {
+        auto texture = MakeTexture(1024);
+        const auto compression = static_cast<Neo::Compression>(state.range(0));
+        const auto path = (Neo::Bench::GetTempDirectory() / "Texture.asset").string();
+        if (!Neo::BinarySerializer::Serialize(texture, path, compression)) state.SkipWithError("Serialize failed");
+
+        Neo::Bench::MemoryCounters memory(state);
+        for (auto _ : state)
+        {
+            Neo::TextureDesc read{};
+            if (!Neo::BinarySerializer::Deserialize(read, path)) state.SkipWithError("Deserialize failed");
+            benchmark::DoNotOptimize(read.Pixels.data());
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<i64>(texture.Pixels.size()));
+        state.SetLabel(std::string(magic_enum::enum_name(compression)));
+    }
+    BENCHMARK(BM_Serializer_ReadTexture)->DenseRange(0, 2)->Unit(benchmark::kMillisecond);
+
+    void BM_FileIO_WriteBinary(benchmark::State& state)
+    {
+        std::vector<char> content(static_cast<size_t>(state.range(0)));
+        auto random = Neo::Bench::MakeRandom();
+        std::ranges::generate(content, [&] { return static_cast<char>(random()); });
+        const auto path = (Neo::Bench::GetTempDirectory() / "Binary.bin").string();
+
+        for (auto _ : state)
+        {
+            if (!Neo::FileIO::WriteBinaryFile(path, content)) state.SkipWithError("WriteBinaryFile failed");
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_FileIO_WriteBinary)->Arg(64 << 10)->Arg(16 << 20)->Unit(benchmark::kMicrosecond);
+
+    void BM_FileIO_ReadBinary(benchmark::State& state)
+    {
+        const std::vector<char> content(static_cast<size_t>(state.range(0)), 'N');
+        const auto path = (Neo::Bench::GetTempDirectory() / "Binary.bin").string();
+        if (!Neo::FileIO::WriteBinaryFile(path, content)) state.SkipWithError("WriteBinaryFile failed");
+
+        for (auto _ : state)
+        {
+            const auto read = Neo::FileIO::ReadBinaryFile(path);
+            benchmark::DoNotOptimize(read.data());
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_FileIO_ReadBinary)->Arg(64 << 10)->Arg(16 << 20)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "EditorBackend.hpp"
+#include "Panel/IEditorPanel.hpp"
+#include "Tools/Profiler.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Frame time history with percentiles, a flame graph of the selected frame per thread and the zones that
+    /// took the most self time in it. With spike capture on, the history freezes on the first frame over budget
+    /// so a hitch can be inspected right where it happened. Counters and gauges from Metrics are listed below.
+    /// </summary>
+    class ProfilerPanel final : public IEditorPanel
+    {
+    public:
+        explicit ProfilerPanel(Neo::Editor& editor) : IEditorPanel(editor) {}
+        void Draw() override;
+
+    private:
+        static constexpr size_t kHistorySize = 300;
+        static constexpr size_t kTopZoneCount = 15;
+
+        void Record();
+        void DrawFrameGraph();
+        void DrawFlameGraph(const ProfileFrame& frame) const;
+        void DrawTopZones(const ProfileFrame& frame) const;
+        static void DrawMetrics();
+
+        [[nodiscard]] static float GetFrameTime(const ProfileFrame& frame);
+        [[nodiscard]] const ProfileFrame& GetHistoryFrame(size_t index) const;
+
+        std::array<ProfileFrame, kHistorySize> mHistory{};
+        size_t mHistoryCount = 0;
+        size_t mHistoryHead = 0;
+        u64 mLastFrameIndex = std::numeric_limits<u64>::max();
+        // Position in the history, oldest first
+        Opt<size_t> mSelectedFrame;
+
+        float mBudget = 1000.f / 60.f;
+        bool mCaptureSpikes = false;
+        bool mPaused = false;
+    };
+}
@@ -5,28 +5,41 @@
 #include "EditorBackend.hpp"
 #include "Panel/IEditorPanel.hpp"
 #include "Panel/ViewportPanel.hpp"
+#include "Panel/ProfilerPanel.hpp"
 #include "MaterialIcons.h"
 #include "Tools/Importer.hpp"
+#include "Memory/MemoryTracker.hpp"
+#include "Tools/Profiler.hpp"
 
 namespace Neo
 {
     void Editor::Init()
     {
+        MemoryTagScope tag(MemoryTag::eEditor);
         mBackend = new EditorBackend();
         AddPanel<ViewportPanel>();
         AddPanel<DetailsPanel>();
         AddPanel<OutlinerPanel>();
+        AddPanel<ProfilerPanel>();
         [[maybe_unused]]
             const auto entity = Engine.ECS().CreateEntity("Hello");
         const auto child = Engine.ECS().CreateEntity("Hello2");
         Engine.ECS().AddChild(entity, child);
         mSelectedEntity = entity;
-        Importer::ImportGLTF(FileIO::GetPath(Location::eProject, "Assets/Models/Drift/Drift.gltf"),
-                             FileIO::GetPath(Location::eProject, "Assets/Models/Drift/"));
+        const auto modelPath = FileIO::GetPath(Location::eProject, "Assets/Models/Drift/Drift.gltf");
+        const auto cookedPath = FileIO::GetPath(Location::eProject, "Assets/Models/Drift/");
+        if (!Importer::IsImported(modelPath, cookedPath))
+        {
+            Importer::ImportGLTF(modelPath, cookedPath);
+        }
+        Engine.Resources().LoadRegistry(
+            FileIO::GetPath(Location::eProject, "Assets/Models/Drift/" + std::string(kAssetRegistryName)));
     }
 
     void Editor::Update()
     {
+        MemoryTagScope tag(MemoryTag::eEditor);
+        NEO_PROFILE_FUNCTION();
         mBackend->Update();
 
         mBackend->StatsBarEntry([&]
@@ -34,6 +47,30 @@ namespace Neo
             const auto data = FormatString("{} {:07.02f}", material_icon_desktop_windows,
                                            1.f / Engine.GetDeltaTime());
             mBackend->Text(data);
+#ifdef NEO_MEMORY_TRACKING
+            constexpr float kMegabyte = 1024.f * 1024.f;
+            const auto memory = MemoryTracker::GetSnapshot();
+            const auto memoryData = FormatString("{} {:.1f} MB (peak {:.1f} MB) {} allocs/frame",
+                                                 material_icon_memory,
+                                                 static_cast<float>(memory.LiveBytes) / kMegabyte,
+                                                 static_cast<float>(memory.PeakBytes) / kMegabyte,
+                                                 memory.FrameAllocations);
+            mBackend->Text(memoryData);
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::BeginTooltip();
+                for (size_t index = 0; index < kMemoryTagCount; index++)
+                {
+                    const auto& stats = memory.Tags[index];
+                    ImGui::Text("%-10s %8.2f MB  peak %8.2f MB  %llu live",
+                                magic_enum::enum_name(static_cast<MemoryTag>(index)).substr(1).data(),
+                                static_cast<float>(stats.LiveBytes) / kMegabyte,
+                                static_cast<float>(stats.PeakBytes) / kMegabyte,
+                                stats.LiveAllocations);
+                }
+                ImGui::EndTooltip();
+            }
+#endif
         });
 
         for (const auto& panel : mPanels)
@@ -53,24 +53,31 @@ namespace Neo
 
         RenderPass renderPass
         {
-            .Execute = []
+            .Name = "ImGui",
+            .Setup = [](RenderGraphBuilder& builder)
+            {
+                // The viewport panel samples the scene
+                builder.Read(Engine.Renderer().GetSceneResource());
+                builder.Write(Engine.Renderer().GetBackbufferResource());
+            },
+            .Execute = [](const RenderGraph& graph, const CommandHandle command)
             {
                 const auto& context = Engine.Renderer().GetRenderContext();
-                const auto& frameData = context->GetFrameData();
+                const auto backbuffer = graph.GetRenderTarget(Engine.Renderer().GetBackbufferResource());
                 const RenderPassInfo renderPassInfo{
-                    .RenderTargets = {frameData.RenderTargetHandle},
+                    .RenderTargets = std::span(&backbuffer, 1),
                     .RenderTargetLoadOp = RenderPassInfo::LoadOp::eLoad,
                 };
-                context->BeginRenderPass(frameData.CommandHandle, renderPassInfo);
+                context->BeginRenderPass(command, renderPassInfo);
                 const Viewport viewport{.Dimensions = Engine.Device().GetWindowSize()};
-                context->SetViewport(frameData.CommandHandle, viewport);
+                context->SetViewport(command, viewport);
                 const Scissor scissor{.Max = Engine.Device().GetWindowSize()};
-                context->SetScissor(frameData.CommandHandle, scissor);
+                context->SetScissor(command, scissor);
                 ImGui::Render();
                 ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(),
                                               static_cast<ID3D12GraphicsCommandList*>(context->
-                                                  GetGraphicsCommandList()));
-                context->EndRenderPass(frameData.CommandHandle);
+                                                  GetGraphicsCommandList(command)));
+                context->EndRenderPass(command);
             }
         };
         Engine.Renderer().AddRenderPass(std::move(renderPass));
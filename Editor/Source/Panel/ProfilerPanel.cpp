@@ -0,0 +1,290 @@
+#include "Panel/ProfilerPanel.hpp"
+#include "Editor.hpp"
+#include "MaterialIcons.h"
+#include "Memory/ScratchAllocator.hpp"
+#include "Tools/Metrics.hpp"
+
+namespace
+{
+    constexpr float kNanosecondsToMilliseconds = 1.f / 1'000'000.f;
+
+    ImU32 GetZoneColor(const std::string_view name)
+    {
+        // Same name, same color, so a zone is easy to follow across frames
+        const auto hash = Neo::HashBytes(name.data(), name.size());
+        const auto hue = static_cast<float>(hash % 360) / 360.f;
+        float r, g, b;
+        ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.8f, r, g, b);
+        return ImGui::GetColorU32(ImVec4(r, g, b, 1.f));
+    }
+}
+
+namespace Neo
+{
+    void ProfilerPanel::Draw()
+    {
+        NEO_PROFILE_FUNCTION();
+        Record();
+
+        const auto& backend = Editor().Backend();
+        backend.Begin(std::string("Profiler ") + material_icon_monitor_heart);
+
+        if (ImGui::Button(mPaused ? "Resume" : "Pause"))
+        {
+            mPaused = !mPaused;
+            if (!mPaused) mSelectedFrame.reset();
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Capture spikes", &mCaptureSpikes);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120.f);
+        ImGui::DragFloat("Budget (ms)", &mBudget, 0.1f, 1.f, 100.f, "%.2f");
+        ImGui::SameLine();
+        if (Profiler::IsCapturing())
+        {
+            if (ImGui::Button("Stop trace")) (void)Profiler::EndCapture("Profile.json");
+        }
+        else if (ImGui::Button("Start trace"))
+        {
+            Profiler::BeginCapture();
+        }
+
+        DrawFrameGraph();
+
+        if (mHistoryCount > 0)
+        {
+            const auto& frame = GetHistoryFrame(mSelectedFrame.value_or(mHistoryCount - 1));
+            ImGui::Text("Frame %llu: %.2f ms, %zu zones", frame.Index, GetFrameTime(frame), frame.Events.size());
+            if (const auto dropped = Profiler::GetDroppedEvents(); dropped > 0)
+            {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.f, 0.6f, 0.2f, 1.f), "(%llu zones dropped)", dropped);
+            }
+            DrawFlameGraph(frame);
+            DrawTopZones(frame);
+        }
+        DrawMetrics();
+
+        backend.End();
+    }
+
+    void ProfilerPanel::Record()
+    {
+        const auto& frame = Profiler::GetLastFrame();
+        if (mPaused || frame.Index == mLastFrameIndex) return;
+        mLastFrameIndex = frame.Index;
+
+        // Copy assignment keeps the capacity of the slot, so the history stops allocating once it is full
+        mHistory[mHistoryHead] = frame;
+        mHistoryHead = (mHistoryHead + 1) % kHistorySize;
+        mHistoryCount = std::min(mHistoryCount + 1, kHistorySize);
+
+        if (mCaptureSpikes && GetFrameTime(frame) > mBudget)
+        {
+            mPaused = true;
+            mSelectedFrame = mHistoryCount - 1;
+        }
+    }
+
+    void ProfilerPanel::DrawFrameGraph()
+    {
+        if (mHistoryCount == 0) return;
+
+        ScratchScope scratch;
+        auto times = scratch.AllocateArray<float>(mHistoryCount);
+        for (size_t index = 0; index < mHistoryCount; index++)
+        {
+            times[index] = GetFrameTime(GetHistoryFrame(index));
+        }
+
+        auto sorted = scratch.AllocateArray<float>(mHistoryCount);
+        std::ranges::copy(times, sorted.begin());
+        std::ranges::sort(sorted);
+        const auto percentile = [&](const float fraction)
+        {
+            return sorted[static_cast<size_t>(fraction * static_cast<float>(sorted.size() - 1))];
+        };
+        ImGui::Text("p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms", percentile(0.5f), percentile(0.95f),
+                    percentile(0.99f), sorted.back());
+
+        const auto graphMax = std::max(sorted.back(), mBudget) * 1.1f;
+        const ImVec2 graphSize(std::max(ImGui::GetContentRegionAvail().x, 1.f), 80.f);
+        ImGui::PlotHistogram("##FrameTimes", times.data(), static_cast<int>(times.size()), 0, nullptr, 0.f,
+                             graphMax, graphSize);
+
+        const auto min = ImGui::GetItemRectMin();
+        const auto max = ImGui::GetItemRectMax();
+        auto* drawList = ImGui::GetWindowDrawList();
+        const auto budgetY = max.y - (max.y - min.y) * (mBudget / graphMax);
+        drawList->AddLine(ImVec2(min.x, budgetY), ImVec2(max.x, budgetY), IM_COL32(255, 80, 80, 255));
+
+        if (mSelectedFrame)
+        {
+            const auto barWidth = (max.x - min.x) / static_cast<float>(mHistoryCount);
+            const auto x = min.x + barWidth * (static_cast<float>(*mSelectedFrame) + 0.5f);
+            drawList->AddLine(ImVec2(x, min.y), ImVec2(x, max.y), IM_COL32(255, 255, 255, 255), 2.f);
+        }
+
+        if (ImGui::IsItemClicked())
+        {
+            const auto position = (ImGui::GetMousePos().x - min.x) / (max.x - min.x);
+            mSelectedFrame = std::min(static_cast<size_t>(position * static_cast<float>(mHistoryCount)),
+                                      mHistoryCount - 1);
+            mPaused = true;
+        }
+    }
+
+    void ProfilerPanel::DrawFlameGraph(const ProfileFrame& frame) const
+    {
+        if (!ImGui::CollapsingHeader("Flame graph", ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+        constexpr float kRowHeight = 18.f;
+        const auto frameDuration = static_cast<float>(std::max<u64>(frame.End - frame.Start, 1));
+        const auto width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+        auto* drawList = ImGui::GetWindowDrawList();
+
+        auto threadBegin = frame.Events.begin();
+        while (threadBegin != frame.Events.end())
+        {
+            const auto thread = threadBegin->Thread;
+            const auto threadEnd = std::find_if(threadBegin, frame.Events.end(),
+                                                [&](const ProfileEvent& event) { return event.Thread != thread; });
+            const auto depth = std::max_element(threadBegin, threadEnd,
+                                                [](const ProfileEvent& a, const ProfileEvent& b)
+                                                {
+                                                    return a.Depth < b.Depth;
+                                                })->Depth + 1;
+
+            ImGui::TextUnformatted(Profiler::GetThreadName(thread).c_str());
+            const auto origin = ImGui::GetCursorScreenPos();
+            ImGui::InvisibleButton(fmt::format("##Thread{}", thread).c_str(),
+                                   ImVec2(width, kRowHeight * static_cast<float>(depth)));
+            const auto hovered = ImGui::IsItemHovered();
+            const auto mouse = ImGui::GetMousePos();
+
+            for (auto it = threadBegin; it != threadEnd; ++it)
+            {
+                // Zones that began in the previous frame are clipped to this one
+                const auto start = it->Start > frame.Start ? it->Start - frame.Start : 0;
+                const auto end = it->End > frame.Start ? it->End - frame.Start : 0;
+                const ImVec2 min(origin.x + width * static_cast<float>(start) / frameDuration,
+                                 origin.y + kRowHeight * static_cast<float>(it->Depth));
+                const ImVec2 max(std::max(origin.x + width * static_cast<float>(end) / frameDuration, min.x + 1.f),
+                                 min.y + kRowHeight - 1.f);
+
+                const std::string_view name = it->Name;
+                drawList->AddRectFilled(min, max, GetZoneColor(name));
+                if (max.x - min.x > ImGui::CalcTextSize(it->Name).x + 4.f)
+                {
+                    drawList->AddText(ImVec2(min.x + 2.f, min.y + 2.f), IM_COL32(0, 0, 0, 255), it->Name);
+                }
+
+                if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+                {
+                    ImGui::SetTooltip("%s\n%.3f ms", it->Name,
+                                      static_cast<float>(it->End - it->Start) * kNanosecondsToMilliseconds);
+                }
+            }
+            threadBegin = threadEnd;
+        }
+    }
+
+    void ProfilerPanel::DrawTopZones(const ProfileFrame& frame) const
+    {
+        if (!ImGui::CollapsingHeader("Top zones by self time", ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+        struct ZoneStats
+        {
+            std::string_view Name;
+            u64 Self = 0;
+            u64 Total = 0;
+            u32 Calls = 0;
+        };
+
+        ScratchScope scratch;
+        std::pmr::unordered_map<std::string_view, ZoneStats> zones(scratch.GetResource());
+        // Events are depth first per thread, so the open zones form a stack and each zone subtracts its time
+        // from its parent's self time
+        std::pmr::vector<const ProfileEvent*> stack(scratch.GetResource());
+        std::pmr::unordered_map<const ProfileEvent*, u64> childTime(scratch.GetResource());
+        for (const auto& event : frame.Events)
+        {
+            while (!stack.empty() && (stack.back()->Thread != event.Thread || stack.back()->Depth >= event.Depth))
+            {
+                stack.pop_back();
+            }
+            if (!stack.empty()) childTime[stack.back()] += event.End - event.Start;
+            stack.emplace_back(&event);
+        }
+
+        for (const auto& event : frame.Events)
+        {
+            auto& zone = zones[event.Name];
+            const auto duration = event.End - event.Start;
+            const auto children = childTime.contains(&event) ? childTime.at(&event) : 0;
+            zone.Name = event.Name;
+            zone.Self += duration > children ? duration - children : 0;
+            zone.Total += duration;
+            zone.Calls++;
+        }
+
+        std::pmr::vector<ZoneStats> sorted(scratch.GetResource());
+        sorted.reserve(zones.size());
+        for (const auto& zone : zones | std::views::values) sorted.emplace_back(zone);
+        const auto count = std::min(kTopZoneCount, sorted.size());
+        std::ranges::partial_sort(sorted, sorted.begin() + static_cast<std::ptrdiff_t>(count),
+                                  [](const ZoneStats& a, const ZoneStats& b) { return a.Self > b.Self; });
+
+        if (!ImGui::BeginTable("##TopZones", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) return;
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Self (ms)");
+        ImGui::TableSetupColumn("Total (ms)");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableHeadersRow();
+        for (const auto& zone : std::span(sorted).first(count))
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(zone.Name.data(), zone.Name.data() + zone.Name.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", static_cast<float>(zone.Self) * kNanosecondsToMilliseconds);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", static_cast<float>(zone.Total) * kNanosecondsToMilliseconds);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", zone.Calls);
+        }
+        ImGui::EndTable();
+    }
+
+    void ProfilerPanel::DrawMetrics()
+    {
+        if (!ImGui::CollapsingHeader("Metrics", ImGuiTreeNodeFlags_DefaultOpen)) return;
+        if (!ImGui::BeginTable("##Metrics", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) return;
+        ImGui::TableSetupColumn("Metric");
+        ImGui::TableSetupColumn("Last frame");
+        ImGui::TableSetupColumn("Total / peak");
+        ImGui::TableHeadersRow();
+        for (const auto& sample : Metrics::GetSamples())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(sample.Name.data(), sample.Name.data() + sample.Name.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%lld", sample.Value);
+            ImGui::TableNextColumn();
+            ImGui::Text("%lld", sample.Total);
+        }
+        ImGui::EndTable();
+    }
+
+    float ProfilerPanel::GetFrameTime(const ProfileFrame& frame)
+    {
+        return static_cast<float>(frame.End - frame.Start) * kNanosecondsToMilliseconds;
+    }
+
+    const ProfileFrame& ProfilerPanel::GetHistoryFrame(const size_t index) const
+    {
+        const auto oldest = mHistoryCount < kHistorySize ? 0 : mHistoryHead;
+        return mHistory[(oldest + index) % kHistorySize];
+    }
+}
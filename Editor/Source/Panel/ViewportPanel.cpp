@@ -12,6 +12,16 @@ namespace Neo
         const auto& backend = Editor().Backend();
         backend.Begin(std::string("Viewport ") + material_icon_gamepad);
         backend.Image(Engine.Renderer().GetRenderTarget());
+
+        // The render target is stretched over the whole image, so the click maps straight onto it
+        if (ImGui::IsItemClicked())
+        {
+            const auto min = ImGui::GetItemRectMin();
+            const auto size = ImGui::GetItemRectSize();
+            const auto mouse = ImGui::GetMousePos();
+            const glm::vec2 position((mouse.x - min.x) / size.x, (mouse.y - min.y) / size.y);
+            Editor().SetSelectedEntity(Engine.Renderer().Pick(position));
+        }
         backend.End();
     }
 }
@@ -11,7 +11,9 @@ namespace Neo
         ~Device();
 
         [[nodiscard]] GLFWwindow* GetWindow() const { return mWindow; }
+#ifdef _WIN32
         [[nodiscard]] HWND GetNativeHandle() const { return mHWND; }
+#endif
         [[nodiscard]] bool IsRunning() const;
         [[nodiscard]] glm::uvec2 GetWindowSize() const { return mWindowSize; }
 
@@ -27,6 +29,8 @@ namespace Neo
         bool mResized = false;
         glm::uvec2 mWindowSize{};
         GLFWwindow* mWindow;
+#ifdef _WIN32
         HWND mHWND;
+#endif
     };
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Components.hpp"
+#include "Tools/BinaryStream.hpp"
 
 namespace Neo
 {
@@ -97,6 +98,26 @@ namespace Neo
 
         World& GetWorld() { return mWorld; }
 
+        /// <summary>
+        /// Write every entity and all of its [[Serialize]] components, using the functions generated by PreBuildTool.
+        /// </summary>
+        void Serialize(BinaryWriter& writer);
+
+        /// <summary>
+        /// Replace the world with the entities written by Serialize. Entity ids are kept as they were.
+        /// </summary>
+        bool Deserialize(BinaryReader& reader);
+
+        /// <summary>
+        /// Write the world as a JSON scene, streaming it out one entity at a time.
+        /// </summary>
+        bool ExportJson(std::string_view path);
+
+        /// <summary>
+        /// Replace the world with a JSON scene written by ExportJson, reading it one entity at a time.
+        /// </summary>
+        bool ImportJson(std::string_view path);
+
     private:
         World mWorld;
     };
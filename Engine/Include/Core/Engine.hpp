@@ -4,13 +4,16 @@
 #include "Core/Resources.hpp"
 #include "Core/Device.hpp"
 #include "Core/FileIO.hpp"
+#include "Memory/FrameAllocator.hpp"
 
 struct GLFWwindow;
 namespace Neo
 {
     struct EngineCreateInfo
     {
+#ifdef _WIN32
         HWND mHwnd;
+#endif
         GLFWwindow* mWindow;
     };
     class Project;
@@ -29,6 +32,11 @@ namespace Neo
         [[nodiscard]] Resources& Resources() const { return *mResources; }
         [[nodiscard]] ECS& ECS() const { return *mECS; }
 
+        /// <summary>
+        /// Memory for data that only lives until the end of the next frame.
+        /// </summary>
+        [[nodiscard]] FrameAllocator& FrameAllocator() { return mFrameAllocator; }
+
         [[nodiscard]] float GetDeltaTime() const { return mDeltaTime; }
 
     private:
@@ -38,6 +46,7 @@ namespace Neo
         Neo::Project* mProject = nullptr;
         Neo::Resources* mResources = nullptr;
         Neo::ECS* mECS = nullptr;
+        Neo::FrameAllocator mFrameAllocator;
         float mDeltaTime = 0.f;
     };
 
@@ -0,0 +1,190 @@
+#pragma once
+
+namespace Neo
+{
+    /// <summary>
+    /// Bit layout of every handle into a Pool. The low bits index a slot and the high bits hold the generation
+    /// of the slot, with every bit set meaning null.
+    /// </summary>
+    struct PoolHandleLayout
+    {
+        static constexpr u32 kIndexBits = 20;
+        static constexpr u32 kGenerationBits = 32 - kIndexBits;
+        static constexpr u32 kIndexMask = (1u << kIndexBits) - 1;
+        static constexpr u32 kGenerationMask = (1u << kGenerationBits) - 1;
+        static constexpr u32 kNull = std::numeric_limits<u32>::max();
+        // The last index is never handed out, so no live handle can ever equal kNull
+        static constexpr u32 kMaxSlots = kIndexMask;
+    };
+
+    /// <summary>
+    /// Anything that is just a u32 can be a pool handle, like the render handle enums or AssetHandle.
+    /// </summary>
+    template <typename Handle>
+    concept PoolHandle = sizeof(Handle) == sizeof(u32) && std::is_trivially_copyable_v<Handle>;
+
+    /// <summary>
+    /// Typed object pool with generational handles. Objects are stored densely, so iterating never skips holes,
+    /// and handles go through a slot table so removing an object swaps the last one into its place.
+    /// Removing an object bumps the generation of its slot, which turns every handle still pointing at it stale
+    /// instead of letting it alias whatever reuses the slot next.
+    /// </summary>
+    template <typename T, PoolHandle Handle>
+    class Pool
+    {
+    public:
+        static constexpr Handle kNullHandle = std::bit_cast<Handle>(PoolHandleLayout::kNull);
+
+        template <typename... Args>
+        Handle Emplace(Args&&... args)
+        {
+            u32 index;
+            if (!mFreeSlots.empty())
+            {
+                index = mFreeSlots.back();
+                mFreeSlots.pop_back();
+            }
+            else
+            {
+                index = static_cast<u32>(mSlots.size());
+                if (index >= PoolHandleLayout::kMaxSlots)
+                {
+                    Log::Critical("Pool: Out of slots");
+                    return kNullHandle;
+                }
+                mSlots.emplace_back();
+            }
+
+            auto& slot = mSlots[index];
+            slot.Dense = static_cast<u32>(mItems.size());
+            slot.Occupied = true;
+            mItems.emplace_back(std::forward<Args>(args)...);
+            mDenseToSlot.emplace_back(index);
+            return MakeHandle(index, slot.Generation);
+        }
+
+        Handle Add(T value) { return Emplace(std::move(value)); }
+
+        [[nodiscard]] bool IsValid(const Handle handle) const
+        {
+            const auto index = GetIndex(handle);
+            return index < mSlots.size() && mSlots[index].Occupied &&
+                (mSlots[index].Generation & PoolHandleLayout::kGenerationMask) == GetGeneration(handle);
+        }
+
+        /// <summary>
+        /// Returns nullptr if the handle is null or stale.
+        /// </summary>
+        [[nodiscard]] T* Get(const Handle handle)
+        {
+            return IsValid(handle) ? &mItems[mSlots[GetIndex(handle)].Dense] : nullptr;
+        }
+
+        [[nodiscard]] const T* Get(const Handle handle) const
+        {
+            return IsValid(handle) ? &mItems[mSlots[GetIndex(handle)].Dense] : nullptr;
+        }
+
+        /// <summary>
+        /// Like Get, but throws std::out_of_range if the handle is null or stale, the way std::vector::at would.
+        /// </summary>
+        [[nodiscard]] T& At(const Handle handle)
+        {
+            if (!IsValid(handle)) throw std::out_of_range("Pool: Invalid or stale handle");
+            return mItems[mSlots[GetIndex(handle)].Dense];
+        }
+
+        [[nodiscard]] const T& At(const Handle handle) const { return const_cast<Pool*>(this)->At(handle); }
+
+        /// <summary>
+        /// Remove an object and return it, so the caller can release whatever it owns.
+        /// </summary>
+        Opt<T> Remove(const Handle handle)
+        {
+            if (!IsValid(handle)) return std::nullopt;
+
+            const auto index = GetIndex(handle);
+            auto& slot = mSlots[index];
+            const auto dense = slot.Dense;
+            T removed = std::move(mItems[dense]);
+            if (dense != mItems.size() - 1)
+            {
+                mItems[dense] = std::move(mItems.back());
+                mDenseToSlot[dense] = mDenseToSlot.back();
+                mSlots[mDenseToSlot[dense]].Dense = dense;
+            }
+            mItems.pop_back();
+            mDenseToSlot.pop_back();
+
+            slot.Occupied = false;
+            slot.Generation++;
+            mFreeSlots.emplace_back(index);
+            return removed;
+        }
+
+        void Clear()
+        {
+            mFreeSlots.clear();
+            for (u32 index = static_cast<u32>(mSlots.size()); index > 0; index--)
+            {
+                auto& slot = mSlots[index - 1];
+                if (slot.Occupied)
+                {
+                    slot.Occupied = false;
+                    slot.Generation++;
+                }
+                mFreeSlots.emplace_back(index - 1);
+            }
+            mItems.clear();
+            mDenseToSlot.clear();
+        }
+
+        /// <summary>
+        /// Handle of the object at a position in GetItems.
+        /// </summary>
+        [[nodiscard]] Handle GetHandle(const size_t dense) const
+        {
+            const auto index = mDenseToSlot[dense];
+            return MakeHandle(index, mSlots[index].Generation);
+        }
+
+        [[nodiscard]] std::span<T> GetItems() { return mItems; }
+        [[nodiscard]] std::span<const T> GetItems() const { return mItems; }
+        [[nodiscard]] size_t GetSize() const { return mItems.size(); }
+        [[nodiscard]] bool IsEmpty() const { return mItems.empty(); }
+
+        auto begin() { return mItems.begin(); }
+        auto end() { return mItems.end(); }
+        auto begin() const { return mItems.begin(); }
+        auto end() const { return mItems.end(); }
+
+        [[nodiscard]] static constexpr u32 GetIndex(const Handle handle)
+        {
+            return std::bit_cast<u32>(handle) & PoolHandleLayout::kIndexMask;
+        }
+
+        [[nodiscard]] static constexpr u32 GetGeneration(const Handle handle)
+        {
+            return std::bit_cast<u32>(handle) >> PoolHandleLayout::kIndexBits;
+        }
+
+        [[nodiscard]] static constexpr Handle MakeHandle(const u32 index, const u32 generation)
+        {
+            return std::bit_cast<Handle>((generation & PoolHandleLayout::kGenerationMask)
+                << PoolHandleLayout::kIndexBits | (index & PoolHandleLayout::kIndexMask));
+        }
+
+    private:
+        struct Slot
+        {
+            u32 Dense = 0;
+            u32 Generation = 0;
+            bool Occupied = false;
+        };
+
+        std::vector<T> mItems;
+        std::vector<u32> mDenseToSlot;
+        std::vector<Slot> mSlots;
+        std::vector<u32> mFreeSlots;
+    };
+}
@@ -1,30 +1,164 @@
 #pragma once
+#include "Memory/FrameAllocator.hpp"
+#include "Memory/RingAllocator.hpp"
+#include "Render/DrawList.hpp"
 #include "Render/RenderContext.hpp"
+#include "Render/RenderGraph.hpp"
+#include "Render/UploadQueue.hpp"
 
 namespace Neo
 {
     struct RenderPass
     {
-        std::function<void()> Execute;
+        /// <summary>
+        /// Shown in the profiler.
+        /// </summary>
+        std::string Name;
+        /// <summary>
+        /// Declares what the pass reads and writes, every frame while the render graph is built. A pass that
+        /// writes nothing another pass or the frame needs is culled.
+        /// </summary>
+        std::function<void(RenderGraphBuilder&)> Setup;
+        RenderGraphExecute Execute;
     };
+
+    /// <summary>
+    /// What shaders read for an instance of a DrawBatch, from the upload buffer at GetFirstInstance plus the
+    /// FirstInstance of the batch.
+    /// </summary>
+    struct InstanceData
+    {
+        glm::mat4 World{1.f};
+        /// <summary>
+        /// Index into the MaterialTable of Resources.
+        /// </summary>
+        u32 Material = 0;
+        std::array<u32, 3> Padding{};
+    };
+
     class Renderer final
     {
     public:
-        Renderer();
+        explicit Renderer(const RenderContextCreateInfo& createInfo);
         ~Renderer();
-        void Update(float);
+        /// <summary>
+        /// Build, record and present a frame. Whatever the frame needs only until it is recorded comes from the
+        /// frame allocator, which has to be flipped with BeginFrame before every call.
+        /// </summary>
+        void Update(float, FrameAllocator& frameAllocator);
+        /// <summary>
+        /// Resize the swapchain and the render target, the frame after a window resize.
+        /// </summary>
+        void Resize(glm::uvec2 size);
         [[nodiscard]] std::unique_ptr<IRenderContext>& GetRenderContext() { return mContext; }
         [[nodiscard]] RenderTargetHandle GetRenderTarget() const { return mRenderTarget; }
+        [[nodiscard]] RenderGraph& GetRenderGraph() { return mGraph; }
+        /// <summary>
+        /// The swapchain image of this frame in the render graph, presented at the end of the frame.
+        /// </summary>
+        [[nodiscard]] RenderGraphResource GetBackbufferResource() const { return mBackbuffer; }
+        /// <summary>
+        /// GetRenderTarget in the render graph, left readable by shaders at the end of the frame.
+        /// </summary>
+        [[nodiscard]] RenderGraphResource GetSceneResource() const { return mScene; }
 
         void AddRenderPass(RenderPass&& renderPass);
+        /// <summary>
+        /// Bring the scene BVH up to date and collect the draws of every MeshRenderer seen by the first Camera for
+        /// this frame, then sort and batch them. Without a camera nothing is culled. Batches are drawn into the
+        /// scene from the next Update on, once their primitives are uploaded.
+        /// </summary>
+        void ExtractDraws(const ECS& ecs, Resources& resources);
+        [[nodiscard]] const DrawList& GetDrawList() const { return mDrawList; }
+        [[nodiscard]] SceneBVH& GetSceneBVH() { return mSceneBVH; }
+        /// <summary>
+        /// The entity under a point of the render target, from (0, 0) at the top left to (1, 1) at the bottom
+        /// right, as seen by the camera of the last extracted frame. Entities are hit by their boxes.
+        /// </summary>
+        [[nodiscard]] Entity Pick(glm::vec2 position) const;
+        /// <summary>
+        /// Record render passes on worker threads, each into a command of its own. Off by default.
+        /// </summary>
+        void SetParallelRecording(const bool parallel) { mParallelRecording = parallel; }
+
+        /// <summary>
+        /// Persistently mapped staging buffer every upload of a frame is written to, and which shaders read the
+        /// instances of the draw list from. Its elements are InstanceData.
+        /// </summary>
+        [[nodiscard]] BufferHandle GetUploadBuffer() const { return mUploadBuffer; }
+        /// <summary>
+        /// Element of the upload buffer holding the first instance of this frame.
+        /// </summary>
+        [[nodiscard]] u32 GetFirstInstance() const { return mFirstInstance; }
+        [[nodiscard]] const RingAllocator& GetUploadRing() const { return mUploadRing; }
+        /// <summary>
+        /// Uploads on the transfer queue, submitted at the start of every Update.
+        /// </summary>
+        [[nodiscard]] UploadQueue& GetUploadQueue() { return *mUploadQueue; }
 
     private:
+        static constexpr u32 kUploadInstances = 1u << 19;
+
+        // Copy out of the upload buffer, recorded into the copy command of the next frame
+        struct PendingCopy
+        {
+            BufferHandle Destination = BufferHandle::eNull;
+            u64 SourceOffset = 0;
+            u64 Size = 0;
+        };
+
+        // A batch of the draw list with the buffers of its primitive, so the mesh pass needs no resources
+        struct MeshDraw
+        {
+            ShaderHandle Shader = ShaderHandle::eNull;
+            BufferHandle VertexBuffer = BufferHandle::eNull;
+            BufferHandle IndexBuffer = BufferHandle::eNull;
+            u32 IndexCount = 0;
+            u32 FirstInstance = 0;
+            u32 InstanceCount = 0;
+        };
+
+        /// <summary>
+        /// Write size bytes to the upload buffer and copy them to the destination on the GPU before anything of
+        /// the next frame runs. Fails when the frames in flight still use too much of the buffer.
+        /// </summary>
+        bool Upload(BufferHandle destination, const void* data, u64 size);
+        /// <summary>
+        /// Write the instances of the draw list to the upload buffer. Fails when they do not fit, which leaves
+        /// the frame without mesh draws.
+        /// </summary>
+        bool StreamInstances();
+        void DrawMeshes(CommandHandle command);
+
         std::unique_ptr<IRenderContext> mContext;
+        std::unique_ptr<UploadQueue> mUploadQueue;
+        glm::uvec2 mSize{};
         BufferHandle mVertexBuffer = BufferHandle::eNull;
         ShaderHandle mTriangleShader = ShaderHandle::eNull;
+        /// <summary>
+        /// Draws the batches whose MeshRenderer has no shader of its own.
+        /// </summary>
+        ShaderHandle mMeshShader = ShaderHandle::eNull;
         RenderTargetHandle mRenderTarget = RenderTargetHandle::eNull;
-        CommandHandle mTransferCommand = CommandHandle::eNull;
+        BufferHandle mUploadBuffer = BufferHandle::eNull;
+        std::byte* mUploadData = nullptr;
+        RingAllocator mUploadRing{static_cast<u64>(kUploadInstances) * sizeof(InstanceData)};
+        std::vector<PendingCopy> mPendingCopies;
+        /// <summary>
+        /// One per frame in flight, submitted ahead of the frame so the copies land before any pass runs, also
+        /// when the passes are recorded into commands of their own.
+        /// </summary>
+        std::array<CommandHandle, kFrameCount> mCopyCommands{};
+        u32 mFirstInstance = 0;
 
         std::vector<RenderPass> mRenderPasses;
+        RenderGraph mGraph;
+        RenderGraphResource mBackbuffer = RenderGraphResource::eNull;
+        RenderGraphResource mScene = RenderGraphResource::eNull;
+        DrawList mDrawList;
+        std::vector<MeshDraw> mMeshDraws;
+        bool mDrawMeshes = false;
+        SceneBVH mSceneBVH;
+        bool mParallelRecording = false;
     };
 } // namespace FS
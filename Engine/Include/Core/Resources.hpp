@@ -1,18 +1,190 @@
 #pragma once
-#include "Core/Resources.hpp"
 #include "Resources/Resource.hpp"
+#include "Resources/AssetStreamer.hpp"
+#include "Resources/MaterialTable.hpp"
+#include "Resources/TextureResidency.hpp"
 
 namespace Neo
 {
+    class IRenderContext;
+
+    inline constexpr std::chrono::microseconds kDefaultStreamingFrameBudget{2000};
+    inline constexpr u64 kDefaultMemoryBudget = 1024ull * 1024 * 1024;
+
+    /// <summary>
+    /// Owns every loaded Texture, Material and Mesh. Assets are loaded by AssetID, loading the same asset twice
+    /// returns the same handle, and every handle handed out holds a reference that is given back with Release.
+    /// Loading a material or mesh also loads what it refers to, and unloading it releases those again.
+    ///
+    /// Assets can be loaded right away with Load, or streamed in the background with Request, in which case
+    /// Get returns nullptr until Update has finished the load. Unreferenced assets stay cached until the
+    /// memory budget is exceeded, at which point the least recently used ones are unloaded.
+    /// Textures additionally only keep the mips they are drawn at, see ReportTextureUsage.
+    /// </summary>
     class Resources
     {
     public:
         Resources();
         ~Resources();
 
+        /// <summary>
+        /// Add the entries of an AssetRegistry file written by the Importer. Returns false if it could not be read.
+        /// </summary>
+        bool LoadRegistry(std::string_view path);
+        void RegisterAsset(const AssetID& id, std::string_view path);
+
+        /// <summary>
+        /// Give textures loaded from now on a copy on the GPU, whose descriptor index goes into the MaterialParams
+        /// of the materials using them. Without a context texture slots stay kNoTextureDescriptor.
+        /// </summary>
+        void SetRenderContext(IRenderContext* context) { mContext = context; }
+        /// <summary>
+        /// Give the primitives of meshes loaded from now on vertex and index buffers, filled through the queue
+        /// without waiting for the GPU. Needs a render context as well.
+        /// </summary>
+        void SetUploadQueue(UploadQueue* uploads) { mUploads = uploads; }
+
+        /// <summary>
+        /// Get a handle to an asset, loading it on the calling thread if needed.
+        /// Returns a null handle if the asset is unknown or could not be loaded.
+        /// </summary>
+        AssetHandle<Texture> LoadTexture(const AssetID& id);
+        AssetHandle<Material> LoadMaterial(const AssetID& id);
+        AssetHandle<Mesh> LoadMesh(const AssetID& id);
+
+        /// <summary>
+        /// Get a handle to an asset and stream it in on a worker thread. Higher priorities are loaded first,
+        /// requesting an asset that is still loading raises its priority if the new one is higher.
+        /// </summary>
+        AssetHandle<Texture> RequestTexture(const AssetID& id, float priority);
+        AssetHandle<Material> RequestMaterial(const AssetID& id, float priority);
+        AssetHandle<Mesh> RequestMesh(const AssetID& id, float priority);
+
+        void Release(AssetHandle<Texture> handle);
+        void Release(AssetHandle<Material> handle);
+        void Release(AssetHandle<Mesh> handle);
+
+        template <typename T>
+        void AddRef(const AssetHandle<T> handle) { GetPool<T>().AddRef(handle); }
+
+        /// <summary>
+        /// Returns nullptr while the asset is still streaming in, or if the handle is stale.
+        /// Also marks the asset as used this frame.
+        /// </summary>
+        template <typename T>
+        [[nodiscard]] T* Get(const AssetHandle<T> handle)
+        {
+            GetPool<T>().Touch(handle, mFrame);
+            return GetPool<T>().Get(handle);
+        }
+
+        template <typename T>
+        [[nodiscard]] const T* Get(const AssetHandle<T> handle) const { return GetPool<T>().Get(handle); }
+
+        template <typename T>
+        [[nodiscard]] bool IsValid(const AssetHandle<T> handle) const { return GetPool<T>().IsValid(handle); }
+
+        template <typename T>
+        [[nodiscard]] bool IsLoaded(const AssetHandle<T> handle) const { return GetPool<T>().IsLoaded(handle); }
+
+        /// <summary>
+        /// Finish streamed loads until the frame budget is used up, then evict unused assets if over the memory budget.
+        /// </summary>
+        void Update();
+
+        void SetFrameBudget(const std::chrono::microseconds budget) { mFrameBudget = budget; }
+        void SetMemoryBudget(const u64 bytes) { mMemoryBudget = bytes; }
+
+        /// <summary>
+        /// Report the screen size in pixels a texture is drawn at this frame. Mips that are not needed for it
+        /// are dropped and needed ones are streamed back in, within the texture budget.
+        /// </summary>
+        void ReportTextureUsage(const AssetHandle<Texture> texture, const float screenSize)
+        {
+            mTextureResidency.ReportUsage(texture, screenSize);
+        }
+        /// <summary>
+        /// ReportTextureUsage for every texture of the material.
+        /// </summary>
+        void ReportMaterialUsage(AssetHandle<Material> material, float screenSize);
+
+        void SetTextureBudget(const u64 bytes) { mTextureResidency.SetBudget(bytes); }
+        [[nodiscard]] const TextureResidency& GetTextureResidency() const { return mTextureResidency; }
+
+        /// <summary>
+        /// Parameters of every loaded material, indexed by Material::ParamsIndex.
+        /// </summary>
+        [[nodiscard]] const MaterialTable& GetMaterialTable() const { return mMaterialTable; }
+
+        [[nodiscard]] u64 GetResidentSize() const;
+        [[nodiscard]] size_t GetPendingCount() const { return mStreamer.GetPendingCount(); }
+
+        /// <summary>
+        /// Unload everything, regardless of outstanding references.
+        /// </summary>
         void CleanupResources();
 
     private:
-        std::shared_ptr<IResource> mResources;
+        template <typename T>
+        AssetPool<T>& GetPool()
+        {
+            if constexpr (std::is_same_v<T, Texture>) return mTextures;
+            else if constexpr (std::is_same_v<T, Material>) return mMaterials;
+            else
+            {
+                static_assert(std::is_same_v<T, Mesh>, "Not a resource type");
+                return mMeshes;
+            }
+        }
+
+        template <typename T>
+        const AssetPool<T>& GetPool() const { return const_cast<Resources*>(this)->GetPool<T>(); }
+
+        template <typename T>
+        AssetHandle<T> Load(const AssetID& id, Opt<float> priority);
+
+        void Finish(AssetHandle<Texture> handle, TextureDesc&& desc, Opt<float> priority);
+        void Finish(AssetHandle<Material> handle, MaterialDesc&& desc, Opt<float> priority);
+        void Finish(AssetHandle<Mesh> handle, MeshDesc&& desc, Opt<float> priority);
+        void Finish(StreamResult&& result);
+
+        void Unload(AssetHandle<Texture> handle);
+        void Unload(AssetHandle<Material> handle);
+        void Unload(AssetHandle<Mesh> handle);
+        void EvictUnused();
+        void UpdateTextureResidency();
+        void RefineTexture(AssetHandle<Texture> handle, TextureMipsDesc&& desc);
+
+        [[nodiscard]] u32 GetTextureDescriptor(AssetHandle<Texture> handle) const;
+        void ResolveTextureSlots(const Material& material, MaterialParams& params) const;
+        /// <summary>
+        /// Point the materials that use the texture at its GPU copy, for materials built before it finished.
+        /// </summary>
+        void UpdateTextureSlots(AssetHandle<Texture> handle);
+        /// <summary>
+        /// Create the buffers of a primitive and queue the uploads of its vertices and indices.
+        /// </summary>
+        void UploadPrimitive(Primitive& primitive, std::string_view name);
+        void DestroyPrimitive(const Primitive& primitive);
+
+        Opt<std::string> FindPath(const AssetID& id) const;
+
+        IRenderContext* mContext = nullptr;
+        UploadQueue* mUploads = nullptr;
+        std::unordered_map<AssetID, std::string> mPaths;
+        AssetPool<Texture> mTextures;
+        AssetPool<Material> mMaterials;
+        AssetPool<Mesh> mMeshes;
+        MaterialTable mMaterialTable;
+
+        std::chrono::microseconds mFrameBudget = kDefaultStreamingFrameBudget;
+        u64 mMemoryBudget = kDefaultMemoryBudget;
+        u64 mFrame = 0;
+
+        TextureResidency mTextureResidency;
+        std::vector<MipRequest> mMipStreamIn;
+        std::vector<MipRequest> mMipEvict;
+
+        AssetStreamer mStreamer;
     };
 }
@@ -0,0 +1,44 @@
+#pragma once
+#include "Memory/LinearAllocator.hpp"
+
+namespace Neo
+{
+    inline constexpr size_t kDefaultFrameArenaSize = 1024 * 1024;
+
+    /// <summary>
+    /// Double buffered arena for memory that lives for a frame. BeginFrame switches to the other arena and
+    /// clears it, so what was allocated during the previous frame stays valid for one more frame, long enough
+    /// to hand data from one frame to the next one.
+    /// </summary>
+    class FrameAllocator
+    {
+    public:
+        explicit FrameAllocator(const size_t blockSize = kDefaultFrameArenaSize)
+            : mArenas{LinearAllocator(blockSize), LinearAllocator(blockSize)},
+              mResources{ArenaResource(mArenas[0]), ArenaResource(mArenas[1])}
+        {
+        }
+
+        void BeginFrame()
+        {
+            mCurrent ^= 1;
+            mArenas[mCurrent].Reset();
+        }
+
+        [[nodiscard]] void* Allocate(const size_t size, const size_t alignment = alignof(std::max_align_t))
+        {
+            return mArenas[mCurrent].Allocate(size, alignment);
+        }
+
+        template <typename T>
+        [[nodiscard]] std::span<T> AllocateArray(const size_t count) { return mArenas[mCurrent].AllocateArray<T>(count); }
+
+        [[nodiscard]] LinearAllocator& GetArena() { return mArenas[mCurrent]; }
+        [[nodiscard]] std::pmr::memory_resource* GetResource() { return &mResources[mCurrent]; }
+
+    private:
+        std::array<LinearAllocator, 2> mArenas;
+        std::array<ArenaResource, 2> mResources;
+        u32 mCurrent = 0;
+    };
+}
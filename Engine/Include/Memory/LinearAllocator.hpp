@@ -0,0 +1,95 @@
+#pragma once
+
+namespace Neo
+{
+    inline constexpr size_t kDefaultArenaBlockSize = 64 * 1024;
+
+    /// <summary>
+    /// Arena that hands out memory by bumping an offset and frees everything at once with Reset or Rewind.
+    /// Nothing is destroyed, so only trivially destructible types should live in it.
+    /// When a block runs out a new one is taken from the heap, and the next Reset merges all blocks into one,
+    /// so after a few frames of warm up the arena stops touching the heap.
+    /// </summary>
+    class LinearAllocator
+    {
+    public:
+        struct Marker
+        {
+            u32 Block = 0;
+            size_t Offset = 0;
+        };
+
+        explicit LinearAllocator(size_t blockSize = kDefaultArenaBlockSize);
+
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        [[nodiscard]] void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T>
+        [[nodiscard]] std::span<T> AllocateArray(const size_t count)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "Arenas never run destructors");
+            auto* data = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+            std::uninitialized_value_construct_n(data, count);
+            return {data, count};
+        }
+
+        template <typename T, typename... Args>
+        [[nodiscard]] T* New(Args&&... args)
+        {
+            static_assert(std::is_trivially_destructible_v<T>, "Arenas never run destructors");
+            return std::construct_at(static_cast<T*>(Allocate(sizeof(T), alignof(T))), std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] Marker GetMarker() const { return {mBlock, mOffset}; }
+
+        /// <summary>
+        /// Free everything allocated after the marker was taken.
+        /// </summary>
+        void Rewind(Marker marker);
+        void Reset();
+
+        [[nodiscard]] size_t GetUsed() const;
+        [[nodiscard]] size_t GetCapacity() const;
+
+    private:
+        struct Block
+        {
+            Scoped<std::byte[]> Memory;
+            size_t Size = 0;
+        };
+
+        void AddBlock(size_t size);
+
+        std::vector<Block> mBlocks;
+        size_t mBlockSize;
+        u32 mBlock = 0;
+        size_t mOffset = 0;
+    };
+
+    /// <summary>
+    /// Lets std::pmr containers allocate from a LinearAllocator. Deallocation does nothing,
+    /// the memory comes back when the arena is reset.
+    /// </summary>
+    class ArenaResource final : public std::pmr::memory_resource
+    {
+    public:
+        explicit ArenaResource(LinearAllocator& arena) : mArena(&arena) {}
+
+    private:
+        void* do_allocate(const size_t bytes, const size_t alignment) override
+        {
+            return mArena->Allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        LinearAllocator* mArena;
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+// Tracking replaces the global operator new and delete, so it is only built outside of release builds unless
+// the engine is configured WITH_MEMORY_TRACKING
+#if !defined(NEO_RELEASE) && !defined(NEO_MEMORY_TRACKING)
+#define NEO_MEMORY_TRACKING 1
+#endif
+
+namespace Neo
+{
+    enum class MemoryTag : u8
+    {
+        eUntagged,
+        eEngine,
+        eImporter,
+        eECS,
+        eRenderer,
+        eResources,
+        eScripting,
+        eEditor,
+        eCount,
+    };
+
+    inline constexpr size_t kMemoryTagCount = static_cast<size_t>(MemoryTag::eCount);
+
+    struct MemoryTagStats
+    {
+        u64 LiveBytes = 0;
+        u64 PeakBytes = 0;
+        u64 LiveAllocations = 0;
+        u64 TotalAllocations = 0;
+    };
+
+    struct MemorySnapshot
+    {
+        std::array<MemoryTagStats, kMemoryTagCount> Tags{};
+        u64 LiveBytes = 0;
+        u64 PeakBytes = 0;
+        u64 TotalAllocations = 0;
+        /// <summary>
+        /// Allocations made during the last finished frame.
+        /// </summary>
+        u64 FrameAllocations = 0;
+        u64 FrameBytes = 0;
+    };
+
+    /// <summary>
+    /// Counts every heap allocation made through operator new, per MemoryTag. The tag of an allocation is the
+    /// innermost MemoryTagScope active on the allocating thread, and frees are credited back to the same tag.
+    /// Callstacks of live allocations can be captured to find leaks, which is slow and off by default.
+    /// With NEO_RELEASE everything compiles down to nothing and snapshots are empty.
+    /// </summary>
+    class MemoryTracker
+    {
+    public:
+        /// <summary>
+        /// Close the current frame for the per frame counters. Called by the engine at the start of every frame.
+        /// </summary>
+        static void BeginFrame();
+
+        [[nodiscard]] static MemorySnapshot GetSnapshot();
+
+        /// <summary>
+        /// Allocations made on any thread since startup, useful to check that a piece of code does not allocate.
+        /// </summary>
+        [[nodiscard]] static u64 GetAllocationCount();
+
+        /// <summary>
+        /// Start measuring the peak again from the bytes live right now, to find the peak of one piece of code.
+        /// </summary>
+        static void ResetPeak();
+
+        static void SetCaptureCallstacks(bool capture);
+
+        /// <summary>
+        /// Log every live allocation made while callstacks were captured, with the callstack that made it.
+        /// </summary>
+        static void ReportLeaks();
+
+        static void OnAllocate(void* memory, size_t size, MemoryTag tag);
+        static void OnFree(void* memory, size_t size, MemoryTag tag);
+
+        [[nodiscard]] static MemoryTag GetCurrentTag();
+        static void SetCurrentTag(MemoryTag tag);
+    };
+
+    /// <summary>
+    /// Tag every allocation made on this thread while the scope is alive.
+    /// </summary>
+    class MemoryTagScope
+    {
+    public:
+#ifdef NEO_MEMORY_TRACKING
+        explicit MemoryTagScope(const MemoryTag tag) : mPrevious(MemoryTracker::GetCurrentTag())
+        {
+            MemoryTracker::SetCurrentTag(tag);
+        }
+
+        ~MemoryTagScope() { MemoryTracker::SetCurrentTag(mPrevious); }
+#else
+        explicit MemoryTagScope(MemoryTag) {}
+#endif
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+    private:
+#ifdef NEO_MEMORY_TRACKING
+        MemoryTag mPrevious;
+#endif
+    };
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+namespace Neo
+{
+    struct OffsetAllocation
+    {
+        u64 Offset = 0;
+        u64 Size = 0;
+        /// <summary>
+        /// Identifies the allocation to the allocator that made it.
+        /// </summary>
+        u32 Block = std::numeric_limits<u32>::max();
+    };
+
+    struct OffsetAllocatorStats
+    {
+        u64 Used = 0;
+        u64 Free = 0;
+        /// <summary>
+        /// Largest allocation that would fit without alignment.
+        /// </summary>
+        u64 LargestFree = 0;
+        /// <summary>
+        /// Freed, but waiting for a fence before it can be allocated again.
+        /// </summary>
+        u64 Deferred = 0;
+        u32 Allocations = 0;
+        u32 FreeRegions = 0;
+
+        /// <summary>
+        /// 0 when all free memory is in one piece, approaching 1 the more it is split up.
+        /// </summary>
+        [[nodiscard]] float GetFragmentation() const
+        {
+            return Free == 0 ? 0.f : 1.f - static_cast<float>(LargestFree) / static_cast<float>(Free);
+        }
+    };
+
+    /// <summary>
+    /// Hands out ranges of offsets, like places in a GPU heap, with a two level segregated fit allocator (TLSF).
+    /// Free ranges are kept in lists by size class, with bitmasks of the non empty ones, so allocating and freeing
+    /// take constant time, and freed ranges merge with free neighbours right away.
+    ///
+    /// Everything is a multiple of the granularity, so alignments up to it cost nothing. Larger alignments are
+    /// found by asking for more and returning the part in front. Nothing here touches the memory, so it works for
+    /// any backend and runs on the CPU alone.
+    /// </summary>
+    class OffsetAllocator
+    {
+    public:
+        explicit OffsetAllocator(u64 size = 0, u64 granularity = 1);
+
+        /// <summary>
+        /// Aligned to a power of two. Empty when no free range is big enough.
+        /// </summary>
+        [[nodiscard]] Opt<OffsetAllocation> Allocate(u64 size, u64 alignment = 1);
+        void Free(const OffsetAllocation& allocation);
+        /// <summary>
+        /// Free once Collect is called with a completed fence value of at least fenceValue, for memory the GPU may
+        /// still use. Fence values have to grow from one call to the next.
+        /// </summary>
+        void FreeDeferred(const OffsetAllocation& allocation, u64 fenceValue);
+        void Collect(u64 completedValue);
+        /// <summary>
+        /// Free everything, including deferred frees.
+        /// </summary>
+        void Reset();
+
+        [[nodiscard]] u64 GetSize() const { return mSize; }
+        [[nodiscard]] u64 GetGranularity() const { return mGranularity; }
+        [[nodiscard]] OffsetAllocatorStats GetStats() const;
+
+    private:
+        static constexpr u32 kSecondLevelBits = 4;
+        static constexpr u32 kSecondLevels = 1u << kSecondLevelBits;
+        static constexpr u32 kFirstLevels = 64 - kSecondLevelBits + 1;
+        static constexpr u32 kNone = std::numeric_limits<u32>::max();
+
+        // Sizes and offsets are in granules. Neighbours are linked by address, free blocks also by size class
+        struct Block
+        {
+            u64 Offset = 0;
+            u64 Size = 0;
+            u32 Previous = kNone;
+            u32 Next = kNone;
+            u32 PreviousFree = kNone;
+            u32 NextFree = kNone;
+            bool Free = false;
+        };
+
+        struct DeferredFree
+        {
+            u64 FenceValue = 0;
+            OffsetAllocation Allocation;
+        };
+
+        /// <summary>
+        /// Size class a block of the size goes into.
+        /// </summary>
+        static std::pair<u32, u32> GetBin(u64 size);
+        /// <summary>
+        /// First size class whose blocks are all at least the size.
+        /// </summary>
+        static std::pair<u32, u32> GetSearchBin(u64 size);
+        /// <summary>
+        /// Non empty size class at or above the bin, or kNone.
+        /// </summary>
+        [[nodiscard]] u32 FindBin(u32 firstLevel, u32 secondLevel) const;
+
+        u32 AddBlock(const Block& block);
+        void InsertFree(u32 block);
+        void RemoveFree(u32 block);
+        /// <summary>
+        /// Shrink a block to the size and return a new block after it for the rest, in no free list.
+        /// </summary>
+        u32 Split(u32 block, u64 size);
+        /// <summary>
+        /// Merge a block with the block after it, which goes away.
+        /// </summary>
+        void Merge(u32 block, u32 next);
+
+        u64 mSize = 0;
+        u64 mGranularity = 1;
+        std::vector<Block> mBlocks;
+        std::vector<u32> mUnusedBlocks;
+        std::array<u32, kFirstLevels * kSecondLevels> mFreeHeads{};
+        u64 mFirstLevelMask = 0;
+        std::array<u32, kFirstLevels> mSecondLevelMasks{};
+        std::deque<DeferredFree> mDeferred;
+        u64 mUsed = 0;
+        u64 mDeferredSize = 0;
+        u32 mAllocations = 0;
+        u32 mFreeRegions = 0;
+    };
+}
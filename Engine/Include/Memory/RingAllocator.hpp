@@ -0,0 +1,48 @@
+#pragma once
+#include "Render/RenderConstants.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Hands out offsets into a fixed range of memory, like a mapped upload buffer, that is shared by the
+    /// kFrameCount frames in flight. Allocations are never freed one by one: BeginFrame frees everything the
+    /// frame allocated the last time it was in flight, which the caller guarantees the GPU is done with by then.
+    ///
+    /// Positions only ever grow and the offset is the position wrapped to the capacity, so an allocation that
+    /// would run past the end starts over at the beginning instead, leaving the rest of the lap unused. Nothing
+    /// here touches the memory itself, so it works for any backend.
+    /// </summary>
+    class RingAllocator
+    {
+    public:
+        explicit RingAllocator(u64 capacity);
+
+        /// <summary>
+        /// Start allocating for a frame, freeing what it allocated kFrameCount frames ago.
+        /// </summary>
+        void BeginFrame(u32 frameIndex);
+        /// <summary>
+        /// Everything allocated since BeginFrame stays in use until the frame begins again.
+        /// </summary>
+        void EndFrame();
+
+        /// <summary>
+        /// Offset of size bytes aligned to alignment, which has to divide the capacity. Fails rather than
+        /// overwrite memory a frame in flight still uses.
+        /// </summary>
+        [[nodiscard]] Opt<u64> Allocate(u64 size, u64 alignment = 16);
+
+        [[nodiscard]] u64 GetCapacity() const { return mCapacity; }
+        /// <summary>
+        /// Bytes held by the frames in flight, including the unused ends of laps.
+        /// </summary>
+        [[nodiscard]] u64 GetUsed() const { return mHead - mTail; }
+
+    private:
+        u64 mCapacity;
+        u64 mHead = 0;
+        u64 mTail = 0;
+        u32 mFrameIndex = 0;
+        std::array<u64, kFrameCount> mFrameEnds{};
+    };
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Memory/LinearAllocator.hpp"
+
+namespace Neo
+{
+    inline constexpr size_t kScratchArenaSize = 256 * 1024;
+
+    /// <summary>
+    /// Every thread has its own scratch arena used as a stack. A ScratchScope allocates from it and frees
+    /// everything it allocated when it goes out of scope, which makes it a drop in for temporary containers:
+    ///     ScratchScope scratch;
+    ///     std::pmr::vector<u32> indices(scratch.GetResource());
+    /// Scopes can nest, but memory from an inner scope must not be used after it ends.
+    /// </summary>
+    class ScratchScope
+    {
+    public:
+        ScratchScope();
+        ~ScratchScope();
+
+        ScratchScope(const ScratchScope&) = delete;
+        ScratchScope& operator=(const ScratchScope&) = delete;
+
+        [[nodiscard]] void* Allocate(const size_t size, const size_t alignment = alignof(std::max_align_t))
+        {
+            return mArena.Allocate(size, alignment);
+        }
+
+        template <typename T>
+        [[nodiscard]] std::span<T> AllocateArray(const size_t count) { return mArena.AllocateArray<T>(count); }
+
+        [[nodiscard]] std::pmr::memory_resource* GetResource() { return &mResource; }
+
+    private:
+        LinearAllocator& mArena;
+        LinearAllocator::Marker mMarker;
+        ArenaResource mResource;
+    };
+}
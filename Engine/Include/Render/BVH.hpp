@@ -0,0 +1,136 @@
+#pragma once
+#include "Render/Culling.hpp"
+
+namespace Neo
+{
+    enum class BVHProxy : u32
+    {
+        eNull = std::numeric_limits<u32>::max(),
+    };
+
+    struct RayHit
+    {
+        u32 Value = 0;
+        /// <summary>
+        /// Along the ray to where it enters the box, zero when it starts inside.
+        /// </summary>
+        float Distance = 0.f;
+    };
+
+    /// <summary>
+    /// Bounding volume hierarchy over axis aligned boxes, each carrying a value like an entity. Every node holds
+    /// the boxes of up to four children side by side, so a query tests all of them at once with SIMD, and nodes
+    /// live in one array that is walked with a small stack instead of pointers.
+    ///
+    /// Build splits the boxes with the surface area heuristic and gives the best tree. Insert and Remove change it
+    /// in place, and Update refits the boxes above a moved object, which is cheap but loosens the tree the further
+    /// objects move, so anything that moves a lot is better rebuilt now and then. Only the Min and Max of the
+    /// bounds are used.
+    /// </summary>
+    class BVH
+    {
+    public:
+        static constexpr u32 kWidth = 4;
+
+        /// <summary>
+        /// Rebuild the tree from every object inserted so far. Proxies stay valid.
+        /// </summary>
+        void Build();
+        void Clear();
+
+        BVHProxy Insert(const Bounds& bounds, u32 value);
+        void Remove(BVHProxy proxy);
+        /// <summary>
+        /// Move an object to new bounds and refit the nodes above it.
+        /// </summary>
+        void Update(BVHProxy proxy, const Bounds& bounds);
+
+        /// <summary>
+        /// Append the value of every object whose box is at least partly inside the frustum.
+        /// </summary>
+        void QueryFrustum(const Frustum& frustum, std::vector<u32>& values) const;
+        /// <summary>
+        /// Append the value of every object whose box overlaps the bounds.
+        /// </summary>
+        void QueryOverlap(const Bounds& bounds, std::vector<u32>& values) const;
+        /// <summary>
+        /// The object whose box the ray enters first, within maxDistance. Direction does not need to be normalized,
+        /// distances are in multiples of it.
+        /// </summary>
+        [[nodiscard]] Opt<RayHit> Raycast(glm::vec3 origin, glm::vec3 direction, float maxDistance) const;
+
+        [[nodiscard]] u32 GetCount() const { return mCount; }
+        [[nodiscard]] u32 GetNodeCount() const { return static_cast<u32>(mNodes.size() - mFreeNodes.size()); }
+        /// <summary>
+        /// Summed surface area of every node relative to the root. Grows as refits loosen the tree, so comparing
+        /// it to the value right after Build tells when to rebuild.
+        /// </summary>
+        [[nodiscard]] float GetCost() const;
+
+    private:
+        static constexpr u32 kNone = std::numeric_limits<u32>::max();
+        // Children with this bit set are objects, the rest are nodes
+        static constexpr u32 kObjectBit = 1u << 31;
+        static constexpr u32 kBins = 16;
+
+        struct alignas(16) Node
+        {
+            std::array<float, kWidth> MinX;
+            std::array<float, kWidth> MinY;
+            std::array<float, kWidth> MinZ;
+            std::array<float, kWidth> MaxX;
+            std::array<float, kWidth> MaxY;
+            std::array<float, kWidth> MaxZ;
+            std::array<u32, kWidth> Children;
+            u32 Parent;
+            /// <summary>
+            /// Bit i set when child i is used.
+            /// </summary>
+            u32 Used;
+        };
+
+        // Objects are copied next to each other while building, so splitting never chases indices
+        struct BuildItem
+        {
+            glm::vec3 Min;
+            glm::vec3 Max;
+            u32 Object;
+        };
+
+        struct Object
+        {
+            glm::vec3 Min;
+            glm::vec3 Max;
+            u32 Value;
+            u32 Node = kNone;
+            u32 Slot = 0;
+        };
+
+        u32 AllocateNode(u32 parent);
+        void FreeNode(u32 node);
+        void SetChild(u32 node, u32 slot, u32 child, glm::vec3 min, glm::vec3 max);
+        void ClearChild(u32 node, u32 slot);
+        /// <summary>
+        /// Box around every child of a node.
+        /// </summary>
+        [[nodiscard]] std::pair<glm::vec3, glm::vec3> GetNodeBounds(u32 node) const;
+        /// <summary>
+        /// Recompute the box of a node in its parent, and so on up to the root.
+        /// </summary>
+        void Refit(u32 node);
+        /// <summary>
+        /// Split objects into two groups with the surface area heuristic and return the size of the first.
+        /// </summary>
+        static u32 Split(std::span<BuildItem> items);
+        u32 BuildNode(std::span<BuildItem> items, u32 parent);
+        void AddChild(u32 node, std::span<BuildItem> items);
+        void CollectAll(u32 node, std::vector<u32>& values) const;
+
+        std::vector<Node> mNodes;
+        std::vector<u32> mFreeNodes;
+        std::vector<Object> mObjects;
+        std::vector<u32> mFreeObjects;
+        u32 mRoot = kNone;
+        u32 mCount = 0;
+    };
+}
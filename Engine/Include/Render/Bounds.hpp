@@ -0,0 +1,27 @@
+#pragma once
+#include "Render/RenderComponents.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Axis aligned box and bounding sphere of a primitive in its local space. The sphere is centered on the box,
+    /// with the radius reaching the farthest vertex rather than the corner of the box.
+    /// </summary>
+    struct Bounds
+    {
+        glm::vec3 Min{0.f};
+        glm::vec3 Max{0.f};
+        glm::vec3 Center{0.f};
+        float Radius = 0.f;
+
+        [[nodiscard]] glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+    };
+
+    [[nodiscard]] Bounds ComputeBounds(std::span<const Vertex> vertices);
+
+    /// <summary>
+    /// Bounds of the transformed box, which is never smaller than the box itself, and of the sphere scaled by the
+    /// largest scale of the transform.
+    /// </summary>
+    [[nodiscard]] Bounds TransformBounds(const Bounds& bounds, const glm::mat4& transform);
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Render/Bounds.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Six planes with their normals facing inwards, in the order left, right, bottom, top, near, far. A point is
+    /// inside a plane when dot(plane.xyz, point) + plane.w is not negative. The default frustum contains everything.
+    /// </summary>
+    struct Frustum
+    {
+        std::array<glm::vec4, 6> Planes{
+            glm::vec4(0.f, 0.f, 0.f, 1.f), glm::vec4(0.f, 0.f, 0.f, 1.f), glm::vec4(0.f, 0.f, 0.f, 1.f),
+            glm::vec4(0.f, 0.f, 0.f, 1.f), glm::vec4(0.f, 0.f, 0.f, 1.f), glm::vec4(0.f, 0.f, 0.f, 1.f),
+        };
+
+        /// <summary>
+        /// Planes of the clip space of a view projection matrix.
+        /// </summary>
+        [[nodiscard]] static Frustum FromMatrix(const glm::mat4& viewProjection);
+    };
+
+    /// <summary>
+    /// World space bounds of many objects, tested against a frustum four objects at a time with SIMD. An object is
+    /// culled when its sphere or its box is entirely behind one of the planes. Large sets are split into chunks
+    /// culled on worker threads, and the visible indices are compacted into one list in the order the objects
+    /// were added.
+    /// </summary>
+    class FrustumCuller
+    {
+    public:
+        /// <summary>
+        /// Objects each thread culls at once. Sets no larger than this are culled on the calling thread.
+        /// </summary>
+        static constexpr u32 kChunkSize = 4096;
+
+        void Clear();
+        /// <summary>
+        /// Returns the index of the object, the value Cull reports it visible with.
+        /// </summary>
+        u32 Add(const Bounds& worldBounds);
+
+        /// <summary>
+        /// Indices of the objects inside the frustum, valid until the next Cull or Clear.
+        /// </summary>
+        std::span<const u32> Cull(const Frustum& frustum);
+
+        [[nodiscard]] u32 GetCount() const { return mCount; }
+
+    private:
+        static constexpr u32 kLanes = 4;
+        static constexpr u32 kChunkBlocks = kChunkSize / kLanes;
+
+        // Four objects with every component in an array of its own, so a component of all four loads at once
+        struct alignas(16) Block
+        {
+            std::array<float, kLanes> CenterX;
+            std::array<float, kLanes> CenterY;
+            std::array<float, kLanes> CenterZ;
+            std::array<float, kLanes> Radius;
+            std::array<float, kLanes> ExtentX;
+            std::array<float, kLanes> ExtentY;
+            std::array<float, kLanes> ExtentZ;
+        };
+
+        /// <summary>
+        /// Write the visible indices of a chunk to its own range of mVisible and return how many there are.
+        /// </summary>
+        u32 CullChunk(const Frustum& frustum, u32 chunk);
+
+        std::vector<Block> mBlocks;
+        u32 mCount = 0;
+        std::vector<u32> mVisible;
+        std::vector<u32> mChunkCounts;
+    };
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Render/RenderStructs.hpp"
+#include "Memory/ScratchAllocator.hpp"
 
 namespace Neo::DX12
 {
@@ -98,6 +99,32 @@ namespace Neo::DX12
 
     constexpr bool GetFrontFace(const FrontFace frontFace) { return static_cast<bool>(frontFace); }
 
+    constexpr D3D12_RESOURCE_STATES GetResourceState(const ResourceState state)
+    {
+        switch (state)
+        {
+        case ResourceState::eUndefined:
+            return D3D12_RESOURCE_STATE_COMMON;
+        case ResourceState::eRenderTarget:
+            return D3D12_RESOURCE_STATE_RENDER_TARGET;
+        case ResourceState::eDepthWrite:
+            return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+        case ResourceState::eDepthRead:
+            return D3D12_RESOURCE_STATE_DEPTH_READ;
+        case ResourceState::eShaderRead:
+            return D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE;
+        case ResourceState::eUnorderedAccess:
+            return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+        case ResourceState::eCopySource:
+            return D3D12_RESOURCE_STATE_COPY_SOURCE;
+        case ResourceState::eCopyDest:
+            return D3D12_RESOURCE_STATE_COPY_DEST;
+        case ResourceState::ePresent:
+            return D3D12_RESOURCE_STATE_PRESENT;
+        }
+        return D3D12_RESOURCE_STATE_COMMON;
+    }
+
     constexpr D3D12_RTV_DIMENSION GetRTVDimension(const ViewType viewType)
     {
         return static_cast<D3D12_RTV_DIMENSION>(viewType);
@@ -169,10 +196,17 @@ namespace Neo::DX12
         return resource;
     }
 
+    // Debug names are widened on the thread scratch arena instead of the heap
+    inline HRESULT SetName(ID3D12Object* const object, const std::string_view name)
+    {
+        ScratchScope scratch;
+        const std::pmr::wstring wideName(name.begin(), name.end(), scratch.GetResource());
+        return object->SetName(wideName.c_str());
+    }
+
     inline void Name(ID3D12Object* const object, const std::string_view name)
     {
-        const auto wDebugName = std::wstring(name.begin(), name.end());
-        const auto nameResult = object->SetName(wDebugName.c_str());
+        const auto nameResult = SetName(object, name);
         ThrowIfFailed(nameResult, "Failed to name swap chain buffer resource");
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "Render/DX12/RenderStructsDX12.hpp"
 #include "Render/RenderContext.hpp"
+#include "Core/Pool.hpp"
 
 namespace Neo
 {
@@ -14,54 +15,56 @@ namespace Neo
 
         ResourceHandle GetResourceHandle(BufferHandle handle) override
         {
-            return mBuffers.at(static_cast<u32>(handle)).ResourceHandle;
+            return mBuffers.At(handle).ResourceHandle;
         }
 
         ResourceHandle GetResourceHandle(TextureHandle handle) override
         {
-            return mTextures.at(static_cast<u32>(handle)).ResourceHandle;
+            return mTextures.At(handle).ResourceHandle;
         }
 
         ResourceHandle GetResourceHandle(DepthStencilHandle handle) override
         {
-            return mDepthStencils.at(static_cast<u32>(handle)).ResourceHandle;
+            return mDepthStencils.At(handle).ResourceHandle;
         }
 
         ResourceHandle GetResourceHandle(RenderTargetHandle handle) override
         {
-            return mRenderTargets.at(static_cast<u32>(handle)).ResourceHandle;
+            return mRenderTargets.At(handle).ResourceHandle;
         }
 
         [[nodiscard]] void* GetDevice() const override { return mDevice; }
         [[nodiscard]] void* GetGraphicsCommandQueue() const override { return mGraphicsQueue; }
 
-        [[nodiscard]] void* GetGraphicsCommandList() override
+        [[nodiscard]] void* GetGraphicsCommandList(const CommandHandle commandHandle) override
         {
-            return mCommands.at(static_cast<u32>(GetFrameData().CommandHandle)).CommandList;
+            return mCommands.At(commandHandle).CommandList;
         }
 
         [[nodiscard]] void* GetCBVUAVSRVAllocator() override { return &mCBVUAVSRVAllocator; }
 
         [[nodiscard]] void* GetRenderDescriptor(RenderTargetHandle renderTargetHandle) override
         {
-            return &mRenderTargets.at(static_cast<u32>(renderTargetHandle)).RenderDescriptor;
+            return &mRenderTargets.At(renderTargetHandle).RenderDescriptor;
         }
 
         [[nodiscard]] void* GetTextureDescriptor(RenderTargetHandle renderTargetHandle) override
         {
-            return &mRenderTargets.at(static_cast<u32>(renderTargetHandle)).TextureDescriptor;
+            return &mRenderTargets.At(renderTargetHandle).TextureDescriptor;
         }
 
         RenderTargetHandle CreateRenderTarget(RenderTargetCreateInfo createInfo, std::string_view debugName) override;
         DepthStencilHandle CreateDepthStencil(DepthStencilCreateInfo createInfo, std::string_view debugName) override;
         CommandHandle CreateCommand(QueueType queueType, std::string_view debugName) override;
         BufferHandle CreateBuffer(const BufferCreateInfo& createInfo, std::string_view debugName) override;
+        TextureHandle CreateTexture(const TextureCreateInfo& createInfo, std::string_view debugName) override;
         ShaderHandle CreateShader(const GraphicsShaderCreateInfo& createInfo, std::string_view debugName) override;
         ShaderHandle CreateShader(const ComputeShaderCreateInfo& createInfo, std::string_view debugName) override;
 
         void DestroyRenderTarget(RenderTargetHandle renderTargetHandle) override;
         void DestroyDepthStencil(DepthStencilHandle depthStencilHandle) override;
         void DestroyBuffer(BufferHandle bufferHandle) override;
+        void DestroyTexture(TextureHandle textureHandle) override;
 
         void* MapBuffer(BufferHandle bufferHandle) override;
         void UnmapBuffer(BufferHandle bufferHandle) override;
@@ -77,16 +80,20 @@ namespace Neo
         void WaitForFrame() override;
         void WaitForGPU() override;
         void Resize() override;
-        void OneTimeSubmit(const std::vector<CommandHandle>& commandHandle, QueueType queueType) override;
-        void Submit(const std::vector<CommandHandle>& commandHandles, QueueType queueType) override;
+        void OneTimeSubmit(std::span<const CommandHandle> commandHandle, QueueType queueType) override;
+        void Submit(std::span<const CommandHandle> commandHandles, QueueType queueType) override;
+        u64 SignalTransfer() override;
+        u64 GetCompletedTransfer() const override;
         void Present() override;
         void BeginCommand(CommandHandle commandHandle) override;
         void EndCommand(CommandHandle commandHandle) override;
         void SetupGraphicsCommand(CommandHandle commandHandle) override;
+        void Barrier(CommandHandle commandHandle, std::span<const ResourceBarrier> barriers) override;
         void BeginRenderPass(CommandHandle commandHandle, const RenderPassInfo& renderPassInfo) override;
         void EndRenderPass(CommandHandle commandHandle) override;
         void BindShader(CommandHandle commandHandle, ShaderHandle shaderHandle) override;
         void SetPrimitiveTopology(CommandHandle commandHandle, PrimitiveTopology topology) override;
+        void BindIndexBuffer(CommandHandle commandHandle, BufferHandle bufferHandle) override;
         void Draw(CommandHandle commandHandle,
                   u32 vertexCount,
                   u32 instanceCount,
@@ -113,9 +120,20 @@ namespace Neo
         void CreateHeaps();
         void CreateRootSignature();
         [[nodiscard]] ResourceHandle
-        CreateResource(const DX12::Heap& heap, const TextureCreateInfo& createInfo, std::string_view debugName);
+        CreateResource(DX12::Heap& heap, const TextureCreateInfo& createInfo, std::string_view debugName);
         [[nodiscard]] ResourceHandle
         CreateResource(DX12::Heap& heap, const BufferCreateInfo& createInfo, std::string_view debugName);
+        /// <summary>
+        /// Create a resource in a free range of the heap that fits it.
+        /// </summary>
+        [[nodiscard]] ResourceHandle PlaceResource(DX12::Heap& heap,
+                                                   const D3D12_RESOURCE_DESC& resourceDesc,
+                                                   const D3D12_CLEAR_VALUE* clearValue,
+                                                   std::string_view debugName);
+        /// <summary>
+        /// Release destroyed resources and their heap memory once the frames that could use them are done.
+        /// </summary>
+        void ReleaseResources(u64 completedFrame);
         [[nodiscard]] DX12::Heap CreateHeap(D3D12_HEAP_TYPE type, u32 size, std::string_view debugName) const;
         [[nodiscard]] DX12::DescriptorAllocator CreateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE heapType,
                                                                      std::string_view debugName) const;
@@ -125,6 +143,7 @@ namespace Neo
                                                                 const TextureCreateInfo& createInfo);
         [[nodiscard]] DX12::Descriptor CreateRenderTargetView(ResourceHandle resourceHandle,
                                                               const RenderTargetCreateInfo& createInfo);
+        void DestroyResource(ResourceHandle resourceHandle);
         void TransitionResource(CommandHandle commandHandle,
                                 ResourceHandle resourceHandle,
                                 D3D12_RESOURCE_STATES newState);
@@ -138,7 +157,8 @@ namespace Neo
         ID3D12Fence1* mGraphicsFence = nullptr;
         ID3D12CommandQueue* mTransferQueue = nullptr;
         ID3D12Fence1* mTransferFence = nullptr;
-        u64 mTransferFenceValue = 0;
+        // The fence starts at 0, so the first value signaled has to be above it
+        u64 mTransferFenceValue = 1;
         ID3D12RootSignature* mRootSignature = nullptr;
 
         DX12::DescriptorAllocator mCBVUAVSRVAllocator;
@@ -150,12 +170,19 @@ namespace Neo
         DX12::Heap mUploadHeap;
         DX12::Heap mReadbackHeap;
 
-        std::vector<DX12::Command> mCommands;
-        std::vector<DX12::RenderTarget> mRenderTargets;
-        std::vector<DX12::DepthStencil> mDepthStencils;
-        std::vector<DX12::Texture> mTextures;
-        std::vector<DX12::Buffer> mBuffers;
-        std::vector<ID3D12PipelineState*> mShaders;
-        std::vector<DX12::Resource> mResources;
+        Pool<DX12::Command, CommandHandle> mCommands;
+        Pool<DX12::RenderTarget, RenderTargetHandle> mRenderTargets;
+        Pool<DX12::DepthStencil, DepthStencilHandle> mDepthStencils;
+        Pool<DX12::Texture, TextureHandle> mTextures;
+        Pool<DX12::Buffer, BufferHandle> mBuffers;
+        Pool<ID3D12PipelineState*, ShaderHandle> mShaders;
+        Pool<DX12::Resource, ResourceHandle> mResources;
+
+        std::unordered_map<ResourceHandle, DX12::Placement> mPlacements;
+        std::deque<DX12::PendingRelease> mPendingReleases;
+        // Frames presented so far
+        u64 mFrameNumber = 0;
+
+        std::vector<ID3D12CommandList*> mSubmitCommands;
     };
 } // namespace FS
@@ -1,7 +1,9 @@
 #pragma once
+#include "Memory/OffsetAllocator.hpp"
 #include "Render/RenderStructs.hpp"
 #include "spdlog/fmt/bundled/std.h"
 #include "Tools/Tools.hpp"
+#include "Tools/Metrics.hpp"
 
 namespace Neo::DX12
 {
@@ -9,7 +11,22 @@ namespace Neo::DX12
     {
         ID3D12Heap* BaseHeap = nullptr;
         u32 Size = 0;
-        u32 Offset = 0;
+        OffsetAllocator Allocator;
+    };
+
+    /// <summary>
+    /// Where a placed resource lives, to give the memory back when it is destroyed.
+    /// </summary>
+    struct Placement
+    {
+        DX12::Heap* Heap = nullptr;
+        OffsetAllocation Allocation;
+    };
+
+    struct PendingRelease
+    {
+        u64 FrameNumber = 0;
+        ID3D12Resource2* Resource = nullptr;
     };
 
     struct Descriptor
@@ -32,6 +49,9 @@ namespace Neo::DX12
 
         Descriptor Allocate()
         {
+            static const Counter allocations("Render/DescriptorAllocations");
+            allocations.Add();
+            GetLiveDescriptors().Add(1);
             u32 index;
             if (FreeIndices.empty())
             {
@@ -50,7 +70,11 @@ namespace Neo::DX12
             };
         }
 
-        void Free(const Descriptor& descriptor) { FreeIndices.push_back(descriptor.Index); }
+        void Free(const Descriptor& descriptor)
+        {
+            GetLiveDescriptors().Add(-1);
+            FreeIndices.push_back(descriptor.Index);
+        }
 
         void Free(const D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle, const D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle) 
         {
@@ -60,14 +84,23 @@ namespace Neo::DX12
             {
                 ThrowError("Freeing an incorrect Descriptor");
             }
+            GetLiveDescriptors().Add(-1);
             FreeIndices.push_back(cpuIdx);
         }
+
+    private:
+        static const Gauge& GetLiveDescriptors()
+        {
+            static const Gauge liveDescriptors("Render/LiveDescriptors");
+            return liveDescriptors;
+        }
     };
 
     struct Command
     {
         ID3D12CommandAllocator* CommandAllocator = nullptr;
         ID3D12GraphicsCommandList10* CommandList = nullptr;
+        QueueType Queue = QueueType::eGraphics;
     };
 
     struct Resource
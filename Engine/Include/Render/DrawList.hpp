@@ -0,0 +1,189 @@
+#pragma once
+#include "Render/Occlusion.hpp"
+#include "Render/SceneBVH.hpp"
+#include "Resources/Resource.hpp"
+
+namespace Neo
+{
+
+    /// <summary>
+    /// Where the draws are seen from. Depth is the distance along Forward, scaled by Far into the depth bits of
+    /// the sort key. Extracted draws outside the frustum are culled, and with OcclusionCulling so are draws hidden
+    /// behind an Occluder. The field of view and viewport height give the screen size textures are reported at.
+    /// </summary>
+    struct DrawView
+    {
+        glm::vec3 Position{0.f};
+        glm::vec3 Forward{0.f, 0.f, 1.f};
+        float Far = 1000.f;
+        /// <summary>
+        /// Vertical, in radians.
+        /// </summary>
+        float FieldOfView = 0.f;
+        /// <summary>
+        /// In pixels, 0 when the view is not drawn to a viewport, which reports every texture at full detail.
+        /// </summary>
+        float ViewportHeight = 0.f;
+        glm::mat4 ViewProjection{1.f};
+        Frustum Frustum;
+        bool OcclusionCulling = false;
+
+        /// <summary>
+        /// Approximate size in pixels the bounds cover on screen.
+        /// </summary>
+        [[nodiscard]] float GetScreenSize(const Bounds& bounds) const;
+    };
+
+    [[nodiscard]] DrawView MakeDrawView(const Transform& transform, const Camera& camera, glm::uvec2 viewportSize);
+
+    /// <summary>
+    /// Consecutive draws with the same state, drawn with one instanced draw call. Its instances are
+    /// InstanceCount world matrices starting at FirstInstance in DrawList::GetInstances.
+    /// </summary>
+    struct DrawBatch
+    {
+        DrawPass Pass = DrawPass::eOpaque;
+        ShaderHandle Shader = ShaderHandle::eNull;
+        /// <summary>
+        /// Index into the MaterialTable of Resources.
+        /// </summary>
+        u32 Material = 0;
+        AssetHandle<Mesh> Mesh;
+        u32 Primitive = 0;
+        u32 FirstInstance = 0;
+        u32 InstanceCount = 0;
+    };
+
+    struct DrawStats
+    {
+        u32 Draws = 0;
+        /// <summary>
+        /// Extracted draws left out for being outside the frustum. Entities the scene BVH already left out are
+        /// not counted.
+        /// </summary>
+        u32 Culled = 0;
+        /// <summary>
+        /// Extracted draws in the frustum left out for being hidden behind occluders.
+        /// </summary>
+        u32 Occluded = 0;
+        /// <summary>
+        /// One per batch.
+        /// </summary>
+        u32 DrawCalls = 0;
+        u32 ShaderChanges = 0;
+        u32 MaterialChanges = 0;
+        u32 MeshChanges = 0;
+
+        [[nodiscard]] u32 GetStateChanges() const { return ShaderChanges + MaterialChanges + MeshChanges; }
+    };
+
+    /// <summary>
+    /// Collects the draws of a frame, sorts them by a 64 bit key and merges draws with the same state into
+    /// instanced batches.
+    ///
+    /// Opaque keys hold, from the highest bits down, the pass, shader, material, mesh, primitive and depth, so
+    /// state changes as rarely as possible and each batch is drawn front to back. Transparent keys move the inverted
+    /// depth right after the pass, drawing back to front and only merging neighbours. Every field is truncated to
+    /// its bits, which at worst splits batches: merging compares the full state, never the key.
+    /// </summary>
+    class DrawList
+    {
+    public:
+        static constexpr u32 kPassBits = 3;
+        static constexpr u32 kShaderBits = 9;
+        static constexpr u32 kMaterialBits = 16;
+        static constexpr u32 kMeshBits = 16;
+        static constexpr u32 kPrimitiveBits = 4;
+        static constexpr u32 kDepthBits = 16;
+        static_assert(kPassBits + kShaderBits + kMaterialBits + kMeshBits + kPrimitiveBits + kDepthBits == 64);
+        static_assert(static_cast<u32>(DrawPass::eCount) <= 1u << kPassBits);
+
+        [[nodiscard]] static u64 MakeKey(DrawPass pass, ShaderHandle shader, u32 material, AssetHandle<Mesh> mesh,
+                                         u32 primitive, float depth);
+
+        /// <summary>
+        /// Drop the draws of the last frame, keeping their memory.
+        /// </summary>
+        void Begin(const DrawView& view);
+        void Add(DrawPass pass,
+                 ShaderHandle shader,
+                 u32 material,
+                 AssetHandle<Mesh> mesh,
+                 u32 primitive,
+                 const glm::mat4& world);
+        /// <summary>
+        /// Add a draw for every primitive of every entity with a MeshRenderer whose mesh is loaded and whose bounds are
+        /// in the frustum of the view. Primitives whose material is not loaded yet are left out until it is. With a
+        /// scene BVH only the entities it finds in the frustum are looked at, instead of every entity. With occlusion
+        /// culling every Occluder is rasterized first and draws behind them are left out. The textures of every draw
+        /// are reported to the resources at their screen size, so they keep the mips they are drawn at.
+        /// </summary>
+        void Extract(const ECS& ecs, Resources& resources, const SceneBVH* scene = nullptr);
+        /// <summary>
+        /// Sort the draws and build the batches and instances.
+        /// </summary>
+        void Finish();
+
+        [[nodiscard]] const DrawView& GetView() const { return mView; }
+        [[nodiscard]] const OcclusionCuller& GetOcclusion() const { return mOcclusion; }
+        [[nodiscard]] std::span<const DrawBatch> GetBatches() const { return mBatches; }
+        [[nodiscard]] std::span<const glm::mat4> GetInstances() const { return mInstances; }
+        [[nodiscard]] const DrawStats& GetStats() const { return mStats; }
+
+    private:
+        /// <summary>
+        /// Draws each sorting thread handles at once. Lists no longer than this are sorted on the calling thread.
+        /// </summary>
+        static constexpr u32 kSortChunkSize = 1u << 16;
+
+        using Histogram = std::array<u32, 256>;
+
+        struct SortItem
+        {
+            u64 Key;
+            u32 Draw;
+        };
+
+        // Kept apart from the world matrices so merging batches only reads the state
+        struct Draw
+        {
+            DrawPass Pass;
+            ShaderHandle Shader;
+            u32 Material;
+            AssetHandle<Mesh> Mesh;
+            u32 Primitive;
+        };
+
+        // A draw that still has to pass culling
+        struct Candidate
+        {
+            Draw Draw;
+            u32 World;
+            AssetHandle<Material> Material;
+        };
+
+        void AddCandidates(const Transform& transform, const MeshRenderer& renderer, Resources& resources);
+        void RasterizeOccluders(const ECS& ecs, Resources& resources);
+        void Sort();
+        void Batch();
+
+        DrawView mView;
+        std::vector<u32> mSceneVisible;
+        std::vector<Candidate> mCandidates;
+        std::vector<glm::mat4> mCandidateWorlds;
+        std::vector<Bounds> mCandidateBounds;
+        FrustumCuller mCuller;
+        u32 mCulled = 0;
+        OcclusionCuller mOcclusion;
+        std::vector<u8> mUnoccluded;
+        u32 mOccluded = 0;
+        std::vector<Draw> mDraws;
+        std::vector<glm::mat4> mWorlds;
+        std::vector<SortItem> mItems;
+        std::vector<SortItem> mScratch;
+        std::vector<Histogram> mHistograms;
+        std::vector<DrawBatch> mBatches;
+        std::vector<glm::mat4> mInstances;
+        DrawStats mStats;
+    };
+}
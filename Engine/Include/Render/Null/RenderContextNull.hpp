@@ -0,0 +1,253 @@
+#pragma once
+#include "Render/RenderContext.hpp"
+#include "Core/Pool.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Every IRenderContext call the null backend counts.
+    /// </summary>
+    enum class NullCall : u8
+    {
+        eCreateRenderTarget,
+        eCreateDepthStencil,
+        eCreateCommand,
+        eCreateBuffer,
+        eCreateTexture,
+        eCreateShader,
+        eDestroyRenderTarget,
+        eDestroyDepthStencil,
+        eDestroyBuffer,
+        eDestroyTexture,
+        eMapBuffer,
+        eUnmapBuffer,
+        eOneTimeSubmit,
+        eSubmit,
+        eSignalTransfer,
+        ePresent,
+        eWaitForGPU,
+        eWaitForFrame,
+        eResize,
+        eBeginCommand,
+        eSetupGraphicsCommand,
+        eEndCommand,
+        eBarrier,
+        eBeginRenderPass,
+        eEndRenderPass,
+        eBindShader,
+        eSetViewport,
+        eSetScissor,
+        eSetPrimitiveTopology,
+        eBindIndexBuffer,
+        eDraw,
+        eDrawIndexed,
+        eBlitToSwapchain,
+        ePushConstant,
+        eCopyBuffer,
+        eCount,
+    };
+
+    /// <summary>
+    /// One call recorded into a command. Args holds the arguments after the command handle in the order of the
+    /// IRenderContext signature, with handles as their raw value and floats as their bits. Render passes store
+    /// their first render target, the depth stencil and the render target count, push constants their count and
+    /// the offset and size of their data in the command's PushConstantData.
+    /// </summary>
+    struct NullCommand
+    {
+        NullCall Call;
+        std::array<u64, 5> Args{};
+    };
+
+    namespace Null
+    {
+        struct Command
+        {
+            QueueType Queue;
+            std::vector<NullCommand> Commands;
+            std::vector<u8> PushConstantData;
+            bool Recording = false;
+        };
+
+        struct Buffer
+        {
+            BufferCreateInfo CreateInfo;
+            ResourceHandle ResourceHandle;
+        };
+
+        struct RenderTarget
+        {
+            RenderTargetCreateInfo CreateInfo;
+            ResourceHandle ResourceHandle;
+        };
+
+        struct DepthStencil
+        {
+            DepthStencilCreateInfo CreateInfo;
+            ResourceHandle ResourceHandle;
+        };
+
+        struct Texture
+        {
+            TextureCreateInfo CreateInfo;
+            ResourceHandle ResourceHandle;
+        };
+
+        /// <summary>
+        /// Only buffers keep their contents, textures would cost memory nothing reads.
+        /// </summary>
+        struct Resource
+        {
+            std::vector<u8> Data;
+        };
+    }
+
+    /// <summary>
+    /// IRenderContext that never touches a GPU. It hands out valid handles, keeps buffer contents in memory so
+    /// mapping and copying behave, records every command into a stream that can be inspected after submission
+    /// and counts every API call. Lets the CPU side of the renderer run and be measured on a machine without D3D12.
+    /// </summary>
+    class RenderContextNull final : public IRenderContext
+    {
+    public:
+        explicit RenderContextNull(const RenderContextCreateInfo& args);
+        ~RenderContextNull() override = default;
+
+        ResourceHandle GetResourceHandle(BufferHandle handle) override
+        {
+            return mBuffers.At(handle).ResourceHandle;
+        }
+
+        ResourceHandle GetResourceHandle(TextureHandle handle) override
+        {
+            return mTextures.At(handle).ResourceHandle;
+        }
+
+        ResourceHandle GetResourceHandle(DepthStencilHandle handle) override
+        {
+            return mDepthStencils.At(handle).ResourceHandle;
+        }
+
+        ResourceHandle GetResourceHandle(RenderTargetHandle handle) override
+        {
+            return mRenderTargets.At(handle).ResourceHandle;
+        }
+
+        // There are no native objects behind the null backend
+        [[nodiscard]] void* GetDevice() const override { return nullptr; }
+        [[nodiscard]] void* GetGraphicsCommandQueue() const override { return nullptr; }
+        [[nodiscard]] void* GetGraphicsCommandList(CommandHandle) override { return nullptr; }
+        [[nodiscard]] void* GetCBVUAVSRVAllocator() override { return nullptr; }
+        [[nodiscard]] void* GetRenderDescriptor(RenderTargetHandle) override { return nullptr; }
+        [[nodiscard]] void* GetTextureDescriptor(RenderTargetHandle) override { return nullptr; }
+
+        RenderTargetHandle CreateRenderTarget(RenderTargetCreateInfo createInfo, std::string_view debugName) override;
+        DepthStencilHandle CreateDepthStencil(DepthStencilCreateInfo createInfo, std::string_view debugName) override;
+        CommandHandle CreateCommand(QueueType queueType, std::string_view debugName) override;
+        BufferHandle CreateBuffer(const BufferCreateInfo& createInfo, std::string_view debugName) override;
+        TextureHandle CreateTexture(const TextureCreateInfo& createInfo, std::string_view debugName) override;
+        ShaderHandle CreateShader(const GraphicsShaderCreateInfo& createInfo, std::string_view debugName) override;
+        ShaderHandle CreateShader(const ComputeShaderCreateInfo& createInfo, std::string_view debugName) override;
+
+        void DestroyRenderTarget(RenderTargetHandle renderTargetHandle) override;
+        void DestroyDepthStencil(DepthStencilHandle depthStencilHandle) override;
+        void DestroyBuffer(BufferHandle bufferHandle) override;
+        void DestroyTexture(TextureHandle textureHandle) override;
+
+        void* MapBuffer(BufferHandle bufferHandle) override;
+        void UnmapBuffer(BufferHandle bufferHandle) override;
+        u32 GetGPUAddress(TextureHandle textureHandle) override;
+        u32 GetGPUAddress(BufferHandle bufferHandle) override;
+        void CopyBuffer(CommandHandle commandHandle,
+                        BufferHandle srcBufferHandle,
+                        BufferHandle dstBufferHandle,
+                        u64 srcOffset,
+                        u64 dstOffset,
+                        u64 size) override;
+
+        void WaitForFrame() override;
+        void WaitForGPU() override;
+        void Resize() override;
+        void OneTimeSubmit(std::span<const CommandHandle> commandHandles, QueueType queueType) override;
+        void Submit(std::span<const CommandHandle> commandHandles, QueueType queueType) override;
+        u64 SignalTransfer() override;
+        u64 GetCompletedTransfer() const override { return mTransferFenceValue; }
+        void Present() override;
+        void BeginCommand(CommandHandle commandHandle) override;
+        void EndCommand(CommandHandle commandHandle) override;
+        void SetupGraphicsCommand(CommandHandle commandHandle) override;
+        void Barrier(CommandHandle commandHandle, std::span<const ResourceBarrier> barriers) override;
+        void BeginRenderPass(CommandHandle commandHandle, const RenderPassInfo& renderPassInfo) override;
+        void EndRenderPass(CommandHandle commandHandle) override;
+        void BindShader(CommandHandle commandHandle, ShaderHandle shaderHandle) override;
+        void SetPrimitiveTopology(CommandHandle commandHandle, PrimitiveTopology topology) override;
+        void BindIndexBuffer(CommandHandle commandHandle, BufferHandle bufferHandle) override;
+        void Draw(CommandHandle commandHandle,
+                  u32 vertexCount,
+                  u32 instanceCount,
+                  u32 vertexOffset,
+                  u32 firstInstance) override;
+        void DrawIndexed(CommandHandle commandHandle,
+                         u32 indexCount,
+                         u32 instanceCount,
+                         u32 firstIndex,
+                         int vertexOffset,
+                         u32 firstInstance) override;
+        void SetViewport(CommandHandle commandHandle, const Viewport& viewport) override;
+        void SetScissor(CommandHandle commandHandle, const Scissor& scissor) override;
+        void BlitToSwapchain(CommandHandle commandHandle, RenderTargetHandle renderTargetHandle) override;
+        void PushConstant(CommandHandle commandHandle, u32 count, const void* data) override;
+
+        /// <summary>
+        /// Calls recorded into a command since its last BeginCommand.
+        /// </summary>
+        [[nodiscard]] std::span<const NullCommand> GetCommands(CommandHandle commandHandle) const
+        {
+            return mCommands.At(commandHandle).Commands;
+        }
+
+        [[nodiscard]] std::span<const u8> GetPushConstantData(CommandHandle commandHandle) const
+        {
+            return mCommands.At(commandHandle).PushConstantData;
+        }
+
+        /// <summary>
+        /// Commands submitted for the current frame in submission order, or for the last one right after Present.
+        /// </summary>
+        [[nodiscard]] std::span<const CommandHandle> GetSubmitted() const { return mSubmitted; }
+
+        [[nodiscard]] u64 GetCallCount(const NullCall call) const
+        {
+            return mCallCounts[static_cast<size_t>(call)].load(std::memory_order_relaxed);
+        }
+
+        void ResetCallCounts()
+        {
+            for (auto& count : mCallCounts) count.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        void CreateFrameData();
+        void Count(const NullCall call)
+        {
+            mCallCounts[static_cast<size_t>(call)].fetch_add(1, std::memory_order_relaxed);
+        }
+        void Record(CommandHandle commandHandle, NullCall call, const std::array<u64, 5>& args = {});
+
+        RenderContextCreateInfo mArgs;
+        // Commands may be recorded from several threads
+        std::array<std::atomic<u64>, static_cast<size_t>(NullCall::eCount)> mCallCounts{};
+        std::vector<CommandHandle> mSubmitted;
+        bool mClearSubmitted = false;
+        // Submitted work is done right away, so the fence is always at the last value signaled
+        u64 mTransferFenceValue = 0;
+
+        Pool<Null::Command, CommandHandle> mCommands;
+        Pool<Null::RenderTarget, RenderTargetHandle> mRenderTargets;
+        Pool<Null::DepthStencil, DepthStencilHandle> mDepthStencils;
+        Pool<Null::Texture, TextureHandle> mTextures;
+        Pool<Null::Buffer, BufferHandle> mBuffers;
+        Pool<bool, ShaderHandle> mShaders;
+        Pool<Null::Resource, ResourceHandle> mResources;
+    };
+} // namespace FS
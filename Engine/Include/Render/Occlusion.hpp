@@ -0,0 +1,78 @@
+#pragma once
+#include "Render/Bounds.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Software occlusion culling. Occluder triangles are rasterized on the CPU into a small depth buffer, and
+    /// object bounds are tested against it before they are drawn. The buffer is split into tiles rasterized on
+    /// worker threads, four pixels at a time with SIMD, and every tile also keeps the farthest depth of each of
+    /// its blocks, so most tests never look at single pixels.
+    ///
+    /// Depth is the normalized device depth of the view projection, with the buffer cleared to the far plane. An
+    /// object is occluded when the nearest point of its box is behind the occluders everywhere the box covers,
+    /// which only errs towards drawing too much, apart from slivers thinner than a pixel of the small buffer.
+    /// </summary>
+    class OcclusionCuller
+    {
+    public:
+        static constexpr u32 kWidth = 320;
+        static constexpr u32 kHeight = 192;
+        static constexpr u32 kTileWidth = 64;
+        static constexpr u32 kTileHeight = 32;
+        static constexpr u32 kBlockSize = 8;
+        static_assert(kWidth % kTileWidth == 0 && kHeight % kTileHeight == 0);
+        static_assert(kTileWidth % kBlockSize == 0 && kTileHeight % kBlockSize == 0 && kBlockSize % 4 == 0);
+
+        /// <summary>
+        /// Drop the occluders of the last frame and look through a new view projection.
+        /// </summary>
+        void Begin(const glm::mat4& viewProjection);
+        /// <summary>
+        /// Queue the triangles of a mesh, clipped against the near plane. Both sides of a triangle occlude.
+        /// </summary>
+        void AddOccluder(std::span<const Vertex> vertices, std::span<const u32> indices, const glm::mat4& world);
+        /// <summary>
+        /// Rasterize the queued occluders. Has to be called before testing.
+        /// </summary>
+        void Rasterize();
+
+        /// <summary>
+        /// False when the box is entirely hidden behind the occluders. Safe to call from several threads.
+        /// </summary>
+        [[nodiscard]] bool IsVisible(const Bounds& worldBounds) const;
+
+        [[nodiscard]] bool HasOccluders() const { return !mTriangles.empty(); }
+        [[nodiscard]] u32 GetTriangleCount() const { return static_cast<u32>(mTriangles.size()); }
+        /// <summary>
+        /// Row major, top row first.
+        /// </summary>
+        [[nodiscard]] std::span<const float> GetDepth() const { return mDepth; }
+
+    private:
+        static constexpr u32 kTilesX = kWidth / kTileWidth;
+        static constexpr u32 kTilesY = kHeight / kTileHeight;
+        static constexpr u32 kBlocksX = kWidth / kBlockSize;
+        static constexpr u32 kBlocksY = kHeight / kBlockSize;
+
+        // In pixels, with the depth in z
+        struct Triangle
+        {
+            std::array<glm::vec3, 3> Vertices;
+        };
+
+        void AddTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+        void RasterizeTile(u32 tile);
+        /// <summary>
+        /// Farthest depth of every block of a tile.
+        /// </summary>
+        void UpdateBlocks(u32 tile);
+
+        glm::mat4 mViewProjection{1.f};
+        std::vector<glm::vec4> mClipVertices;
+        std::vector<Triangle> mTriangles;
+        std::array<std::vector<u32>, kTilesX * kTilesY> mBins;
+        std::vector<float> mDepth = std::vector<float>(kWidth * kHeight, 1.f);
+        std::vector<float> mBlockDepth = std::vector<float>(kBlocksX * kBlocksY, 1.f);
+    };
+}
@@ -1,7 +1,12 @@
 #pragma once
+#include "Render/RenderEnums.hpp"
+#include "Render/RenderStructs.hpp"
+#include "Resources/AssetHandle.hpp"
 
 namespace Neo
 {
+    struct Mesh;
+
     struct Vertex
     {
         glm::vec3 Position;
@@ -10,4 +15,39 @@ namespace Neo
         float UVy;
         glm::vec4 Tangent;
     };
+
+    /// <summary>
+    /// Draws every primitive of a mesh with the material of the primitive at the entity's transform.
+    /// </summary>
+    struct MeshRenderer
+    {
+        AssetHandle<Mesh> Mesh;
+        DrawPass Pass = DrawPass::eOpaque;
+        /// <summary>
+        /// Null draws with the renderer's default shader.
+        /// </summary>
+        ShaderHandle Shader = ShaderHandle::eNull;
+    };
+
+    /// <summary>
+    /// Hides what is behind it from the renderer by drawing its mesh into the occlusion buffer. Usually a few large
+    /// triangles standing in for something like a building, rather than the mesh that is drawn.
+    /// </summary>
+    struct Occluder
+    {
+        AssetHandle<Mesh> Mesh;
+    };
+
+    /// <summary>
+    /// Perspective camera looking down the -Z axis of its entity. The renderer draws from the first one it finds.
+    /// </summary>
+    struct Camera
+    {
+        /// <summary>
+        /// Vertical, in degrees.
+        /// </summary>
+        float FieldOfView = 60.f;
+        float Near = 0.1f;
+        float Far = 1000.f;
+    };
 }
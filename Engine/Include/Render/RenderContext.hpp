@@ -9,6 +9,27 @@ namespace Neo
     public:
         virtual ~IRenderContext() = default;
         FrameData& GetFrameData() { return mFrameDatas.at(mFrameIndex); }
+        /// <summary>
+        /// Which of the kFrameCount frames in flight is being recorded. Present waits until the GPU is done with
+        /// the last frame that had the next index.
+        /// </summary>
+        [[nodiscard]] u32 GetFrameIndex() const { return mFrameIndex; }
+
+        /// <summary>
+        /// The index-th secondary command of the current frame, for recording next to the frame command on
+        /// another thread. Every frame in flight has its own, so a command is only reset once the GPU is done with
+        /// it. Get them on the submitting thread, recording into different ones may then happen in parallel.
+        /// </summary>
+        [[nodiscard]] CommandHandle GetSecondaryCommand(const u32 index)
+        {
+            auto& commands = GetFrameData().SecondaryCommands;
+            while (commands.size() <= index)
+            {
+                const auto name = fmt::format("Secondary Command {} {}", mFrameIndex, commands.size());
+                commands.emplace_back(CreateCommand(QueueType::eGraphics, name));
+            }
+            return commands[index];
+        }
 
         [[nodiscard]] virtual ResourceHandle GetResourceHandle(RenderTargetHandle handle) = 0;
         [[nodiscard]] virtual ResourceHandle GetResourceHandle(DepthStencilHandle handle) = 0;
@@ -17,7 +38,7 @@ namespace Neo
 
         [[nodiscard]] virtual void* GetDevice() const = 0;
         [[nodiscard]] virtual void* GetGraphicsCommandQueue() const = 0;
-        [[nodiscard]] virtual void* GetGraphicsCommandList() = 0;
+        [[nodiscard]] virtual void* GetGraphicsCommandList(CommandHandle commandHandle) = 0;
         [[nodiscard]] virtual void* GetCBVUAVSRVAllocator() = 0;
         [[nodiscard]] virtual void* GetRenderDescriptor(RenderTargetHandle renderTargetHandle) = 0;
         [[nodiscard]] virtual void* GetTextureDescriptor(RenderTargetHandle renderTargetHandle) = 0;
@@ -29,6 +50,11 @@ namespace Neo
         [[nodiscard]] virtual CommandHandle CreateCommand(QueueType queueType, std::string_view debugName) = 0;
         [[nodiscard]] virtual BufferHandle CreateBuffer(const BufferCreateInfo& createInfo,
                                                         std::string_view debugName) = 0;
+        /// <summary>
+        /// A texture shaders sample through the descriptor index GetGPUAddress returns for it.
+        /// </summary>
+        [[nodiscard]] virtual TextureHandle CreateTexture(const TextureCreateInfo& createInfo,
+                                                          std::string_view debugName) = 0;
         [[nodiscard]] virtual ShaderHandle CreateShader(const GraphicsShaderCreateInfo& createInfo,
                                                         std::string_view debugName) = 0;
         [[nodiscard]] virtual ShaderHandle CreateShader(const ComputeShaderCreateInfo& createInfo,
@@ -37,14 +63,21 @@ namespace Neo
         virtual void DestroyRenderTarget(RenderTargetHandle renderTargetHandle) = 0;
         virtual void DestroyDepthStencil(DepthStencilHandle depthStencilHandle) = 0;
         virtual void DestroyBuffer(BufferHandle bufferHandle) = 0;
+        virtual void DestroyTexture(TextureHandle textureHandle) = 0;
 
         [[nodiscard]] virtual void* MapBuffer(BufferHandle buffer) = 0;
         virtual void UnmapBuffer(BufferHandle buffer) = 0;
         virtual u32 GetGPUAddress(TextureHandle textureHandle) = 0;
         virtual u32 GetGPUAddress(BufferHandle textureHandle) = 0;
 
-        virtual void OneTimeSubmit(const std::vector<CommandHandle>& commandHandle, QueueType queueType) = 0;
-        virtual void Submit(const std::vector<CommandHandle>& commandHandle, QueueType queueType) = 0;
+        virtual void OneTimeSubmit(std::span<const CommandHandle> commandHandles, QueueType queueType) = 0;
+        virtual void Submit(std::span<const CommandHandle> commandHandles, QueueType queueType) = 0;
+        /// <summary>
+        /// Mark the end of everything submitted to the transfer queue so far, without waiting for it. Returns the
+        /// value GetCompletedTransfer reaches once that work is done. Values only grow.
+        /// </summary>
+        [[nodiscard]] virtual u64 SignalTransfer() = 0;
+        [[nodiscard]] virtual u64 GetCompletedTransfer() const = 0;
         virtual void Present() = 0;
         virtual void WaitForGPU() = 0;
         virtual void WaitForFrame() = 0;
@@ -52,12 +85,21 @@ namespace Neo
         virtual void BeginCommand(CommandHandle commandHandle) = 0;
         virtual void SetupGraphicsCommand(CommandHandle commandHandle) = 0;
         virtual void EndCommand(CommandHandle commandHandle) = 0;
+        /// <summary>
+        /// Transition resources between states. Backends that track resource states themselves may transition
+        /// from the state they know rather than Before.
+        /// </summary>
+        virtual void Barrier(CommandHandle commandHandle, std::span<const ResourceBarrier> barriers) = 0;
         virtual void BeginRenderPass(CommandHandle commandHandle, const RenderPassInfo& renderPassInfo) = 0;
         virtual void EndRenderPass(CommandHandle commandHandle) = 0;
         virtual void BindShader(CommandHandle commandHandle, ShaderHandle shaderHandle) = 0;
         virtual void SetViewport(CommandHandle commandHandle, const Viewport& viewport) = 0;
         virtual void SetScissor(CommandHandle commandHandle, const Scissor& scissor) = 0;
         virtual void SetPrimitiveTopology(CommandHandle commandHandle, PrimitiveTopology topology) = 0;
+        /// <summary>
+        /// Bind a buffer of u32 indices for DrawIndexed.
+        /// </summary>
+        virtual void BindIndexBuffer(CommandHandle commandHandle, BufferHandle bufferHandle) = 0;
         virtual void
         Draw(CommandHandle commandHandle, u32 vertexCount, u32 instanceCount, u32 vertexOffset, u32 firstInstance) = 0;
         virtual void DrawIndexed(CommandHandle commandHandle,
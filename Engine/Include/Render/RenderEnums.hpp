@@ -2,6 +2,15 @@
 
 namespace Neo
 {
+    enum class RenderBackend : uint8_t
+    {
+        eDX12,
+        /// <summary>
+        /// Records commands instead of executing them, for running the renderer without a GPU.
+        /// </summary>
+        eNull,
+    };
+
     enum class DevicePreference : uint8_t
     {
         eHighPerformance,
@@ -132,6 +141,22 @@ namespace Neo
         eTexture3D = 8,
     };
 
+    /// <summary>
+    /// What a resource is being used for, which decides the barriers between passes.
+    /// </summary>
+    enum class ResourceState : uint8_t
+    {
+        eUndefined,
+        eRenderTarget,
+        eDepthWrite,
+        eDepthRead,
+        eShaderRead,
+        eUnorderedAccess,
+        eCopySource,
+        eCopyDest,
+        ePresent,
+    };
+
     enum class BufferType : uint8_t
     {
         eStorage,
@@ -139,4 +164,15 @@ namespace Neo
         eStaging,
         eReadback
     };
+
+    /// <summary>
+    /// Which pass a draw belongs to. Opaque draws are sorted front to back and by state, transparent ones back
+    /// to front.
+    /// </summary>
+    enum class DrawPass : uint8_t
+    {
+        eOpaque,
+        eTransparent,
+        eCount
+    };
 } // namespace FS
\ No newline at end of file
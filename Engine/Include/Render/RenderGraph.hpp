@@ -0,0 +1,201 @@
+#pragma once
+#include "Render/RenderContext.hpp"
+
+namespace Neo
+{
+    class RenderGraph;
+
+    /// <summary>
+    /// Index of a resource declared to a RenderGraph, only valid for the frame it was declared in.
+    /// </summary>
+    enum class RenderGraphResource : u32
+    {
+        eNull = std::numeric_limits<u32>::max(),
+    };
+
+    struct RenderGraphTextureDesc
+    {
+        glm::uvec2 Size{};
+        Format Format = Format::eB8G8R8A8_UNORM;
+
+        bool operator==(const RenderGraphTextureDesc&) const = default;
+    };
+
+    /// <summary>
+    /// Records a pass into the given command, which is not necessarily the frame command and may be recorded on
+    /// another thread.
+    /// </summary>
+    using RenderGraphExecute = std::function<void(const RenderGraph&, CommandHandle)>;
+
+    /// <summary>
+    /// Handed to the setup of a pass to declare what it reads and writes.
+    /// </summary>
+    class RenderGraphBuilder
+    {
+    public:
+        /// <summary>
+        /// Render target that only lives between its first and last use this frame. Targets whose uses never
+        /// overlap share memory, so the first pass writing one has to clear it.
+        /// </summary>
+        RenderGraphResource CreateRenderTarget(std::string_view name, const RenderGraphTextureDesc& desc);
+        RenderGraphResource Read(RenderGraphResource resource, ResourceState state = ResourceState::eShaderRead);
+        RenderGraphResource Write(RenderGraphResource resource, ResourceState state = ResourceState::eRenderTarget);
+        /// <summary>
+        /// Keep the pass even when nothing reads what it writes.
+        /// </summary>
+        void SideEffect();
+
+    private:
+        friend class RenderGraph;
+        RenderGraphBuilder(RenderGraph& graph, const u32 pass) : mGraph(graph), mPass(pass) {}
+
+        RenderGraph& mGraph;
+        u32 mPass;
+    };
+
+    /// <summary>
+    /// Passes declared every frame together with the resources they read and write. Compiling culls passes
+    /// nothing depends on, lets transient render targets that are never live at the same time share one
+    /// physical target and plans the fewest barriers between passes. The compiled result is kept for as long as
+    /// the passes and their resources stay the same, so a steady frame only rebuilds the declarations.
+    /// </summary>
+    class RenderGraph
+    {
+    public:
+        struct Barrier
+        {
+            RenderGraphResource Resource;
+            ResourceState Before;
+            ResourceState After;
+        };
+
+        /// <summary>
+        /// Drop last frame's declarations. The compiled result and the physical targets are kept. The new
+        /// declarations and what compiling needs on the side live in memory until the next Reset, which is usually
+        /// the FrameAllocator, so a steady frame does not touch the heap.
+        /// </summary>
+        void Reset(std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+        /// <summary>
+        /// Use a render target that lives outside the graph. Writing it keeps the pass alive, and the graph
+        /// leaves it in finalState at the end of the frame.
+        /// </summary>
+        RenderGraphResource Import(std::string_view name,
+                                   RenderTargetHandle renderTarget,
+                                   ResourceState initialState,
+                                   ResourceState finalState);
+        /// <summary>
+        /// Declare a pass. The setup runs right away, the execute only if the pass survives culling.
+        /// </summary>
+        void AddPass(std::string_view name,
+                     const std::function<void(RenderGraphBuilder&)>& setup,
+                     RenderGraphExecute execute);
+
+        void Compile(IRenderContext& context);
+        /// <summary>
+        /// Record every pass into commandHandle on this thread.
+        /// </summary>
+        void Execute(IRenderContext& context, CommandHandle commandHandle);
+        /// <summary>
+        /// Record the passes in parallel, each into a secondary command of its own. The barriers are recorded up
+        /// front on this thread in pass order, so backends tracking resource states never race. commandHandle
+        /// receives the barriers after the last pass and has to be ended by the caller. Returns the commands to
+        /// submit, in order, ending with commandHandle.
+        /// </summary>
+        [[nodiscard]] std::span<const CommandHandle> ExecuteParallel(IRenderContext& context,
+                                                                     CommandHandle commandHandle);
+
+        /// <summary>
+        /// Destroy the physical render targets. Call before the context goes away.
+        /// </summary>
+        void Release(IRenderContext& context);
+
+        [[nodiscard]] RenderTargetHandle GetRenderTarget(RenderGraphResource resource) const;
+
+        /// <summary>
+        /// Indices of the passes that run, in the order they were added.
+        /// </summary>
+        [[nodiscard]] std::span<const u32> GetExecutedPasses() const { return mExecutedPasses; }
+
+        /// <summary>
+        /// Every planned barrier, the ones after the last pass included.
+        /// </summary>
+        [[nodiscard]] std::span<const Barrier> GetBarriers() const { return mBarriers; }
+
+        [[nodiscard]] size_t GetPassCount() const { return mPasses.size(); }
+        [[nodiscard]] size_t GetTransientCount() const;
+        [[nodiscard]] size_t GetPhysicalTargetCount() const { return mPhysicalTargets.size(); }
+
+        /// <summary>
+        /// How often the graph was actually compiled rather than reused.
+        /// </summary>
+        [[nodiscard]] u64 GetCompileCount() const { return mCompileCount; }
+
+    private:
+        friend class RenderGraphBuilder;
+
+        struct Resource
+        {
+            std::pmr::string Name;
+            RenderGraphTextureDesc Desc;
+            RenderTargetHandle RenderTarget = RenderTargetHandle::eNull;
+            bool Imported = false;
+            ResourceState InitialState = ResourceState::eUndefined;
+            ResourceState FinalState = ResourceState::eUndefined;
+        };
+
+        struct Access
+        {
+            RenderGraphResource Resource;
+            ResourceState State;
+            bool Write;
+        };
+
+        struct Pass
+        {
+            std::pmr::string Name;
+            std::pmr::vector<Access> Accesses;
+            RenderGraphExecute Execute;
+            bool SideEffect = false;
+        };
+
+        struct PhysicalTarget
+        {
+            RenderGraphTextureDesc Desc;
+            RenderTargetHandle RenderTarget;
+            // Where the last executed frame left the target, and where the planned barriers leave it
+            ResourceState State = ResourceState::eUndefined;
+            ResourceState PlannedState = ResourceState::eUndefined;
+        };
+
+        [[nodiscard]] bool IsImported(const RenderGraphResource resource) const
+        {
+            return mResources[static_cast<u32>(resource)].Imported;
+        }
+
+        [[nodiscard]] u64 HashTopology() const;
+        void Cull();
+        void Alias(IRenderContext& context);
+        void PlanBarriers();
+        void UpdateTargetStates();
+        void FlushBarriers(IRenderContext& context, CommandHandle commandHandle, u32 first, u32 last);
+
+        std::pmr::memory_resource* mMemory = std::pmr::get_default_resource();
+        std::vector<Resource> mResources;
+        std::vector<Pass> mPasses;
+
+        // Compiled result
+        bool mCompiled = false;
+        u64 mCompiledHash = 0;
+        u64 mCompileCount = 0;
+        std::vector<u32> mExecutedPasses;
+        std::vector<const char*> mPassZones;
+        std::vector<Barrier> mBarriers;
+        // Barriers in front of each executed pass, as ranges into mBarriers, with one more for the frame's end
+        std::vector<u32> mBarrierOffsets;
+        std::vector<u32> mPhysicalIndices;
+        std::vector<PhysicalTarget> mPhysicalTargets;
+        std::vector<ResourceBarrier> mBarrierScratch;
+        std::vector<CommandHandle> mSubmitCommands;
+    };
+} // namespace FS
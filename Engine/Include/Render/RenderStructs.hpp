@@ -6,6 +6,11 @@ namespace Neo
     struct RenderContextCreateInfo
     {
         DevicePreference GpuPreference;
+        RenderBackend Backend = RenderBackend::eDX12;
+        /// <summary>
+        /// Size of the swapchain. The DX12 backend takes it from the window instead.
+        /// </summary>
+        glm::uvec2 Size{};
     };
     enum class CommandHandle : u32
     {
@@ -39,7 +44,10 @@ namespace Neo
 
     struct RenderPassInfo
     {
-        std::vector<RenderTargetHandle> RenderTargets{};
+        /// <summary>
+        /// Only read by BeginRenderPass, so passes can point at handles they already have without allocating.
+        /// </summary>
+        std::span<const RenderTargetHandle> RenderTargets{};
         DepthStencilHandle DepthStencil = DepthStencilHandle::eNull;
 
         enum class LoadOp
@@ -69,6 +77,15 @@ namespace Neo
         CommandHandle CommandHandle = CommandHandle::eNull;
         RenderTargetHandle RenderTargetHandle = RenderTargetHandle::eNull;
         u64 FenceValue = 0;
+        // Recorded on worker threads, created on first use
+        std::vector<Neo::CommandHandle> SecondaryCommands{};
+    };
+
+    struct ResourceBarrier
+    {
+        ResourceHandle Resource = ResourceHandle::eNull;
+        ResourceState Before = ResourceState::eUndefined;
+        ResourceState After = ResourceState::eUndefined;
     };
 
     struct RenderTargetCreateInfo
@@ -0,0 +1,48 @@
+#pragma once
+#include "Render/BVH.hpp"
+
+namespace Neo
+{
+    class ECS;
+    class Resources;
+    struct Transform;
+
+    [[nodiscard]] glm::mat4 GetWorldMatrix(const Transform& transform);
+
+    /// <summary>
+    /// Keeps a BVH of the world boxes of every entity with a MeshRenderer, with the entity as the value. Changes
+    /// are picked up from the signals of the world, so only components changed through ECS::Add, ECS::Modify or
+    /// the registry itself are seen, and applied on the next Sync.
+    /// </summary>
+    class SceneBVH
+    {
+    public:
+        /// <summary>
+        /// Start listening to the world, which has to outlive the listening.
+        /// </summary>
+        void Attach(World& world);
+
+        /// <summary>
+        /// Insert, refit or remove the entities changed since the last Sync. Entities whose mesh is not loaded yet
+        /// are retried every Sync. Once more objects changed than half the tree holds, it is rebuilt.
+        /// </summary>
+        void Sync(const ECS& ecs, const Resources& resources);
+
+        /// <summary>
+        /// The entity whose box the ray enters first, or NullEntity.
+        /// </summary>
+        [[nodiscard]] Entity Raycast(glm::vec3 origin, glm::vec3 direction, float maxDistance) const;
+
+        [[nodiscard]] const BVH& GetBVH() const { return mBVH; }
+
+    private:
+        void OnChanged(World& world, Entity entity);
+        void OnDestroyed(World& world, Entity entity);
+
+        BVH mBVH;
+        std::unordered_map<Entity, BVHProxy> mProxies;
+        std::unordered_set<Entity> mDirty;
+        std::vector<Entity> mPending;
+        u32 mChanges = 0;
+    };
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include "Render/RenderContext.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Identifies an upload to check on. eNull is always complete.
+    /// </summary>
+    enum class UploadTicket : u64
+    {
+        eNull = 0,
+    };
+
+    /// <summary>
+    /// Uploads buffer data on the transfer queue without waiting for it. Data is copied into large mapped staging
+    /// pages right away, and Submit records the copies of all of them into one command, submits it and signals
+    /// the transfer fence, once per frame. Pages are reused once the fence shows the GPU is done with them, so
+    /// bulk loads stream through a fixed amount of staging memory while rendering goes on.
+    ///
+    /// Uploads complete in the order they were made. When every page is in flight the data is kept on the CPU and
+    /// written by a later Submit, so Upload never blocks. Destinations should not be in use on the graphics queue
+    /// until their upload is complete.
+    /// </summary>
+    class UploadQueue
+    {
+    public:
+        static constexpr u64 kDefaultPageSize = 16ull * 1024 * 1024;
+        static constexpr u32 kDefaultMaxPages = 8;
+
+        explicit UploadQueue(IRenderContext& context,
+                             u64 pageSize = kDefaultPageSize,
+                             u32 maxPages = kDefaultMaxPages);
+        /// <summary>
+        /// Releases the staging pages, the GPU has to be done with them.
+        /// </summary>
+        ~UploadQueue();
+
+        UploadQueue(const UploadQueue&) = delete;
+        UploadQueue& operator=(const UploadQueue&) = delete;
+
+        /// <summary>
+        /// Copy data to the destination buffer at an offset in bytes. The data is copied before this returns.
+        /// onComplete is called by Submit once the data is in the destination.
+        /// </summary>
+        UploadTicket Upload(BufferHandle destination,
+                            u64 destinationOffset,
+                            std::span<const std::byte> data,
+                            std::function<void()> onComplete = {});
+        /// <summary>
+        /// Call the callbacks of uploads that completed, then submit everything uploaded since the last call.
+        /// </summary>
+        void Submit();
+
+        /// <summary>
+        /// Whether the data of an upload is in its destination, as of the last Submit.
+        /// </summary>
+        [[nodiscard]] bool IsComplete(UploadTicket ticket) const { return ticket <= mCompleted; }
+        /// <summary>
+        /// Bytes uploaded that are not in their destination yet, including those waiting for a page.
+        /// </summary>
+        [[nodiscard]] u64 GetPendingBytes() const { return mPendingBytes; }
+        [[nodiscard]] u32 GetPageCount() const { return static_cast<u32>(mPages.size()); }
+        [[nodiscard]] u64 GetPageSize() const { return mPageSize; }
+
+    private:
+        struct Copy
+        {
+            BufferHandle Destination = BufferHandle::eNull;
+            u64 SourceOffset = 0;
+            u64 DestinationOffset = 0;
+            u64 Size = 0;
+        };
+
+        struct Page
+        {
+            BufferHandle Buffer = BufferHandle::eNull;
+            std::byte* Data = nullptr;
+            u64 Used = 0;
+            std::vector<Copy> Copies;
+        };
+
+        // Pages and the command submitted together, free again once the fence reaches FenceValue
+        struct Batch
+        {
+            u64 FenceValue = 0;
+            UploadTicket LastTicket = UploadTicket::eNull;
+            CommandHandle Command = CommandHandle::eNull;
+            std::vector<u32> Pages;
+            u64 Bytes = 0;
+        };
+
+        // An upload that did not fit the free pages, waiting with the rest of its data
+        struct Backlog
+        {
+            UploadTicket Ticket = UploadTicket::eNull;
+            BufferHandle Destination = BufferHandle::eNull;
+            u64 DestinationOffset = 0;
+            std::vector<std::byte> Data;
+        };
+
+        struct Callback
+        {
+            UploadTicket Ticket = UploadTicket::eNull;
+            std::function<void()> Function;
+        };
+
+        /// <summary>
+        /// Write as much of the data as the free pages hold and return how many bytes that was.
+        /// </summary>
+        u64 Write(BufferHandle destination, u64 destinationOffset, std::span<const std::byte> data);
+        /// <summary>
+        /// The page being filled, taking a free one or creating one when there is none. Null when every page is
+        /// in flight.
+        /// </summary>
+        Page* GetOpenPage();
+        /// <summary>
+        /// Free the pages of batches the transfer queue finished and call the callbacks that are due.
+        /// </summary>
+        void Retire();
+
+        IRenderContext& mContext;
+        u64 mPageSize;
+        u32 mMaxPages;
+
+        std::vector<Page> mPages;
+        std::vector<u32> mFreePages;
+        std::vector<u32> mFilledPages;
+        std::vector<CommandHandle> mFreeCommands;
+        std::deque<Batch> mBatches;
+        std::deque<Backlog> mBacklog;
+        std::deque<Callback> mCallbacks;
+
+        u64 mNextTicket = 1;
+        // Last upload whose data is all in a page
+        UploadTicket mWritten = UploadTicket::eNull;
+        UploadTicket mCompleted = UploadTicket::eNull;
+        u64 mPendingBytes = 0;
+        u64 mFilledBytes = 0;
+    };
+}
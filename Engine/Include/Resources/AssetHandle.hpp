@@ -0,0 +1,235 @@
+#pragma once
+#include "Core/Pool.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Typed handle to a resource owned by Resources. The low bits index a slot in the pool of that type and the
+    /// high bits hold the generation of the slot, so a handle to an unloaded resource is detected instead of
+    /// silently pointing at whatever was loaded into the slot afterwards.
+    /// </summary>
+    template <typename T>
+    class AssetHandle
+    {
+    public:
+        static constexpr u32 kIndexBits = PoolHandleLayout::kIndexBits;
+        static constexpr u32 kGenerationBits = PoolHandleLayout::kGenerationBits;
+        static constexpr u32 kIndexMask = PoolHandleLayout::kIndexMask;
+        static constexpr u32 kGenerationMask = PoolHandleLayout::kGenerationMask;
+        static constexpr u32 kNull = PoolHandleLayout::kNull;
+
+        constexpr AssetHandle() = default;
+
+        constexpr AssetHandle(const u32 index, const u32 generation)
+            : mValue((generation & kGenerationMask) << kIndexBits | (index & kIndexMask))
+        {
+        }
+
+        [[nodiscard]] constexpr u32 GetIndex() const { return mValue & kIndexMask; }
+        [[nodiscard]] constexpr u32 GetGeneration() const { return mValue >> kIndexBits; }
+        [[nodiscard]] constexpr u32 GetValue() const { return mValue; }
+        [[nodiscard]] constexpr bool IsNull() const { return mValue == kNull; }
+
+        constexpr bool operator==(const AssetHandle&) const = default;
+
+    private:
+        u32 mValue = kNull;
+    };
+
+    /// <summary>
+    /// Pool of one resource type, adding reference counts, lookup by AssetID and memory accounting on top of Pool.
+    /// A slot can be reserved before its resource has finished loading, Get returns nullptr until then.
+    /// </summary>
+    template <typename T>
+    class AssetPool
+    {
+    public:
+        using Handle = AssetHandle<T>;
+
+        /// <summary>
+        /// Take a slot for an asset that is still loading. The slot starts with one reference.
+        /// </summary>
+        Handle Reserve(const AssetID& id)
+        {
+            const auto handle = mEntries.Emplace();
+            if (handle.IsNull()) return {};
+
+            auto& entry = mEntries.At(handle);
+            entry.ID = id;
+            entry.RefCount = 1;
+            mLookup[id] = handle;
+            return handle;
+        }
+
+        /// <summary>
+        /// Store the loaded resource of a reserved slot. Size is what the resource counts against the memory budget.
+        /// </summary>
+        void Finish(const Handle handle, T&& value, const u64 size)
+        {
+            auto* entry = mEntries.Get(handle);
+            if (!entry) return;
+            entry->Item = std::move(value);
+            mLoadedSize += size - entry->Size;
+            entry->Size = size;
+            entry->Loaded = true;
+        }
+
+        Handle Add(const AssetID& id, T&& value, const u64 size = 0)
+        {
+            const auto handle = Reserve(id);
+            Finish(handle, std::move(value), size);
+            return handle;
+        }
+
+        [[nodiscard]] Handle Find(const AssetID& id) const
+        {
+            const auto it = mLookup.find(id);
+            return it != mLookup.end() ? it->second : Handle{};
+        }
+
+        [[nodiscard]] bool IsValid(const Handle handle) const { return mEntries.IsValid(handle); }
+
+        [[nodiscard]] bool IsLoaded(const Handle handle) const
+        {
+            const auto* entry = mEntries.Get(handle);
+            return entry && entry->Loaded;
+        }
+
+        [[nodiscard]] T* Get(const Handle handle)
+        {
+            auto* entry = mEntries.Get(handle);
+            return entry && entry->Loaded ? &entry->Item : nullptr;
+        }
+
+        [[nodiscard]] const T* Get(const Handle handle) const
+        {
+            const auto* entry = mEntries.Get(handle);
+            return entry && entry->Loaded ? &entry->Item : nullptr;
+        }
+
+        void AddRef(const Handle handle)
+        {
+            if (auto* entry = mEntries.Get(handle))
+            {
+                entry->RefCount++;
+            }
+        }
+
+        /// <summary>
+        /// Drop one reference and return how many are left. Unreferenced resources stay in the pool until removed.
+        /// </summary>
+        u32 Release(const Handle handle)
+        {
+            auto* entry = mEntries.Get(handle);
+            if (!entry) return 0;
+            if (entry->RefCount > 0)
+            {
+                entry->RefCount--;
+            }
+            return entry->RefCount;
+        }
+
+        /// <summary>
+        /// Remove a resource regardless of its references. It is moved out and returned so the caller can release
+        /// whatever it refers to.
+        /// </summary>
+        Opt<T> Remove(const Handle handle)
+        {
+            auto entry = mEntries.Remove(handle);
+            if (!entry) return std::nullopt;
+
+            mLookup.erase(entry->ID);
+            mLoadedSize -= entry->Size;
+            return std::move(entry->Item);
+        }
+
+        /// <summary>
+        /// Change what a loaded resource counts against the memory budget, for resources that shrink or grow.
+        /// </summary>
+        void SetSize(const Handle handle, const u64 size)
+        {
+            auto* entry = mEntries.Get(handle);
+            if (!entry || !entry->Loaded) return;
+            mLoadedSize += size - entry->Size;
+            entry->Size = size;
+        }
+
+        [[nodiscard]] AssetID GetID(const Handle handle) const
+        {
+            const auto* entry = mEntries.Get(handle);
+            return entry ? entry->ID : AssetID{};
+        }
+
+        void Touch(const Handle handle, const u64 frame)
+        {
+            if (auto* entry = mEntries.Get(handle))
+            {
+                entry->LastUsed = frame;
+            }
+        }
+
+        /// <summary>
+        /// Call func(handle, lastUsed, size) for every loaded resource without references.
+        /// </summary>
+        template <typename Func>
+        void ForEachUnreferenced(Func&& func) const
+        {
+            const auto entries = mEntries.GetItems();
+            for (size_t dense = 0; dense < entries.size(); dense++)
+            {
+                const auto& entry = entries[dense];
+                if (entry.Loaded && entry.RefCount == 0)
+                {
+                    func(mEntries.GetHandle(dense), entry.LastUsed, entry.Size);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Call func(handle, resource) for every loaded resource.
+        /// </summary>
+        template <typename Func>
+        void ForEachLoaded(Func&& func)
+        {
+            const auto entries = mEntries.GetItems();
+            for (size_t dense = 0; dense < entries.size(); dense++)
+            {
+                if (entries[dense].Loaded)
+                {
+                    func(mEntries.GetHandle(dense), entries[dense].Item);
+                }
+            }
+        }
+
+        [[nodiscard]] u32 GetRefCount(const Handle handle) const
+        {
+            const auto* entry = mEntries.Get(handle);
+            return entry ? entry->RefCount : 0;
+        }
+
+        [[nodiscard]] size_t GetSize() const { return mEntries.GetSize(); }
+        [[nodiscard]] u64 GetLoadedSize() const { return mLoadedSize; }
+
+        void Clear()
+        {
+            mEntries.Clear();
+            mLookup.clear();
+            mLoadedSize = 0;
+        }
+
+    private:
+        struct Entry
+        {
+            T Item{};
+            AssetID ID;
+            u32 RefCount = 0;
+            u64 LastUsed = 0;
+            u64 Size = 0;
+            bool Loaded = false;
+        };
+
+        Pool<Entry, Handle> mEntries;
+        std::unordered_map<AssetID, Handle> mLookup;
+        u64 mLoadedSize = 0;
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "Resources/Resource.hpp"
+
+namespace Neo
+{
+    enum class AssetType : u8
+    {
+        eTexture,
+        eMaterial,
+        eMesh,
+    };
+
+    /// <summary>
+    /// Mips of a texture that is already loaded, from FirstMip up to but not including EndMip.
+    /// </summary>
+    struct MipRange
+    {
+        u32 Width = 0;
+        u32 Height = 0;
+        u16 MipLevels = 1;
+        u16 FirstMip = 0;
+        u16 EndMip = 0;
+    };
+
+    /// <summary>
+    /// The pixels of a MipRange, read without the rest of the texture.
+    /// </summary>
+    struct TextureMipsDesc
+    {
+        u16 FirstMip = 0;
+        u16 EndMip = 0;
+        std::vector<u8> Pixels;
+    };
+
+    using StreamedAsset = std::variant<TextureDesc, MaterialDesc, MeshDesc, TextureMipsDesc>;
+
+    struct StreamResult
+    {
+        AssetID ID;
+        AssetType Type = AssetType::eTexture;
+        float Priority = 0.f;
+        /// <summary>
+        /// Empty if the asset could not be read.
+        /// </summary>
+        Opt<StreamedAsset> Asset;
+    };
+
+    /// <summary>
+    /// Reads and decodes cooked assets on worker threads. Requests with a higher priority are picked up first,
+    /// and finished loads are collected by the main thread with PopResult. Only the decoding happens here,
+    /// turning the result into a resource is left to Resources.
+    /// </summary>
+    class AssetStreamer
+    {
+    public:
+        explicit AssetStreamer(u32 workerCount = std::max(1u, std::thread::hardware_concurrency() / 2));
+        ~AssetStreamer();
+
+        AssetStreamer(const AssetStreamer&) = delete;
+        AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+        /// <summary>
+        /// Queue an asset. Requesting an asset that is still queued only raises its priority, and requesting one
+        /// that is being decoded does nothing, its result is on the way.
+        /// </summary>
+        void Request(const AssetID& id, AssetType type, std::string path, float priority);
+        /// <summary>
+        /// Queue reading only some mips of a loaded texture, decompressing just the blocks they are in. The result
+        /// is a TextureMipsDesc. Shares the queue with Request, so a texture is only ever read once at a time.
+        /// </summary>
+        void RequestMips(const AssetID& id, std::string path, const MipRange& mips, float priority);
+
+        /// <summary>
+        /// Take the oldest finished load. Returns false if there is none.
+        /// </summary>
+        bool PopResult(StreamResult& result);
+
+        /// <summary>
+        /// Number of assets that are queued or being decoded.
+        /// </summary>
+        [[nodiscard]] size_t GetPendingCount() const;
+
+    private:
+        struct StreamRequest
+        {
+            AssetID ID;
+            AssetType Type;
+            std::string Path;
+            float Priority;
+            u64 Sequence;
+            Opt<MipRange> Mips;
+
+            bool operator<(const StreamRequest& other) const
+            {
+                // Equal priorities are loaded in the order they were requested
+                return Priority != other.Priority ? Priority < other.Priority : Sequence > other.Sequence;
+            }
+        };
+
+        void Push(StreamRequest&& request);
+        void Work(const std::stop_token& stopToken);
+
+        mutable std::mutex mRequestMutex;
+        std::condition_variable_any mRequestCondition;
+        std::priority_queue<StreamRequest> mRequests;
+        std::unordered_map<AssetID, float> mPending;
+        u64 mSequence = 0;
+        std::unordered_set<AssetID> mInFlight;
+
+        std::mutex mResultMutex;
+        std::deque<StreamResult> mResults;
+
+        std::vector<std::jthread> mWorkers;
+    };
+}
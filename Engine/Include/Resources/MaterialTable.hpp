@@ -0,0 +1,47 @@
+#pragma once
+#include "Resources/Resource.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Packed array of the MaterialParams of every loaded material, ready to be copied into a GPU buffer as is.
+    /// Materials with identical parameters share one entry, so draws can be grouped by the index alone.
+    /// Entries are reference counted and their slots reused once released.
+    /// </summary>
+    class MaterialTable
+    {
+    public:
+        /// <summary>
+        /// Get the index of an entry with these parameters, adding it if there is none yet.
+        /// </summary>
+        u32 Add(const MaterialParams& params);
+        void Release(u32 index);
+        void Clear();
+
+        [[nodiscard]] const MaterialParams& Get(const u32 index) const { return mParams[index]; }
+
+        /// <summary>
+        /// Every slot, including released ones, so indices can be used to address the buffer directly.
+        /// </summary>
+        [[nodiscard]] std::span<const MaterialParams> GetParams() const { return mParams; }
+
+        [[nodiscard]] size_t GetCount() const { return mParams.size() - mFreeSlots.size(); }
+
+        /// <summary>
+        /// Changes whenever an entry is added or released, to know when the GPU copy is out of date.
+        /// </summary>
+        [[nodiscard]] u64 GetVersion() const { return mVersion; }
+
+    private:
+        struct ParamsHash
+        {
+            size_t operator()(const MaterialParams& params) const { return HashBytes(&params, sizeof(params)); }
+        };
+
+        std::vector<MaterialParams> mParams;
+        std::vector<u32> mRefCounts;
+        std::vector<u32> mFreeSlots;
+        std::unordered_map<MaterialParams, u32, ParamsHash> mLookup;
+        u64 mVersion = 0;
+    };
+}
@@ -1,6 +1,11 @@
 #pragma once
+#include "Render/Bounds.hpp"
 #include "Render/RenderComponents.hpp"
 #include "Render/RenderEnums.hpp"
+#include "Render/RenderStructs.hpp"
+#include "Render/UploadQueue.hpp"
+#include "Tools/AssetFile.hpp"
+#include "Resources/AssetHandle.hpp"
 
 namespace Neo
 {
@@ -27,6 +32,7 @@ namespace Neo
         uint16_t ArraySize = 1;
         uint16_t MipLevels = 1;
         Format Format = Format::eR8G8B8A8_UNORM;
+        // Has to stay the last member, mips are streamed in by reading the end of the cooked payload
         std::vector<uint8_t> Pixels;
     };
     
@@ -38,10 +44,41 @@ namespace Neo
         uint32_t Height;
         uint16_t ArraySize = 1;
         uint16_t MipLevels = 1;
+        // Most detailed mip that is loaded, Pixels holds the mips from here down to the smallest one
+        uint16_t ResidentMip = 0;
         Format Format = Format::eR8G8B8A8_UNORM;
         std::vector<uint8_t> Pixels;
+        // Copy on the GPU, made when Resources has a render context
+        TextureHandle GPUTexture = TextureHandle::eNull;
     };
 
+    /// <summary>
+    /// Texture slot of a material without the texture, or whose texture has no GPU copy yet.
+    /// </summary>
+    inline constexpr u32 kNoTextureDescriptor = std::numeric_limits<u32>::max();
+
+    /// <summary>
+    /// Material constants laid out the way shaders read them, 64 bytes per material with no padding.
+    /// Texture slots hold the bindless descriptor index of the GPU copy of the texture, or kNoTextureDescriptor.
+    /// </summary>
+    struct alignas(16) MaterialParams
+    {
+        glm::vec4 BaseColorFactor{1.f};
+        glm::vec3 EmissiveFactor{0.f};
+        float NormalFactor = 1.f;
+        float OcclusionFactor = 1.f;
+        float MetallicFactor = 1.f;
+        float RoughnessFactor = 1.f;
+        u32 BaseColorTexture = kNoTextureDescriptor;
+        u32 NormalTexture = kNoTextureDescriptor;
+        u32 MetallicRoughnessTexture = kNoTextureDescriptor;
+        u32 OcclusionTexture = kNoTextureDescriptor;
+        u32 EmissiveTexture = kNoTextureDescriptor;
+
+        bool operator==(const MaterialParams&) const = default;
+    };
+    static_assert(sizeof(MaterialParams) == 64, "MaterialParams has to match the shader layout");
+
     struct MaterialDesc
     {
         std::string Name;
@@ -52,36 +89,35 @@ namespace Neo
         Opt<AssetID> OcclusionTextureID;
         Opt<AssetID> EmissiveTextureID;
 
-        glm::vec4 BaseColorFactor;
-        glm::vec3 EmissiveFactor;
-        float NormalFactor;
-        float OcclusionFactor;
-        float MetallicFactor;
-        float RoughnessFactor;
+        // Texture slots are filled in by Resources once the textures are loaded
+        MaterialParams Params;
     };
     
     struct Material : IResource
     {
         AssetID ID;
-        Ref<Texture> BaseColorTexture;
-        Ref<Texture> NormalTexture;
-        Ref<Texture> MetallicRoughnessTexture;
-        Ref<Texture> OcclusionTexture;
-        Ref<Texture> EmissiveTexture;
+        AssetHandle<Texture> BaseColorTexture;
+        AssetHandle<Texture> NormalTexture;
+        AssetHandle<Texture> MetallicRoughnessTexture;
+        AssetHandle<Texture> OcclusionTexture;
+        AssetHandle<Texture> EmissiveTexture;
 
-        glm::vec4 BaseColorFactor;
-        glm::vec3 EmissiveFactor;
-        float NormalFactor;
-        float OcclusionFactor;
-        float MetallicFactor;
-        float RoughnessFactor;
+        /// <summary>
+        /// Index of the parameters in the MaterialTable of Resources, shared by every material with the same ones.
+        /// </summary>
+        u32 ParamsIndex = 0;
     };
 
     struct Primitive
     {
         std::vector<u32> Indices;
         std::vector<Vertex> Vertices;
-        Ref<Material> Material;
+        AssetHandle<Material> Material;
+        Bounds Bounds;
+        // Copies on the GPU, made when Resources has an upload queue, usable once Upload is complete
+        BufferHandle VertexBuffer = BufferHandle::eNull;
+        BufferHandle IndexBuffer = BufferHandle::eNull;
+        UploadTicket Upload = UploadTicket::eNull;
     };
     
     struct Mesh : IResource
@@ -94,6 +130,8 @@ namespace Neo
         std::vector<u32> Indices;
         std::vector<Vertex> Vertices;
         Opt<AssetID> MaterialID;
+        // Computed by the Importer from the vertices
+        Bounds Bounds;
     };
     
     struct MeshDesc
@@ -114,4 +152,48 @@ namespace Neo
         std::vector<NodeDesc> Nodes;
         std::vector<uint64_t> RootNodes;
     };
+
+    /// <summary>
+    /// Maps the AssetID of every cooked asset to the file it was written to. Written next to the cooked files
+    /// by the Importer and loaded by Resources to find assets on demand.
+    /// </summary>
+    struct AssetRegistry
+    {
+        std::unordered_map<std::string, std::string> Paths;
+        /// <summary>
+        /// Type hash each asset was cooked as, by AssetID like the paths.
+        /// </summary>
+        std::unordered_map<std::string, u32> Types;
+        /// <summary>
+        /// Source files imported into the folder, with their modification time at the time of the import.
+        /// </summary>
+        std::unordered_map<std::string, u64> Sources;
+    };
+
+    inline constexpr std::string_view kAssetRegistryName = "AssetRegistry.json";
+
+    // Raw pixels compress very well, so they are worth the slower codec
+    template <>
+    struct AssetTraits<TextureDesc>
+    {
+        static constexpr std::string_view Name = "TextureDesc";
+        static constexpr u32 Version = 1;
+        static constexpr Compression Compression = Compression::eZstd;
+    };
+
+    template <>
+    struct AssetTraits<MaterialDesc>
+    {
+        static constexpr std::string_view Name = "MaterialDesc";
+        static constexpr u32 Version = 2;
+        static constexpr Compression Compression = Compression::eNone;
+    };
+
+    template <>
+    struct AssetTraits<MeshDesc>
+    {
+        static constexpr std::string_view Name = "MeshDesc";
+        static constexpr u32 Version = 2;
+        static constexpr Compression Compression = Compression::eLZ4;
+    };
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+namespace Neo
+{
+    // Textures are imported as RGBA8
+    inline constexpr u32 kTextureBytesPerPixel = 4;
+
+    [[nodiscard]] inline u16 GetMipCount(const u32 width, const u32 height)
+    {
+        return static_cast<u16>(std::bit_width(std::max({width, height, 1u})));
+    }
+
+    [[nodiscard]] inline u32 GetMipExtent(const u32 extent, const u16 mip)
+    {
+        return std::max(extent >> mip, 1u);
+    }
+
+    [[nodiscard]] inline u64 GetMipSize(const u32 width, const u32 height, const u16 mip,
+                                        const u32 bytesPerPixel = kTextureBytesPerPixel)
+    {
+        return static_cast<u64>(GetMipExtent(width, mip)) * GetMipExtent(height, mip) * bytesPerPixel;
+    }
+
+    /// <summary>
+    /// Byte offset of a mip in a chain stored from the largest mip to the smallest one.
+    /// </summary>
+    [[nodiscard]] inline u64 GetMipOffset(const u32 width, const u32 height, const u16 mip,
+                                          const u32 bytesPerPixel = kTextureBytesPerPixel)
+    {
+        u64 offset = 0;
+        for (u16 level = 0; level < mip; level++)
+        {
+            offset += GetMipSize(width, height, level, bytesPerPixel);
+        }
+        return offset;
+    }
+
+    /// <summary>
+    /// Size of the mips from firstMip down to the smallest one.
+    /// </summary>
+    [[nodiscard]] inline u64 GetMipChainSize(const u32 width, const u32 height, const u16 mipLevels, const u16 firstMip,
+                                             const u32 bytesPerPixel = kTextureBytesPerPixel)
+    {
+        u64 size = 0;
+        for (u16 level = firstMip; level < mipLevels; level++)
+        {
+            size += GetMipSize(width, height, level, bytesPerPixel);
+        }
+        return size;
+    }
+
+    /// <summary>
+    /// Build the full mip chain of an RGBA8 image with a box filter. The result starts with the image itself.
+    /// </summary>
+    [[nodiscard]] std::vector<u8> GenerateMips(std::span<const u8> pixels, u32 width, u32 height);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "Resources/Resource.hpp"
+
+namespace Neo
+{
+    inline constexpr u64 kDefaultTextureBudget = 512ull * 1024 * 1024;
+
+    struct MipRequest
+    {
+        AssetHandle<Texture> Texture;
+        /// <summary>
+        /// The most detailed mip that should be resident.
+        /// </summary>
+        u16 Mip = 0;
+        /// <summary>
+        /// Largest screen size the texture was used at, bigger textures on screen should stream in first.
+        /// </summary>
+        float ScreenSize = 0.f;
+    };
+
+    /// <summary>
+    /// Decides which mips of every texture should be resident. Users report the screen size of what they draw
+    /// with a texture each frame, Update turns that into the mip each texture needs, lowers detail where needed
+    /// to stay within the texture budget, and lists the textures that should drop or stream in mips.
+    /// It only does the bookkeeping, so it can be driven without a GPU or any loaded pixels.
+    /// </summary>
+    class TextureResidency
+    {
+    public:
+        void Register(AssetHandle<Texture> texture, u32 width, u32 height, u16 mipLevels, u16 residentMip = 0);
+        void Unregister(AssetHandle<Texture> texture);
+        void Clear();
+
+        /// <summary>
+        /// Report that the texture is drawn covering screenSize pixels along its longest side this frame.
+        /// </summary>
+        void ReportUsage(AssetHandle<Texture> texture, float screenSize);
+
+        /// <summary>
+        /// Work out the target mip of every texture from the usage reported since the last call.
+        /// Textures that should drop mips are dropped right away and listed in evict, textures that need more
+        /// detail are listed in streamIn, most visible first, and stay at their resident mip until OnMipsLoaded.
+        /// A texture is listed in streamIn once, and not again until OnMipsLoaded is called for it. Textures that
+        /// were registered since the last call and have no usage yet keep what they have for a frame.
+        /// </summary>
+        void Update(std::vector<MipRequest>& streamIn, std::vector<MipRequest>& evict);
+
+        /// <summary>
+        /// Mips down to the given one have been loaded for the texture. Pass the resident mip when the load
+        /// failed or brought nothing new, so the texture can be listed in streamIn again.
+        /// </summary>
+        void OnMipsLoaded(AssetHandle<Texture> texture, u16 mip);
+
+        [[nodiscard]] u16 GetResidentMip(AssetHandle<Texture> texture) const;
+        [[nodiscard]] u16 GetTargetMip(AssetHandle<Texture> texture) const;
+        [[nodiscard]] u64 GetResidentSize() const { return mResidentSize; }
+
+        void SetBudget(const u64 bytes) { mBudget = bytes; }
+        [[nodiscard]] u64 GetBudget() const { return mBudget; }
+
+        /// <summary>
+        /// The least detailed mip that still has at least one texel per pixel at the given screen size.
+        /// </summary>
+        [[nodiscard]] static u16 ComputeRequiredMip(u32 width, u32 height, u16 mipLevels, float screenSize);
+
+        /// <summary>
+        /// Approximate screen size in pixels of a sphere of the given radius, seen from distance with a vertical
+        /// field of view in radians on a viewport of viewportHeight pixels.
+        /// </summary>
+        [[nodiscard]] static float EstimateScreenSize(float radius, float distance, float fovY, float viewportHeight);
+
+    private:
+        struct Entry
+        {
+            AssetHandle<Texture> Texture;
+            u32 Width = 0;
+            u32 Height = 0;
+            u16 MipLevels = 1;
+            u16 ResidentMip = 0;
+            u16 TargetMip = 0;
+            float ScreenSize = 0.f;
+            // Listed in streamIn, waiting for OnMipsLoaded
+            bool Requested = false;
+            // Registered since the last Update
+            bool Fresh = true;
+        };
+
+        Entry* Find(AssetHandle<Texture> texture);
+        const Entry* Find(AssetHandle<Texture> texture) const;
+
+        std::vector<Entry> mEntries;
+        u64 mBudget = kDefaultTextureBudget;
+        u64 mResidentSize = 0;
+    };
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "Tools/Compression.hpp"
+
+namespace Neo
+{
+    /// <summary>
+    /// Per asset type settings used by the BinarySerializer.
+    /// Specialize it next to the asset type to change them. Bump the Version whenever the layout changes,
+    /// and register an upgrade with the AssetUpgrader if older files should keep loading.
+    /// </summary>
+    template <typename T>
+    struct AssetTraits
+    {
+        static constexpr std::string_view Name = entt::type_name<T>::value();
+        static constexpr u32 Version = 1;
+        static constexpr Compression Compression = Compression::eNone;
+    };
+
+    template <typename T>
+    constexpr u32 GetAssetTypeHash()
+    {
+        return entt::hashed_string::value(AssetTraits<T>::Name.data(), AssetTraits<T>::Name.size());
+    }
+
+    inline constexpr u32 kAssetMagic = 0x4153454E; // NEOA
+
+    /// <summary>
+    /// Fixed size header at the start of every cooked asset file. It can be checked without touching the payload.
+    /// </summary>
+    struct AssetHeader
+    {
+        u32 Magic = kAssetMagic;
+        u32 TypeHash = 0;
+        u32 SchemaVersion = 0;
+        u32 Reserved = 0;
+        u64 PayloadSize = 0;
+        u64 Checksum = 0;
+    };
+    static_assert(sizeof(AssetHeader) == 32);
+
+    class AssetUpgrader
+    {
+    public:
+        /// <summary>
+        /// Rewrites a decompressed payload from one schema version to the next one. Returns false on failure.
+        /// </summary>
+        using Function = std::function<bool(std::vector<char>& payload)>;
+
+        static void Register(u32 typeHash, u32 fromVersion, Function function);
+
+        /// <summary>
+        /// Register an upgrade from the layout TOld at fromVersion to T at fromVersion + 1.
+        /// </summary>
+        template <typename T, typename TOld, typename Func>
+        static void Register(const u32 fromVersion, Func&& convert)
+        {
+            Register(GetAssetTypeHash<T>(), fromVersion,
+                     [convert = std::forward<Func>(convert)](std::vector<char>& payload)
+                     {
+                         TOld oldValue{};
+                         if (glz::read_beve(oldValue, payload).ec != glz::error_code::none) return false;
+                         T newValue{};
+                         convert(oldValue, newValue);
+                         std::string buffer;
+                         if (glz::write_beve(newValue, buffer).ec != glz::error_code::none) return false;
+                         payload.assign(buffer.begin(), buffer.end());
+                         return true;
+                     });
+        }
+
+        [[nodiscard]] static bool CanUpgrade(u32 typeHash, u32 fromVersion, u32 toVersion);
+        [[nodiscard]] static bool Upgrade(u32 typeHash, u32 fromVersion, u32 toVersion, std::vector<char>& payload);
+    };
+
+    namespace AssetFile
+    {
+        enum class Error
+        {
+            eFileNotFound,
+            eInvalidHeader,
+            eTypeMismatch,
+            eUnsupportedVersion,
+            eChecksumMismatch,
+            eCorruptPayload,
+            eUpgradeFailed,
+        };
+
+        [[nodiscard]] bool Write(std::string_view path,
+                                 u32 typeHash,
+                                 u32 version,
+                                 Compression compression,
+                                 std::span<const char> payload);
+
+        /// <summary>
+        /// Read only the header and check that the file can be loaded as the given type and version,
+        /// either directly or through registered upgrades.
+        /// </summary>
+        [[nodiscard]] Exp<AssetHeader, Error> Validate(std::string_view path, u32 typeHash, u32 version);
+
+        /// <summary>
+        /// Read, verify and decompress the payload, upgrading it to the given version if needed.
+        /// </summary>
+        [[nodiscard]] Exp<std::vector<char>, Error> Read(std::string_view path, u32 typeHash, u32 version);
+
+        /// <summary>
+        /// Read size bytes of the payload, starting endOffset bytes before its end, decompressing only the
+        /// blocks they are in. Upgrades work on whole payloads, so the file has to be at the given version.
+        /// </summary>
+        [[nodiscard]] Exp<std::vector<char>, Error> ReadTail(std::string_view path,
+                                                             u32 typeHash,
+                                                             u32 version,
+                                                             u64 endOffset,
+                                                             u64 size);
+    }
+}
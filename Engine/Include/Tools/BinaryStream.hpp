@@ -0,0 +1,242 @@
+#pragma once
+
+namespace Neo
+{
+    /// <summary>
+    /// Whether every byte of a T belongs to its value, so writing its bytes gives the same output for equal values.
+    /// has_unique_object_representations is false for floats, which still have no padding, and so for the glm
+    /// types built from them.
+    /// </summary>
+    template <typename T>
+    struct IsPacked : std::bool_constant<std::has_unique_object_representations_v<T> || std::is_floating_point_v<T>>
+    {
+    };
+
+    template <glm::length_t L, typename T, glm::qualifier Q>
+    struct IsPacked<glm::vec<L, T, Q>>
+        : std::bool_constant<IsPacked<T>::value && sizeof(glm::vec<L, T, Q>) == L * sizeof(T)>
+    {
+    };
+
+    template <glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+    struct IsPacked<glm::mat<C, R, T, Q>>
+        : std::bool_constant<IsPacked<T>::value && sizeof(glm::mat<C, R, T, Q>) == C * R * sizeof(T)>
+    {
+    };
+
+    template <typename T, glm::qualifier Q>
+    struct IsPacked<glm::qua<T, Q>> : std::bool_constant<IsPacked<T>::value && sizeof(glm::qua<T, Q>) == 4 * sizeof(T)>
+    {
+    };
+
+    /// <summary>
+    /// Values that are copied as raw bytes. Anything else goes through its Serialize/Deserialize overloads.
+    /// </summary>
+    template <typename T>
+    inline constexpr bool kIsRawCopyable = std::is_trivially_copyable_v<T> && IsPacked<T>::value;
+
+    template <typename>
+    struct MemberType;
+
+    template <typename T, typename TClass>
+    struct MemberType<T TClass::*>
+    {
+        using Type = T;
+    };
+
+    /// <summary>
+    /// The bytes of members declared next to each other, or an empty span if they cannot be copied as one
+    /// because a member has padding or there is padding between them.
+    /// </summary>
+    template <auto... Members, typename T>
+    std::span<const char> GetRunBytes(const T& value)
+    {
+        if constexpr ((kIsRawCopyable<typename MemberType<decltype(Members)>::Type> && ...))
+        {
+            const std::array addresses{reinterpret_cast<const char*>(&(value.*Members))...};
+            constexpr std::array sizes{sizeof(typename MemberType<decltype(Members)>::Type)...};
+            const auto size = static_cast<size_t>(addresses.back() + sizes.back() - addresses.front());
+            if (size == (sizeof(typename MemberType<decltype(Members)>::Type) + ...))
+            {
+                return {addresses.front(), size};
+            }
+        }
+        return {};
+    }
+
+    /// <summary>
+    /// Appends values to a byte buffer. Values without padding bytes are copied as is, strings and vectors are
+    /// length prefixed, and anything else goes through a Serialize(BinaryWriter&, const T&) overload,
+    /// which PreBuildTool generates for every struct with [[Serialize]] fields.
+    /// </summary>
+    class BinaryWriter
+    {
+    public:
+        explicit BinaryWriter(std::vector<char>& buffer) : mBuffer(buffer)
+        {
+        }
+
+        void WriteBytes(const void* data, const size_t size)
+        {
+            const auto* bytes = static_cast<const char*>(data);
+            mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+        }
+
+        template <typename T>
+        void Write(const T& value)
+        {
+            if constexpr (kIsRawCopyable<T>)
+            {
+                WriteBytes(&value, sizeof(T));
+            }
+            else
+            {
+                Serialize(*this, value);
+            }
+        }
+
+        void Write(const std::string& value)
+        {
+            Write(static_cast<u32>(value.size()));
+            WriteBytes(value.data(), value.size());
+        }
+
+        template <typename T>
+        void Write(const std::vector<T>& values)
+        {
+            Write(static_cast<u32>(values.size()));
+            if constexpr (kIsRawCopyable<T>)
+            {
+                WriteBytes(values.data(), values.size() * sizeof(T));
+            }
+            else
+            {
+                for (const auto& value : values)
+                {
+                    Write(value);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Write members declared next to each other, in one copy when none of them has padding bytes, and
+        /// there are none between them. Otherwise they are written one at a time.
+        /// </summary>
+        template <auto... Members, typename T>
+        void WriteRun(const T& value)
+        {
+            if (const auto bytes = GetRunBytes<Members...>(value); !bytes.empty())
+            {
+                WriteBytes(bytes.data(), bytes.size());
+                return;
+            }
+            (Write(value.*Members), ...);
+        }
+
+        [[nodiscard]] size_t GetSize() const { return mBuffer.size(); }
+
+    private:
+        std::vector<char>& mBuffer;
+    };
+
+    /// <summary>
+    /// Reads values written by the BinaryWriter. Reading past the end of the data sets the failed flag
+    /// and leaves the remaining values untouched.
+    /// </summary>
+    class BinaryReader
+    {
+    public:
+        explicit BinaryReader(const std::span<const char> data) : mData(data)
+        {
+        }
+
+        bool ReadBytes(void* data, const size_t size)
+        {
+            if (mFailed || mOffset + size > mData.size())
+            {
+                mFailed = true;
+                return false;
+            }
+            std::memcpy(data, mData.data() + mOffset, size);
+            mOffset += size;
+            return true;
+        }
+
+        template <typename T>
+        bool Read(T& value)
+        {
+            if constexpr (kIsRawCopyable<T>)
+            {
+                return ReadBytes(&value, sizeof(T));
+            }
+            else
+            {
+                Deserialize(*this, value);
+                return !mFailed;
+            }
+        }
+
+        bool Read(std::string& value)
+        {
+            u32 size = 0;
+            if (!Read(size) || size > mData.size() - mOffset)
+            {
+                mFailed = true;
+                return false;
+            }
+            value.assign(mData.data() + mOffset, size);
+            mOffset += size;
+            return true;
+        }
+
+        template <typename T>
+        bool Read(std::vector<T>& values)
+        {
+            u32 count = 0;
+            if (!Read(count)) return false;
+            if constexpr (kIsRawCopyable<T>)
+            {
+                if (static_cast<size_t>(count) * sizeof(T) > mData.size() - mOffset)
+                {
+                    mFailed = true;
+                    return false;
+                }
+                values.resize(count);
+                return ReadBytes(values.data(), values.size() * sizeof(T));
+            }
+            else
+            {
+                // Every element takes at least a byte, so a count above the bytes left can only come from bad data
+                if (count > mData.size() - mOffset)
+                {
+                    mFailed = true;
+                    return false;
+                }
+                values.resize(count);
+                for (auto& value : values)
+                {
+                    if (!Read(value)) return false;
+                }
+                return true;
+            }
+        }
+
+        template <auto... Members, typename T>
+        bool ReadRun(T& value)
+        {
+            if (const auto bytes = GetRunBytes<Members...>(std::as_const(value)); !bytes.empty())
+            {
+                return ReadBytes(const_cast<char*>(bytes.data()), bytes.size());
+            }
+            return (Read(value.*Members) && ...);
+        }
+
+        [[nodiscard]] bool Failed() const { return mFailed; }
+        [[nodiscard]] bool IsAtEnd() const { return mOffset == mData.size(); }
+
+    private:
+        std::span<const char> mData;
+        size_t mOffset = 0;
+        bool mFailed = false;
+    };
+}
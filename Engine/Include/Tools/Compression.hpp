@@ -0,0 +1,151 @@
+#pragma once
+
+namespace Neo
+{
+    enum class Compression : u8
+    {
+        eNone,
+        eLZ4,
+        eZstd,
+    };
+
+    inline constexpr u32 kCompressionBlockSize = 256 * 1024;
+    /// <summary>
+    /// Limits on what a stream may claim to decompress to, so a corrupt or hostile file cannot make the reader
+    /// allocate more than this before any block is checked.
+    /// </summary>
+    inline constexpr u32 kMaxCompressionBlockSize = 64 * 1024 * 1024;
+    inline constexpr u64 kMaxDecompressedSize = 1ull * 1024 * 1024 * 1024;
+    inline constexpr int kZstdLevel = 3;
+
+    namespace Compressor
+    {
+        enum class Error
+        {
+            eInvalidStream,
+            eChecksumMismatch,
+            eCodecError,
+        };
+
+        /// <summary>
+        /// Where a block's stored bytes are in a compressed stream, and where its data is once decompressed.
+        /// </summary>
+        struct Block
+        {
+            u64 Source = 0;
+            u64 Destination = 0;
+            u32 StoredSize = 0;
+            u32 RawSize = 0;
+            u64 Checksum = 0;
+        };
+
+        [[nodiscard]] u64 Checksum(std::span<const char> data);
+
+        /// <summary>
+        /// Returns an empty vector if the block size is zero or above kMaxCompressionBlockSize.
+        /// </summary>
+        [[nodiscard]] std::vector<char> Compress(std::span<const char> data,
+                                                 Compression compression,
+                                                 u32 blockSize = kCompressionBlockSize);
+
+        /// <summary>
+        /// Decompress a whole stream that is already in memory. Blocks are decompressed in parallel.
+        /// </summary>
+        [[nodiscard]] Exp<std::vector<char>, Error> Decompress(std::span<const char> data);
+    }
+
+    /// <summary>
+    /// Writes data to a stream as a sequence of independently compressed, checksummed blocks, followed by a table
+    /// of the blocks that lets readers seek straight to any part of the data.
+    /// </summary>
+    class CompressedWriter
+    {
+    public:
+        CompressedWriter(std::ostream& stream, Compression compression, u32 blockSize = kCompressionBlockSize);
+        ~CompressedWriter();
+
+        CompressedWriter(const CompressedWriter&) = delete;
+        CompressedWriter& operator=(const CompressedWriter&) = delete;
+
+        /// <summary>
+        /// Whole blocks are compressed in parallel and written right away, the rest waits for the next write.
+        /// </summary>
+        void Write(std::span<const char> data);
+
+        /// <summary>
+        /// Flush the last partial block and write the end marker and the block table.
+        /// Returns true if every block was written successfully.
+        /// </summary>
+        bool Finish();
+
+        /// <summary>
+        /// Size and checksum of everything written to the stream so far, stream header and block table included.
+        /// </summary>
+        [[nodiscard]] u64 GetSize() const { return mSize; }
+        [[nodiscard]] u64 GetChecksum() const;
+
+    private:
+        void WriteBlocks(std::span<const char> data);
+        void WriteBytes(const void* data, size_t size);
+
+        std::ostream& mStream;
+        Compression mCompression;
+        u32 mBlockSize;
+        std::vector<char> mBlock;
+        std::vector<std::vector<char>> mScratch;
+        std::vector<char> mTable;
+        void* mChecksumState = nullptr;
+        u64 mSize = 0;
+        bool mFinished = false;
+        bool mFailed = false;
+    };
+
+    /// <summary>
+    /// Reads a stream written by the CompressedWriter, either one block after the other or by seeking to the blocks
+    /// a range of the data is in.
+    /// </summary>
+    class CompressedReader
+    {
+    public:
+        /// <summary>
+        /// The compressed stream starts at the current position of the stream. Seeking needs it to end where the
+        /// stream does.
+        /// </summary>
+        explicit CompressedReader(std::istream& stream);
+
+        /// <summary>
+        /// Read up to data.size() bytes. Returns the number of bytes read, which is smaller than requested
+        /// only at the end of the stream or if the stream is corrupted.
+        /// </summary>
+        size_t Read(std::span<char> data);
+
+        /// <summary>
+        /// Size of the decompressed stream, from the block table alone.
+        /// </summary>
+        [[nodiscard]] Exp<u64, Compressor::Error> GetSize();
+
+        /// <summary>
+        /// Read size bytes at offset in the decompressed stream. Only the blocks they are in are read, in one go,
+        /// and decompressed in parallel. Read carries on where it was afterwards.
+        /// </summary>
+        [[nodiscard]] Exp<std::vector<char>, Compressor::Error> ReadRange(u64 offset, u64 size);
+
+        [[nodiscard]] bool Failed() const { return mFailed; }
+
+    private:
+        bool ReadBlock();
+        Opt<Compressor::Error> ReadTable();
+
+        std::istream& mStream;
+        std::streampos mStart;
+        Compression mCompression = Compression::eNone;
+        u32 mBlockSize = 0;
+        std::vector<char> mBlock;
+        std::vector<char> mScratch;
+        std::vector<Compressor::Block> mTable;
+        size_t mBlockOffset = 0;
+        bool mTableRead = false;
+        bool mFinished = false;
+        bool mFailed = false;
+    };
+}
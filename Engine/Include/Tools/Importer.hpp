@@ -17,9 +17,15 @@ namespace Neo
             eNoTexCoords,
             eNoNormals,
             eNoImage,
+            eWriteFailed,
         };
 
         static Exp<void, Error> ImportGLTF(std::string_view inPath, std::string_view outPath);
+        /// <summary>
+        /// Whether the cooked assets in outPath are current for the source file: it has not changed since it was
+        /// imported, and every cooked file has a header that the current asset versions can load.
+        /// </summary>
+        static bool IsImported(std::string_view inPath, std::string_view outPath);
 
     private:
         static Exp<std::vector<MeshDesc>, Error> ImportMeshes(const fastgltf::Asset& asset, std::span<const MaterialDesc> materials, std::string_view outPath);
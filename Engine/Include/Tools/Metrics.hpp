@@ -0,0 +1,83 @@
+#pragma once
+
+namespace Neo
+{
+    enum class MetricType : u8
+    {
+        /// <summary>
+        /// Summed over a frame, like draw calls or uploaded bytes.
+        /// </summary>
+        eCounter,
+        /// <summary>
+        /// A level that persists between frames, like the number of live entities.
+        /// </summary>
+        eGauge,
+    };
+
+    struct MetricSample
+    {
+        std::string_view Name;
+        MetricType Type = MetricType::eCounter;
+        /// <summary>
+        /// Counters: the total of the last finished frame. Gauges: the value when that frame ended.
+        /// </summary>
+        i64 Value = 0;
+        /// <summary>
+        /// Counters: the total since startup. Gauges: the highest value seen.
+        /// </summary>
+        i64 Total = 0;
+    };
+
+    /// <summary>
+    /// Registry of named counters and gauges. Counters are spread over per thread shards of atomics so hot
+    /// paths on different threads never contend, and are summed into samples once per frame. Samples can be
+    /// read from code, the editor or a benchmark without the editor running.
+    /// </summary>
+    class Metrics
+    {
+    public:
+        static constexpr u32 kMaxMetrics = 256;
+        static constexpr u32 kShardCount = 16;
+
+        /// <summary>
+        /// Registering a name again returns the id it already has.
+        /// </summary>
+        [[nodiscard]] static u32 Register(std::string_view name, MetricType type);
+
+        static void Add(u32 id, i64 value);
+        static void Set(u32 id, i64 value);
+
+        /// <summary>
+        /// Sum the shards into the samples of the frame that just ended. Called by the engine at the start of
+        /// every frame.
+        /// </summary>
+        static void BeginFrame();
+
+        /// <summary>
+        /// Samples of every registered metric, in registration order.
+        /// </summary>
+        [[nodiscard]] static std::span<const MetricSample> GetSamples();
+        [[nodiscard]] static Opt<MetricSample> Find(std::string_view name);
+    };
+
+    class Counter
+    {
+    public:
+        explicit Counter(const std::string_view name) : mID(Metrics::Register(name, MetricType::eCounter)) {}
+        void Add(const i64 value = 1) const { Metrics::Add(mID, value); }
+
+    private:
+        u32 mID;
+    };
+
+    class Gauge
+    {
+    public:
+        explicit Gauge(const std::string_view name) : mID(Metrics::Register(name, MetricType::eGauge)) {}
+        void Set(const i64 value) const { Metrics::Set(mID, value); }
+        void Add(const i64 value) const { Metrics::Add(mID, value); }
+
+    private:
+        u32 mID;
+    };
+}
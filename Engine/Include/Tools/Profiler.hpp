@@ -0,0 +1,107 @@
+#pragma once
+
+// Zones compile to nothing unless the engine is configured WITH_PROFILER
+#ifdef NEO_PROFILER
+#define NEO_PROFILE_CONCAT_INNER(a, b) a##b
+#define NEO_PROFILE_CONCAT(a, b) NEO_PROFILE_CONCAT_INNER(a, b)
+/// Time the rest of the enclosing scope. The name must outlive the profiler, like a literal or an interned name.
+#define NEO_PROFILE_SCOPE(name) const Neo::ProfileZone NEO_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define NEO_PROFILE_FUNCTION() NEO_PROFILE_SCOPE(__FUNCTION__)
+#else
+#define NEO_PROFILE_SCOPE(name)
+#define NEO_PROFILE_FUNCTION()
+#endif
+
+namespace Neo
+{
+    struct ProfileEvent
+    {
+        const char* Name = nullptr;
+        /// <summary>
+        /// Nanoseconds since the profiler started.
+        /// </summary>
+        u64 Start = 0;
+        u64 End = 0;
+        /// <summary>
+        /// Number of zones this one is nested in, on its own thread.
+        /// </summary>
+        u32 Depth = 0;
+        u32 Thread = 0;
+    };
+
+    struct ProfileFrame
+    {
+        u64 Index = 0;
+        u64 Start = 0;
+        u64 End = 0;
+        /// <summary>
+        /// Zones that ended during the frame, sorted by thread and then start time. Within a thread this is the
+        /// zone tree in depth first order, so a zone's children are the following events with a greater Depth.
+        /// </summary>
+        std::vector<ProfileEvent> Events;
+    };
+
+    /// <summary>
+    /// CPU profiler built from scoped zones. Every thread writes finished zones into its own lock free ring,
+    /// which the main thread drains once per frame into the frame breakdown, so zones never take a lock.
+    /// A capture keeps every frame until it ends and is written out as Chrome trace JSON, which both
+    /// chrome://tracing and Perfetto open. Setting NEO_PROFILE_CAPTURE to a path captures a run without the
+    /// editor, for NEO_PROFILE_FRAMES frames or until shutdown.
+    /// </summary>
+    class Profiler
+    {
+    public:
+        static void Init();
+        static void Shutdown();
+
+        /// <summary>
+        /// Close the current frame and collect its zones. Called by the engine at the start of every frame.
+        /// </summary>
+        static void BeginFrame();
+
+        [[nodiscard]] static const ProfileFrame& GetLastFrame();
+
+        static void BeginCapture();
+        /// <summary>
+        /// Stop capturing and write the captured frames as Chrome trace JSON.
+        /// Returns true if the file was written successfully.
+        /// </summary>
+        static bool EndCapture(std::string_view path);
+        [[nodiscard]] static bool IsCapturing();
+
+        /// <summary>
+        /// Name shown for the calling thread in captures.
+        /// </summary>
+        static void SetThreadName(std::string_view name);
+        [[nodiscard]] static std::string GetThreadName(u32 thread);
+
+        /// <summary>
+        /// Copy a name into storage that lives as long as the profiler, for zones named at runtime.
+        /// Interning the same name twice returns the same pointer.
+        /// </summary>
+        [[nodiscard]] static const char* InternName(std::string_view name);
+
+        /// <summary>
+        /// Zones lost because a thread filled its ring before the main thread drained it.
+        /// </summary>
+        [[nodiscard]] static u64 GetDroppedEvents();
+
+        [[nodiscard]] static u64 Now();
+        static void EnterZone();
+        static void LeaveZone(const char* name, u64 start);
+    };
+
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(const char* name) : mName(name), mStart(Profiler::Now()) { Profiler::EnterZone(); }
+        ~ProfileZone() { Profiler::LeaveZone(mName, mStart); }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* mName;
+        u64 mStart;
+    };
+}
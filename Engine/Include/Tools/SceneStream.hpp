@@ -0,0 +1,116 @@
+#pragma once
+
+namespace Neo
+{
+    inline constexpr u32 kSceneVersion = 1;
+    inline constexpr size_t kSceneBufferSize = 64 * 1024;
+
+    /// <summary>
+    /// Writes a JSON scene one entity at a time. Output is collected in a buffer of bufferSize bytes
+    /// which is flushed to the stream whenever it fills up, so memory use does not grow with the scene.
+    /// Every entity is written on its own line to keep diffs of scene files small.
+    /// </summary>
+    class JsonSceneWriter
+    {
+    public:
+        explicit JsonSceneWriter(std::ostream& stream, size_t bufferSize = kSceneBufferSize);
+        ~JsonSceneWriter();
+
+        JsonSceneWriter(const JsonSceneWriter&) = delete;
+        JsonSceneWriter& operator=(const JsonSceneWriter&) = delete;
+
+        void BeginEntity(Entity entity);
+        void EndEntity();
+
+        template <typename T>
+        void WriteComponent(const std::string_view name, const T& component)
+        {
+            mScratch.clear();
+            if (glz::write_json(component, mScratch).ec != glz::error_code::none)
+            {
+                Log::Error("JsonSceneWriter: Failed to write component {}", name);
+                mFailed = true;
+                return;
+            }
+            WriteField(name, mScratch);
+        }
+
+        /// <summary>
+        /// Close the entity list and flush what is left in the buffer. Called by the destructor if needed.
+        /// </summary>
+        [[nodiscard]] bool Finish();
+
+    private:
+        void WriteField(std::string_view name, std::string_view json);
+        void Append(std::string_view text);
+        void Flush();
+
+        std::ostream& mStream;
+        std::string mBuffer;
+        std::string mScratch;
+        size_t mBufferSize;
+        u64 mEntityCount = 0;
+        bool mFirstField = true;
+        bool mFinished = false;
+        bool mFailed = false;
+    };
+
+    /// <summary>
+    /// Reads a scene written by the JsonSceneWriter one entity at a time. The file is read in chunks of bufferSize
+    /// bytes, and only the entity being read is ever parsed, so the scene is never held in memory as a whole.
+    /// </summary>
+    class JsonSceneReader
+    {
+    public:
+        explicit JsonSceneReader(std::istream& stream, size_t bufferSize = kSceneBufferSize);
+
+        /// <summary>
+        /// Move to the next entity. Returns false once all entities have been read, or when the file is malformed.
+        /// </summary>
+        [[nodiscard]] bool NextEntity();
+
+        [[nodiscard]] Entity GetEntity() const { return mEntity; }
+        [[nodiscard]] bool HasComponent(const std::string_view name) const { return mFields.contains(name); }
+
+        /// <summary>
+        /// Read a component of the current entity. Returns false if the entity does not have it.
+        /// </summary>
+        template <typename T>
+        bool ReadComponent(const std::string_view name, T& component)
+        {
+            const auto it = mFields.find(name);
+            if (it == mFields.end()) return false;
+            if (glz::read_json(component, it->second.str).ec != glz::error_code::none)
+            {
+                Log::Error("JsonSceneReader: Failed to read component {}", name);
+                mFailed = true;
+                return false;
+            }
+            return true;
+        }
+
+        [[nodiscard]] u32 GetVersion() const { return mVersion; }
+        [[nodiscard]] bool Failed() const { return mFailed; }
+
+    private:
+        bool ReadHeader();
+        bool Fill();
+        bool IsStructural(char c);
+        Opt<std::string_view> NextObject();
+
+        std::istream& mStream;
+        std::string mBuffer;
+        std::string mObject;
+        std::map<std::string, glz::raw_json, std::less<>> mFields;
+        size_t mBufferSize;
+        size_t mScan = 0;
+        size_t mObjectStart = std::string::npos;
+        u32 mDepth = 0;
+        bool mInString = false;
+        bool mEscape = false;
+        Entity mEntity = NullEntity;
+        u32 mVersion = 0;
+        bool mFinished = false;
+        bool mFailed = false;
+    };
+}
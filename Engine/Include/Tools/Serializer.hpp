@@ -1,5 +1,5 @@
 #pragma once
-
+#include "Tools/AssetFile.hpp"
 
 namespace Neo
 {
@@ -33,21 +33,29 @@ namespace Neo
     namespace BinarySerializer
     {
         template <typename T>
-        bool Serialize(T& value, std::string_view path)
+        bool Serialize(T& value, std::string_view path, const Compression compression = AssetTraits<T>::Compression)
         {
-            const auto errContext = glz::write_file_beve(value, path, std::string{});
+            std::string buffer;
+            const auto errContext = glz::write_beve(value, buffer);
             if (errContext.ec != glz::error_code::none)
             {
                 Log::Error("Failed to serialize: {}", magic_enum::enum_name(errContext.ec));
                 return false;
             }
-            return true;
+            return AssetFile::Write(path, GetAssetTypeHash<T>(), AssetTraits<T>::Version, compression, buffer);
         }
 
         template <typename T>
         bool Deserialize(T& value, std::string_view path)
         {
-            const auto errContext = glz::read_file_beve(value, path, std::string{});
+            const auto payload = AssetFile::Read(path, GetAssetTypeHash<T>(), AssetTraits<T>::Version);
+            if (!payload)
+            {
+                Log::Error("Failed to load {}: {}", path, magic_enum::enum_name(payload.error()));
+                return false;
+            }
+
+            const auto errContext = glz::read_beve(value, payload.value());
             if (errContext.ec != glz::error_code::none)
             {
                 Log::Error("Failed to deserialize: {}", magic_enum::enum_name(errContext.ec));
@@ -55,5 +63,14 @@ namespace Neo
             }
             return true;
         }
+
+        /// <summary>
+        /// Check from the header alone whether the file can be loaded as T, without reading the payload.
+        /// </summary>
+        template <typename T>
+        bool Validate(std::string_view path)
+        {
+            return AssetFile::Validate(path, GetAssetTypeHash<T>(), AssetTraits<T>::Version).has_value();
+        }
     }
 }
@@ -0,0 +1,86 @@
+#pragma once
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include "immintrin.h"
+#define NEO_SIMD_SSE
+#endif
+
+namespace Neo
+{
+    /// <summary>
+    /// Four floats operated on at once, with SSE where it is available and plain loops elsewhere. Comparisons
+    /// return a mask with bit i set when lane i compares true.
+    /// </summary>
+    struct Float4
+    {
+#ifdef NEO_SIMD_SSE
+        __m128 Value;
+
+        /// <summary>
+        /// Data has to be 16 byte aligned.
+        /// </summary>
+        [[nodiscard]] static Float4 Load(const float* data) { return {_mm_load_ps(data)}; }
+        [[nodiscard]] static Float4 Broadcast(const float value) { return {_mm_set1_ps(value)}; }
+
+        friend Float4 operator+(const Float4 a, const Float4 b) { return {_mm_add_ps(a.Value, b.Value)}; }
+        friend Float4 operator-(const Float4 a, const Float4 b) { return {_mm_sub_ps(a.Value, b.Value)}; }
+        friend Float4 operator*(const Float4 a, const Float4 b) { return {_mm_mul_ps(a.Value, b.Value)}; }
+        friend Float4 Min(const Float4 a, const Float4 b) { return {_mm_min_ps(a.Value, b.Value)}; }
+        friend Float4 Max(const Float4 a, const Float4 b) { return {_mm_max_ps(a.Value, b.Value)}; }
+
+        friend u32 LessThan(const Float4 a, const Float4 b)
+        {
+            return static_cast<u32>(_mm_movemask_ps(_mm_cmplt_ps(a.Value, b.Value)));
+        }
+
+        friend u32 LessEqual(const Float4 a, const Float4 b)
+        {
+            return static_cast<u32>(_mm_movemask_ps(_mm_cmple_ps(a.Value, b.Value)));
+        }
+
+        void Store(float* data) const { _mm_store_ps(data, Value); }
+#else
+        std::array<float, 4> Value;
+
+        [[nodiscard]] static Float4 Load(const float* data) { return {{data[0], data[1], data[2], data[3]}}; }
+        [[nodiscard]] static Float4 Broadcast(const float value) { return {{value, value, value, value}}; }
+
+        template <typename Func>
+        [[nodiscard]] static Float4 Apply(const Float4 a, const Float4 b, Func&& func)
+        {
+            return {{func(a.Value[0], b.Value[0]), func(a.Value[1], b.Value[1]),
+                     func(a.Value[2], b.Value[2]), func(a.Value[3], b.Value[3])}};
+        }
+
+        template <typename Func>
+        [[nodiscard]] static u32 Compare(const Float4 a, const Float4 b, Func&& func)
+        {
+            u32 mask = 0;
+            for (u32 lane = 0; lane < 4; lane++)
+            {
+                if (func(a.Value[lane], b.Value[lane])) mask |= 1u << lane;
+            }
+            return mask;
+        }
+
+        friend Float4 operator+(const Float4 a, const Float4 b) { return Apply(a, b, std::plus{}); }
+        friend Float4 operator-(const Float4 a, const Float4 b) { return Apply(a, b, std::minus{}); }
+        friend Float4 operator*(const Float4 a, const Float4 b) { return Apply(a, b, std::multiplies{}); }
+
+        friend Float4 Min(const Float4 a, const Float4 b)
+        {
+            return Apply(a, b, [](const float x, const float y) { return std::min(x, y); });
+        }
+
+        friend Float4 Max(const Float4 a, const Float4 b)
+        {
+            return Apply(a, b, [](const float x, const float y) { return std::max(x, y); });
+        }
+
+        friend u32 LessThan(const Float4 a, const Float4 b) { return Compare(a, b, std::less{}); }
+        friend u32 LessEqual(const Float4 a, const Float4 b) { return Compare(a, b, std::less_equal{}); }
+
+        void Store(float* data) const { std::ranges::copy(Value, data); }
+#endif
+    };
+}
@@ -1,10 +1,15 @@
 #pragma once
+#include "Tools/Warnings.hpp"
 
 namespace Neo
 {
     inline void ThrowError(const std::string_view error)
     {
+#ifdef _WIN32
         MessageBox(nullptr, error.data(), "Error", MB_ICONERROR | MB_OK);
+#else
+        Log::Error("{}", error);
+#endif
         exit(-1);
     }
 
@@ -28,6 +33,31 @@ namespace Neo
         return result;
     }
 
+    /// <summary>
+    /// 64 bit FNV-1a hash of a range of bytes. Pass a previous result as hash to combine several ranges.
+    /// </summary>
+    inline u64 HashBytes(const void* data, const size_t size, u64 hash = 14695981039346656037ull)
+    {
+        const auto* bytes = static_cast<const u8*>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /// <summary>
+    /// Value of an environment variable, or an empty string if it is not set.
+    /// </summary>
+    inline std::string ReadEnvironment(const char* name)
+    {
+        NEO_WARN_BEG()
+        NEO_WARN_DEPRECATED()
+        const auto* value = std::getenv(name);
+        NEO_WARN_END()
+        return value ? value : "";
+    }
+
     inline AssetID GenerateUUID()
     {
         return uuids::uuid_system_generator{}();
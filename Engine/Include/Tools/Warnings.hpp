@@ -1,7 +1,19 @@
 #pragma once
 
+#ifdef _MSC_VER
 #define NEO_WARN_BEG() __pragma(warning(push))
 
 #define NEO_WARN_END() __pragma(warning(pop))
 
-#define NEO_WARN_WCONV() __pragma(warning(disable : 4244))
\ No newline at end of file
+#define NEO_WARN_WCONV() __pragma(warning(disable : 4244))
+
+#define NEO_WARN_DEPRECATED() __pragma(warning(disable : 4996))
+#else
+#define NEO_WARN_BEG() _Pragma("GCC diagnostic push")
+
+#define NEO_WARN_END() _Pragma("GCC diagnostic pop")
+
+#define NEO_WARN_WCONV() _Pragma("GCC diagnostic ignored \"-Wconversion\"")
+
+#define NEO_WARN_DEPRECATED() _Pragma("GCC diagnostic ignored \"-Wdeprecated-declarations\"")
+#endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+struct Vertex
+{
+    float3 Position;
+    float UVx;
+    float3 Normal;
+    float UVy;
+    float4 Tangent;
+};
+
+struct Instance
+{
+    float4x4 World;
+    uint Material;
+    uint3 Padding;
+};
+
+struct PerDrawConstants
+{
+    uint vertexBufferIndex;
+    uint instanceBufferIndex;
+    // SV_InstanceID starts at 0 whatever the first instance of the draw is
+    uint firstInstance;
+    uint padding;
+    float4x4 viewProjection;
+};
+
+ConstantBuffer<PerDrawConstants> PerDraw : register(b0);
+
+void main(
+        in  uint   inVertexIndex   : SV_VertexID,
+        in  uint   inInstanceIndex : SV_InstanceID,
+        out float4 outPosition     : SV_Position,
+        out float2 outUv           : TEXCOORD,
+        out float4 outTangent      : TANGENT,
+        out float4 outColor        : COLOR)
+{
+    StructuredBuffer<Vertex> vertexBuffer = ResourceDescriptorHeap[PerDraw.vertexBufferIndex];
+    StructuredBuffer<Instance> instanceBuffer = ResourceDescriptorHeap[PerDraw.instanceBufferIndex];
+    Vertex vertex = vertexBuffer.Load(inVertexIndex);
+    Instance instance = instanceBuffer.Load(PerDraw.firstInstance + inInstanceIndex);
+
+    float3 normal = normalize(mul((float3x3)instance.World, vertex.Normal));
+    outPosition = mul(PerDraw.viewProjection, mul(instance.World, float4(vertex.Position, 1.0)));
+    outUv = float2(vertex.UVx, vertex.UVy);
+    outTangent = float4(mul((float3x3)instance.World, vertex.Tangent.xyz), vertex.Tangent.w);
+    outColor = float4(normal * 0.5 + 0.5, 1.0);
+}
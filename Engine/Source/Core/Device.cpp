@@ -2,8 +2,10 @@
 #include "GLFW/glfw3.h"
 #include "Tools/Tools.hpp"
 
+#ifdef _WIN32
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include "GLFW/glfw3native.h"
+#endif
 
 Neo::Device::Device()
 {
@@ -18,7 +20,9 @@ Neo::Device::Device()
     {
         Neo::ThrowError("Device::Device Failed to create window");
     }
+#ifdef _WIN32
     mHWND = glfwGetWin32Window(mWindow);
+#endif
     glfwSetWindowUserPointer(mWindow, this);
     int width, height;
     glfwGetWindowSize(mWindow, &width, &height);
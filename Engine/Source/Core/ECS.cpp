@@ -1,10 +1,62 @@
 #include "Core/ECS.hpp"
 #include "Generated.hpp"
+#include "Tools/SceneStream.hpp"
+#include "Memory/MemoryTracker.hpp"
 
 
 namespace
 {
+    template <typename T>
+    constexpr std::string_view GetComponentName()
+    {
+        constexpr auto name = entt::type_name<T>::value();
+        return name.substr(name.rfind(':') + 1);
+    }
+
+    template <typename Func>
+    void ForEachSerializedType(Func&& func)
+    {
+        [&]<typename... T>(std::type_identity<std::tuple<T...>>)
+        {
+            (func.template operator()<T>(), ...);
+        }(std::type_identity<Neo::SerializedTypes>{});
+    }
+
+    template <typename T>
+    void WriteComponents(Neo::World& world, Neo::BinaryWriter& writer)
+    {
+        const auto& storage = world.storage<T>();
+        writer.Write(entt::type_hash<T>::value());
+        writer.Write(static_cast<u32>(storage.size()));
+        for (const auto [entity, component] : storage.each())
+        {
+            writer.Write(entity);
+            writer.Write(component);
+        }
+    }
 
+    template <typename T>
+    bool ReadComponents(Neo::World& world, Neo::BinaryReader& reader)
+    {
+        u32 typeHash = 0;
+        u32 count = 0;
+        if (!reader.Read(typeHash) || !reader.Read(count)) return false;
+        if (typeHash != entt::type_hash<T>::value())
+        {
+            Neo::Log::Error("ECS: Component {} does not match the serialized data", entt::type_name<T>::value());
+            return false;
+        }
+
+        for (u32 i = 0; i < count; i++)
+        {
+            Neo::Entity entity = Neo::NullEntity;
+            T component{};
+            if (!reader.Read(entity) || !reader.Read(component)) return false;
+            if (!world.valid(entity)) return false;
+            world.emplace_or_replace<T>(entity, std::move(component));
+        }
+        return true;
+    }
 }
 
 namespace Neo
@@ -40,4 +92,108 @@ namespace Neo
         
         RegisterMeta();
     }
+
+    void ECS::Serialize(BinaryWriter& writer)
+    {
+        MemoryTagScope tag(MemoryTag::eECS);
+        std::vector<Entity> entities;
+        for (const auto entity : mWorld.view<Entity>())
+        {
+            entities.emplace_back(entity);
+        }
+        writer.Write(entities);
+
+        ForEachSerializedType([&]<typename T>()
+        {
+            WriteComponents<T>(mWorld, writer);
+        });
+    }
+
+    bool ECS::Deserialize(BinaryReader& reader)
+    {
+        MemoryTagScope tag(MemoryTag::eECS);
+        std::vector<Entity> entities;
+        if (!reader.Read(entities)) return false;
+
+        mWorld.clear();
+        for (const auto entity : entities)
+        {
+            if (mWorld.create(entity) != entity)
+            {
+                Log::Error("ECS: Entity {} appears more than once in the serialized world", entt::to_integral(entity));
+                return false;
+            }
+        }
+
+        const bool result = [&]<typename... T>(std::type_identity<std::tuple<T...>>)
+        {
+            return (ReadComponents<T>(mWorld, reader) && ...);
+        }(std::type_identity<SerializedTypes>{});
+
+        if (!result)
+        {
+            Log::Error("ECS: Failed to deserialize the world");
+        }
+        return result;
+    }
+
+    bool ECS::ExportJson(const std::string_view path)
+    {
+        MemoryTagScope tag(MemoryTag::eECS);
+        std::ofstream file(path.data(), std::ios::binary);
+        if (!file.is_open())
+        {
+            Log::Error("File {} could not be opened for writing!", path);
+            return false;
+        }
+
+        JsonSceneWriter writer(file);
+        for (const auto entity : mWorld.view<Entity>())
+        {
+            writer.BeginEntity(entity);
+            ForEachSerializedType([&]<typename T>()
+            {
+                if (const auto* component = mWorld.try_get<T>(entity))
+                {
+                    writer.WriteComponent(GetComponentName<T>(), *component);
+                }
+            });
+            writer.EndEntity();
+        }
+        return writer.Finish();
+    }
+
+    bool ECS::ImportJson(const std::string_view path)
+    {
+        MemoryTagScope tag(MemoryTag::eECS);
+        std::ifstream file(path.data(), std::ios::binary);
+        if (!file.is_open())
+        {
+            Log::Error("File {} could not be opened!", path);
+            return false;
+        }
+
+        JsonSceneReader reader(file);
+        if (reader.Failed()) return false;
+
+        mWorld.clear();
+        while (reader.NextEntity())
+        {
+            const auto entity = mWorld.create(reader.GetEntity());
+            if (entity != reader.GetEntity())
+            {
+                Log::Error("ECS: Entity {} appears more than once in {}", entt::to_integral(entity), path);
+                return false;
+            }
+
+            ForEachSerializedType([&]<typename T>()
+            {
+                if (T component{}; reader.ReadComponent(GetComponentName<T>(), component))
+                {
+                    mWorld.emplace<T>(entity, std::move(component));
+                }
+            });
+        }
+        return !reader.Failed();
+    }
 } // Neo
@@ -2,21 +2,49 @@
 #include "Tools/Log.hpp"
 #include "Core/Scripting.hpp"
 #include "Project/ProjectBuilder.hpp"
+#include "Memory/MemoryTracker.hpp"
+#include "Tools/Profiler.hpp"
+#include "Tools/Metrics.hpp"
 
 namespace Neo
 {
     EngineClass Engine;
 
     static auto time = std::chrono::high_resolution_clock::now();
+    static const Gauge kEntities("ECS/Entities");
 
     void EngineClass::Init()
     {
+        MemoryTagScope engineTag(MemoryTag::eEngine);
         Log::Init();
-        mECS = new Neo::ECS();
+        Profiler::Init();
+        {
+            MemoryTagScope tag(MemoryTag::eECS);
+            mECS = new Neo::ECS();
+        }
         mDevice = new Neo::Device();
-        mRenderer = new Neo::Renderer();
-        mScripting = new Neo::Scripting();
-        mResources = new Neo::Resources();
+        {
+            MemoryTagScope tag(MemoryTag::eRenderer);
+            // NEO_RENDER_BACKEND=Null runs the renderer without a GPU
+            const auto backend = magic_enum::enum_cast<RenderBackend>("e" + ReadEnvironment("NEO_RENDER_BACKEND"));
+            const RenderContextCreateInfo createInfo{
+                .GpuPreference = DevicePreference::eHighPerformance,
+                .Backend = backend.value_or(RenderBackend::eDX12),
+                .Size = mDevice->GetWindowSize(),
+            };
+            mRenderer = new Neo::Renderer(createInfo);
+            mRenderer->GetSceneBVH().Attach(mECS->GetWorld());
+        }
+        {
+            MemoryTagScope tag(MemoryTag::eScripting);
+            mScripting = new Neo::Scripting();
+        }
+        {
+            MemoryTagScope tag(MemoryTag::eResources);
+            mResources = new Neo::Resources();
+            mResources->SetRenderContext(mRenderer->GetRenderContext().get());
+            mResources->SetUploadQueue(&mRenderer->GetUploadQueue());
+        }
         mProject = new Neo::Project();
 
         // const ProjectInfo info
@@ -31,10 +59,12 @@ namespace Neo
 
     void EngineClass::Shutdown() const
     {
+        Profiler::Shutdown();
         delete mDevice;
         delete mScripting;
         delete mECS;
         delete mProject;
+        delete mResources;
         delete mRenderer;
     }
 
@@ -45,11 +75,37 @@ namespace Neo
         mDeltaTime = std::chrono::duration<float>(elapsed).count();
         time = ctime;
 
-        mDevice->Update(mDeltaTime);
-        mScripting->Update(mDeltaTime);
+        MemoryTracker::BeginFrame();
+        Profiler::BeginFrame();
+        Metrics::BeginFrame();
+        NEO_PROFILE_SCOPE("EngineClass::Update");
+        // Every entity has a hierarchy, so this counts them all
+        kEntities.Set(static_cast<i64>(mECS->View<Hierarchy>().size()));
+        mFrameAllocator.BeginFrame();
+        MemoryTagScope engineTag(MemoryTag::eEngine);
+        {
+            NEO_PROFILE_SCOPE("Device::Update");
+            mDevice->Update(mDeltaTime);
+        }
+        {
+            MemoryTagScope tag(MemoryTag::eScripting);
+            mScripting->Update(mDeltaTime);
+        }
+        {
+            MemoryTagScope tag(MemoryTag::eResources);
+            mResources->Update();
+        }
 
         // Should always happen last
-        mRenderer->Update(mDeltaTime);
+        {
+            MemoryTagScope tag(MemoryTag::eRenderer);
+            if (mDevice->IsWindowResized())
+            {
+                mRenderer->Resize(mDevice->GetWindowSize());
+            }
+            mRenderer->ExtractDraws(*mECS, *mResources);
+            mRenderer->Update(mDeltaTime, mFrameAllocator);
+        }
         
         
         mDevice->ResetState();
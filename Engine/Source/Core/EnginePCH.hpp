@@ -14,7 +14,21 @@
 #include "functional"
 #include "fstream"
 #include "expected"
-
+#include "span"
+#include "atomic"
+#include "execution"
+#include "thread"
+#include "mutex"
+#include "condition_variable"
+#include "queue"
+#include "variant"
+#include "bit"
+#include "cmath"
+#include "memory_resource"
+#include "charconv"
+
+// The DX12 backend and the window handle are Windows only, everything else builds anywhere
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #define NOCRYPT       
@@ -26,6 +40,7 @@
 #include "directx/d3dx12.h"
 #include "dxgi1_6.h"
 #include "dxcapi.h"
+#endif
 
 #include "glm/glm.hpp"
 #include "glm/gtc/type_ptr.hpp"
@@ -1,6 +1,7 @@
 #pragma once
 // This file was generated by PreBuildTool
 // Do not modify.
+#include "Tools/BinaryStream.hpp"
 namespace Neo
 {
 
@@ -42,4 +43,36 @@ inline void RegisterMeta() {
     RegisterTransform();
     RegisterHierarchy();
 }
+
+inline void Serialize(BinaryWriter& writer, const Name& value)
+{
+    writer.Write(value.EntityName);
+}
+
+inline void Deserialize(BinaryReader& reader, Name& value)
+{
+    reader.Read(value.EntityName);
+}
+
+inline void Serialize(BinaryWriter& writer, const Transform& value)
+{
+    writer.WriteRun<&Transform::Position, &Transform::Rotation, &Transform::Scale>(value);
+}
+
+inline void Deserialize(BinaryReader& reader, Transform& value)
+{
+    reader.ReadRun<&Transform::Position, &Transform::Rotation, &Transform::Scale>(value);
+}
+
+inline void Serialize(BinaryWriter& writer, const Hierarchy& value)
+{
+    writer.WriteRun<&Hierarchy::Parent, &Hierarchy::Children>(value);
+}
+
+inline void Deserialize(BinaryReader& reader, Hierarchy& value)
+{
+    reader.ReadRun<&Hierarchy::Parent, &Hierarchy::Children>(value);
+}
+
+using SerializedTypes = std::tuple<Name, Transform, Hierarchy>;
 }
@@ -1,24 +1,47 @@
 #include "Core/Renderer.hpp"
-#include "Core/Device.hpp"
-#include "Core/Engine.hpp"
+#include "Core/ECS.hpp"
+#include "Core/FileIO.hpp"
+#include "Core/Resources.hpp"
+#ifdef _WIN32
 #include "Render/DX12/RenderContextDX12.hpp"
+#endif
+#include "Render/Null/RenderContextNull.hpp"
 #include "Render/RenderComponents.hpp"
+#include "Tools/Profiler.hpp"
 
 namespace Neo
 {
-    Renderer::Renderer()
+    Renderer::Renderer(const RenderContextCreateInfo& createInfo) : mSize(createInfo.Size)
     {
-        RenderContextCreateInfo createArgs{
-            .GpuPreference = DevicePreference::eHighPerformance,
-        };
-        mContext = std::make_unique<RenderContextDX12>(createArgs);
+        switch (createInfo.Backend)
+        {
+        case RenderBackend::eDX12:
+#ifdef _WIN32
+            mContext = std::make_unique<RenderContextDX12>(createInfo);
+            break;
+#else
+            Log::Error("Renderer: The DX12 backend is only built on Windows, using the null backend instead");
+            [[fallthrough]];
+#endif
+        case RenderBackend::eNull:
+            mContext = std::make_unique<RenderContextNull>(createInfo);
+            break;
+        }
+        mUploadQueue = std::make_unique<UploadQueue>(*mContext);
+        for (u32 index = 0; index < kFrameCount; index++)
+        {
+            mCopyCommands[index] = mContext->CreateCommand(QueueType::eGraphics, fmt::format("Copy Command {}", index));
+        }
 
+        // Mapped once and written every frame, so nothing waits on the GPU or maps again to upload
         constexpr BufferCreateInfo uploadCreateInfo{
-            .FirstElement = 0, .NumElements = 3, .Stride = sizeof(Vertex), .Type = BufferType::eStaging
+            .FirstElement = 0,
+            .NumElements = kUploadInstances,
+            .Stride = sizeof(InstanceData),
+            .Type = BufferType::eStaging,
         };
-        const auto uploadBuffer = mContext->CreateBuffer(uploadCreateInfo, "Vertex Upload Buffer");
-
-        mTransferCommand = mContext->CreateCommand(QueueType::eTransfer, "Transfer");
+        mUploadBuffer = mContext->CreateBuffer(uploadCreateInfo, "Upload Buffer");
+        mUploadData = static_cast<std::byte*>(mContext->MapBuffer(mUploadBuffer));
 
         constexpr std::array vertexData{
             Vertex{.Position = glm::vec3(-0.5f, -0.5f, 0.0f)},
@@ -26,21 +49,11 @@ namespace Neo
             Vertex{.Position = glm::vec3(0.0f, 0.5f, 0.0f)},
         };
 
-        auto* const mappedPtr = mContext->MapBuffer(uploadBuffer);
-        std::memcpy(mappedPtr, vertexData.data(), sizeof(Vertex) * 3);
-        mContext->UnmapBuffer(uploadBuffer);
-
         constexpr BufferCreateInfo vertexCreateInfo{
             .FirstElement = 0, .NumElements = 3, .Stride = sizeof(Vertex), .Type = BufferType::eStorage
         };
         mVertexBuffer = mContext->CreateBuffer(vertexCreateInfo, "Vertex Buffer");
-
-        mContext->BeginCommand(mTransferCommand);
-        mContext->CopyBuffer(mTransferCommand, uploadBuffer, mVertexBuffer, 0, 0, sizeof(Vertex) * 3);
-        mContext->EndCommand(mTransferCommand);
-        mContext->OneTimeSubmit({mTransferCommand}, QueueType::eTransfer);
-
-        mContext->DestroyBuffer(uploadBuffer);
+        Upload(mVertexBuffer, vertexData.data(), sizeof(vertexData));
 
         const GraphicsShaderCreateInfo shaderCreateInfo{
             .VertexCode = FileIO::ReadBinaryFile("Shaders/GeomVS.cso"),
@@ -51,10 +64,12 @@ namespace Neo
             .DepthStencilFormat = Format::eUnknown,
         };
         mTriangleShader = mContext->CreateShader(shaderCreateInfo, "Triangle Shader");
+        GraphicsShaderCreateInfo meshShaderCreateInfo = shaderCreateInfo;
+        meshShaderCreateInfo.VertexCode = FileIO::ReadBinaryFile("Shaders/MeshVS.cso");
+        mMeshShader = mContext->CreateShader(meshShaderCreateInfo, "Mesh Shader");
 
-        const auto size = Engine.Device().GetWindowSize();
         const RenderTargetCreateInfo renderTargetCreateInfo{
-            .Size = {size.x, size.y},
+            .Size = mSize,
             .Format = Format::eB8G8R8A8_UNORM,
             .ViewType = ViewType::eTexture2D,
         };
@@ -63,20 +78,24 @@ namespace Neo
 
         RenderPass renderPass
         {
-            .Execute = [&]
+            .Name = "Triangle",
+            .Setup = [this](RenderGraphBuilder& builder)
+            {
+                builder.Write(mScene);
+            },
+            .Execute = [this](const RenderGraph&, const CommandHandle command)
             {
-                const auto& context = Engine.Renderer().GetRenderContext();
-                const auto& command = context->GetFrameData().CommandHandle;
+                const auto& context = mContext;
                 const RenderPassInfo renderPassInfo{
-                    .RenderTargets = {mRenderTarget},
+                    .RenderTargets = std::span(&mRenderTarget, 1),
                     .ClearColor = glm::vec4(0.392f, 0.584f, 0.929f, 1.0f),
                 };
                 context->BeginRenderPass(command, renderPassInfo);
                 context->BindShader(command, mTriangleShader);
                 context->SetPrimitiveTopology(command, PrimitiveTopology::eTriangle);
-                const Viewport viewport{.Dimensions = Engine.Device().GetWindowSize()};
+                const Viewport viewport{.Dimensions = mSize};
                 context->SetViewport(command, viewport);
-                const Scissor scissor{.Max = Engine.Device().GetWindowSize()};
+                const Scissor scissor{.Max = mSize};
                 context->SetScissor(command, scissor);
 
                 const struct PushConstant
@@ -91,46 +110,231 @@ namespace Neo
             }
         };
         AddRenderPass(std::move(renderPass));
+        AddRenderPass({
+            .Name = "Meshes",
+            .Setup = [this](RenderGraphBuilder& builder)
+            {
+                // Culled when there is nothing to draw
+                if (mDrawMeshes) builder.Write(mScene);
+            },
+            .Execute = [this](const RenderGraph&, const CommandHandle command) { DrawMeshes(command); },
+        });
     }
 
     Renderer::~Renderer()
-    = default;
+    {
+        mGraph.Release(*mContext);
+        mContext->UnmapBuffer(mUploadBuffer);
+        mContext->DestroyBuffer(mUploadBuffer);
+    }
 
-    void Renderer::Update(float)
+    void Renderer::Update(float, FrameAllocator& frameAllocator)
     {
-        const auto& [command, renderTarget, fenceValue] = mContext->GetFrameData();
-        if (Engine.Device().IsWindowResized())
-        {
-            GetRenderContext()->WaitForGPU();
-            mContext->Resize();
-            mContext->DestroyRenderTarget(mRenderTarget);
-            const auto size = Engine.Device().GetWindowSize();
-            const RenderTargetCreateInfo renderTargetCreateInfo{
-                .Size = {size.x, size.y},
-                .Format = Format::eB8G8R8A8_UNORM,
-                .ViewType = ViewType::eTexture2D,
-            };
-            mRenderTarget = mContext->CreateRenderTarget(renderTargetCreateInfo, "Render Target");
+        NEO_PROFILE_FUNCTION();
+        const auto& frameData = mContext->GetFrameData();
+        const auto command = frameData.CommandHandle;
+        // Present waited for the frame that last had this index, so what it uploaded can be overwritten
+        mUploadRing.BeginFrame(mContext->GetFrameIndex());
+        mDrawMeshes = StreamInstances() && !mMeshDraws.empty();
+        mUploadQueue->Submit();
+        {
+            NEO_PROFILE_SCOPE("RenderGraph::Build");
+            mGraph.Reset(frameAllocator.GetResource());
+            mBackbuffer = mGraph.Import(
+                "Backbuffer", frameData.RenderTargetHandle, ResourceState::ePresent, ResourceState::ePresent);
+            mScene = mGraph.Import("Scene", mRenderTarget, ResourceState::eShaderRead, ResourceState::eShaderRead);
+            for (const auto& renderPass : mRenderPasses)
+            {
+                mGraph.AddPass(renderPass.Name, renderPass.Setup, renderPass.Execute);
+            }
         }
-        else
+        mGraph.Compile(*mContext);
+
+        if (!mPendingCopies.empty())
         {
-            mContext->BeginCommand(command);
-            mContext->SetupGraphicsCommand(command);
-            
-            for (auto& renderPass : mRenderPasses)
+            const auto copyCommand = mCopyCommands[mContext->GetFrameIndex()];
+            mContext->BeginCommand(copyCommand);
+            for (const auto& copy : mPendingCopies)
             {
-                if (renderPass.Execute)
-                {
-                    renderPass.Execute();
-                }
+                mContext->CopyBuffer(copyCommand, mUploadBuffer, copy.Destination, copy.SourceOffset, 0, copy.Size);
             }
+            mContext->EndCommand(copyCommand);
+            mContext->Submit(std::span(&copyCommand, 1), QueueType::eGraphics);
+            mPendingCopies.clear();
+        }
 
-            mContext->EndCommand(command);
-            mContext->Submit({command}, QueueType::eGraphics);
+        mContext->BeginCommand(command);
+        mContext->SetupGraphicsCommand(command);
+        std::span<const CommandHandle> commands(&command, 1);
+        if (mParallelRecording)
+        {
+            commands = mGraph.ExecuteParallel(*mContext, command);
+        }
+        else
+        {
+            mGraph.Execute(*mContext, command);
+        }
+        mContext->EndCommand(command);
+        {
+            NEO_PROFILE_SCOPE("Submit");
+            mContext->Submit(commands, QueueType::eGraphics);
+        }
+        mUploadRing.EndFrame();
+        {
+            NEO_PROFILE_SCOPE("Present");
             mContext->Present();
         }
     }
 
+    void Renderer::Resize(const glm::uvec2 size)
+    {
+        mSize = size;
+        mContext->WaitForGPU();
+        mContext->Resize();
+        mContext->DestroyRenderTarget(mRenderTarget);
+        const RenderTargetCreateInfo renderTargetCreateInfo{
+            .Size = mSize,
+            .Format = Format::eB8G8R8A8_UNORM,
+            .ViewType = ViewType::eTexture2D,
+        };
+        mRenderTarget = mContext->CreateRenderTarget(renderTargetCreateInfo, "Render Target");
+    }
+
+    void Renderer::ExtractDraws(const ECS& ecs, Resources& resources)
+    {
+        DrawView view;
+        for (const auto [entity, transform, camera] : ecs.View<Transform, Camera>().each())
+        {
+            view = MakeDrawView(transform, camera, mSize);
+            break;
+        }
+        mSceneBVH.Sync(ecs, resources);
+        mDrawList.Begin(view);
+        mDrawList.Extract(ecs, resources, &mSceneBVH);
+        mDrawList.Finish();
+
+        mMeshDraws.clear();
+        for (const auto& batch : mDrawList.GetBatches())
+        {
+            const auto* mesh = resources.Get(batch.Mesh);
+            if (!mesh || batch.Primitive >= mesh->Primitives.size()) continue;
+            // Drawn once its buffers are on the GPU, the instances written for it until then go unused
+            const auto& primitive = mesh->Primitives[batch.Primitive];
+            if (primitive.IndexBuffer == BufferHandle::eNull || !mUploadQueue->IsComplete(primitive.Upload)) continue;
+
+            mMeshDraws.emplace_back(MeshDraw{
+                .Shader = batch.Shader == ShaderHandle::eNull ? mMeshShader : batch.Shader,
+                .VertexBuffer = primitive.VertexBuffer,
+                .IndexBuffer = primitive.IndexBuffer,
+                .IndexCount = static_cast<u32>(primitive.Indices.size()),
+                .FirstInstance = batch.FirstInstance,
+                .InstanceCount = batch.InstanceCount,
+            });
+        }
+    }
+
+    Entity Renderer::Pick(const glm::vec2 position) const
+    {
+        // The ray runs from the camera to the point on the far plane under the position
+        const auto& view = mDrawList.GetView();
+        const glm::vec2 clip(position.x * 2.f - 1.f, 1.f - position.y * 2.f);
+        const auto far = glm::inverse(view.ViewProjection) * glm::vec4(clip, 1.f, 1.f);
+        return mSceneBVH.Raycast(view.Position, glm::vec3(far) / far.w - view.Position, 1.f);
+    }
+
+    bool Renderer::Upload(const BufferHandle destination, const void* data, const u64 size)
+    {
+        const auto offset = mUploadRing.Allocate(size);
+        if (!offset)
+        {
+            Log::Warn("Renderer: Upload of {} bytes does not fit the upload buffer", size);
+            return false;
+        }
+        std::memcpy(mUploadData + *offset, data, size);
+        mPendingCopies.emplace_back(PendingCopy{.Destination = destination, .SourceOffset = *offset, .Size = size});
+        return true;
+    }
+
+    bool Renderer::StreamInstances()
+    {
+        NEO_PROFILE_FUNCTION();
+        const auto instances = mDrawList.GetInstances();
+        if (instances.empty()) return true;
+
+        // Aligned to whole instances, so the first one is an element of the upload buffer
+        const auto offset = mUploadRing.Allocate(instances.size() * sizeof(InstanceData), sizeof(InstanceData));
+        if (!offset)
+        {
+            Log::Warn("Renderer: {} instances do not fit the upload buffer", instances.size());
+            return false;
+        }
+        mFirstInstance = static_cast<u32>(*offset / sizeof(InstanceData));
+
+        auto* const destination = reinterpret_cast<InstanceData*>(mUploadData + *offset);
+        const auto batches = mDrawList.GetBatches();
+        const auto write = [&](const DrawBatch& batch)
+        {
+            for (u32 i = batch.FirstInstance; i < batch.FirstInstance + batch.InstanceCount; i++)
+            {
+                destination[i] = InstanceData{.World = instances[i], .Material = batch.Material};
+            }
+        };
+        // Written straight into memory the GPU reads, so every byte is written once and never read back
+        if (instances.size() > FrustumCuller::kChunkSize)
+        {
+            std::for_each(std::execution::par, batches.begin(), batches.end(), write);
+        }
+        else
+        {
+            std::ranges::for_each(batches, write);
+        }
+        return true;
+    }
+
+    void Renderer::DrawMeshes(const CommandHandle command)
+    {
+        NEO_PROFILE_FUNCTION();
+        // Drawn over the triangle, in the order of the draw list. Without a depth buffer the later draw wins
+        const RenderPassInfo renderPassInfo{
+            .RenderTargets = std::span(&mRenderTarget, 1),
+            .RenderTargetLoadOp = RenderPassInfo::LoadOp::eLoad,
+        };
+        mContext->BeginRenderPass(command, renderPassInfo);
+        mContext->SetPrimitiveTopology(command, PrimitiveTopology::eTriangle);
+        const Viewport viewport{.Dimensions = mSize};
+        mContext->SetViewport(command, viewport);
+        const Scissor scissor{.Max = mSize};
+        mContext->SetScissor(command, scissor);
+
+        struct PushConstant
+        {
+            u32 VertexBuffer = 0;
+            u32 InstanceBuffer = 0;
+            // Shaders do not see the first instance of a draw in their instance index
+            u32 FirstInstance = 0;
+            u32 Padding = 0;
+            glm::mat4 ViewProjection{1.f};
+        } pc{
+            .InstanceBuffer = mContext->GetGPUAddress(mUploadBuffer),
+            .ViewProjection = mDrawList.GetView().ViewProjection,
+        };
+        auto shader = ShaderHandle::eNull;
+        for (const auto& draw : mMeshDraws)
+        {
+            if (draw.Shader != shader)
+            {
+                shader = draw.Shader;
+                mContext->BindShader(command, shader);
+            }
+            pc.VertexBuffer = mContext->GetGPUAddress(draw.VertexBuffer);
+            pc.FirstInstance = mFirstInstance + draw.FirstInstance;
+            mContext->PushConstant(command, sizeof(pc) / sizeof(u32), &pc);
+            mContext->BindIndexBuffer(command, draw.IndexBuffer);
+            mContext->DrawIndexed(command, draw.IndexCount, draw.InstanceCount, 0, 0, pc.FirstInstance);
+        }
+        mContext->EndRenderPass(command);
+    }
+
     void Renderer::AddRenderPass(RenderPass&& renderPass)
     {
         mRenderPasses.emplace_back(std::move(renderPass));
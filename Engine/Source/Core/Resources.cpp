@@ -1,19 +1,643 @@
 #include "Core/Resources.hpp"
+#include "Render/RenderContext.hpp"
+#include "Tools/Serializer.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Memory/ScratchAllocator.hpp"
+#include "Tools/Profiler.hpp"
+#include "Tools/Metrics.hpp"
+
+namespace
+{
+    const Neo::Counter kAssetsLoaded("Resources/AssetsLoaded");
+    const Neo::Gauge kStreamingPending("Resources/StreamingPending");
+    const Neo::Counter kMipRequests("Resources/MipRequests");
+}
+
+namespace
+{
+    template <typename T>
+    struct ResourceInfo;
+
+    template <>
+    struct ResourceInfo<Neo::Texture>
+    {
+        using Desc = Neo::TextureDesc;
+        static constexpr auto Type = Neo::AssetType::eTexture;
+    };
+
+    template <>
+    struct ResourceInfo<Neo::Material>
+    {
+        using Desc = Neo::MaterialDesc;
+        static constexpr auto Type = Neo::AssetType::eMaterial;
+    };
+
+    template <>
+    struct ResourceInfo<Neo::Mesh>
+    {
+        using Desc = Neo::MeshDesc;
+        static constexpr auto Type = Neo::AssetType::eMesh;
+    };
+
+    // MaterialDesc before its factors were packed into MaterialParams
+    struct MaterialDescV1
+    {
+        std::string Name;
+        Neo::AssetID ID;
+        Neo::Opt<Neo::AssetID> BaseColorTextureID;
+        Neo::Opt<Neo::AssetID> NormalTextureID;
+        Neo::Opt<Neo::AssetID> MetallicRoughnessTextureID;
+        Neo::Opt<Neo::AssetID> OcclusionTextureID;
+        Neo::Opt<Neo::AssetID> EmissiveTextureID;
+
+        glm::vec4 BaseColorFactor;
+        glm::vec3 EmissiveFactor;
+        float NormalFactor;
+        float OcclusionFactor;
+        float MetallicFactor;
+        float RoughnessFactor;
+    };
+
+    // MeshDesc before primitives had bounds
+    struct PrimitiveDescV1
+    {
+        std::vector<u32> Indices;
+        std::vector<Neo::Vertex> Vertices;
+        Neo::Opt<Neo::AssetID> MaterialID;
+    };
+
+    struct MeshDescV1
+    {
+        std::string Name;
+        Neo::AssetID ID;
+        std::vector<PrimitiveDescV1> Primitives;
+    };
+
+    u64 GetMeshSize(const Neo::Mesh& mesh)
+    {
+        u64 size = 0;
+        for (const auto& primitive : mesh.Primitives)
+        {
+            size += primitive.Indices.size() * sizeof(u32) + primitive.Vertices.size() * sizeof(Neo::Vertex);
+        }
+        return size;
+    }
+}
 
 namespace Neo
 {
     Resources::Resources()
     {
-        
+        AssetUpgrader::Register<MaterialDesc, MaterialDescV1>(1, [](const MaterialDescV1& oldDesc, MaterialDesc& desc)
+        {
+            desc.Name = oldDesc.Name;
+            desc.ID = oldDesc.ID;
+            desc.BaseColorTextureID = oldDesc.BaseColorTextureID;
+            desc.NormalTextureID = oldDesc.NormalTextureID;
+            desc.MetallicRoughnessTextureID = oldDesc.MetallicRoughnessTextureID;
+            desc.OcclusionTextureID = oldDesc.OcclusionTextureID;
+            desc.EmissiveTextureID = oldDesc.EmissiveTextureID;
+            desc.Params.BaseColorFactor = oldDesc.BaseColorFactor;
+            desc.Params.EmissiveFactor = oldDesc.EmissiveFactor;
+            desc.Params.NormalFactor = oldDesc.NormalFactor;
+            desc.Params.OcclusionFactor = oldDesc.OcclusionFactor;
+            desc.Params.MetallicFactor = oldDesc.MetallicFactor;
+            desc.Params.RoughnessFactor = oldDesc.RoughnessFactor;
+        });
+        AssetUpgrader::Register<MeshDesc, MeshDescV1>(1, [](const MeshDescV1& oldDesc, MeshDesc& desc)
+        {
+            desc.Name = oldDesc.Name;
+            desc.ID = oldDesc.ID;
+            for (const auto& primitive : oldDesc.Primitives)
+            {
+                desc.Primitives.emplace_back(PrimitiveDesc{
+                    .Indices = primitive.Indices,
+                    .Vertices = primitive.Vertices,
+                    .MaterialID = primitive.MaterialID,
+                    .Bounds = ComputeBounds(primitive.Vertices),
+                });
+            }
+        });
     }
-    
+
     Resources::~Resources()
     {
-        
+        CleanupResources();
+    }
+
+    bool Resources::LoadRegistry(const std::string_view path)
+    {
+        AssetRegistry registry;
+        if (!JsonSerializer::Deserialize(registry, path)) return false;
+
+        // Paths are stored relative to the registry so cooked assets can be moved together with it
+        const auto directory = std::filesystem::path(path).parent_path();
+        for (const auto& [key, file] : registry.Paths)
+        {
+            const auto id = uuids::uuid::from_string(key);
+            if (!id)
+            {
+                Log::Warn("Resources: Invalid asset id {} in {}", key, path);
+                continue;
+            }
+            RegisterAsset(id.value(), (directory / file).generic_string());
+        }
+        return true;
+    }
+
+    void Resources::RegisterAsset(const AssetID& id, const std::string_view path)
+    {
+        mPaths[id] = std::string(path);
+    }
+
+    AssetHandle<Texture> Resources::LoadTexture(const AssetID& id) { return Load<Texture>(id, std::nullopt); }
+    AssetHandle<Material> Resources::LoadMaterial(const AssetID& id) { return Load<Material>(id, std::nullopt); }
+    AssetHandle<Mesh> Resources::LoadMesh(const AssetID& id) { return Load<Mesh>(id, std::nullopt); }
+
+    AssetHandle<Texture> Resources::RequestTexture(const AssetID& id, const float priority)
+    {
+        return Load<Texture>(id, priority);
+    }
+
+    AssetHandle<Material> Resources::RequestMaterial(const AssetID& id, const float priority)
+    {
+        return Load<Material>(id, priority);
+    }
+
+    AssetHandle<Mesh> Resources::RequestMesh(const AssetID& id, const float priority)
+    {
+        return Load<Mesh>(id, priority);
+    }
+
+    template <typename T>
+    AssetHandle<T> Resources::Load(const AssetID& id, const Opt<float> priority)
+    {
+        auto& pool = GetPool<T>();
+        auto handle = pool.Find(id);
+        if (!handle.IsNull())
+        {
+            pool.AddRef(handle);
+            pool.Touch(handle, mFrame);
+            if (pool.IsLoaded(handle)) return handle;
+        }
+
+        const auto path = FindPath(id);
+        if (!path)
+        {
+            return handle;
+        }
+
+        if (priority)
+        {
+            if (handle.IsNull())
+            {
+                handle = pool.Reserve(id);
+                pool.Touch(handle, mFrame);
+            }
+            mStreamer.Request(id, ResourceInfo<T>::Type, path.value(), priority.value());
+            return handle;
+        }
+
+        // Loading right away also covers assets that are still queued, the streamed copy is dropped once it arrives
+        typename ResourceInfo<T>::Desc desc;
+        if (!BinarySerializer::Deserialize(desc, path.value()))
+        {
+            if (!handle.IsNull())
+            {
+                pool.Release(handle);
+            }
+            return {};
+        }
+
+        if (handle.IsNull())
+        {
+            handle = pool.Reserve(id);
+            pool.Touch(handle, mFrame);
+        }
+        Finish(handle, std::move(desc), std::nullopt);
+        return handle;
+    }
+
+    void Resources::Finish(const AssetHandle<Texture> handle, TextureDesc&& desc, Opt<float>)
+    {
+        Texture texture;
+        texture.WrapX = desc.WrapX;
+        texture.WrapY = desc.WrapY;
+        texture.Width = desc.Width;
+        texture.Height = desc.Height;
+        texture.ArraySize = desc.ArraySize;
+        texture.MipLevels = desc.MipLevels;
+        texture.Format = desc.Format;
+        texture.Pixels = std::move(desc.Pixels);
+        if (mContext)
+        {
+            const TextureCreateInfo createInfo{
+                .Width = texture.Width,
+                .Height = texture.Height,
+                .MipLevels = texture.MipLevels,
+                .Format = texture.Format,
+                .ViewType = ViewType::eTexture2D,
+            };
+            texture.GPUTexture = mContext->CreateTexture(createInfo, desc.Name);
+        }
+        const auto size = texture.Pixels.size();
+        const auto gpuTexture = texture.GPUTexture;
+        mTextureResidency.Register(handle, texture.Width, texture.Height, texture.MipLevels);
+        mTextures.Finish(handle, std::move(texture), size);
+        if (gpuTexture != TextureHandle::eNull) UpdateTextureSlots(handle);
+    }
+
+    void Resources::Finish(const AssetHandle<Material> handle, MaterialDesc&& desc, const Opt<float> priority)
+    {
+        // Textures of a streamed material are streamed as well, with the priority of the material
+        const auto loadTexture = [&](const Opt<AssetID>& textureID)
+        {
+            return textureID ? Load<Texture>(textureID.value(), priority) : AssetHandle<Texture>{};
+        };
+
+        Material material;
+        material.ID = desc.ID;
+        material.BaseColorTexture = loadTexture(desc.BaseColorTextureID);
+        material.NormalTexture = loadTexture(desc.NormalTextureID);
+        material.MetallicRoughnessTexture = loadTexture(desc.MetallicRoughnessTextureID);
+        material.OcclusionTexture = loadTexture(desc.OcclusionTextureID);
+        material.EmissiveTexture = loadTexture(desc.EmissiveTextureID);
+
+        // Textures that are still streaming are filled in by UpdateTextureSlots once they finish
+        ResolveTextureSlots(material, desc.Params);
+        material.ParamsIndex = mMaterialTable.Add(desc.Params);
+        mMaterials.Finish(handle, std::move(material), sizeof(Material));
+    }
+
+    void Resources::Finish(const AssetHandle<Mesh> handle, MeshDesc&& desc, const Opt<float> priority)
+    {
+        Mesh mesh;
+        mesh.Primitives.reserve(desc.Primitives.size());
+        for (auto& [indices, vertices, materialID, bounds] : desc.Primitives)
+        {
+            auto& primitive = mesh.Primitives.emplace_back();
+            primitive.Indices = std::move(indices);
+            primitive.Vertices = std::move(vertices);
+            primitive.Bounds = bounds;
+            if (materialID)
+            {
+                primitive.Material = Load<Material>(materialID.value(), priority);
+            }
+            if (mContext && mUploads)
+            {
+                UploadPrimitive(primitive, desc.Name);
+            }
+        }
+        const auto size = GetMeshSize(mesh);
+        mMeshes.Finish(handle, std::move(mesh), size);
+    }
+
+    void Resources::Finish(StreamResult&& result)
+    {
+        if (!result.Asset)
+        {
+            // Drop the reserved slot, everyone holding its handle now sees it as stale
+            const auto drop = [&]<typename T>(AssetPool<T>& pool)
+            {
+                if (const auto handle = pool.Find(result.ID); !pool.IsLoaded(handle))
+                {
+                    Unload(handle);
+                }
+            };
+            switch (result.Type)
+            {
+            case AssetType::eTexture:
+                // Reading mips of a loaded texture failed, it may ask for them again
+                if (const auto handle = mTextures.Find(result.ID); mTextures.IsLoaded(handle))
+                {
+                    mTextureResidency.OnMipsLoaded(handle, mTextureResidency.GetResidentMip(handle));
+                    return;
+                }
+                drop(mTextures);
+                break;
+            case AssetType::eMaterial:
+                drop(mMaterials);
+                break;
+            case AssetType::eMesh:
+                drop(mMeshes);
+                break;
+            }
+            return;
+        }
+
+        std::visit([&]<typename Desc>(Desc& desc)
+        {
+            constexpr bool isTexture = std::is_same_v<Desc, TextureDesc> || std::is_same_v<Desc, TextureMipsDesc>;
+            using T = std::conditional_t<isTexture, Texture,
+                                         std::conditional_t<std::is_same_v<Desc, MaterialDesc>, Material, Mesh>>;
+            auto& pool = GetPool<T>();
+            // The asset may have been loaded right away or unloaded while it was streaming
+            const auto handle = pool.Find(result.ID);
+            if (handle.IsNull()) return;
+            if constexpr (std::is_same_v<Desc, TextureMipsDesc>)
+            {
+                // Mips are only read for loaded textures
+                if (pool.IsLoaded(handle)) RefineTexture(handle, std::move(desc));
+            }
+            else if (pool.IsLoaded(handle))
+            {
+                // A mip request for the texture may have been merged into this load, it can ask again
+                if constexpr (std::is_same_v<T, Texture>)
+                {
+                    mTextureResidency.OnMipsLoaded(handle, mTextureResidency.GetResidentMip(handle));
+                }
+            }
+            else
+            {
+                Finish(handle, std::move(desc), result.Priority);
+                kAssetsLoaded.Add();
+            }
+        }, result.Asset.value());
+    }
+
+    void Resources::Release(const AssetHandle<Texture> handle) { mTextures.Release(handle); }
+    void Resources::Release(const AssetHandle<Material> handle) { mMaterials.Release(handle); }
+    void Resources::Release(const AssetHandle<Mesh> handle) { mMeshes.Release(handle); }
+
+    void Resources::Unload(const AssetHandle<Texture> handle)
+    {
+        mTextureResidency.Unregister(handle);
+        const auto texture = mTextures.Remove(handle);
+        if (texture && texture->GPUTexture != TextureHandle::eNull)
+        {
+            mContext->DestroyTexture(texture->GPUTexture);
+        }
+    }
+
+    void Resources::Unload(const AssetHandle<Material> handle)
+    {
+        // A material that is still streaming, or failed to, holds no params entry or textures yet
+        const bool loaded = mMaterials.IsLoaded(handle);
+        const auto material = mMaterials.Remove(handle);
+        if (!material || !loaded) return;
+
+        mMaterialTable.Release(material->ParamsIndex);
+        Release(material->BaseColorTexture);
+        Release(material->NormalTexture);
+        Release(material->MetallicRoughnessTexture);
+        Release(material->OcclusionTexture);
+        Release(material->EmissiveTexture);
+    }
+
+    void Resources::Unload(const AssetHandle<Mesh> handle)
+    {
+        const auto mesh = mMeshes.Remove(handle);
+        if (!mesh) return;
+
+        for (const auto& primitive : mesh->Primitives)
+        {
+            Release(primitive.Material);
+            DestroyPrimitive(primitive);
+        }
+    }
+
+    void Resources::Update()
+    {
+        NEO_PROFILE_FUNCTION();
+        mFrame++;
+
+        const auto start = std::chrono::steady_clock::now();
+        StreamResult result;
+        while (std::chrono::steady_clock::now() - start < mFrameBudget && mStreamer.PopResult(result))
+        {
+            NEO_PROFILE_SCOPE("Resources::Finish");
+            Finish(std::move(result));
+        }
+
+        kStreamingPending.Set(static_cast<i64>(mStreamer.GetPendingCount()));
+
+        UpdateTextureResidency();
+        EvictUnused();
+    }
+
+    void Resources::UpdateTextureResidency()
+    {
+        NEO_PROFILE_FUNCTION();
+        mTextureResidency.Update(mMipStreamIn, mMipEvict);
+
+        for (const auto& [handle, mip, screenSize] : mMipEvict)
+        {
+            auto* texture = mTextures.Get(handle);
+            if (!texture || mip <= texture->ResidentMip) continue;
+
+            const auto dropped = GetMipOffset(texture->Width, texture->Height, mip) -
+                GetMipOffset(texture->Width, texture->Height, texture->ResidentMip);
+            texture->Pixels.erase(texture->Pixels.begin(),
+                                  texture->Pixels.begin() + static_cast<std::ptrdiff_t>(dropped));
+            texture->Pixels.shrink_to_fit();
+            texture->ResidentMip = mip;
+            mTextures.SetSize(handle, texture->Pixels.size());
+        }
+
+        // Only the mips in front of the resident ones are read, the texture is listed again once they arrive
+        for (const auto& [handle, mip, screenSize] : mMipStreamIn)
+        {
+            const auto* texture = mTextures.Get(handle);
+            const auto id = mTextures.GetID(handle);
+            const auto path = texture ? FindPath(id) : std::nullopt;
+            if (!path) continue;
+
+            const MipRange mips{
+                .Width = texture->Width,
+                .Height = texture->Height,
+                .MipLevels = texture->MipLevels,
+                .FirstMip = mip,
+                .EndMip = texture->ResidentMip,
+            };
+            mStreamer.RequestMips(id, path.value(), mips, screenSize);
+            kMipRequests.Add();
+        }
+    }
+
+    void Resources::RefineTexture(const AssetHandle<Texture> handle, TextureMipsDesc&& desc)
+    {
+        auto* texture = mTextures.Get(handle);
+        if (!texture) return;
+
+        // Mips may have been dropped or wanted since the request, only the ones in front of the resident ones
+        // that the data covers are used, and nothing if dropping left a gap between the two
+        const auto resident = texture->ResidentMip;
+        const auto first = std::max(desc.FirstMip, mTextureResidency.GetTargetMip(handle));
+        const auto dataBegin = GetMipOffset(texture->Width, texture->Height, desc.FirstMip);
+        const auto dataEnd = GetMipOffset(texture->Width, texture->Height, desc.EndMip);
+        if (first >= resident || desc.EndMip < resident || desc.Pixels.size() != dataEnd - dataBegin)
+        {
+            mTextureResidency.OnMipsLoaded(handle, resident);
+            return;
+        }
+
+        const auto begin = GetMipOffset(texture->Width, texture->Height, first) - dataBegin;
+        const auto end = GetMipOffset(texture->Width, texture->Height, resident) - dataBegin;
+        texture->Pixels.insert(texture->Pixels.begin(),
+                               desc.Pixels.begin() + static_cast<std::ptrdiff_t>(begin),
+                               desc.Pixels.begin() + static_cast<std::ptrdiff_t>(end));
+        texture->ResidentMip = first;
+        mTextures.SetSize(handle, texture->Pixels.size());
+        mTextureResidency.OnMipsLoaded(handle, first);
+    }
+
+    void Resources::ReportMaterialUsage(const AssetHandle<Material> material, const float screenSize)
+    {
+        const auto* entry = mMaterials.Get(material);
+        if (!entry) return;
+
+        ReportTextureUsage(entry->BaseColorTexture, screenSize);
+        ReportTextureUsage(entry->NormalTexture, screenSize);
+        ReportTextureUsage(entry->MetallicRoughnessTexture, screenSize);
+        ReportTextureUsage(entry->OcclusionTexture, screenSize);
+        ReportTextureUsage(entry->EmissiveTexture, screenSize);
+    }
+
+    u32 Resources::GetTextureDescriptor(const AssetHandle<Texture> handle) const
+    {
+        const auto* texture = mTextures.Get(handle);
+        if (!texture || texture->GPUTexture == TextureHandle::eNull) return kNoTextureDescriptor;
+        return mContext->GetGPUAddress(texture->GPUTexture);
+    }
+
+    void Resources::ResolveTextureSlots(const Material& material, MaterialParams& params) const
+    {
+        params.BaseColorTexture = GetTextureDescriptor(material.BaseColorTexture);
+        params.NormalTexture = GetTextureDescriptor(material.NormalTexture);
+        params.MetallicRoughnessTexture = GetTextureDescriptor(material.MetallicRoughnessTexture);
+        params.OcclusionTexture = GetTextureDescriptor(material.OcclusionTexture);
+        params.EmissiveTexture = GetTextureDescriptor(material.EmissiveTexture);
+    }
+
+    void Resources::UpdateTextureSlots(const AssetHandle<Texture> handle)
+    {
+        mMaterials.ForEachLoaded([&](AssetHandle<Material>, Material& material)
+        {
+            const auto textures = {material.BaseColorTexture, material.NormalTexture,
+                                   material.MetallicRoughnessTexture, material.OcclusionTexture,
+                                   material.EmissiveTexture};
+            if (std::ranges::find(textures, handle) == textures.end()) return;
+
+            auto params = mMaterialTable.Get(material.ParamsIndex);
+            ResolveTextureSlots(material, params);
+            if (params == mMaterialTable.Get(material.ParamsIndex)) return;
+            // Added before the old entry is released, so an unchanged entry is not freed in between
+            const auto index = mMaterialTable.Add(params);
+            mMaterialTable.Release(material.ParamsIndex);
+            material.ParamsIndex = index;
+        });
+    }
+
+    void Resources::UploadPrimitive(Primitive& primitive, const std::string_view name)
+    {
+        if (primitive.Vertices.empty()) return;
+
+        // The data stays on the CPU for culling and picking, so the uploads copy rather than take it
+        const BufferCreateInfo vertexCreateInfo{
+            .FirstElement = 0,
+            .NumElements = static_cast<u32>(primitive.Vertices.size()),
+            .Stride = sizeof(Vertex),
+            .Type = BufferType::eStorage,
+        };
+        primitive.VertexBuffer = mContext->CreateBuffer(vertexCreateInfo, fmt::format("{} Vertices", name));
+        primitive.Upload = mUploads->Upload(primitive.VertexBuffer, 0, std::as_bytes(std::span(primitive.Vertices)));
+        if (primitive.Indices.empty()) return;
+
+        const BufferCreateInfo indexCreateInfo{
+            .FirstElement = 0,
+            .NumElements = static_cast<u32>(primitive.Indices.size()),
+            .Stride = sizeof(u32),
+            .Type = BufferType::eStorage,
+        };
+        primitive.IndexBuffer = mContext->CreateBuffer(indexCreateInfo, fmt::format("{} Indices", name));
+        // Uploads complete in order, so the index upload finishing means both did
+        primitive.Upload = mUploads->Upload(primitive.IndexBuffer, 0, std::as_bytes(std::span(primitive.Indices)));
+    }
+
+    void Resources::DestroyPrimitive(const Primitive& primitive)
+    {
+        if (primitive.VertexBuffer != BufferHandle::eNull) mContext->DestroyBuffer(primitive.VertexBuffer);
+        if (primitive.IndexBuffer != BufferHandle::eNull) mContext->DestroyBuffer(primitive.IndexBuffer);
+    }
+
+    void Resources::EvictUnused()
+    {
+        NEO_PROFILE_FUNCTION();
+        if (GetResidentSize() <= mMemoryBudget) return;
+
+        struct Candidate
+        {
+            u64 LastUsed;
+            AssetType Type;
+            u32 Handle;
+        };
+        ScratchScope scratch;
+        std::pmr::vector<Candidate> candidates(scratch.GetResource());
+        const auto collect = [&](const AssetType type)
+        {
+            return [&, type]<typename T>(const AssetHandle<T> handle, const u64 lastUsed, u64)
+            {
+                candidates.emplace_back(lastUsed, type, handle.GetValue());
+            };
+        };
+        mTextures.ForEachUnreferenced(collect(AssetType::eTexture));
+        mMaterials.ForEachUnreferenced(collect(AssetType::eMaterial));
+        mMeshes.ForEachUnreferenced(collect(AssetType::eMesh));
+        std::ranges::sort(candidates, {}, &Candidate::LastUsed);
+
+        // Unloading a mesh or material only frees what it refers to once that is evicted on a later frame
+        for (const auto& [lastUsed, type, handle] : candidates)
+        {
+            if (GetResidentSize() <= mMemoryBudget) break;
+
+            switch (type)
+            {
+            case AssetType::eTexture:
+                Unload(std::bit_cast<AssetHandle<Texture>>(handle));
+                break;
+            case AssetType::eMaterial:
+                Unload(std::bit_cast<AssetHandle<Material>>(handle));
+                break;
+            case AssetType::eMesh:
+                Unload(std::bit_cast<AssetHandle<Mesh>>(handle));
+                break;
+            }
+        }
+    }
+
+    u64 Resources::GetResidentSize() const
+    {
+        return mTextures.GetLoadedSize() + mMaterials.GetLoadedSize() + mMeshes.GetLoadedSize();
     }
 
     void Resources::CleanupResources()
     {
-        
+        mTextures.ForEachLoaded([&](AssetHandle<Texture>, const Texture& texture)
+        {
+            if (texture.GPUTexture != TextureHandle::eNull) mContext->DestroyTexture(texture.GPUTexture);
+        });
+        mMeshes.ForEachLoaded([&](AssetHandle<Mesh>, const Mesh& mesh)
+        {
+            for (const auto& primitive : mesh.Primitives)
+            {
+                DestroyPrimitive(primitive);
+            }
+        });
+        mMeshes.Clear();
+        mMaterials.Clear();
+        mMaterialTable.Clear();
+        mTextures.Clear();
+        mTextureResidency.Clear();
+    }
+
+    Opt<std::string> Resources::FindPath(const AssetID& id) const
+    {
+        const auto it = mPaths.find(id);
+        if (it == mPaths.end())
+        {
+            Log::Error("Resources: Asset {} is not in the registry", uuids::to_string(id));
+            return std::nullopt;
+        }
+        return it->second;
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,8 @@
 #include "Core/Scripting.hpp"
 #include "Core/Engine.hpp"
 #include "Tools/Log.hpp"
+#include "Tools/Profiler.hpp"
+#include "Tools/Metrics.hpp"
 #include "mono/jit/jit.h"
 #include "mono/metadata/assembly.h"
 
@@ -22,6 +24,8 @@ namespace
     }
     
     MonoObject* object = nullptr;
+
+    const Neo::Counter kScriptCalls("Scripting/Calls");
 }
 
 namespace Neo
@@ -39,6 +43,7 @@ namespace Neo
 
     void Scripting::Update(float)
     {
+        NEO_PROFILE_FUNCTION();
 
     }
 
@@ -71,6 +76,7 @@ namespace Neo
 
     MonoAssembly* Scripting::LoadAssembly(const std::string_view assemblyPath)
     {
+        NEO_PROFILE_FUNCTION();
         const auto code = FileIO::ReadBinaryFile(assemblyPath);
         MonoImageOpenStatus status;
         auto* monoData = const_cast<char*>(code.data());
@@ -136,6 +142,8 @@ namespace Neo
 
     MonoObject* Scripting::Instantiate(MonoAssembly* assembly, const char* namespaceName, const char* className) const
     {
+        NEO_PROFILE_FUNCTION();
+        kScriptCalls.Add();
         auto* assemblyClass = GetClassInAssembly(assembly, namespaceName, className);
         auto* object = mono_object_new(mAppDomain, assemblyClass);
         mono_runtime_object_init(object);
@@ -144,6 +152,8 @@ namespace Neo
 
     void Scripting::CallFunction(MonoObject* object, const std::string_view functionName, void* params) const
     {
+        NEO_PROFILE_FUNCTION();
+        kScriptCalls.Add();
         auto* method = mono_class_get_method_from_name(mono_object_get_class(object), functionName.data(), 1);
         mono_runtime_invoke(method, object, &params, nullptr);
     }
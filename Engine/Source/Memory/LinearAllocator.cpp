@@ -0,0 +1,87 @@
+#include "Memory/LinearAllocator.hpp"
+
+namespace Neo
+{
+    LinearAllocator::LinearAllocator(const size_t blockSize) : mBlockSize(blockSize)
+    {
+    }
+
+    void* LinearAllocator::Allocate(const size_t size, const size_t alignment)
+    {
+        const auto tryBlock = [&](const u32 blockIndex, const size_t offset) -> void*
+        {
+            const auto& block = mBlocks[blockIndex];
+            const auto address = reinterpret_cast<uintptr_t>(block.Memory.get()) + offset;
+            const auto aligned = (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+            const auto end = aligned - reinterpret_cast<uintptr_t>(block.Memory.get()) + size;
+            if (end > block.Size) return nullptr;
+
+            mBlock = blockIndex;
+            mOffset = end;
+            return reinterpret_cast<void*>(aligned);
+        };
+
+        if (!mBlocks.empty())
+        {
+            if (auto* memory = tryBlock(mBlock, mOffset)) return memory;
+
+            // Blocks past the current one are empty, left over from before the last Rewind
+            for (u32 blockIndex = mBlock + 1; blockIndex < mBlocks.size(); blockIndex++)
+            {
+                if (auto* memory = tryBlock(blockIndex, 0)) return memory;
+            }
+        }
+
+        AddBlock(std::max(mBlockSize, size + alignment));
+        return tryBlock(static_cast<u32>(mBlocks.size() - 1), 0);
+    }
+
+    void LinearAllocator::Rewind(const Marker marker)
+    {
+        if (marker.Block == 0 && marker.Offset == 0)
+        {
+            Reset();
+            return;
+        }
+        mBlock = marker.Block;
+        mOffset = marker.Offset;
+    }
+
+    void LinearAllocator::Reset()
+    {
+        // Merge the blocks so the next round fits into one without going back to the heap
+        if (mBlocks.size() > 1)
+        {
+            const auto capacity = GetCapacity();
+            mBlocks.clear();
+            AddBlock(capacity);
+        }
+        mBlock = 0;
+        mOffset = 0;
+    }
+
+    size_t LinearAllocator::GetUsed() const
+    {
+        size_t used = mOffset;
+        for (u32 blockIndex = 0; blockIndex < mBlock; blockIndex++)
+        {
+            used += mBlocks[blockIndex].Size;
+        }
+        return used;
+    }
+
+    size_t LinearAllocator::GetCapacity() const
+    {
+        size_t capacity = 0;
+        for (const auto& block : mBlocks)
+        {
+            capacity += block.Size;
+        }
+        return capacity;
+    }
+
+    void LinearAllocator::AddBlock(const size_t size)
+    {
+        mBlocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size), size);
+    }
+}
@@ -0,0 +1,278 @@
+#include "Memory/MemoryTracker.hpp"
+
+#ifdef NEO_MEMORY_TRACKING
+#include "stacktrace"
+
+namespace
+{
+    // Stored in front of every allocation so frees know what to credit back
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) AllocationHeader
+    {
+        u64 Size = 0;
+        Neo::MemoryTag Tag = Neo::MemoryTag::eUntagged;
+    };
+
+    struct TagCounters
+    {
+        std::atomic<u64> LiveBytes = 0;
+        std::atomic<u64> PeakBytes = 0;
+        std::atomic<u64> LiveAllocations = 0;
+        std::atomic<u64> TotalAllocations = 0;
+    };
+
+    std::array<TagCounters, Neo::kMemoryTagCount> gTags;
+    std::atomic<u64> gLiveBytes = 0;
+    std::atomic<u64> gPeakBytes = 0;
+    std::atomic<u64> gTotalAllocations = 0;
+    std::atomic<u64> gFrameAllocations = 0;
+    std::atomic<u64> gFrameBytes = 0;
+    std::atomic<u64> gLastFrameAllocations = 0;
+    std::atomic<u64> gLastFrameBytes = 0;
+    std::atomic<bool> gCaptureCallstacks = false;
+
+    thread_local Neo::MemoryTag tCurrentTag = Neo::MemoryTag::eUntagged;
+    // Set while the tracker allocates for itself, so capturing a callstack does not recurse
+    thread_local bool tInsideTracker = false;
+
+    struct LeakTable
+    {
+        std::mutex Mutex;
+        std::unordered_map<void*, std::pair<u64, std::stacktrace>> Allocations;
+    };
+
+    LeakTable& GetLeakTable()
+    {
+        static LeakTable table;
+        return table;
+    }
+
+    void UpdatePeak(std::atomic<u64>& peak, const u64 value)
+    {
+        auto current = peak.load(std::memory_order_relaxed);
+        while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void* TrackedAllocate(const size_t size)
+    {
+        auto* block = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+        if (!block) return nullptr;
+        block->Size = size;
+        block->Tag = tCurrentTag;
+        auto* memory = block + 1;
+        Neo::MemoryTracker::OnAllocate(memory, size, block->Tag);
+        return memory;
+    }
+
+    void TrackedFree(void* memory)
+    {
+        if (!memory) return;
+        auto* block = static_cast<AllocationHeader*>(memory) - 1;
+        Neo::MemoryTracker::OnFree(memory, block->Size, block->Tag);
+        std::free(block);
+    }
+
+    // Over-aligned allocations, like the ones of std::pmr::new_delete_resource, keep the start of the block they
+    // were placed in right in front of their header
+    void* TrackedAllocateAligned(const size_t size, const std::align_val_t alignment)
+    {
+        const auto align = static_cast<size_t>(alignment);
+        const auto front = sizeof(void*) + sizeof(AllocationHeader);
+        auto* block = static_cast<std::byte*>(std::malloc(front + align - 1 + size));
+        if (!block) return nullptr;
+        const auto start = reinterpret_cast<uintptr_t>(block) + front;
+        auto* memory = block + front + (align - start % align) % align;
+        auto* header = reinterpret_cast<AllocationHeader*>(memory) - 1;
+        header->Size = size;
+        header->Tag = tCurrentTag;
+        reinterpret_cast<void**>(header)[-1] = block;
+        Neo::MemoryTracker::OnAllocate(memory, size, header->Tag);
+        return memory;
+    }
+
+    void TrackedFreeAligned(void* memory)
+    {
+        if (!memory) return;
+        auto* header = static_cast<AllocationHeader*>(memory) - 1;
+        Neo::MemoryTracker::OnFree(memory, header->Size, header->Tag);
+        std::free(reinterpret_cast<void**>(header)[-1]);
+    }
+}
+
+namespace Neo
+{
+    void MemoryTracker::BeginFrame()
+    {
+        gLastFrameAllocations = gFrameAllocations.exchange(0, std::memory_order_relaxed);
+        gLastFrameBytes = gFrameBytes.exchange(0, std::memory_order_relaxed);
+    }
+
+    MemorySnapshot MemoryTracker::GetSnapshot()
+    {
+        MemorySnapshot snapshot;
+        for (size_t index = 0; index < kMemoryTagCount; index++)
+        {
+            const auto& counters = gTags[index];
+            snapshot.Tags[index] = MemoryTagStats{
+                .LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed),
+                .PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed),
+                .LiveAllocations = counters.LiveAllocations.load(std::memory_order_relaxed),
+                .TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed),
+            };
+        }
+        snapshot.LiveBytes = gLiveBytes.load(std::memory_order_relaxed);
+        snapshot.PeakBytes = gPeakBytes.load(std::memory_order_relaxed);
+        snapshot.TotalAllocations = gTotalAllocations.load(std::memory_order_relaxed);
+        snapshot.FrameAllocations = gLastFrameAllocations.load(std::memory_order_relaxed);
+        snapshot.FrameBytes = gLastFrameBytes.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    u64 MemoryTracker::GetAllocationCount() { return gTotalAllocations.load(std::memory_order_relaxed); }
+
+    void MemoryTracker::ResetPeak()
+    {
+        gPeakBytes = gLiveBytes.load(std::memory_order_relaxed);
+        for (auto& counters : gTags)
+        {
+            counters.PeakBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+        }
+    }
+
+    void MemoryTracker::SetCaptureCallstacks(const bool capture) { gCaptureCallstacks = capture; }
+
+    void MemoryTracker::ReportLeaks()
+    {
+        auto& table = GetLeakTable();
+        tInsideTracker = true;
+        {
+            std::scoped_lock lock(table.Mutex);
+            Log::Warn("MemoryTracker: {} live allocations with callstacks", table.Allocations.size());
+            for (const auto& [memory, allocation] : table.Allocations)
+            {
+                Log::Warn("{} bytes at {}\n{}", allocation.first, memory, std::to_string(allocation.second));
+            }
+        }
+        tInsideTracker = false;
+    }
+
+    void MemoryTracker::OnAllocate(void* memory, const size_t size, const MemoryTag tag)
+    {
+        if (tInsideTracker) return;
+
+        auto& counters = gTags[static_cast<size_t>(tag)];
+        UpdatePeak(counters.PeakBytes, counters.LiveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+        counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+        UpdatePeak(gPeakBytes, gLiveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+        gTotalAllocations.fetch_add(1, std::memory_order_relaxed);
+        gFrameAllocations.fetch_add(1, std::memory_order_relaxed);
+        gFrameBytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (gCaptureCallstacks.load(std::memory_order_relaxed))
+        {
+            tInsideTracker = true;
+            auto& table = GetLeakTable();
+            auto callstack = std::stacktrace::current(2);
+            {
+                std::scoped_lock lock(table.Mutex);
+                table.Allocations.insert_or_assign(memory, std::pair{static_cast<u64>(size), std::move(callstack)});
+            }
+            tInsideTracker = false;
+        }
+    }
+
+    void MemoryTracker::OnFree(void* memory, const size_t size, const MemoryTag tag)
+    {
+        if (tInsideTracker) return;
+
+        auto& counters = gTags[static_cast<size_t>(tag)];
+        counters.LiveBytes.fetch_sub(size, std::memory_order_relaxed);
+        counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+        gLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+
+        if (gCaptureCallstacks.load(std::memory_order_relaxed))
+        {
+            tInsideTracker = true;
+            auto& table = GetLeakTable();
+            {
+                std::scoped_lock lock(table.Mutex);
+                table.Allocations.erase(memory);
+            }
+            tInsideTracker = false;
+        }
+    }
+
+    MemoryTag MemoryTracker::GetCurrentTag() { return tCurrentTag; }
+    void MemoryTracker::SetCurrentTag(const MemoryTag tag) { tCurrentTag = tag; }
+}
+
+void* operator new(const size_t size)
+{
+    if (auto* memory = TrackedAllocate(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size)
+{
+    if (auto* memory = TrackedAllocate(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size); }
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size); }
+
+void operator delete(void* memory) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, size_t) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, size_t) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory); }
+
+void* operator new(const size_t size, const std::align_val_t alignment)
+{
+    if (auto* memory = TrackedAllocateAligned(size, alignment)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment)
+{
+    if (auto* memory = TrackedAllocateAligned(size, alignment)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocateAligned(size, alignment);
+}
+
+void* operator new[](const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocateAligned(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+void operator delete(void* memory, size_t, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+void operator delete[](void* memory, size_t, std::align_val_t) noexcept { TrackedFreeAligned(memory); }
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFreeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { TrackedFreeAligned(memory); }
+
+#else
+
+namespace Neo
+{
+    void MemoryTracker::BeginFrame() {}
+    MemorySnapshot MemoryTracker::GetSnapshot() { return {}; }
+    u64 MemoryTracker::GetAllocationCount() { return 0; }
+    void MemoryTracker::ResetPeak() {}
+    void MemoryTracker::SetCaptureCallstacks(bool) {}
+    void MemoryTracker::ReportLeaks() {}
+    void MemoryTracker::OnAllocate(void*, size_t, MemoryTag) {}
+    void MemoryTracker::OnFree(void*, size_t, MemoryTag) {}
+    MemoryTag MemoryTracker::GetCurrentTag() { return MemoryTag::eUntagged; }
+    void MemoryTracker::SetCurrentTag(MemoryTag) {}
+}
+
+#endif
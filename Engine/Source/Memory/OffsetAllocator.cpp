@@ -0,0 +1,242 @@
+#include "Memory/OffsetAllocator.hpp"
+
+namespace Neo
+{
+    OffsetAllocator::OffsetAllocator(const u64 size, const u64 granularity)
+        : mSize(size), mGranularity(std::bit_ceil(std::max<u64>(granularity, 1)))
+    {
+        Reset();
+    }
+
+    Opt<OffsetAllocation> OffsetAllocator::Allocate(const u64 size, const u64 alignment)
+    {
+        if (!std::has_single_bit(alignment)) return std::nullopt;
+
+        const auto units = std::max<u64>((size + mGranularity - 1) / mGranularity, 1);
+        const auto alignmentUnits = std::max<u64>(alignment / mGranularity, 1);
+        // Any block of this size has room for an aligned start, whatever its offset
+        const auto [firstLevel, secondLevel] = GetSearchBin(units + alignmentUnits - 1);
+        const auto bin = FindBin(firstLevel, secondLevel);
+        if (bin == kNone) return std::nullopt;
+
+        auto block = mFreeHeads[bin];
+        RemoveFree(block);
+
+        const auto offset = mBlocks[block].Offset;
+        const auto padding = (offset + alignmentUnits - 1) / alignmentUnits * alignmentUnits - offset;
+        if (padding > 0)
+        {
+            const auto rest = Split(block, padding);
+            InsertFree(block);
+            block = rest;
+        }
+        if (mBlocks[block].Size > units)
+        {
+            InsertFree(Split(block, units));
+        }
+
+        mUsed += units;
+        mAllocations++;
+        return OffsetAllocation{
+            .Offset = mBlocks[block].Offset * mGranularity,
+            .Size = units * mGranularity,
+            .Block = block,
+        };
+    }
+
+    void OffsetAllocator::Free(const OffsetAllocation& allocation)
+    {
+        auto block = allocation.Block;
+        if (block >= mBlocks.size() || mBlocks[block].Free || mBlocks[block].Size == 0)
+        {
+            Log::Error("OffsetAllocator: Free of an allocation that is not live");
+            return;
+        }
+        mUsed -= mBlocks[block].Size;
+        mAllocations--;
+
+        const auto next = mBlocks[block].Next;
+        if (next != kNone && mBlocks[next].Free)
+        {
+            RemoveFree(next);
+            Merge(block, next);
+        }
+        const auto previous = mBlocks[block].Previous;
+        if (previous != kNone && mBlocks[previous].Free)
+        {
+            RemoveFree(previous);
+            Merge(previous, block);
+            block = previous;
+        }
+        InsertFree(block);
+    }
+
+    void OffsetAllocator::FreeDeferred(const OffsetAllocation& allocation, const u64 fenceValue)
+    {
+        mDeferred.emplace_back(DeferredFree{.FenceValue = fenceValue, .Allocation = allocation});
+        mDeferredSize += allocation.Size / mGranularity;
+    }
+
+    void OffsetAllocator::Collect(const u64 completedValue)
+    {
+        while (!mDeferred.empty() && mDeferred.front().FenceValue <= completedValue)
+        {
+            const auto& allocation = mDeferred.front().Allocation;
+            mDeferredSize -= allocation.Size / mGranularity;
+            Free(allocation);
+            mDeferred.pop_front();
+        }
+    }
+
+    void OffsetAllocator::Reset()
+    {
+        mBlocks.clear();
+        mUnusedBlocks.clear();
+        mFreeHeads.fill(kNone);
+        mFirstLevelMask = 0;
+        mSecondLevelMasks.fill(0);
+        mDeferred.clear();
+        mUsed = 0;
+        mDeferredSize = 0;
+        mAllocations = 0;
+        mFreeRegions = 0;
+
+        const auto units = mSize / mGranularity;
+        if (units > 0)
+        {
+            InsertFree(AddBlock(Block{.Offset = 0, .Size = units}));
+        }
+    }
+
+    OffsetAllocatorStats OffsetAllocator::GetStats() const
+    {
+        OffsetAllocatorStats stats{
+            .Used = (mUsed - mDeferredSize) * mGranularity,
+            .Free = (mSize / mGranularity - mUsed) * mGranularity,
+            .Deferred = mDeferredSize * mGranularity,
+            .Allocations = mAllocations - static_cast<u32>(mDeferred.size()),
+            .FreeRegions = mFreeRegions,
+        };
+        if (mFirstLevelMask != 0)
+        {
+            // Only the blocks of the largest size class can be the largest
+            const auto firstLevel = static_cast<u32>(std::bit_width(mFirstLevelMask) - 1);
+            const auto secondLevel = static_cast<u32>(std::bit_width(mSecondLevelMasks[firstLevel]) - 1);
+            for (auto block = mFreeHeads[firstLevel * kSecondLevels + secondLevel]; block != kNone;
+                 block = mBlocks[block].NextFree)
+            {
+                stats.LargestFree = std::max(stats.LargestFree, mBlocks[block].Size * mGranularity);
+            }
+        }
+        return stats;
+    }
+
+    std::pair<u32, u32> OffsetAllocator::GetBin(const u64 size)
+    {
+        const auto log = static_cast<u32>(std::bit_width(size) - 1);
+        if (log < kSecondLevelBits) return {0, static_cast<u32>(size)};
+        const auto secondLevel = static_cast<u32>(size >> (log - kSecondLevelBits)) - kSecondLevels;
+        return {log - kSecondLevelBits + 1, secondLevel};
+    }
+
+    std::pair<u32, u32> OffsetAllocator::GetSearchBin(u64 size)
+    {
+        if (size >= kSecondLevels)
+        {
+            // Round up to the next size class, so every block in it is big enough
+            const auto log = static_cast<u32>(std::bit_width(size) - 1);
+            size += (1ull << (log - kSecondLevelBits)) - 1;
+        }
+        return GetBin(size);
+    }
+
+    u32 OffsetAllocator::FindBin(u32 firstLevel, const u32 secondLevel) const
+    {
+        if (firstLevel >= kFirstLevels) return kNone;
+        auto secondLevelMask = mSecondLevelMasks[firstLevel] & (~0u << secondLevel);
+        if (secondLevelMask == 0)
+        {
+            const auto firstLevelMask = mFirstLevelMask & (~0ull << (firstLevel + 1));
+            if (firstLevelMask == 0) return kNone;
+            firstLevel = static_cast<u32>(std::countr_zero(firstLevelMask));
+            secondLevelMask = mSecondLevelMasks[firstLevel];
+        }
+        return firstLevel * kSecondLevels + static_cast<u32>(std::countr_zero(secondLevelMask));
+    }
+
+    u32 OffsetAllocator::AddBlock(const Block& block)
+    {
+        if (mUnusedBlocks.empty())
+        {
+            mBlocks.emplace_back(block);
+            return static_cast<u32>(mBlocks.size() - 1);
+        }
+        const auto index = mUnusedBlocks.back();
+        mUnusedBlocks.pop_back();
+        mBlocks[index] = block;
+        return index;
+    }
+
+    void OffsetAllocator::InsertFree(const u32 block)
+    {
+        const auto [firstLevel, secondLevel] = GetBin(mBlocks[block].Size);
+        auto& head = mFreeHeads[firstLevel * kSecondLevels + secondLevel];
+        mBlocks[block].Free = true;
+        mBlocks[block].PreviousFree = kNone;
+        mBlocks[block].NextFree = head;
+        if (head != kNone) mBlocks[head].PreviousFree = block;
+        head = block;
+        mFirstLevelMask |= 1ull << firstLevel;
+        mSecondLevelMasks[firstLevel] |= 1u << secondLevel;
+        mFreeRegions++;
+    }
+
+    void OffsetAllocator::RemoveFree(const u32 block)
+    {
+        auto& entry = mBlocks[block];
+        const auto [firstLevel, secondLevel] = GetBin(entry.Size);
+        auto& head = mFreeHeads[firstLevel * kSecondLevels + secondLevel];
+        if (entry.PreviousFree != kNone) mBlocks[entry.PreviousFree].NextFree = entry.NextFree;
+        if (entry.NextFree != kNone) mBlocks[entry.NextFree].PreviousFree = entry.PreviousFree;
+        if (head == block)
+        {
+            head = entry.NextFree;
+            if (head == kNone)
+            {
+                mSecondLevelMasks[firstLevel] &= ~(1u << secondLevel);
+                if (mSecondLevelMasks[firstLevel] == 0) mFirstLevelMask &= ~(1ull << firstLevel);
+            }
+        }
+        entry.Free = false;
+        entry.PreviousFree = kNone;
+        entry.NextFree = kNone;
+        mFreeRegions--;
+    }
+
+    u32 OffsetAllocator::Split(const u32 block, const u64 size)
+    {
+        const auto rest = AddBlock(Block{
+            .Offset = mBlocks[block].Offset + size,
+            .Size = mBlocks[block].Size - size,
+            .Previous = block,
+            .Next = mBlocks[block].Next,
+        });
+        // AddBlock may have grown the array, so the block is looked up again
+        auto& entry = mBlocks[block];
+        if (entry.Next != kNone) mBlocks[entry.Next].Previous = rest;
+        entry.Next = rest;
+        entry.Size = size;
+        return rest;
+    }
+
+    void OffsetAllocator::Merge(const u32 block, const u32 next)
+    {
+        auto& entry = mBlocks[block];
+        const auto& merged = mBlocks[next];
+        entry.Size += merged.Size;
+        entry.Next = merged.Next;
+        if (entry.Next != kNone) mBlocks[entry.Next].Previous = block;
+        mBlocks[next] = Block{};
+        mUnusedBlocks.emplace_back(next);
+    }
+}
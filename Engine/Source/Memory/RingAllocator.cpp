@@ -0,0 +1,33 @@
+#include "Memory/RingAllocator.hpp"
+
+namespace Neo
+{
+    RingAllocator::RingAllocator(const u64 capacity) : mCapacity(capacity)
+    {
+    }
+
+    void RingAllocator::BeginFrame(const u32 frameIndex)
+    {
+        mFrameIndex = frameIndex;
+        // Frames finish in the order they were submitted, so everything before this frame's end is free as well
+        mTail = std::max(mTail, mFrameEnds[frameIndex]);
+    }
+
+    void RingAllocator::EndFrame()
+    {
+        mFrameEnds[mFrameIndex] = mHead;
+    }
+
+    Opt<u64> RingAllocator::Allocate(const u64 size, const u64 alignment)
+    {
+        if (size > mCapacity || mCapacity % alignment != 0) return std::nullopt;
+
+        auto position = (mHead + alignment - 1) / alignment * alignment;
+        const auto lapStart = position / mCapacity * mCapacity;
+        if (position + size > lapStart + mCapacity) position = lapStart + mCapacity;
+        if (position + size - mTail > mCapacity) return std::nullopt;
+
+        mHead = position + size;
+        return position % mCapacity;
+    }
+}
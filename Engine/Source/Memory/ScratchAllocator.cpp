@@ -0,0 +1,22 @@
+#include "Memory/ScratchAllocator.hpp"
+
+namespace
+{
+    Neo::LinearAllocator& GetThreadScratch()
+    {
+        thread_local Neo::LinearAllocator arena(Neo::kScratchArenaSize);
+        return arena;
+    }
+}
+
+namespace Neo
+{
+    ScratchScope::ScratchScope() : mArena(GetThreadScratch()), mMarker(mArena.GetMarker()), mResource(mArena)
+    {
+    }
+
+    ScratchScope::~ScratchScope()
+    {
+        mArena.Rewind(mMarker);
+    }
+}
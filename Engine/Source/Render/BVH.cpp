@@ -0,0 +1,607 @@
+#include "Render/BVH.hpp"
+#include "Memory/ScratchAllocator.hpp"
+#include "Tools/Profiler.hpp"
+#include "Tools/Simd.hpp"
+
+namespace
+{
+    constexpr float kEmptyMin = std::numeric_limits<float>::max();
+    constexpr float kEmptyMax = std::numeric_limits<float>::lowest();
+
+    // Half the surface area, which is all the heuristic needs to compare boxes
+    float GetArea(const glm::vec3 min, const glm::vec3 max)
+    {
+        const auto size = glm::max(max - min, glm::vec3(0.f));
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+}
+
+namespace Neo
+{
+    void BVH::Build()
+    {
+        NEO_PROFILE_FUNCTION();
+        mNodes.clear();
+        mFreeNodes.clear();
+        mRoot = kNone;
+
+        std::vector<BuildItem> items;
+        items.reserve(mCount);
+        for (u32 index = 0; index < mObjects.size(); index++)
+        {
+            const auto& object = mObjects[index];
+            if (object.Node != kNone) items.emplace_back(BuildItem{object.Min, object.Max, index});
+        }
+        if (items.empty()) return;
+
+        mNodes.reserve(items.size() / 2);
+        mRoot = BuildNode(items, kNone);
+    }
+
+    void BVH::Clear()
+    {
+        mNodes.clear();
+        mFreeNodes.clear();
+        mObjects.clear();
+        mFreeObjects.clear();
+        mRoot = kNone;
+        mCount = 0;
+    }
+
+    BVHProxy BVH::Insert(const Bounds& bounds, const u32 value)
+    {
+        u32 index;
+        if (!mFreeObjects.empty())
+        {
+            index = mFreeObjects.back();
+            mFreeObjects.pop_back();
+        }
+        else
+        {
+            index = static_cast<u32>(mObjects.size());
+            mObjects.emplace_back();
+        }
+        mObjects[index] = {.Min = bounds.Min, .Max = bounds.Max, .Value = value};
+        mCount++;
+
+        if (mRoot == kNone)
+        {
+            mRoot = AllocateNode(kNone);
+            SetChild(mRoot, 0, index | kObjectBit, bounds.Min, bounds.Max);
+            return static_cast<BVHProxy>(index);
+        }
+
+        // Walk down into whichever child grows the least, until a node has room or an object has to share
+        auto node = mRoot;
+        while (true)
+        {
+            if (mNodes[node].Used != 0xFu)
+            {
+                SetChild(node, static_cast<u32>(std::countr_one(mNodes[node].Used)), index | kObjectBit, bounds.Min,
+                         bounds.Max);
+                Refit(node);
+                break;
+            }
+
+            const auto& current = mNodes[node];
+            u32 best = 0;
+            auto bestGrowth = std::numeric_limits<float>::max();
+            auto bestArea = std::numeric_limits<float>::max();
+            for (u32 slot = 0; slot < kWidth; slot++)
+            {
+                const glm::vec3 min(current.MinX[slot], current.MinY[slot], current.MinZ[slot]);
+                const glm::vec3 max(current.MaxX[slot], current.MaxY[slot], current.MaxZ[slot]);
+                const auto area = GetArea(min, max);
+                const auto growth = GetArea(glm::min(min, bounds.Min), glm::max(max, bounds.Max)) - area;
+                if (growth < bestGrowth || (growth == bestGrowth && area < bestArea))
+                {
+                    best = slot;
+                    bestGrowth = growth;
+                    bestArea = area;
+                }
+            }
+
+            const auto child = current.Children[best];
+            if (child & kObjectBit)
+            {
+                const auto& existing = mObjects[child & ~kObjectBit];
+                const auto pair = AllocateNode(node);
+                SetChild(pair, 0, child, existing.Min, existing.Max);
+                SetChild(pair, 1, index | kObjectBit, bounds.Min, bounds.Max);
+                const auto [min, max] = GetNodeBounds(pair);
+                SetChild(node, best, pair, min, max);
+                Refit(node);
+                break;
+            }
+            node = child;
+        }
+        return static_cast<BVHProxy>(index);
+    }
+
+    void BVH::Remove(const BVHProxy proxy)
+    {
+        const auto index = static_cast<u32>(proxy);
+        if (index >= mObjects.size() || mObjects[index].Node == kNone) return;
+
+        auto& object = mObjects[index];
+        auto node = object.Node;
+        ClearChild(node, object.Slot);
+        object.Node = kNone;
+        mFreeObjects.emplace_back(index);
+        mCount--;
+
+        // Nodes left empty are removed, and nodes left with one child hand it to their parent
+        while (true)
+        {
+            const auto used = std::popcount(mNodes[node].Used);
+            if (node == mRoot)
+            {
+                if (used == 0)
+                {
+                    FreeNode(node);
+                    mRoot = kNone;
+                }
+                else if (const auto only = mNodes[node].Children[std::countr_zero(mNodes[node].Used)];
+                    used == 1 && !(only & kObjectBit))
+                {
+                    FreeNode(node);
+                    mRoot = only;
+                    mNodes[only].Parent = kNone;
+                }
+                break;
+            }
+
+            const auto parent = mNodes[node].Parent;
+            const auto parentSlot = static_cast<u32>(std::ranges::find(mNodes[parent].Children, node) -
+                mNodes[parent].Children.begin());
+            if (used == 0)
+            {
+                ClearChild(parent, parentSlot);
+                FreeNode(node);
+                node = parent;
+                continue;
+            }
+            if (used == 1)
+            {
+                const auto& current = mNodes[node];
+                const auto slot = static_cast<u32>(std::countr_zero(current.Used));
+                const auto child = current.Children[slot];
+                const glm::vec3 min(current.MinX[slot], current.MinY[slot], current.MinZ[slot]);
+                const glm::vec3 max(current.MaxX[slot], current.MaxY[slot], current.MaxZ[slot]);
+                SetChild(parent, parentSlot, child, min, max);
+                FreeNode(node);
+                node = parent;
+            }
+            Refit(node);
+            break;
+        }
+    }
+
+    void BVH::Update(const BVHProxy proxy, const Bounds& bounds)
+    {
+        const auto index = static_cast<u32>(proxy);
+        if (index >= mObjects.size() || mObjects[index].Node == kNone) return;
+
+        auto& object = mObjects[index];
+        object.Min = bounds.Min;
+        object.Max = bounds.Max;
+        SetChild(object.Node, object.Slot, index | kObjectBit, bounds.Min, bounds.Max);
+        Refit(object.Node);
+    }
+
+    void BVH::QueryFrustum(const Frustum& frustum, std::vector<u32>& values) const
+    {
+        NEO_PROFILE_FUNCTION();
+        if (mRoot == kNone) return;
+
+        struct Plane
+        {
+            Float4 X, Y, Z, W;
+            Float4 AbsX, AbsY, AbsZ;
+        };
+        std::array<Plane, 6> planes;
+        for (u32 index = 0; index < planes.size(); index++)
+        {
+            const auto& plane = frustum.Planes[index];
+            planes[index] = {
+                Float4::Broadcast(plane.x), Float4::Broadcast(plane.y), Float4::Broadcast(plane.z),
+                Float4::Broadcast(plane.w), Float4::Broadcast(std::abs(plane.x)),
+                Float4::Broadcast(std::abs(plane.y)), Float4::Broadcast(std::abs(plane.z)),
+            };
+        }
+        const auto zero = Float4::Broadcast(0.f);
+        const auto half = Float4::Broadcast(0.5f);
+
+        // Walked every frame, so the stack comes from the scratch arena of the calling thread
+        ScratchScope scratch;
+        std::pmr::vector<u32> stack(scratch.GetResource());
+        stack.emplace_back(mRoot);
+        while (!stack.empty())
+        {
+            const auto& node = mNodes[stack.back()];
+            stack.pop_back();
+
+            const auto minX = Float4::Load(node.MinX.data());
+            const auto minY = Float4::Load(node.MinY.data());
+            const auto minZ = Float4::Load(node.MinZ.data());
+            const auto maxX = Float4::Load(node.MaxX.data());
+            const auto maxY = Float4::Load(node.MaxY.data());
+            const auto maxZ = Float4::Load(node.MaxZ.data());
+            const auto centerX = (minX + maxX) * half;
+            const auto centerY = (minY + maxY) * half;
+            const auto centerZ = (minZ + maxZ) * half;
+            const auto extentX = (maxX - minX) * half;
+            const auto extentY = (maxY - minY) * half;
+            const auto extentZ = (maxZ - minZ) * half;
+
+            // Children entirely inside every plane have all of their objects visible without testing further
+            u32 outside = 0;
+            u32 crossing = 0;
+            for (const auto& plane : planes)
+            {
+                const auto distance = centerX * plane.X + centerY * plane.Y + centerZ * plane.Z + plane.W;
+                const auto reach = extentX * plane.AbsX + extentY * plane.AbsY + extentZ * plane.AbsZ;
+                outside |= LessThan(distance + reach, zero);
+                crossing |= LessThan(distance - reach, zero);
+            }
+
+            for (auto visible = node.Used & ~outside; visible != 0; visible &= visible - 1)
+            {
+                const auto slot = std::countr_zero(visible);
+                const auto child = node.Children[slot];
+                if (child & kObjectBit) values.emplace_back(mObjects[child & ~kObjectBit].Value);
+                else if (crossing & 1u << slot) stack.emplace_back(child);
+                else CollectAll(child, values);
+            }
+        }
+    }
+
+    void BVH::QueryOverlap(const Bounds& bounds, std::vector<u32>& values) const
+    {
+        NEO_PROFILE_FUNCTION();
+        if (mRoot == kNone) return;
+
+        const auto queryMinX = Float4::Broadcast(bounds.Min.x);
+        const auto queryMinY = Float4::Broadcast(bounds.Min.y);
+        const auto queryMinZ = Float4::Broadcast(bounds.Min.z);
+        const auto queryMaxX = Float4::Broadcast(bounds.Max.x);
+        const auto queryMaxY = Float4::Broadcast(bounds.Max.y);
+        const auto queryMaxZ = Float4::Broadcast(bounds.Max.z);
+
+        ScratchScope scratch;
+        std::pmr::vector<u32> stack(scratch.GetResource());
+        stack.emplace_back(mRoot);
+        while (!stack.empty())
+        {
+            const auto& node = mNodes[stack.back()];
+            stack.pop_back();
+
+            const auto overlapping = node.Used &
+                LessEqual(Float4::Load(node.MinX.data()), queryMaxX) &
+                LessEqual(Float4::Load(node.MinY.data()), queryMaxY) &
+                LessEqual(Float4::Load(node.MinZ.data()), queryMaxZ) &
+                LessEqual(queryMinX, Float4::Load(node.MaxX.data())) &
+                LessEqual(queryMinY, Float4::Load(node.MaxY.data())) &
+                LessEqual(queryMinZ, Float4::Load(node.MaxZ.data()));
+            for (auto remaining = overlapping; remaining != 0; remaining &= remaining - 1)
+            {
+                const auto child = node.Children[std::countr_zero(remaining)];
+                if (child & kObjectBit) values.emplace_back(mObjects[child & ~kObjectBit].Value);
+                else stack.emplace_back(child);
+            }
+        }
+    }
+
+    Opt<RayHit> BVH::Raycast(const glm::vec3 origin, const glm::vec3 direction, const float maxDistance) const
+    {
+        NEO_PROFILE_FUNCTION();
+        if (mRoot == kNone) return std::nullopt;
+
+        // Slab test, with a zero direction component dividing to infinity so that axis never limits the ray
+        const auto inverse = 1.f / direction;
+        const auto originX = Float4::Broadcast(origin.x);
+        const auto originY = Float4::Broadcast(origin.y);
+        const auto originZ = Float4::Broadcast(origin.z);
+        const auto inverseX = Float4::Broadcast(inverse.x);
+        const auto inverseY = Float4::Broadcast(inverse.y);
+        const auto inverseZ = Float4::Broadcast(inverse.z);
+        const auto zero = Float4::Broadcast(0.f);
+
+        Opt<RayHit> hit;
+        auto closest = maxDistance;
+        ScratchScope scratch;
+        std::pmr::vector<std::pair<u32, float>> stack(scratch.GetResource());
+        stack.emplace_back(mRoot, 0.f);
+        while (!stack.empty())
+        {
+            const auto [index, entry] = stack.back();
+            stack.pop_back();
+            // Something closer was hit since the node was pushed
+            if (entry > closest) continue;
+
+            const auto& node = mNodes[index];
+            const auto nearX = (Float4::Load(node.MinX.data()) - originX) * inverseX;
+            const auto farX = (Float4::Load(node.MaxX.data()) - originX) * inverseX;
+            const auto nearY = (Float4::Load(node.MinY.data()) - originY) * inverseY;
+            const auto farY = (Float4::Load(node.MaxY.data()) - originY) * inverseY;
+            const auto nearZ = (Float4::Load(node.MinZ.data()) - originZ) * inverseZ;
+            const auto farZ = (Float4::Load(node.MaxZ.data()) - originZ) * inverseZ;
+            const auto enter = Max(Max(Max(Min(nearX, farX), Min(nearY, farY)), Min(nearZ, farZ)), zero);
+            const auto exit = Min(Min(Max(nearX, farX), Max(nearY, farY)), Max(nearZ, farZ));
+            const auto hits = node.Used & LessEqual(enter, exit) & LessEqual(enter, Float4::Broadcast(closest));
+
+            alignas(16) std::array<float, kWidth> distances;
+            enter.Store(distances.data());
+            std::array<std::pair<u32, float>, kWidth> children;
+            u32 childCount = 0;
+            for (auto remaining = hits; remaining != 0; remaining &= remaining - 1)
+            {
+                const auto slot = std::countr_zero(remaining);
+                const auto child = node.Children[slot];
+                if (!(child & kObjectBit))
+                {
+                    children[childCount++] = {child, distances[slot]};
+                }
+                else if (distances[slot] <= closest)
+                {
+                    closest = distances[slot];
+                    hit = RayHit{.Value = mObjects[child & ~kObjectBit].Value, .Distance = closest};
+                }
+            }
+
+            // Farthest pushed first, so the nearest child is walked next and culls the others sooner
+            std::sort(children.begin(), children.begin() + childCount,
+                      [](const auto& a, const auto& b) { return a.second > b.second; });
+            stack.insert(stack.end(), children.begin(), children.begin() + childCount);
+        }
+        return hit;
+    }
+
+    float BVH::GetCost() const
+    {
+        if (mRoot == kNone) return 0.f;
+
+        float cost = 0.f;
+        for (u32 node = 0; node < mNodes.size(); node++)
+        {
+            // Only free nodes have no children
+            if (mNodes[node].Used == 0) continue;
+            const auto [min, max] = GetNodeBounds(node);
+            cost += GetArea(min, max);
+        }
+        const auto [rootMin, rootMax] = GetNodeBounds(mRoot);
+        return cost / std::max(GetArea(rootMin, rootMax), std::numeric_limits<float>::min());
+    }
+
+    u32 BVH::AllocateNode(const u32 parent)
+    {
+        u32 index;
+        if (!mFreeNodes.empty())
+        {
+            index = mFreeNodes.back();
+            mFreeNodes.pop_back();
+        }
+        else
+        {
+            index = static_cast<u32>(mNodes.size());
+            mNodes.emplace_back();
+        }
+
+        auto& node = mNodes[index];
+        node.MinX.fill(kEmptyMin);
+        node.MinY.fill(kEmptyMin);
+        node.MinZ.fill(kEmptyMin);
+        node.MaxX.fill(kEmptyMax);
+        node.MaxY.fill(kEmptyMax);
+        node.MaxZ.fill(kEmptyMax);
+        node.Children.fill(kNone);
+        node.Parent = parent;
+        node.Used = 0;
+        return index;
+    }
+
+    void BVH::FreeNode(const u32 node)
+    {
+        mNodes[node].Used = 0;
+        mFreeNodes.emplace_back(node);
+    }
+
+    void BVH::SetChild(const u32 node, const u32 slot, const u32 child, const glm::vec3 min, const glm::vec3 max)
+    {
+        auto& current = mNodes[node];
+        current.MinX[slot] = min.x;
+        current.MinY[slot] = min.y;
+        current.MinZ[slot] = min.z;
+        current.MaxX[slot] = max.x;
+        current.MaxY[slot] = max.y;
+        current.MaxZ[slot] = max.z;
+        current.Children[slot] = child;
+        current.Used |= 1u << slot;
+        if (child & kObjectBit)
+        {
+            auto& object = mObjects[child & ~kObjectBit];
+            object.Node = node;
+            object.Slot = slot;
+        }
+        else
+        {
+            mNodes[child].Parent = node;
+        }
+    }
+
+    void BVH::ClearChild(const u32 node, const u32 slot)
+    {
+        auto& current = mNodes[node];
+        current.MinX[slot] = kEmptyMin;
+        current.MinY[slot] = kEmptyMin;
+        current.MinZ[slot] = kEmptyMin;
+        current.MaxX[slot] = kEmptyMax;
+        current.MaxY[slot] = kEmptyMax;
+        current.MaxZ[slot] = kEmptyMax;
+        current.Children[slot] = kNone;
+        current.Used &= ~(1u << slot);
+    }
+
+    std::pair<glm::vec3, glm::vec3> BVH::GetNodeBounds(const u32 node) const
+    {
+        const auto& current = mNodes[node];
+        glm::vec3 min(kEmptyMin);
+        glm::vec3 max(kEmptyMax);
+        for (auto used = current.Used; used != 0; used &= used - 1)
+        {
+            const auto slot = std::countr_zero(used);
+            min = glm::min(min, glm::vec3(current.MinX[slot], current.MinY[slot], current.MinZ[slot]));
+            max = glm::max(max, glm::vec3(current.MaxX[slot], current.MaxY[slot], current.MaxZ[slot]));
+        }
+        return {min, max};
+    }
+
+    void BVH::Refit(u32 node)
+    {
+        while (mNodes[node].Parent != kNone)
+        {
+            const auto parent = mNodes[node].Parent;
+            const auto slot = static_cast<u32>(std::ranges::find(mNodes[parent].Children, node) -
+                mNodes[parent].Children.begin());
+            const auto [min, max] = GetNodeBounds(node);
+            SetChild(parent, slot, node, min, max);
+            node = parent;
+        }
+    }
+
+    u32 BVH::Split(const std::span<BuildItem> items)
+    {
+        const auto getCentroid = [](const BuildItem& item) { return item.Min + item.Max; };
+
+        glm::vec3 centroidMin(kEmptyMin);
+        glm::vec3 centroidMax(kEmptyMax);
+        for (const auto& item : items)
+        {
+            centroidMin = glm::min(centroidMin, getCentroid(item));
+            centroidMax = glm::max(centroidMax, getCentroid(item));
+        }
+
+        struct Bin
+        {
+            glm::vec3 Min{kEmptyMin};
+            glm::vec3 Max{kEmptyMax};
+            u32 Count = 0;
+        };
+
+        // Centroids are binned along each axis, and every boundary between bins is a candidate split
+        auto bestCost = std::numeric_limits<float>::max();
+        u32 bestAxis = 0;
+        u32 bestBin = 0;
+        for (u32 axis = 0; axis < 3; axis++)
+        {
+            const auto extent = centroidMax[axis] - centroidMin[axis];
+            if (extent <= 0.f) continue;
+
+            const auto scale = static_cast<float>(kBins) / extent;
+            std::array<Bin, kBins> bins{};
+            for (const auto& item : items)
+            {
+                const auto bin = std::min(static_cast<u32>((getCentroid(item)[axis] - centroidMin[axis]) * scale),
+                                          kBins - 1);
+                bins[bin].Min = glm::min(bins[bin].Min, item.Min);
+                bins[bin].Max = glm::max(bins[bin].Max, item.Max);
+                bins[bin].Count++;
+            }
+
+            std::array<float, kBins - 1> rightCosts{};
+            Bin right;
+            for (u32 bin = kBins - 1; bin > 0; bin--)
+            {
+                right.Min = glm::min(right.Min, bins[bin].Min);
+                right.Max = glm::max(right.Max, bins[bin].Max);
+                right.Count += bins[bin].Count;
+                rightCosts[bin - 1] = static_cast<float>(right.Count) * GetArea(right.Min, right.Max);
+            }
+
+            Bin left;
+            for (u32 bin = 0; bin < kBins - 1; bin++)
+            {
+                left.Min = glm::min(left.Min, bins[bin].Min);
+                left.Max = glm::max(left.Max, bins[bin].Max);
+                left.Count += bins[bin].Count;
+                if (left.Count == 0 || left.Count == items.size()) continue;
+
+                const auto cost = static_cast<float>(left.Count) * GetArea(left.Min, left.Max) + rightCosts[bin];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        if (bestCost < std::numeric_limits<float>::max())
+        {
+            const auto scale = static_cast<float>(kBins) / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+            const auto middle = std::partition(items.begin(), items.end(), [&](const BuildItem& item)
+            {
+                const auto offset = (getCentroid(item)[bestAxis] - centroidMin[bestAxis]) * scale;
+                return std::min(static_cast<u32>(offset), kBins - 1) <= bestBin;
+            });
+            return static_cast<u32>(middle - items.begin());
+        }
+
+        // Every centroid is in the same place, so any split is as good as another
+        return static_cast<u32>(items.size() / 2);
+    }
+
+    u32 BVH::BuildNode(const std::span<BuildItem> items, const u32 parent)
+    {
+        const auto node = AllocateNode(parent);
+        if (items.size() <= kWidth)
+        {
+            for (u32 slot = 0; slot < items.size(); slot++)
+            {
+                SetChild(node, slot, items[slot].Object | kObjectBit, items[slot].Min, items[slot].Max);
+            }
+            return node;
+        }
+
+        // Two levels of binary splits give the four children
+        const auto middle = Split(items);
+        for (const auto half : {items.first(middle), items.subspan(middle)})
+        {
+            if (half.size() < 2)
+            {
+                AddChild(node, half);
+                continue;
+            }
+            const auto quarter = Split(half);
+            AddChild(node, half.first(quarter));
+            AddChild(node, half.subspan(quarter));
+        }
+        return node;
+    }
+
+    void BVH::AddChild(const u32 node, const std::span<BuildItem> items)
+    {
+        if (items.empty()) return;
+
+        const auto slot = static_cast<u32>(std::countr_one(mNodes[node].Used));
+        if (items.size() == 1)
+        {
+            SetChild(node, slot, items.front().Object | kObjectBit, items.front().Min, items.front().Max);
+            return;
+        }
+        const auto child = BuildNode(items, node);
+        const auto [min, max] = GetNodeBounds(child);
+        SetChild(node, slot, child, min, max);
+    }
+
+    void BVH::CollectAll(const u32 node, std::vector<u32>& values) const
+    {
+        const auto& current = mNodes[node];
+        for (auto used = current.Used; used != 0; used &= used - 1)
+        {
+            const auto child = current.Children[std::countr_zero(used)];
+            if (child & kObjectBit) values.emplace_back(mObjects[child & ~kObjectBit].Value);
+            else CollectAll(child, values);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#include "Render/Bounds.hpp"
+
+namespace Neo
+{
+    Bounds ComputeBounds(const std::span<const Vertex> vertices)
+    {
+        if (vertices.empty()) return {};
+
+        Bounds bounds{.Min = vertices.front().Position, .Max = vertices.front().Position};
+        for (const auto& vertex : vertices)
+        {
+            bounds.Min = glm::min(bounds.Min, vertex.Position);
+            bounds.Max = glm::max(bounds.Max, vertex.Position);
+        }
+        bounds.Center = (bounds.Min + bounds.Max) * 0.5f;
+
+        float radiusSquared = 0.f;
+        for (const auto& vertex : vertices)
+        {
+            const auto offset = vertex.Position - bounds.Center;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+        bounds.Radius = std::sqrt(radiusSquared);
+        return bounds;
+    }
+
+    Bounds TransformBounds(const Bounds& bounds, const glm::mat4& transform)
+    {
+        // Each axis of the transformed box spans the absolute projection of the extents onto it
+        const auto center = glm::vec3(transform * glm::vec4(bounds.Center, 1.f));
+        const auto extents = bounds.GetExtents();
+        glm::vec3 transformedExtents{0.f};
+        float scaleSquared = 0.f;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const auto column = glm::vec3(transform[axis]);
+            transformedExtents += glm::abs(column) * extents[axis];
+            scaleSquared = std::max(scaleSquared, glm::dot(column, column));
+        }
+
+        return {
+            .Min = center - transformedExtents,
+            .Max = center + transformedExtents,
+            .Center = center,
+            .Radius = bounds.Radius * std::sqrt(scaleSquared),
+        };
+    }
+}
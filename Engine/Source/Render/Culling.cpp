@@ -0,0 +1,119 @@
+#include "Render/Culling.hpp"
+#include "Tools/Profiler.hpp"
+#include "Tools/Simd.hpp"
+
+namespace Neo
+{
+    Frustum Frustum::FromMatrix(const glm::mat4& viewProjection)
+    {
+        const auto row = [&](const int index)
+        {
+            return glm::vec4(viewProjection[0][index], viewProjection[1][index], viewProjection[2][index],
+                             viewProjection[3][index]);
+        };
+
+        // Near is taken as -w <= z, which is right for [-1, 1] depth and slightly conservative for [0, 1] depth
+        Frustum frustum;
+        frustum.Planes = {
+            row(3) + row(0), row(3) - row(0),
+            row(3) + row(1), row(3) - row(1),
+            row(3) + row(2), row(3) - row(2),
+        };
+        for (auto& plane : frustum.Planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+        return frustum;
+    }
+
+    void FrustumCuller::Clear()
+    {
+        mBlocks.clear();
+        mCount = 0;
+    }
+
+    u32 FrustumCuller::Add(const Bounds& worldBounds)
+    {
+        const auto lane = mCount % kLanes;
+        if (lane == 0) mBlocks.emplace_back();
+
+        auto& block = mBlocks.back();
+        const auto extents = worldBounds.GetExtents();
+        block.CenterX[lane] = worldBounds.Center.x;
+        block.CenterY[lane] = worldBounds.Center.y;
+        block.CenterZ[lane] = worldBounds.Center.z;
+        block.Radius[lane] = worldBounds.Radius;
+        block.ExtentX[lane] = extents.x;
+        block.ExtentY[lane] = extents.y;
+        block.ExtentZ[lane] = extents.z;
+        return mCount++;
+    }
+
+    std::span<const u32> FrustumCuller::Cull(const Frustum& frustum)
+    {
+        NEO_PROFILE_FUNCTION();
+        const auto chunkCount = (mCount + kChunkSize - 1) / kChunkSize;
+        mVisible.resize(mCount);
+        mChunkCounts.resize(chunkCount);
+        if (chunkCount > 1)
+        {
+            const auto chunks = std::views::iota(0u, chunkCount);
+            std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](const u32 chunk)
+            {
+                mChunkCounts[chunk] = CullChunk(frustum, chunk);
+            });
+        }
+        else if (chunkCount == 1)
+        {
+            mChunkCounts.front() = CullChunk(frustum, 0);
+        }
+
+        // Every chunk starts at its first object, so moving them down never overwrites one not moved yet
+        u32 visibleCount = 0;
+        for (u32 chunk = 0; chunk < chunkCount; chunk++)
+        {
+            const auto first = mVisible.begin() + chunk * kChunkSize;
+            std::copy(first, first + mChunkCounts[chunk], mVisible.begin() + visibleCount);
+            visibleCount += mChunkCounts[chunk];
+        }
+        return std::span(mVisible).first(visibleCount);
+    }
+
+    u32 FrustumCuller::CullChunk(const Frustum& frustum, const u32 chunk)
+    {
+        const auto firstBlock = chunk * kChunkBlocks;
+        const auto lastBlock = std::min(firstBlock + kChunkBlocks, static_cast<u32>(mBlocks.size()));
+        auto* const visible = mVisible.data() + chunk * kChunkSize;
+        u32 visibleCount = 0;
+
+        for (u32 blockIndex = firstBlock; blockIndex < lastBlock; blockIndex++)
+        {
+            const auto& block = mBlocks[blockIndex];
+            // Bit i set for lane i outside. Lanes past the last object are treated as outside
+            const auto firstObject = blockIndex * kLanes;
+            u32 outside = mCount - firstObject < kLanes ? 0xFu << (mCount - firstObject) & 0xFu : 0u;
+            const auto centerX = Float4::Load(block.CenterX.data());
+            const auto centerY = Float4::Load(block.CenterY.data());
+            const auto centerZ = Float4::Load(block.CenterZ.data());
+            const auto radius = Float4::Load(block.Radius.data());
+            const auto extentX = Float4::Load(block.ExtentX.data());
+            const auto extentY = Float4::Load(block.ExtentY.data());
+            const auto extentZ = Float4::Load(block.ExtentZ.data());
+            const auto zero = Float4::Broadcast(0.f);
+            for (const auto& plane : frustum.Planes)
+            {
+                const auto distance = centerX * Float4::Broadcast(plane.x) + centerY * Float4::Broadcast(plane.y) +
+                    centerZ * Float4::Broadcast(plane.z) + Float4::Broadcast(plane.w);
+                // How far the box reaches towards the plane
+                const auto reach = extentX * Float4::Broadcast(std::abs(plane.x)) +
+                    extentY * Float4::Broadcast(std::abs(plane.y)) + extentZ * Float4::Broadcast(std::abs(plane.z));
+                outside |= LessThan(distance + Min(radius, reach), zero);
+            }
+            for (auto inside = ~outside & 0xFu; inside != 0; inside &= inside - 1)
+            {
+                visible[visibleCount++] = firstObject + static_cast<u32>(std::countr_zero(inside));
+            }
+        }
+        return visibleCount;
+    }
+}
@@ -2,8 +2,18 @@
 #include "Core/Device.hpp"
 #include "Core/Engine.hpp"
 #include "Render/DX12/HelpersDX12.hpp"
+#include "Tools/Metrics.hpp"
 #include "dxgidebug.h"
 
+namespace {
+    const Neo::Counter kDrawCalls("Render/DrawCalls");
+    const Neo::Counter kTriangles("Render/Triangles");
+    const Neo::Counter kUploadBytes("Render/UploadBytes");
+    const Neo::Gauge kBufferHeapUsed("Render/BufferHeapUsed");
+    const Neo::Gauge kTextureHeapUsed("Render/TextureHeapUsed");
+    const Neo::Gauge kUploadHeapUsed("Render/UploadHeapUsed");
+}
+
 namespace Neo {
     RenderContextDX12::RenderContextDX12(const RenderContextCreateInfo &args) : mArgs(args) {
         ChooseGPU();
@@ -17,7 +27,10 @@ namespace Neo {
         CreateFences();
     }
 
-    RenderContextDX12::~RenderContextDX12() { WaitForGPU(); }
+    RenderContextDX12::~RenderContextDX12() {
+        WaitForGPU();
+        ReleaseResources(mFrameNumber);
+    }
 
     RenderTargetHandle RenderContextDX12::CreateRenderTarget(const RenderTargetCreateInfo createInfo,
                                                              const std::string_view debugName) {
@@ -37,39 +50,81 @@ namespace Neo {
         }
         rt.RenderDescriptor = CreateRenderTargetView(rt.ResourceHandle, createInfo);
         rt.TextureDescriptor = CreateShaderResourceView(rt.ResourceHandle, textureCreateInfo);
-        const auto handle = static_cast<RenderTargetHandle>(mRenderTargets.size());
-        mRenderTargets.emplace_back(rt);
-        return handle;
+        return mRenderTargets.Add(rt);
+    }
+
+    TextureHandle RenderContextDX12::CreateTexture(const TextureCreateInfo &createInfo,
+                                                   const std::string_view debugName) {
+        DX12::Texture texture;
+        texture.ResourceHandle = CreateResource(mTextureHeap, createInfo, debugName);
+        texture.Descriptor = CreateShaderResourceView(texture.ResourceHandle, createInfo);
+        return mTextures.Add(texture);
     }
 
     DepthStencilHandle RenderContextDX12::CreateDepthStencil(DepthStencilCreateInfo createInfo,
                                                              std::string_view debugName) {
-        const auto handle = static_cast<DepthStencilHandle>(mDepthStencils.size());
-        mDepthStencils.emplace_back();
-        return handle;
+        return mDepthStencils.Emplace();
     }
 
     void RenderContextDX12::DestroyRenderTarget(RenderTargetHandle renderTargetHandle) {
-        const auto &renderTarget = mRenderTargets.at(static_cast<u32>(renderTargetHandle));
-        const auto& [BaseResource, ResourceState] = mResources.at(static_cast<u32>(renderTarget.ResourceHandle));
-        mRTVAllocator.Free(renderTarget.RenderDescriptor);
-        mCBVUAVSRVAllocator.Free(renderTarget.TextureDescriptor);
-        BaseResource->Release();
+        const auto renderTarget = mRenderTargets.Remove(renderTargetHandle);
+        if (!renderTarget) return;
+        mRTVAllocator.Free(renderTarget->RenderDescriptor);
+        mCBVUAVSRVAllocator.Free(renderTarget->TextureDescriptor);
+        DestroyResource(renderTarget->ResourceHandle);
     }
 
     void RenderContextDX12::DestroyDepthStencil(DepthStencilHandle depthStencilHandle) {
-        const auto &depthStencil = mDepthStencils.at(static_cast<u32>(depthStencilHandle));
-        const auto& [BaseResource, ResourceState] = mResources.at(static_cast<u32>(depthStencil.ResourceHandle));
-        mDSVAllocator.Free(depthStencil.DepthDescriptor);
-        mCBVUAVSRVAllocator.Free(depthStencil.TextureDescriptor);
-        BaseResource->Release();
+        const auto depthStencil = mDepthStencils.Remove(depthStencilHandle);
+        if (!depthStencil) return;
+        mDSVAllocator.Free(depthStencil->DepthDescriptor);
+        mCBVUAVSRVAllocator.Free(depthStencil->TextureDescriptor);
+        DestroyResource(depthStencil->ResourceHandle);
+    }
+
+    void RenderContextDX12::DestroyTexture(TextureHandle textureHandle) {
+        const auto texture = mTextures.Remove(textureHandle);
+        if (!texture) return;
+        mCBVUAVSRVAllocator.Free(texture->Descriptor);
+        DestroyResource(texture->ResourceHandle);
     }
 
     void RenderContextDX12::DestroyBuffer(BufferHandle bufferHandle) {
-        const auto &buffer = mBuffers.at(static_cast<u32>(bufferHandle));
-        const auto& [BaseResource, ResourceState] = mResources.at(static_cast<u32>(buffer.ResourceHandle));
-        mCBVUAVSRVAllocator.Free(buffer.Descriptor);
-        BaseResource->Release();
+        const auto buffer = mBuffers.Remove(bufferHandle);
+        if (!buffer) return;
+        mCBVUAVSRVAllocator.Free(buffer->Descriptor);
+        DestroyResource(buffer->ResourceHandle);
+    }
+
+    void RenderContextDX12::DestroyResource(const ResourceHandle resourceHandle) {
+        const auto resource = mResources.Remove(resourceHandle);
+        if (!resource || !resource->BaseResource) return;
+
+        // Frames in flight may still use a placed resource, so it and its memory live until they are done.
+        // Swapchain buffers are not placed and have to go right away for the swapchain to resize
+        const auto placement = mPlacements.find(resourceHandle);
+        if (placement == mPlacements.end()) {
+            resource->BaseResource->Release();
+            return;
+        }
+        const auto &[Heap, Allocation] = placement->second;
+        Heap->Allocator.FreeDeferred(Allocation, mFrameNumber);
+        mPendingReleases.emplace_back(
+            DX12::PendingRelease{.FrameNumber = mFrameNumber, .Resource = resource->BaseResource});
+        mPlacements.erase(placement);
+    }
+
+    void RenderContextDX12::ReleaseResources(const u64 completedFrame) {
+        while (!mPendingReleases.empty() && mPendingReleases.front().FrameNumber <= completedFrame) {
+            mPendingReleases.front().Resource->Release();
+            mPendingReleases.pop_front();
+        }
+        for (auto *heap: {&mBufferHeap, &mTextureHeap, &mUploadHeap, &mReadbackHeap}) {
+            heap->Allocator.Collect(completedFrame);
+        }
+        kBufferHeapUsed.Set(static_cast<i64>(mBufferHeap.Allocator.GetStats().Used));
+        kTextureHeapUsed.Set(static_cast<i64>(mTextureHeap.Allocator.GetStats().Used));
+        kUploadHeapUsed.Set(static_cast<i64>(mUploadHeap.Allocator.GetStats().Used));
     }
 
     CommandHandle RenderContextDX12::CreateCommand(const QueueType queueType, std::string_view debugName) {
@@ -83,24 +138,24 @@ namespace Neo {
                 break;
         }
         DX12::Command command;
+        command.Queue = queueType;
         const auto allocResult =
                 mDevice->CreateCommandAllocator(commandListType, IID_PPV_ARGS(&command.CommandAllocator));
         DX12::ThrowIfFailed(allocResult, "RenderContextDX12::CreateCommand Failed to create command allocator");
         const auto listResult = mDevice->CreateCommandList(
             0, commandListType, command.CommandAllocator, nullptr, IID_PPV_ARGS(&command.CommandList));
         DX12::ThrowIfFailed(listResult, "RenderContextDX12::CreateCommand Failed to create command list");
-        mCommands.emplace_back(command);
-        const auto closeResult = mCommands.back().CommandList->Close();
+        const auto commandHandle = mCommands.Add(command);
+        const auto closeResult = command.CommandList->Close();
         DX12::ThrowIfFailed(closeResult, "RenderContextDX12::CreateCommand Failed to close command list");
 
-        const auto wDebugName = std::wstring(debugName.begin(), debugName.end());
-        const auto nameAllocResult = command.CommandAllocator->SetName(wDebugName.c_str());
+        const auto nameAllocResult = DX12::SetName(command.CommandAllocator, debugName);
         DX12::ThrowIfFailed(nameAllocResult, "RenderContextDX12::CreateCommand Failed to name command allocator");
 
-        const auto nameListResult = command.CommandList->SetName(wDebugName.c_str());
+        const auto nameListResult = DX12::SetName(command.CommandList, debugName);
         DX12::ThrowIfFailed(nameListResult, "RenderContextDX12::CreateCommand Failed to name command list");
 
-        return static_cast<CommandHandle>(mCommands.size() - 1);
+        return commandHandle;
     }
 
     BufferHandle RenderContextDX12::CreateBuffer(const BufferCreateInfo &createInfo, const std::string_view debugName) {
@@ -108,26 +163,25 @@ namespace Neo {
 
         buffer.ResourceHandle = createInfo.ResourceHandle;
         if (createInfo.ResourceHandle == ResourceHandle::eNull) {
-            DX12::Heap heap;
+            // Placed through the heap itself rather than a copy, so the next buffer goes after this one
+            DX12::Heap *heap = &mBufferHeap;
             switch (createInfo.Type) {
                 case BufferType::eStorage:
-                    heap = mBufferHeap;
                 case BufferType::eUniform:
+                    heap = &mBufferHeap;
                     break;
                 case BufferType::eStaging:
-                    heap = mUploadHeap;
+                    heap = &mUploadHeap;
                     break;
                 case BufferType::eReadback:
-                    heap = mReadbackHeap;
+                    heap = &mReadbackHeap;
                     break;
             }
-            buffer.ResourceHandle = CreateResource(heap, createInfo, debugName);
+            buffer.ResourceHandle = CreateResource(*heap, createInfo, debugName);
         }
         buffer.Descriptor = CreateShaderResourceView(buffer.ResourceHandle, createInfo);
 
-        const auto handle = static_cast<BufferHandle>(mBuffers.size());
-        mBuffers.emplace_back(buffer);
-        return handle;
+        return mBuffers.Add(buffer);
     }
 
     ShaderHandle RenderContextDX12::CreateShader(const GraphicsShaderCreateInfo &createInfo,
@@ -171,12 +225,9 @@ namespace Neo {
         ID3D12PipelineState *pipelineState;
         const auto result = mDevice->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState));
         DX12::ThrowIfFailed(result, "RenderContextDX12::CreateGraphicsShader Failed to create graphics pipeline");
-        const auto wDebugName = std::wstring(debugName.begin(), debugName.end());
-        const auto nameResult = pipelineState->SetName(wDebugName.c_str());
+        const auto nameResult = DX12::SetName(pipelineState, debugName);
         DX12::ThrowIfFailed(nameResult, "RenderContextDX12::CreateGraphicsShader Failed to name compute pipeline");
-        const auto shaderHandle = static_cast<ShaderHandle>(mShaders.size());
-        mShaders.emplace_back(pipelineState);
-        return shaderHandle;
+        return mShaders.Add(pipelineState);
     }
 
     ShaderHandle RenderContextDX12::CreateShader(const ComputeShaderCreateInfo &createInfo,
@@ -192,17 +243,14 @@ namespace Neo {
         ID3D12PipelineState *pipelineState;
         const auto result = mDevice->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState));
         DX12::ThrowIfFailed(result, "RenderContextDX12::CreateComputeShader Failed to create compute pipeline");
-        const auto wDebugName = std::wstring(debugName.begin(), debugName.end());
-        const auto nameResult = pipelineState->SetName(wDebugName.c_str());
+        const auto nameResult = DX12::SetName(pipelineState, debugName);
         DX12::ThrowIfFailed(nameResult, "RenderContextDX12::CreateComputeShader Failed to name compute pipeline");
-        const auto shaderHandle = static_cast<ShaderHandle>(mShaders.size());
-        mShaders.emplace_back(pipelineState);
-        return shaderHandle;
+        return mShaders.Add(pipelineState);
     }
 
     void *RenderContextDX12::MapBuffer(BufferHandle bufferHandle) {
-        const auto &[Descriptor, Resource] = mBuffers.at(static_cast<u32>(bufferHandle));
-        const auto &[BaseResource, ResourceState] = mResources.at(static_cast<u32>(Resource));
+        const auto &[Descriptor, Resource] = mBuffers.At(bufferHandle);
+        const auto &[BaseResource, ResourceState] = mResources.At(Resource);
 
         constexpr D3D12_RANGE readRange = {0, 0};
         void *mappedPtr = nullptr;
@@ -212,18 +260,18 @@ namespace Neo {
     }
 
     void RenderContextDX12::UnmapBuffer(BufferHandle bufferHandle) {
-        const auto &[Descriptor, Resource] = mBuffers.at(static_cast<u32>(bufferHandle));
-        const auto &[BaseResource, ResourceState] = mResources.at(static_cast<u32>(Resource));
+        const auto &[Descriptor, Resource] = mBuffers.At(bufferHandle);
+        const auto &[BaseResource, ResourceState] = mResources.At(Resource);
         BaseResource->Unmap(0, nullptr);
     }
 
     u32 RenderContextDX12::GetGPUAddress(TextureHandle textureHandle) {
-        const auto &[Descriptor, ResourceHandle] = mTextures.at(static_cast<u32>(textureHandle));
+        const auto &[Descriptor, ResourceHandle] = mTextures.At(textureHandle);
         return Descriptor.Index;
     }
 
     u32 RenderContextDX12::GetGPUAddress(BufferHandle bufferHandle) {
-        const auto &[Descriptor, ResourceHandle] = mBuffers.at(static_cast<u32>(bufferHandle));
+        const auto &[Descriptor, ResourceHandle] = mBuffers.At(bufferHandle);
         return Descriptor.Index;
     }
 
@@ -250,8 +298,7 @@ namespace Neo {
             const auto resource = DX12::GetSwapchainBuffer(mSwapchain, index);
             const auto debugName = std::string("Swapchain Buffer") + std::to_string(index);
             DX12::Name(resource, debugName);
-            const auto resourceHandle = static_cast<ResourceHandle>(mResources.size());
-            mResources.emplace_back(resource);
+            const auto resourceHandle = mResources.Emplace(resource);
 
             const RenderTargetCreateInfo createInfo{
                 .Size = Engine.Device().GetWindowSize(),
@@ -264,7 +311,7 @@ namespace Neo {
         mFrameIndex = 0;
     }
 
-    void RenderContextDX12::OneTimeSubmit(const std::vector<CommandHandle> &commandHandle, const QueueType queueType) {
+    void RenderContextDX12::OneTimeSubmit(const std::span<const CommandHandle> commandHandle, const QueueType queueType) {
         Submit(commandHandle, queueType);
         switch (queueType) {
             case QueueType::eGraphics: {
@@ -287,8 +334,20 @@ namespace Neo {
         }
     }
 
+    u64 RenderContextDX12::SignalTransfer() {
+        // OneTimeSubmit waits for mTransferFenceValue before moving on, so it always holds the next value
+        const auto value = mTransferFenceValue++;
+        const auto signalResult = mTransferQueue->Signal(mTransferFence, value);
+        DX12::ThrowIfFailed(signalResult, "RenderContextDX12::SignalTransfer Failed to signal transfer queue");
+        return value;
+    }
+
+    u64 RenderContextDX12::GetCompletedTransfer() const {
+        return mTransferFence->GetCompletedValue();
+    }
+
     void RenderContextDX12::BeginCommand(CommandHandle commandHandle) {
-        const auto &[CommandAllocator, CommandList] = mCommands.at(static_cast<u32>(commandHandle));
+        const auto &[CommandAllocator, CommandList, Queue] = mCommands.At(commandHandle);
         const auto allocResult = CommandAllocator->Reset();
         DX12::ThrowIfFailed(allocResult, "RenderContextDX12::BeginCommand Failed to reset command allocator");
         const auto listResult = CommandList->Reset(CommandAllocator, nullptr);
@@ -296,32 +355,34 @@ namespace Neo {
     }
 
     void RenderContextDX12::EndCommand(CommandHandle commandHandle) {
-        const auto &renderTarget = mRenderTargets.at(static_cast<u32>(GetFrameData().RenderTargetHandle));
-        TransitionResource(commandHandle, renderTarget.ResourceHandle, D3D12_RESOURCE_STATE_PRESENT);
-        const auto &[CommandAllocator, CommandList] = mCommands.at(static_cast<u32>(commandHandle));
+        // Only the frame command runs last, secondary commands may be recorded on other threads
+        if (commandHandle == GetFrameData().CommandHandle) {
+            const auto &renderTarget = mRenderTargets.At(GetFrameData().RenderTargetHandle);
+            TransitionResource(commandHandle, renderTarget.ResourceHandle, D3D12_RESOURCE_STATE_PRESENT);
+        }
+        const auto &[CommandAllocator, CommandList, Queue] = mCommands.At(commandHandle);
         const auto listResult = CommandList->Close();
         DX12::ThrowIfFailed(listResult, "RenderContextDX12::EndCommand Failed to close command list");
     }
 
     void RenderContextDX12::SetupGraphicsCommand(CommandHandle commandHandle) {
-        const auto &[CommandAllocator, CommandList] = mCommands.at(static_cast<u32>(commandHandle));
+        const auto &[CommandAllocator, CommandList, Queue] = mCommands.At(commandHandle);
         CommandList->SetGraphicsRootSignature(mRootSignature);
         CommandList->SetComputeRootSignature(mRootSignature);
         CommandList->SetDescriptorHeaps(1, &mCBVUAVSRVAllocator.Heap);
     }
 
-    void RenderContextDX12::Submit(const std::vector<CommandHandle> &commandHandles, const QueueType queueType) {
-        std::array<ID3D12CommandList *, 4> commands{};
-        for (const auto &[index, commandHandle]: std::views::enumerate(commandHandles)) {
-            const auto &[CommandAllocator, CommandList] = mCommands.at(static_cast<u32>(commandHandle));
-            commands[index] = CommandList;
+    void RenderContextDX12::Submit(const std::span<const CommandHandle> commandHandles, const QueueType queueType) {
+        mSubmitCommands.clear();
+        for (const auto commandHandle: commandHandles) {
+            mSubmitCommands.emplace_back(mCommands.At(commandHandle).CommandList);
         }
         switch (queueType) {
             case QueueType::eGraphics:
-                mGraphicsQueue->ExecuteCommandLists(commandHandles.size(), commands.data());
+                mGraphicsQueue->ExecuteCommandLists(mSubmitCommands.size(), mSubmitCommands.data());
                 break;
             case QueueType::eTransfer:
-                mTransferQueue->ExecuteCommandLists(commandHandles.size(), commands.data());
+                mTransferQueue->ExecuteCommandLists(mSubmitCommands.size(), mSubmitCommands.data());
                 break;
         }
     }
@@ -332,27 +393,48 @@ namespace Neo {
         WaitForFrame();
     }
 
+    void RenderContextDX12::Barrier(const CommandHandle commandHandle, const std::span<const ResourceBarrier> barriers) {
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
+        std::array<D3D12_RESOURCE_BARRIER, 16> dxBarriers{};
+        u32 count = 0;
+        for (const auto &barrier: barriers) {
+            // The tracked state wins over Before, so resources touched outside the graph stay correct
+            auto &[BaseResource, ResourceState] = mResources.At(barrier.Resource);
+            const auto newState = DX12::GetResourceState(barrier.After);
+            if (ResourceState == newState)
+                continue;
+            dxBarriers[count++] = CD3DX12_RESOURCE_BARRIER::Transition(BaseResource, ResourceState, newState);
+            ResourceState = newState;
+            if (count == dxBarriers.size()) {
+                commandList->ResourceBarrier(count, dxBarriers.data());
+                count = 0;
+            }
+        }
+        if (count > 0) {
+            commandList->ResourceBarrier(count, dxBarriers.data());
+        }
+    }
+
     void RenderContextDX12::BeginRenderPass(const CommandHandle commandHandle, const RenderPassInfo &renderPassInfo) {
         std::array<D3D12_RENDER_PASS_RENDER_TARGET_DESC, 8> renderTargetDescs{};
         for (const auto &[index, renderTargetIndex]: std::views::enumerate(renderPassInfo.RenderTargets)) {
-            const auto &renderTarget = mRenderTargets.at(static_cast<u32>(renderTargetIndex));
+            const auto &renderTarget = mRenderTargets.At(renderTargetIndex);
             renderTargetDescs[index] = GetRenderTargetDesc(renderTarget,
                                                            renderPassInfo.RenderTargetLoadOp,
                                                            renderPassInfo.RenderTargetStoreOp,
                                                            renderPassInfo.ClearColor);
-            TransitionResource(commandHandle, renderTarget.ResourceHandle, D3D12_RESOURCE_STATE_RENDER_TARGET);
         }
 
         D3D12_RENDER_PASS_DEPTH_STENCIL_DESC depthStencilDesc = {};
         if (renderPassInfo.DepthStencil != DepthStencilHandle::eNull) {
-            const auto &depthStencil = mDepthStencils.at(static_cast<u32>(renderPassInfo.DepthStencil));
+            const auto &depthStencil = mDepthStencils.At(renderPassInfo.DepthStencil);
             depthStencilDesc = GetDepthStencilDesc(depthStencil,
                                                    renderPassInfo.DepthStencilLoadOp,
                                                    renderPassInfo.DepthStencilStoreOp,
                                                    renderPassInfo.ClearDepth);
         }
 
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
         commandList->BeginRenderPass(renderPassInfo.RenderTargets.size(),
                                      renderTargetDescs.data(),
                                      renderPassInfo.DepthStencil != DepthStencilHandle::eNull
@@ -362,28 +444,42 @@ namespace Neo {
     }
 
     void RenderContextDX12::EndRenderPass(CommandHandle commandHandle) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
         commandList->EndRenderPass();
     }
 
     void RenderContextDX12::BindShader(CommandHandle commandHandle, ShaderHandle shaderHandle) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
-        const auto &shader = mShaders.at(static_cast<u32>(shaderHandle));
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
+        const auto &shader = mShaders.At(shaderHandle);
         commandList->SetPipelineState(shader);
     }
 
     void RenderContextDX12::SetPrimitiveTopology(CommandHandle commandHandle, const PrimitiveTopology topology) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
         commandList->IASetPrimitiveTopology(DX12::GetPrimitiveTopology(topology));
     }
 
+    void RenderContextDX12::BindIndexBuffer(CommandHandle commandHandle, BufferHandle bufferHandle) {
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
+        const auto &[Descriptor, ResourceHandle] = mBuffers.At(bufferHandle);
+        const auto &resource = mResources.At(ResourceHandle).BaseResource;
+        const D3D12_INDEX_BUFFER_VIEW view{
+            .BufferLocation = resource->GetGPUVirtualAddress(),
+            .SizeInBytes = static_cast<u32>(resource->GetDesc().Width),
+            .Format = DXGI_FORMAT_R32_UINT,
+        };
+        commandList->IASetIndexBuffer(&view);
+    }
+
     void RenderContextDX12::Draw(CommandHandle commandHandle,
                                  const u32 vertexCount,
                                  const u32 instanceCount,
                                  const u32 vertexOffset,
                                  const u32 firstInstance) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
         commandList->DrawInstanced(vertexCount, instanceCount, vertexOffset, firstInstance);
+        kDrawCalls.Add();
+        kTriangles.Add(static_cast<i64>(vertexCount / 3) * instanceCount);
     }
 
     void RenderContextDX12::DrawIndexed(CommandHandle commandHandle,
@@ -392,12 +488,14 @@ namespace Neo {
                                         const u32 firstIndex,
                                         const int vertexOffset,
                                         const u32 firstInstance) {
-        const auto &[CommandAllocator, CommandList] = mCommands.at(static_cast<u32>(commandHandle));
+        const auto &[CommandAllocator, CommandList, Queue] = mCommands.At(commandHandle);
         CommandList->DrawIndexedInstanced(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+        kDrawCalls.Add();
+        kTriangles.Add(static_cast<i64>(indexCount / 3) * instanceCount);
     }
 
     void RenderContextDX12::SetViewport(CommandHandle commandHandle, const Viewport &viewport) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
         const D3D12_VIEWPORT dxViewport = {
             .TopLeftX = viewport.Offset.x,
             .TopLeftY = viewport.Offset.y,
@@ -410,7 +508,7 @@ namespace Neo {
     }
 
     void RenderContextDX12::SetScissor(CommandHandle commandHandle, const Scissor &scissor) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
         const D3D12_RECT scissorRect = {
             .left = scissor.Min.x, .top = scissor.Min.y, .right = scissor.Max.x, .bottom = scissor.Max.y
         };
@@ -418,20 +516,20 @@ namespace Neo {
     }
 
     void RenderContextDX12::BlitToSwapchain(CommandHandle commandHandle, RenderTargetHandle renderTargetHandle) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
-        const auto &renderTarget = mRenderTargets.at(static_cast<u32>(renderTargetHandle));
-        const auto &srcResource = mResources.at(static_cast<u32>(renderTarget.ResourceHandle));
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
+        const auto &renderTarget = mRenderTargets.At(renderTargetHandle);
+        const auto &srcResource = mResources.At(renderTarget.ResourceHandle);
         TransitionResource(commandHandle, renderTarget.ResourceHandle, D3D12_RESOURCE_STATE_COPY_SOURCE);
 
-        const auto &swapchainRenderTarget = mRenderTargets.at(static_cast<u32>(GetFrameData().RenderTargetHandle));
-        const auto &dstResource = mResources.at(static_cast<u32>(swapchainRenderTarget.ResourceHandle));
+        const auto &swapchainRenderTarget = mRenderTargets.At(GetFrameData().RenderTargetHandle);
+        const auto &dstResource = mResources.At(swapchainRenderTarget.ResourceHandle);
         TransitionResource(commandHandle, swapchainRenderTarget.ResourceHandle, D3D12_RESOURCE_STATE_COPY_DEST);
 
         commandList->CopyResource(dstResource.BaseResource, srcResource.BaseResource);
     }
 
     void RenderContextDX12::PushConstant(CommandHandle commandHandle, const u32 count, const void *data) {
-        const auto &commandList = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
+        const auto &commandList = mCommands.At(commandHandle).CommandList;
         commandList->SetGraphicsRoot32BitConstants(0, count, data, 0);
     }
 
@@ -583,8 +681,7 @@ namespace Neo {
             const auto resource = DX12::GetSwapchainBuffer(mSwapchain, index);
             const auto debugName = std::string("Swapchain Buffer") + std::to_string(index);
             DX12::Name(resource, debugName);
-            const auto resourceHandle = static_cast<ResourceHandle>(mResources.size());
-            mResources.emplace_back(resource);
+            const auto resourceHandle = mResources.Emplace(resource);
 
             const RenderTargetCreateInfo createInfo{
                 .Size = Engine.Device().GetWindowSize(),
@@ -685,7 +782,7 @@ namespace Neo {
         DX12::ThrowIfFailed(transferResult, "Failed to create fence");
     }
 
-    ResourceHandle RenderContextDX12::CreateResource(const DX12::Heap &heap,
+    ResourceHandle RenderContextDX12::CreateResource(DX12::Heap &heap,
                                                      const TextureCreateInfo &createInfo,
                                                      const std::string_view debugName) {
         D3D12_RESOURCE_FLAGS flags = {};
@@ -711,19 +808,8 @@ namespace Neo {
             .Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN,
             .Flags = flags,
         };
-        ID3D12Resource2 *resource;
-        const auto resourceResult = mDevice->CreatePlacedResource(heap.BaseHeap,
-                                                                  heap.Offset,
-                                                                  &resourceDesc,
-                                                                  D3D12_RESOURCE_STATE_COMMON,
-                                                                  &clearValue,
-                                                                  IID_PPV_ARGS(&resource));
-        DX12::Name(resource, debugName);
-        DX12::ThrowIfFailed(resourceResult, "RenderContextDX12::CreateResource Failed to create texture resource");
-
-        const auto handle = static_cast<ResourceHandle>(mResources.size());
-        mResources.emplace_back(resource);
-        return handle;
+        const auto hasClearValue = createInfo.RenderTarget || createInfo.DepthStencil;
+        return PlaceResource(heap, resourceDesc, hasClearValue ? &clearValue : nullptr, debugName);
     }
 
     ResourceHandle
@@ -741,19 +827,35 @@ namespace Neo {
             .Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
             .Flags = D3D12_RESOURCE_FLAG_NONE,
         };
-        ID3D12Resource2 *resource;
-        const auto resourceResult = mDevice->CreatePlacedResource(
-            heap.BaseHeap, heap.Offset, &resourceDesc, D3D12_RESOURCE_STATE_COMMON, nullptr, IID_PPV_ARGS(&resource));
-        const auto wDebugName = std::wstring(debugName.begin(), debugName.end());
-        DX12::ThrowIfFailed(resourceResult, "RenderContextDX12::CreateResource Failed to create buffer resource");
+        return PlaceResource(heap, resourceDesc, nullptr, debugName);
+    }
 
+    ResourceHandle RenderContextDX12::PlaceResource(DX12::Heap &heap,
+                                                    const D3D12_RESOURCE_DESC &resourceDesc,
+                                                    const D3D12_CLEAR_VALUE *clearValue,
+                                                    const std::string_view debugName) {
         const auto [SizeInBytes, Alignment] = mDevice->GetResourceAllocationInfo(0, 1, &resourceDesc);
-        const u64 alignedOffset = DX12::Align(heap.Offset, Alignment);
-        heap.Offset = alignedOffset + SizeInBytes;
+        const auto allocation = heap.Allocator.Allocate(SizeInBytes, Alignment);
+        if (!allocation) {
+            const auto stats = heap.Allocator.GetStats();
+            Log::Critical("RenderContextDX12::PlaceResource No room for {} of {} bytes, {} free in {} regions",
+                          debugName, SizeInBytes, stats.Free, stats.FreeRegions);
+            return ResourceHandle::eNull;
+        }
+
+        ID3D12Resource2 *resource;
+        const auto resourceResult = mDevice->CreatePlacedResource(heap.BaseHeap,
+                                                                  allocation->Offset,
+                                                                  &resourceDesc,
+                                                                  D3D12_RESOURCE_STATE_COMMON,
+                                                                  clearValue,
+                                                                  IID_PPV_ARGS(&resource));
+        DX12::ThrowIfFailed(resourceResult, "RenderContextDX12::PlaceResource Failed to create {}", debugName);
+        DX12::Name(resource, debugName);
 
-        const auto handle = static_cast<ResourceHandle>(mResources.size());
-        mResources.emplace_back(resource);
-        return handle;
+        const auto resourceHandle = mResources.Emplace(resource);
+        mPlacements.emplace(resourceHandle, DX12::Placement{.Heap = &heap, .Allocation = *allocation});
+        return resourceHandle;
     }
 
     DX12::Heap
@@ -793,6 +895,8 @@ namespace Neo {
         };
         DX12::Heap heap{};
         heap.Size = size;
+        // Every placement is aligned to at least this, so it is the smallest unit worth tracking
+        heap.Allocator = OffsetAllocator(size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
         const auto result = mDevice->CreateHeap(&desc, IID_PPV_ARGS(&heap.BaseHeap));
         DX12::ThrowIfFailed(result, "Failed to create heap");
 
@@ -829,8 +933,7 @@ namespace Neo {
         const auto result = mDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&descriptorAllocator.Heap));
         DX12::ThrowIfFailed(result, "RenderContextDX12::CreateDescriptorHeap Failed to create descriptor heap");
 
-        const auto wName = std::wstring(debugName.begin(), debugName.end());
-        const auto nameResult = descriptorAllocator.Heap->SetName(wName.c_str());
+        const auto nameResult = DX12::SetName(descriptorAllocator.Heap, debugName);
         DX12::ThrowIfFailed(nameResult, "RenderContextDX12::CreateDescriptorHeap Failed to name descriptor heap");
 
         descriptorAllocator.CpuBase = descriptorAllocator.Heap->GetCPUDescriptorHandleForHeapStart();
@@ -849,7 +952,7 @@ namespace Neo {
 
     DX12::Descriptor RenderContextDX12::CreateShaderResourceView(const ResourceHandle resourceHandle,
                                                                  const BufferCreateInfo &createInfo) {
-        const auto &[BaseResource, ResourceState] = mResources.at(static_cast<u32>(resourceHandle));
+        const auto &[BaseResource, ResourceState] = mResources.At(resourceHandle);
         const D3D12_SHADER_RESOURCE_VIEW_DESC viewDesc = {
             .Format = DXGI_FORMAT_UNKNOWN,
             .ViewDimension = D3D12_SRV_DIMENSION_BUFFER,
@@ -869,7 +972,7 @@ namespace Neo {
 
     DX12::Descriptor RenderContextDX12::CreateShaderResourceView(ResourceHandle resourceHandle,
                                                                  const TextureCreateInfo &createInfo) {
-        const auto &[BaseResource, ResourceState] = mResources.at(static_cast<u32>(resourceHandle));
+        const auto &[BaseResource, ResourceState] = mResources.At(resourceHandle);
         const D3D12_SHADER_RESOURCE_VIEW_DESC viewDesc = {
             .Format = DX12::GetFormat(createInfo.Format),
             .ViewDimension = DX12::GetSRVDimension(createInfo.ViewType),
@@ -894,7 +997,7 @@ namespace Neo {
             .ViewDimension = DX12::GetRTVDimension(createInfo.ViewType),
         };
         const auto rtvDescriptor = mRTVAllocator.Allocate();
-        const auto &[BaseResource, ResourceState] = mResources.at(static_cast<u32>(resourceHandle));
+        const auto &[BaseResource, ResourceState] = mResources.At(resourceHandle);
         mDevice->CreateRenderTargetView(BaseResource, &renderTargetViewDesc, rtvDescriptor.Cpu);
         return rtvDescriptor;
     }
@@ -902,12 +1005,12 @@ namespace Neo {
     void RenderContextDX12::TransitionResource(const CommandHandle commandHandle,
                                                const ResourceHandle resourceHandle,
                                                const D3D12_RESOURCE_STATES newState) {
-        auto &[BaseResource, ResourceState] = mResources.at(static_cast<u32>(resourceHandle));
+        auto &[BaseResource, ResourceState] = mResources.At(resourceHandle);
         if (ResourceState == newState)
             return;
         const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(BaseResource, ResourceState, newState);
         ResourceState = newState;
-        mCommands.at(static_cast<u32>(commandHandle)).CommandList->ResourceBarrier(1, &barrier);
+        mCommands.At(commandHandle).CommandList->ResourceBarrier(1, &barrier);
     }
 
     void RenderContextDX12::CopyBuffer(CommandHandle commandHandle,
@@ -916,19 +1019,25 @@ namespace Neo {
                                        const u64 srcOffset,
                                        const u64 dstOffset,
                                        const u64 size) {
-        const auto &command = mCommands.at(static_cast<u32>(commandHandle)).CommandList;
-
-        const auto &[Descriptor, SrcResourceHandle] = mBuffers.at(static_cast<u32>(srcBufferHandle));
-        const auto &[SrcResource, SrcState] = mResources.at(static_cast<u32>(SrcResourceHandle));
-
-        TransitionResource(commandHandle, SrcResourceHandle, D3D12_RESOURCE_STATE_COPY_SOURCE);
-
-        const auto &[DstDescriptor, DstResourceHandle] = mBuffers.at(static_cast<u32>(dstBufferHandle));
-        const auto &[DstResource, DstState] = mResources.at(static_cast<u32>(DstResourceHandle));
-
-        TransitionResource(commandHandle, DstResourceHandle, D3D12_RESOURCE_STATE_COPY_DEST);
+        const auto &[CommandAllocator, command, Queue] = mCommands.At(commandHandle);
+
+        const auto &[Descriptor, SrcResourceHandle] = mBuffers.At(srcBufferHandle);
+        auto &[SrcResource, SrcState] = mResources.At(SrcResourceHandle);
+        const auto &[DstDescriptor, DstResourceHandle] = mBuffers.At(dstBufferHandle);
+        auto &[DstResource, DstState] = mResources.At(DstResourceHandle);
+
+        if (Queue == QueueType::eTransfer) {
+            // Buffers in the common state are promoted by the copy and decay back to it once the copy queue is done,
+            // so no barriers are needed, and the graphics queue finds them common again
+            SrcState = D3D12_RESOURCE_STATE_COMMON;
+            DstState = D3D12_RESOURCE_STATE_COMMON;
+        } else {
+            TransitionResource(commandHandle, SrcResourceHandle, D3D12_RESOURCE_STATE_COPY_SOURCE);
+            TransitionResource(commandHandle, DstResourceHandle, D3D12_RESOURCE_STATE_COPY_DEST);
+        }
 
         command->CopyBufferRegion(DstResource, dstOffset, SrcResource, srcOffset, size);
+        kUploadBytes.Add(static_cast<i64>(size));
     }
 
     void RenderContextDX12::WaitForFrame() {
@@ -941,5 +1050,11 @@ namespace Neo {
             DX12::ThrowIfFailed(waitResult, "Failed to wait for last frame");
         }
         currentValue++;
+
+        // The frame that had this index before is done, and with it every frame before that
+        mFrameNumber++;
+        if (mFrameNumber >= kFrameCount) {
+            ReleaseResources(mFrameNumber - kFrameCount);
+        }
     }
 } // namespace FS
@@ -0,0 +1,339 @@
+#include "Render/DrawList.hpp"
+#include "Core/ECS.hpp"
+#include "Core/Resources.hpp"
+#include "Resources/TextureResidency.hpp"
+#include "Tools/Metrics.hpp"
+#include "Tools/Profiler.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace
+{
+    const Neo::Gauge kDraws("DrawList/Draws");
+    const Neo::Gauge kBatches("DrawList/Batches");
+    const Neo::Gauge kStateChanges("DrawList/StateChanges");
+    const Neo::Gauge kCulled("DrawList/Culled");
+    const Neo::Gauge kOccluded("DrawList/Occluded");
+
+    constexpr u64 Field(const u64 value, const u32 bits)
+    {
+        return value & ((1ull << bits) - 1);
+    }
+}
+
+namespace Neo
+{
+    float DrawView::GetScreenSize(const Bounds& bounds) const
+    {
+        if (ViewportHeight <= 0.f) return std::numeric_limits<float>::max();
+        const auto distance = glm::length(bounds.Center - Position);
+        return TextureResidency::EstimateScreenSize(bounds.Radius, distance, FieldOfView, ViewportHeight);
+    }
+
+    DrawView MakeDrawView(const Transform& transform, const Camera& camera, const glm::uvec2 viewportSize)
+    {
+        const auto world = glm::translate(glm::mat4(1.f), transform.Position) *
+            glm::mat4_cast(glm::quat(transform.Rotation));
+        const auto fieldOfView = glm::radians(camera.FieldOfView);
+        const auto aspectRatio = static_cast<float>(viewportSize.x) / static_cast<float>(std::max(viewportSize.y, 1u));
+        const auto projection = glm::perspective(fieldOfView, aspectRatio, camera.Near, camera.Far);
+        const auto viewProjection = projection * glm::inverse(world);
+        return {
+            .Position = transform.Position,
+            .Forward = -glm::vec3(world[2]),
+            .Far = camera.Far,
+            .FieldOfView = fieldOfView,
+            .ViewportHeight = static_cast<float>(viewportSize.y),
+            .ViewProjection = viewProjection,
+            .Frustum = Frustum::FromMatrix(viewProjection),
+            .OcclusionCulling = true,
+        };
+    }
+
+    u64 DrawList::MakeKey(const DrawPass pass,
+                          const ShaderHandle shader,
+                          const u32 material,
+                          const AssetHandle<Mesh> mesh,
+                          const u32 primitive,
+                          const float depth)
+    {
+        constexpr auto kDepthMax = static_cast<float>((1u << kDepthBits) - 1);
+        const auto quantized = static_cast<u64>(std::clamp(depth, 0.f, 1.f) * kDepthMax);
+        const auto state = Field(std::bit_cast<u32>(shader) & PoolHandleLayout::kIndexMask, kShaderBits)
+            << kMaterialBits + kMeshBits + kPrimitiveBits | Field(material, kMaterialBits)
+            << kMeshBits + kPrimitiveBits | Field(mesh.GetIndex(), kMeshBits)
+            << kPrimitiveBits | Field(primitive, kPrimitiveBits);
+        const auto passBits = static_cast<u64>(pass) << (64 - kPassBits);
+        if (pass == DrawPass::eTransparent)
+        {
+            const auto inverted = Field(~quantized, kDepthBits);
+            return passBits | inverted << (64 - kPassBits - kDepthBits) | state;
+        }
+        return passBits | state << kDepthBits | quantized;
+    }
+
+    void DrawList::Begin(const DrawView& view)
+    {
+        mView = view;
+        mDraws.clear();
+        mWorlds.clear();
+        mItems.clear();
+        mCulled = 0;
+        mOccluded = 0;
+    }
+
+    void DrawList::Add(const DrawPass pass,
+                       const ShaderHandle shader,
+                       const u32 material,
+                       const AssetHandle<Mesh> mesh,
+                       const u32 primitive,
+                       const glm::mat4& world)
+    {
+        const auto position = glm::vec3(world[3]);
+        const auto depth = glm::dot(position - mView.Position, mView.Forward) / mView.Far;
+        mItems.emplace_back(SortItem{
+            .Key = MakeKey(pass, shader, material, mesh, primitive, depth),
+            .Draw = static_cast<u32>(mDraws.size()),
+        });
+        mWorlds.emplace_back(world);
+        mDraws.emplace_back(Draw{
+            .Pass = pass,
+            .Shader = shader,
+            .Material = material,
+            .Mesh = mesh,
+            .Primitive = primitive,
+        });
+    }
+
+    void DrawList::Extract(const ECS& ecs, Resources& resources, const SceneBVH* scene)
+    {
+        NEO_PROFILE_FUNCTION();
+        mCandidates.clear();
+        mCandidateWorlds.clear();
+        mCandidateBounds.clear();
+        mCuller.Clear();
+        if (mView.OcclusionCulling) RasterizeOccluders(ecs, resources);
+        if (scene)
+        {
+            // The tree only holds whole entities, so their primitives are still culled one by one below
+            mSceneVisible.clear();
+            scene->GetBVH().QueryFrustum(mView.Frustum, mSceneVisible);
+            for (const auto value : mSceneVisible)
+            {
+                const auto entity = static_cast<Entity>(value);
+                if (!ecs.Has<Transform, MeshRenderer>(entity)) continue;
+                const auto [transform, renderer] = ecs.Get<Transform, MeshRenderer>(entity);
+                AddCandidates(transform, renderer, resources);
+            }
+        }
+        else
+        {
+            for (const auto [entity, transform, renderer] : ecs.View<Transform, MeshRenderer>().each())
+            {
+                AddCandidates(transform, renderer, resources);
+            }
+        }
+
+        const auto visible = mCuller.Cull(mView.Frustum);
+        mCulled += static_cast<u32>(mCandidates.size() - visible.size());
+        const auto occlusion = mView.OcclusionCulling && mOcclusion.HasOccluders();
+        if (occlusion)
+        {
+            // Only reads the depth buffer, so large sets are tested on worker threads
+            mUnoccluded.resize(visible.size());
+            const auto test = [this](const u32 index) -> u8 { return mOcclusion.IsVisible(mCandidateBounds[index]); };
+            if (visible.size() > FrustumCuller::kChunkSize)
+            {
+                std::transform(std::execution::par, visible.begin(), visible.end(), mUnoccluded.begin(), test);
+            }
+            else
+            {
+                std::ranges::transform(visible, mUnoccluded.begin(), test);
+            }
+        }
+
+        for (u32 index = 0; index < visible.size(); index++)
+        {
+            if (occlusion && !mUnoccluded[index])
+            {
+                mOccluded++;
+                continue;
+            }
+            const auto& [draw, world, material] = mCandidates[visible[index]];
+            resources.ReportMaterialUsage(material, mView.GetScreenSize(mCandidateBounds[visible[index]]));
+            Add(draw.Pass, draw.Shader, draw.Material, draw.Mesh, draw.Primitive, mCandidateWorlds[world]);
+        }
+    }
+
+    void DrawList::RasterizeOccluders(const ECS& ecs, Resources& resources)
+    {
+        NEO_PROFILE_FUNCTION();
+        mOcclusion.Begin(mView.ViewProjection);
+        for (const auto [entity, transform, occluder] : ecs.View<Transform, Occluder>().each())
+        {
+            const auto* mesh = resources.Get(occluder.Mesh);
+            if (!mesh) continue;
+
+            const auto world = GetWorldMatrix(transform);
+            for (const auto& primitive : mesh->Primitives)
+            {
+                mOcclusion.AddOccluder(primitive.Vertices, primitive.Indices, world);
+            }
+        }
+        mOcclusion.Rasterize();
+    }
+
+    void DrawList::AddCandidates(const Transform& transform, const MeshRenderer& renderer, Resources& resources)
+    {
+        const auto* mesh = resources.Get(renderer.Mesh);
+        if (!mesh) return;
+
+        const auto world = static_cast<u32>(mCandidateWorlds.size());
+        const auto& matrix = mCandidateWorlds.emplace_back(GetWorldMatrix(transform));
+        for (u32 primitive = 0; primitive < mesh->Primitives.size(); primitive++)
+        {
+            // Drawn once the material is loaded, until then it has no params to be sorted and drawn with
+            const auto materialHandle = mesh->Primitives[primitive].Material;
+            const auto* material = resources.Get(materialHandle);
+            if (!material) continue;
+
+            mCuller.Add(mCandidateBounds.emplace_back(TransformBounds(mesh->Primitives[primitive].Bounds, matrix)));
+            mCandidates.emplace_back(Candidate{
+                .Draw = {
+                    .Pass = renderer.Pass,
+                    .Shader = renderer.Shader,
+                    .Material = material->ParamsIndex,
+                    .Mesh = renderer.Mesh,
+                    .Primitive = primitive,
+                },
+                .World = world,
+                .Material = materialHandle,
+            });
+        }
+    }
+
+    void DrawList::Finish()
+    {
+        NEO_PROFILE_FUNCTION();
+        Sort();
+        Batch();
+        kDraws.Set(mStats.Draws);
+        kBatches.Set(mStats.DrawCalls);
+        kStateChanges.Set(mStats.GetStateChanges());
+        kCulled.Set(mStats.Culled);
+        kOccluded.Set(mStats.Occluded);
+    }
+
+    void DrawList::Sort()
+    {
+        NEO_PROFILE_FUNCTION();
+        if (mItems.empty()) return;
+
+        // Least significant byte first, which keeps equal keys in the order they were added. Bytes every key
+        // shares, like the pass of a frame without transparent draws, are skipped. Large lists are split into
+        // chunks that are counted and scattered on their own threads, each chunk writing right behind the ones
+        // before it for every byte value, so the result is the same as sorting on one thread
+        const auto count = static_cast<u32>(mItems.size());
+        const auto chunkCount = (count + kSortChunkSize - 1) / kSortChunkSize;
+        const auto parallel = chunkCount > 1;
+        const auto firstKey = mItems.front().Key;
+        const auto differing = parallel
+            ? std::transform_reduce(std::execution::par, mItems.begin(), mItems.end(), u64{0}, std::bit_or{},
+                                    [firstKey](const SortItem& item) { return item.Key ^ firstKey; })
+            : std::transform_reduce(mItems.begin(), mItems.end(), u64{0}, std::bit_or{},
+                                    [firstKey](const SortItem& item) { return item.Key ^ firstKey; });
+
+        mHistograms.resize(chunkCount);
+        mScratch.resize(count);
+        const auto chunks = std::views::iota(0u, chunkCount);
+        const auto forEachChunk = [&](const auto& func)
+        {
+            if (parallel) std::for_each(std::execution::par, chunks.begin(), chunks.end(), func);
+            else func(0u);
+        };
+        const auto getChunk = [&](const u32 chunk)
+        {
+            const auto first = chunk * kSortChunkSize;
+            return std::span(mItems).subspan(first, std::min(kSortChunkSize, count - first));
+        };
+
+        for (u32 shift = 0; shift < 64; shift += 8)
+        {
+            if ((differing >> shift & 0xFF) == 0) continue;
+
+            forEachChunk([&](const u32 chunk)
+            {
+                auto& histogram = mHistograms[chunk];
+                histogram.fill(0);
+                for (const auto& item : getChunk(chunk))
+                {
+                    histogram[item.Key >> shift & 0xFF]++;
+                }
+            });
+            u32 offset = 0;
+            for (u32 bucket = 0; bucket < 256; bucket++)
+            {
+                for (auto& histogram : mHistograms)
+                {
+                    const auto size = histogram[bucket];
+                    histogram[bucket] = offset;
+                    offset += size;
+                }
+            }
+            forEachChunk([&](const u32 chunk)
+            {
+                auto& histogram = mHistograms[chunk];
+                for (const auto& item : getChunk(chunk))
+                {
+                    mScratch[histogram[item.Key >> shift & 0xFF]++] = item;
+                }
+            });
+            std::swap(mItems, mScratch);
+        }
+    }
+
+    void DrawList::Batch()
+    {
+        NEO_PROFILE_FUNCTION();
+        mBatches.clear();
+        mInstances.resize(mItems.size());
+        mStats = {.Draws = static_cast<u32>(mItems.size()), .Culled = mCulled, .Occluded = mOccluded};
+
+        // Gathering the matrices is most of the work, and every instance is independent
+        const auto gather = [this](const SortItem& item) { return mWorlds[item.Draw]; };
+        if (mItems.size() > kSortChunkSize)
+        {
+            std::transform(std::execution::par, mItems.begin(), mItems.end(), mInstances.begin(), gather);
+        }
+        else
+        {
+            std::ranges::transform(mItems, mInstances.begin(), gather);
+        }
+
+        DrawBatch* batch = nullptr;
+        for (u32 index = 0; index < mItems.size(); index++)
+        {
+            const auto& draw = mDraws[mItems[index].Draw];
+            if (batch && batch->Pass == draw.Pass && batch->Shader == draw.Shader &&
+                batch->Material == draw.Material && batch->Mesh == draw.Mesh && batch->Primitive == draw.Primitive)
+            {
+                batch->InstanceCount++;
+                continue;
+            }
+
+            // The first batch binds everything
+            if (!batch || batch->Shader != draw.Shader) mStats.ShaderChanges++;
+            if (!batch || batch->Material != draw.Material) mStats.MaterialChanges++;
+            if (!batch || batch->Mesh != draw.Mesh || batch->Primitive != draw.Primitive) mStats.MeshChanges++;
+            batch = &mBatches.emplace_back(DrawBatch{
+                .Pass = draw.Pass,
+                .Shader = draw.Shader,
+                .Material = draw.Material,
+                .Mesh = draw.Mesh,
+                .Primitive = draw.Primitive,
+                .FirstInstance = index,
+                .InstanceCount = 1,
+            });
+        }
+        mStats.DrawCalls = static_cast<u32>(mBatches.size());
+    }
+}
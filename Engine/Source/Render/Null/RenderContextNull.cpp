@@ -0,0 +1,392 @@
+#include "Render/Null/RenderContextNull.hpp"
+#include "Tools/Metrics.hpp"
+
+namespace
+{
+    // The same metrics as the DX12 backend, so headless runs report what a frame would draw and upload
+    const Neo::Counter kDrawCalls("Render/DrawCalls");
+    const Neo::Counter kTriangles("Render/Triangles");
+    const Neo::Counter kUploadBytes("Render/UploadBytes");
+}
+
+namespace Neo
+{
+    RenderContextNull::RenderContextNull(const RenderContextCreateInfo& args) : mArgs(args)
+    {
+        CreateFrameData();
+    }
+
+    RenderTargetHandle RenderContextNull::CreateRenderTarget(const RenderTargetCreateInfo createInfo,
+                                                             std::string_view)
+    {
+        Count(NullCall::eCreateRenderTarget);
+        Null::RenderTarget renderTarget{.CreateInfo = createInfo, .ResourceHandle = createInfo.ResourceHandle};
+        if (renderTarget.ResourceHandle == ResourceHandle::eNull)
+        {
+            renderTarget.ResourceHandle = mResources.Emplace();
+        }
+        return mRenderTargets.Add(std::move(renderTarget));
+    }
+
+    DepthStencilHandle RenderContextNull::CreateDepthStencil(const DepthStencilCreateInfo createInfo,
+                                                             std::string_view)
+    {
+        Count(NullCall::eCreateDepthStencil);
+        Null::DepthStencil depthStencil{.CreateInfo = createInfo, .ResourceHandle = createInfo.ResourceHandle};
+        if (depthStencil.ResourceHandle == ResourceHandle::eNull)
+        {
+            depthStencil.ResourceHandle = mResources.Emplace();
+        }
+        return mDepthStencils.Add(std::move(depthStencil));
+    }
+
+    CommandHandle RenderContextNull::CreateCommand(const QueueType queueType, std::string_view)
+    {
+        Count(NullCall::eCreateCommand);
+        return mCommands.Emplace(Null::Command{.Queue = queueType});
+    }
+
+    BufferHandle RenderContextNull::CreateBuffer(const BufferCreateInfo& createInfo, std::string_view)
+    {
+        Count(NullCall::eCreateBuffer);
+        Null::Buffer buffer{.CreateInfo = createInfo, .ResourceHandle = createInfo.ResourceHandle};
+        if (buffer.ResourceHandle == ResourceHandle::eNull)
+        {
+            const auto size = static_cast<size_t>(createInfo.NumElements) * createInfo.Stride;
+            buffer.ResourceHandle = mResources.Emplace(Null::Resource{.Data = std::vector<u8>(size)});
+        }
+        return mBuffers.Add(std::move(buffer));
+    }
+
+    TextureHandle RenderContextNull::CreateTexture(const TextureCreateInfo& createInfo, std::string_view)
+    {
+        Count(NullCall::eCreateTexture);
+        return mTextures.Add(Null::Texture{.CreateInfo = createInfo, .ResourceHandle = mResources.Emplace()});
+    }
+
+    ShaderHandle RenderContextNull::CreateShader(const GraphicsShaderCreateInfo&, std::string_view)
+    {
+        Count(NullCall::eCreateShader);
+        return mShaders.Emplace(false);
+    }
+
+    ShaderHandle RenderContextNull::CreateShader(const ComputeShaderCreateInfo&, std::string_view)
+    {
+        Count(NullCall::eCreateShader);
+        return mShaders.Emplace(true);
+    }
+
+    void RenderContextNull::DestroyRenderTarget(const RenderTargetHandle renderTargetHandle)
+    {
+        Count(NullCall::eDestroyRenderTarget);
+        const auto renderTarget = mRenderTargets.Remove(renderTargetHandle);
+        if (!renderTarget) return;
+        (void)mResources.Remove(renderTarget->ResourceHandle);
+    }
+
+    void RenderContextNull::DestroyDepthStencil(const DepthStencilHandle depthStencilHandle)
+    {
+        Count(NullCall::eDestroyDepthStencil);
+        const auto depthStencil = mDepthStencils.Remove(depthStencilHandle);
+        if (!depthStencil) return;
+        (void)mResources.Remove(depthStencil->ResourceHandle);
+    }
+
+    void RenderContextNull::DestroyBuffer(const BufferHandle bufferHandle)
+    {
+        Count(NullCall::eDestroyBuffer);
+        const auto buffer = mBuffers.Remove(bufferHandle);
+        if (!buffer) return;
+        (void)mResources.Remove(buffer->ResourceHandle);
+    }
+
+    void RenderContextNull::DestroyTexture(const TextureHandle textureHandle)
+    {
+        Count(NullCall::eDestroyTexture);
+        const auto texture = mTextures.Remove(textureHandle);
+        if (!texture) return;
+        (void)mResources.Remove(texture->ResourceHandle);
+    }
+
+    void* RenderContextNull::MapBuffer(const BufferHandle bufferHandle)
+    {
+        Count(NullCall::eMapBuffer);
+        return mResources.At(mBuffers.At(bufferHandle).ResourceHandle).Data.data();
+    }
+
+    void RenderContextNull::UnmapBuffer(BufferHandle)
+    {
+        Count(NullCall::eUnmapBuffer);
+    }
+
+    // Stands in for the descriptor index the DX12 backend hands out
+    u32 RenderContextNull::GetGPUAddress(const TextureHandle textureHandle)
+    {
+        return Pool<Null::Texture, TextureHandle>::GetIndex(textureHandle);
+    }
+
+    u32 RenderContextNull::GetGPUAddress(const BufferHandle bufferHandle)
+    {
+        return Pool<Null::Buffer, BufferHandle>::GetIndex(bufferHandle);
+    }
+
+    void RenderContextNull::CopyBuffer(const CommandHandle commandHandle,
+                                       const BufferHandle srcBufferHandle,
+                                       const BufferHandle dstBufferHandle,
+                                       const u64 srcOffset,
+                                       const u64 dstOffset,
+                                       const u64 size)
+    {
+        Count(NullCall::eCopyBuffer);
+        Record(commandHandle,
+               NullCall::eCopyBuffer,
+               {std::bit_cast<u32>(srcBufferHandle), std::bit_cast<u32>(dstBufferHandle), srcOffset, dstOffset, size});
+        kUploadBytes.Add(static_cast<i64>(size));
+    }
+
+    void RenderContextNull::WaitForFrame()
+    {
+        Count(NullCall::eWaitForFrame);
+    }
+
+    void RenderContextNull::WaitForGPU()
+    {
+        Count(NullCall::eWaitForGPU);
+    }
+
+    // Without a window the swapchain keeps the size it was created with
+    void RenderContextNull::Resize()
+    {
+        Count(NullCall::eResize);
+    }
+
+    void RenderContextNull::OneTimeSubmit(const std::span<const CommandHandle> commandHandles,
+                                          const QueueType queueType)
+    {
+        Count(NullCall::eOneTimeSubmit);
+        Submit(commandHandles, queueType);
+        GetFrameData().FenceValue++;
+    }
+
+    void RenderContextNull::Submit(const std::span<const CommandHandle> commandHandles, const QueueType queueType)
+    {
+        Count(NullCall::eSubmit);
+        if (mClearSubmitted)
+        {
+            mSubmitted.clear();
+            mClearSubmitted = false;
+        }
+        for (const auto commandHandle : commandHandles)
+        {
+            const auto& command = mCommands.At(commandHandle);
+            if (command.Recording)
+            {
+                Log::Error("RenderContextNull::Submit Command submitted before EndCommand");
+            }
+            if (command.Queue != queueType)
+            {
+                Log::Error("RenderContextNull::Submit Command submitted to the wrong queue");
+            }
+            // Commands only execute here, so copies have to land now for mapped reads to see them
+            for (const auto& [call, args] : command.Commands)
+            {
+                if (call != NullCall::eCopyBuffer) continue;
+                auto& src = mResources.At(mBuffers.At(std::bit_cast<BufferHandle>(static_cast<u32>(args[0])))
+                                              .ResourceHandle).Data;
+                auto& dst = mResources.At(mBuffers.At(std::bit_cast<BufferHandle>(static_cast<u32>(args[1])))
+                                              .ResourceHandle).Data;
+                const auto srcOffset = args[2];
+                const auto dstOffset = args[3];
+                const auto size = args[4];
+                if (srcOffset + size > src.size() || dstOffset + size > dst.size())
+                {
+                    Log::Error("RenderContextNull::Submit CopyBuffer out of range");
+                    continue;
+                }
+                std::memmove(dst.data() + dstOffset, src.data() + srcOffset, size);
+            }
+            mSubmitted.emplace_back(commandHandle);
+        }
+    }
+
+    u64 RenderContextNull::SignalTransfer()
+    {
+        Count(NullCall::eSignalTransfer);
+        return ++mTransferFenceValue;
+    }
+
+    void RenderContextNull::Present()
+    {
+        Count(NullCall::ePresent);
+        mClearSubmitted = true;
+        GetFrameData().FenceValue++;
+        mFrameIndex = (mFrameIndex + 1) % kFrameCount;
+        WaitForFrame();
+    }
+
+    void RenderContextNull::BeginCommand(const CommandHandle commandHandle)
+    {
+        Count(NullCall::eBeginCommand);
+        // Like resetting a command allocator, keeping the capacity of the previous recording
+        auto& command = mCommands.At(commandHandle);
+        command.Commands.clear();
+        command.PushConstantData.clear();
+        command.Recording = true;
+        Record(commandHandle, NullCall::eBeginCommand);
+    }
+
+    void RenderContextNull::EndCommand(const CommandHandle commandHandle)
+    {
+        Count(NullCall::eEndCommand);
+        Record(commandHandle, NullCall::eEndCommand);
+        mCommands.At(commandHandle).Recording = false;
+    }
+
+    void RenderContextNull::SetupGraphicsCommand(const CommandHandle commandHandle)
+    {
+        Count(NullCall::eSetupGraphicsCommand);
+        Record(commandHandle, NullCall::eSetupGraphicsCommand);
+    }
+
+    void RenderContextNull::Barrier(const CommandHandle commandHandle, const std::span<const ResourceBarrier> barriers)
+    {
+        Count(NullCall::eBarrier);
+        for (const auto& [resource, before, after] : barriers)
+        {
+            Record(commandHandle,
+                   NullCall::eBarrier,
+                   {std::bit_cast<u32>(resource), static_cast<u64>(before), static_cast<u64>(after)});
+        }
+    }
+
+    void RenderContextNull::BeginRenderPass(const CommandHandle commandHandle, const RenderPassInfo& renderPassInfo)
+    {
+        Count(NullCall::eBeginRenderPass);
+        const auto renderTarget = renderPassInfo.RenderTargets.empty()
+                                      ? RenderTargetHandle::eNull
+                                      : renderPassInfo.RenderTargets.front();
+        Record(commandHandle,
+               NullCall::eBeginRenderPass,
+               {std::bit_cast<u32>(renderTarget),
+                std::bit_cast<u32>(renderPassInfo.DepthStencil),
+                renderPassInfo.RenderTargets.size()});
+    }
+
+    void RenderContextNull::EndRenderPass(const CommandHandle commandHandle)
+    {
+        Count(NullCall::eEndRenderPass);
+        Record(commandHandle, NullCall::eEndRenderPass);
+    }
+
+    void RenderContextNull::BindShader(const CommandHandle commandHandle, const ShaderHandle shaderHandle)
+    {
+        Count(NullCall::eBindShader);
+        Record(commandHandle, NullCall::eBindShader, {std::bit_cast<u32>(shaderHandle)});
+    }
+
+    void RenderContextNull::SetPrimitiveTopology(const CommandHandle commandHandle, const PrimitiveTopology topology)
+    {
+        Count(NullCall::eSetPrimitiveTopology);
+        Record(commandHandle, NullCall::eSetPrimitiveTopology, {static_cast<u64>(topology)});
+    }
+
+    void RenderContextNull::BindIndexBuffer(const CommandHandle commandHandle, const BufferHandle bufferHandle)
+    {
+        Count(NullCall::eBindIndexBuffer);
+        Record(commandHandle, NullCall::eBindIndexBuffer, {std::bit_cast<u32>(bufferHandle)});
+    }
+
+    void RenderContextNull::Draw(const CommandHandle commandHandle,
+                                 const u32 vertexCount,
+                                 const u32 instanceCount,
+                                 const u32 vertexOffset,
+                                 const u32 firstInstance)
+    {
+        Count(NullCall::eDraw);
+        Record(commandHandle, NullCall::eDraw, {vertexCount, instanceCount, vertexOffset, firstInstance});
+        kDrawCalls.Add();
+        kTriangles.Add(static_cast<i64>(vertexCount / 3) * instanceCount);
+    }
+
+    void RenderContextNull::DrawIndexed(const CommandHandle commandHandle,
+                                        const u32 indexCount,
+                                        const u32 instanceCount,
+                                        const u32 firstIndex,
+                                        const int vertexOffset,
+                                        const u32 firstInstance)
+    {
+        Count(NullCall::eDrawIndexed);
+        Record(commandHandle,
+               NullCall::eDrawIndexed,
+               {indexCount, instanceCount, firstIndex, std::bit_cast<u32>(vertexOffset), firstInstance});
+        kDrawCalls.Add();
+        kTriangles.Add(static_cast<i64>(indexCount / 3) * instanceCount);
+    }
+
+    void RenderContextNull::SetViewport(const CommandHandle commandHandle, const Viewport& viewport)
+    {
+        Count(NullCall::eSetViewport);
+        Record(commandHandle,
+               NullCall::eSetViewport,
+               {std::bit_cast<u32>(viewport.Dimensions.x),
+                std::bit_cast<u32>(viewport.Dimensions.y),
+                std::bit_cast<u32>(viewport.Offset.x),
+                std::bit_cast<u32>(viewport.Offset.y)});
+    }
+
+    void RenderContextNull::SetScissor(const CommandHandle commandHandle, const Scissor& scissor)
+    {
+        Count(NullCall::eSetScissor);
+        Record(commandHandle, NullCall::eSetScissor, {scissor.Min.x, scissor.Min.y, scissor.Max.x, scissor.Max.y});
+    }
+
+    void RenderContextNull::BlitToSwapchain(const CommandHandle commandHandle,
+                                            const RenderTargetHandle renderTargetHandle)
+    {
+        Count(NullCall::eBlitToSwapchain);
+        Record(commandHandle,
+               NullCall::eBlitToSwapchain,
+               {std::bit_cast<u32>(renderTargetHandle), std::bit_cast<u32>(GetFrameData().RenderTargetHandle)});
+    }
+
+    void RenderContextNull::PushConstant(const CommandHandle commandHandle, const u32 count, const void* data)
+    {
+        Count(NullCall::ePushConstant);
+        auto& pushConstantData = mCommands.At(commandHandle).PushConstantData;
+        const auto offset = pushConstantData.size();
+        const auto size = static_cast<size_t>(count) * sizeof(u32);
+        pushConstantData.resize(offset + size);
+        std::memcpy(pushConstantData.data() + offset, data, size);
+        Record(commandHandle, NullCall::ePushConstant, {count, offset, size});
+    }
+
+    void RenderContextNull::CreateFrameData()
+    {
+        for (auto [index, frameData] : std::views::enumerate(mFrameDatas))
+        {
+            frameData.CommandHandle = CreateCommand(QueueType::eGraphics, "Frame Command" + std::to_string(index));
+            const RenderTargetCreateInfo createInfo{
+                .Size = mArgs.Size,
+                .Format = Format::eB8G8R8A8_UNORM,
+                .ViewType = ViewType::eTexture2D,
+            };
+            frameData.RenderTargetHandle =
+                CreateRenderTarget(createInfo, std::string("Swapchain Buffer") + std::to_string(index));
+        }
+        mFrameIndex = 0;
+    }
+
+    void RenderContextNull::Record(const CommandHandle commandHandle,
+                                   const NullCall call,
+                                   const std::array<u64, 5>& args)
+    {
+        auto& command = mCommands.At(commandHandle);
+        if (!command.Recording)
+        {
+            Log::Error("RenderContextNull: {} recorded outside of BeginCommand and EndCommand",
+                       magic_enum::enum_name(call));
+            return;
+        }
+        command.Commands.emplace_back(NullCommand{.Call = call, .Args = args});
+    }
+} // namespace FS
@@ -0,0 +1,273 @@
+#include "Render/Occlusion.hpp"
+#include "Tools/Metrics.hpp"
+#include "Tools/Profiler.hpp"
+#include "Tools/Simd.hpp"
+
+namespace
+{
+    const Neo::Gauge kTriangles("Occlusion/Triangles");
+
+    // Bit set for every clip plane the vertex is outside of, so a triangle with a bit set in all three vertices
+    // cannot be seen
+    u32 GetOutcode(const glm::vec4& clip)
+    {
+        return (clip.x < -clip.w ? 1u : 0u) | (clip.x > clip.w ? 2u : 0u) | (clip.y < -clip.w ? 4u : 0u) |
+            (clip.y > clip.w ? 8u : 0u) | (clip.z < -clip.w ? 16u : 0u) | (clip.z > clip.w ? 32u : 0u);
+    }
+}
+
+namespace Neo
+{
+    void OcclusionCuller::Begin(const glm::mat4& viewProjection)
+    {
+        mViewProjection = viewProjection;
+        mTriangles.clear();
+        std::ranges::fill(mDepth, 1.f);
+        std::ranges::fill(mBlockDepth, 1.f);
+    }
+
+    void OcclusionCuller::AddOccluder(const std::span<const Vertex> vertices,
+                                      const std::span<const u32> indices,
+                                      const glm::mat4& world)
+    {
+        const auto transform = mViewProjection * world;
+        auto& clip = mClipVertices;
+        clip.resize(vertices.size());
+        for (u32 index = 0; index < vertices.size(); index++)
+        {
+            clip[index] = transform * glm::vec4(vertices[index].Position, 1.f);
+        }
+
+        for (u32 index = 0; index + 2 < indices.size(); index += 3)
+        {
+            const std::array<glm::vec4, 3> triangle{clip[indices[index]], clip[indices[index + 1]],
+                                                    clip[indices[index + 2]]};
+            const std::array<u32, 3> outcodes{GetOutcode(triangle[0]), GetOutcode(triangle[1]),
+                                              GetOutcode(triangle[2])};
+            if (outcodes[0] & outcodes[1] & outcodes[2]) continue;
+            if (!((outcodes[0] | outcodes[1] | outcodes[2]) & 16u))
+            {
+                AddTriangle(triangle[0], triangle[1], triangle[2]);
+                continue;
+            }
+
+            // Cut away the part in front of the near plane, leaving at most a quad
+            std::array<glm::vec4, 4> polygon;
+            u32 count = 0;
+            for (u32 vertex = 0; vertex < 3; vertex++)
+            {
+                const auto& current = triangle[vertex];
+                const auto& next = triangle[(vertex + 1) % 3];
+                const auto currentDistance = current.z + current.w;
+                const auto nextDistance = next.z + next.w;
+                if (currentDistance >= 0.f) polygon[count++] = current;
+                if ((currentDistance >= 0.f) != (nextDistance >= 0.f))
+                {
+                    const auto t = currentDistance / (currentDistance - nextDistance);
+                    polygon[count++] = current + (next - current) * t;
+                }
+            }
+            for (u32 vertex = 1; vertex + 1 < count; vertex++)
+            {
+                AddTriangle(polygon[0], polygon[vertex], polygon[vertex + 1]);
+            }
+        }
+    }
+
+    void OcclusionCuller::Rasterize()
+    {
+        NEO_PROFILE_FUNCTION();
+        for (auto& bin : mBins)
+        {
+            bin.clear();
+        }
+        for (u32 index = 0; index < mTriangles.size(); index++)
+        {
+            const auto& [vertices] = mTriangles[index];
+            const auto min = glm::min(glm::min(vertices[0], vertices[1]), vertices[2]);
+            const auto max = glm::max(glm::max(vertices[0], vertices[1]), vertices[2]);
+            const auto firstX = static_cast<u32>(std::clamp(min.x, 0.f, kWidth - 1.f)) / kTileWidth;
+            const auto lastX = static_cast<u32>(std::clamp(max.x, 0.f, kWidth - 1.f)) / kTileWidth;
+            const auto firstY = static_cast<u32>(std::clamp(min.y, 0.f, kHeight - 1.f)) / kTileHeight;
+            const auto lastY = static_cast<u32>(std::clamp(max.y, 0.f, kHeight - 1.f)) / kTileHeight;
+            for (auto tileY = firstY; tileY <= lastY; tileY++)
+            {
+                for (auto tileX = firstX; tileX <= lastX; tileX++)
+                {
+                    mBins[tileY * kTilesX + tileX].emplace_back(index);
+                }
+            }
+        }
+
+        // Tiles never share pixels, so each one is rasterized on its own thread
+        const auto tiles = std::views::iota(0u, kTilesX * kTilesY);
+        std::for_each(std::execution::par, tiles.begin(), tiles.end(), [this](const u32 tile)
+        {
+            RasterizeTile(tile);
+            UpdateBlocks(tile);
+        });
+        kTriangles.Set(mTriangles.size());
+    }
+
+    bool OcclusionCuller::IsVisible(const Bounds& worldBounds) const
+    {
+        if (mTriangles.empty()) return true;
+
+        glm::vec2 min(std::numeric_limits<float>::max());
+        glm::vec2 max(std::numeric_limits<float>::lowest());
+        auto nearest = std::numeric_limits<float>::max();
+        for (u32 corner = 0; corner < 8; corner++)
+        {
+            const glm::vec3 position(corner & 1 ? worldBounds.Max.x : worldBounds.Min.x,
+                                     corner & 2 ? worldBounds.Max.y : worldBounds.Min.y,
+                                     corner & 4 ? worldBounds.Max.z : worldBounds.Min.z);
+            const auto clip = mViewProjection * glm::vec4(position, 1.f);
+            // Crossing the near plane, where the projected box would not contain the object
+            if (clip.z + clip.w < 0.f || clip.w <= 0.f) return true;
+
+            const auto device = glm::vec3(clip) / clip.w;
+            min = glm::min(min, glm::vec2(device.x, device.y));
+            max = glm::max(max, glm::vec2(device.x, device.y));
+            nearest = std::min(nearest, device.z);
+        }
+
+        // Top row first, so the largest y is the smallest row
+        const auto left = (min.x * 0.5f + 0.5f) * kWidth;
+        const auto right = (max.x * 0.5f + 0.5f) * kWidth;
+        const auto top = (0.5f - max.y * 0.5f) * kHeight;
+        const auto bottom = (0.5f - min.y * 0.5f) * kHeight;
+        if (right < 0.f || bottom < 0.f || left >= kWidth || top >= kHeight) return true;
+
+        const auto firstX = static_cast<u32>(std::clamp(left, 0.f, kWidth - 1.f));
+        const auto lastX = static_cast<u32>(std::clamp(right, 0.f, kWidth - 1.f));
+        const auto firstY = static_cast<u32>(std::clamp(top, 0.f, kHeight - 1.f));
+        const auto lastY = static_cast<u32>(std::clamp(bottom, 0.f, kHeight - 1.f));
+        for (auto blockY = firstY / kBlockSize; blockY <= lastY / kBlockSize; blockY++)
+        {
+            for (auto blockX = firstX / kBlockSize; blockX <= lastX / kBlockSize; blockX++)
+            {
+                // Behind the farthest occluder in the block, so hidden in all of it
+                if (nearest > mBlockDepth[blockY * kBlocksX + blockX]) continue;
+
+                const auto endY = std::min(lastY, (blockY + 1) * kBlockSize - 1);
+                const auto endX = std::min(lastX, (blockX + 1) * kBlockSize - 1);
+                for (auto y = std::max(firstY, blockY * kBlockSize); y <= endY; y++)
+                {
+                    for (auto x = std::max(firstX, blockX * kBlockSize); x <= endX; x++)
+                    {
+                        if (nearest <= mDepth[y * kWidth + x]) return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    void OcclusionCuller::AddTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+    {
+        const auto toScreen = [](const glm::vec4& clip)
+        {
+            const auto device = glm::vec3(clip) / clip.w;
+            return glm::vec3((device.x * 0.5f + 0.5f) * kWidth, (0.5f - device.y * 0.5f) * kHeight, device.z);
+        };
+        const Triangle triangle{{toScreen(a), toScreen(b), toScreen(c)}};
+        const auto& [v0, v1, v2] = triangle.Vertices;
+        const auto area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        // Degenerate triangles cover no pixel centers worth the setup
+        if (std::abs(area) < 1e-6f) return;
+        mTriangles.emplace_back(triangle);
+    }
+
+    void OcclusionCuller::RasterizeTile(const u32 tile)
+    {
+        alignas(16) static constexpr std::array kLaneOffsets{0.5f, 1.5f, 2.5f, 3.5f};
+        const auto tileX = tile % kTilesX * kTileWidth;
+        const auto tileY = tile / kTilesX * kTileHeight;
+        const auto laneOffsets = Float4::Load(kLaneOffsets.data());
+        const auto zero = Float4::Broadcast(0.f);
+
+        for (const auto index : mBins[tile])
+        {
+            auto [v0, v1, v2] = mTriangles[index].Vertices;
+            auto area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+            if (area < 0.f)
+            {
+                std::swap(v1, v2);
+                area = -area;
+            }
+
+            // Edge i is opposite vertex i and positive on the inside, where it equals area times the weight of
+            // vertex i. Depth is interpolated with the same weights
+            const std::array<std::pair<glm::vec3, glm::vec3>, 3> edges{{{v1, v2}, {v2, v0}, {v0, v1}}};
+            std::array<glm::vec3, 3> planes;
+            for (u32 edge = 0; edge < 3; edge++)
+            {
+                const auto& [from, to] = edges[edge];
+                const auto stepX = from.y - to.y;
+                const auto stepY = to.x - from.x;
+                planes[edge] = glm::vec3(stepX, stepY, -(stepX * from.x + stepY * from.y));
+            }
+            const auto depth = (planes[0] * v0.z + planes[1] * v1.z + planes[2] * v2.z) / area;
+
+            const auto min = glm::min(glm::min(v0, v1), v2);
+            const auto max = glm::max(glm::max(v0, v1), v2);
+            const auto firstX = static_cast<u32>(std::clamp(min.x, static_cast<float>(tileX),
+                                                            static_cast<float>(tileX + kTileWidth - 1))) & ~3u;
+            const auto lastX = static_cast<u32>(std::clamp(max.x, static_cast<float>(tileX),
+                                                           static_cast<float>(tileX + kTileWidth - 1)));
+            const auto firstY = static_cast<u32>(std::clamp(min.y, static_cast<float>(tileY),
+                                                            static_cast<float>(tileY + kTileHeight - 1)));
+            const auto lastY = static_cast<u32>(std::clamp(max.y, static_cast<float>(tileY),
+                                                           static_cast<float>(tileY + kTileHeight - 1)));
+
+            const auto stepX0 = Float4::Broadcast(planes[0].x);
+            const auto stepX1 = Float4::Broadcast(planes[1].x);
+            const auto stepX2 = Float4::Broadcast(planes[2].x);
+            const auto depthStepX = Float4::Broadcast(depth.x);
+            for (auto y = firstY; y <= lastY; y++)
+            {
+                const auto centerY = static_cast<float>(y) + 0.5f;
+                const auto row0 = Float4::Broadcast(planes[0].y * centerY + planes[0].z);
+                const auto row1 = Float4::Broadcast(planes[1].y * centerY + planes[1].z);
+                const auto row2 = Float4::Broadcast(planes[2].y * centerY + planes[2].z);
+                const auto depthRow = Float4::Broadcast(depth.y * centerY + depth.z);
+                auto* const pixels = mDepth.data() + y * kWidth;
+                for (auto x = firstX; x <= lastX; x += 4)
+                {
+                    const auto centerX = Float4::Broadcast(static_cast<float>(x)) + laneOffsets;
+                    const auto outside = LessThan(centerX * stepX0 + row0, zero) |
+                        LessThan(centerX * stepX1 + row1, zero) | LessThan(centerX * stepX2 + row2, zero);
+                    const auto inside = ~outside & 0xFu;
+                    if (!inside) continue;
+
+                    alignas(16) std::array<float, 4> depths;
+                    (centerX * depthStepX + depthRow).Store(depths.data());
+                    for (auto remaining = inside; remaining != 0; remaining &= remaining - 1)
+                    {
+                        const auto lane = std::countr_zero(remaining);
+                        pixels[x + lane] = std::min(pixels[x + lane], depths[lane]);
+                    }
+                }
+            }
+        }
+    }
+
+    void OcclusionCuller::UpdateBlocks(const u32 tile)
+    {
+        const auto tileX = tile % kTilesX * kTileWidth;
+        const auto tileY = tile / kTilesX * kTileHeight;
+        for (auto blockY = tileY; blockY < tileY + kTileHeight; blockY += kBlockSize)
+        {
+            for (auto blockX = tileX; blockX < tileX + kTileWidth; blockX += kBlockSize)
+            {
+                auto farthest = std::numeric_limits<float>::lowest();
+                for (auto y = blockY; y < blockY + kBlockSize; y++)
+                {
+                    const auto* row = mDepth.data() + y * kWidth + blockX;
+                    farthest = std::max(farthest, *std::max_element(row, row + kBlockSize));
+                }
+                mBlockDepth[blockY / kBlockSize * kBlocksX + blockX / kBlockSize] = farthest;
+            }
+        }
+    }
+}
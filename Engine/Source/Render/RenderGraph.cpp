@@ -0,0 +1,417 @@
+#include "Render/RenderGraph.hpp"
+#include "Tools/Profiler.hpp"
+
+namespace
+{
+    constexpr u32 kNoPhysical = std::numeric_limits<u32>::max();
+
+    template <typename T>
+    u64 HashValue(const T& value, const u64 hash)
+    {
+        return Neo::HashBytes(&value, sizeof(value), hash);
+    }
+}
+
+namespace Neo
+{
+    RenderGraphResource RenderGraphBuilder::CreateRenderTarget(const std::string_view name,
+                                                               const RenderGraphTextureDesc& desc)
+    {
+        const auto index = static_cast<u32>(mGraph.mResources.size());
+        mGraph.mResources.emplace_back(RenderGraph::Resource{
+            .Name = std::pmr::string(name, mGraph.mMemory),
+            .Desc = desc,
+        });
+        return static_cast<RenderGraphResource>(index);
+    }
+
+    RenderGraphResource RenderGraphBuilder::Read(const RenderGraphResource resource, const ResourceState state)
+    {
+        if (static_cast<u32>(resource) >= mGraph.mResources.size())
+        {
+            Log::Error("RenderGraph: Pass {} reads an unknown resource", mGraph.mPasses[mPass].Name);
+            return RenderGraphResource::eNull;
+        }
+        mGraph.mPasses[mPass].Accesses.emplace_back(RenderGraph::Access{resource, state, false});
+        return resource;
+    }
+
+    RenderGraphResource RenderGraphBuilder::Write(const RenderGraphResource resource, const ResourceState state)
+    {
+        if (static_cast<u32>(resource) >= mGraph.mResources.size())
+        {
+            Log::Error("RenderGraph: Pass {} writes an unknown resource", mGraph.mPasses[mPass].Name);
+            return RenderGraphResource::eNull;
+        }
+        mGraph.mPasses[mPass].Accesses.emplace_back(RenderGraph::Access{resource, state, true});
+        return resource;
+    }
+
+    void RenderGraphBuilder::SideEffect()
+    {
+        mGraph.mPasses[mPass].SideEffect = true;
+    }
+
+    void RenderGraph::Reset(std::pmr::memory_resource* memory)
+    {
+        mResources.clear();
+        mPasses.clear();
+        mMemory = memory;
+    }
+
+    RenderGraphResource RenderGraph::Import(const std::string_view name,
+                                            const RenderTargetHandle renderTarget,
+                                            const ResourceState initialState,
+                                            const ResourceState finalState)
+    {
+        const auto index = static_cast<u32>(mResources.size());
+        mResources.emplace_back(Resource{
+            .Name = std::pmr::string(name, mMemory),
+            .RenderTarget = renderTarget,
+            .Imported = true,
+            .InitialState = initialState,
+            .FinalState = finalState,
+        });
+        return static_cast<RenderGraphResource>(index);
+    }
+
+    void RenderGraph::AddPass(const std::string_view name,
+                              const std::function<void(RenderGraphBuilder&)>& setup,
+                              RenderGraphExecute execute)
+    {
+        const auto index = static_cast<u32>(mPasses.size());
+        mPasses.emplace_back(Pass{
+            .Name = std::pmr::string(name, mMemory),
+            .Accesses = std::pmr::vector<Access>(mMemory),
+        });
+        if (setup)
+        {
+            RenderGraphBuilder builder(*this, index);
+            setup(builder);
+        }
+        mPasses[index].Execute = std::move(execute);
+    }
+
+    void RenderGraph::Compile(IRenderContext& context)
+    {
+        NEO_PROFILE_FUNCTION();
+        const auto hash = HashTopology();
+        if (mCompiled && hash == mCompiledHash) return;
+
+        Cull();
+        Alias(context);
+        PlanBarriers();
+
+        mPassZones.clear();
+        for (const auto pass : mExecutedPasses)
+        {
+            mPassZones.emplace_back(Profiler::InternName(mPasses[pass].Name.empty() ? "RenderPass"
+                                                                                    : mPasses[pass].Name));
+        }
+        mCompiled = true;
+        mCompiledHash = hash;
+        mCompileCount++;
+    }
+
+    void RenderGraph::Execute(IRenderContext& context, const CommandHandle commandHandle)
+    {
+        if (!mCompiled)
+        {
+            Log::Error("RenderGraph: Executed before being compiled");
+            return;
+        }
+        for (const auto& [index, pass] : std::views::enumerate(mExecutedPasses))
+        {
+            FlushBarriers(context, commandHandle, mBarrierOffsets[index], mBarrierOffsets[index + 1]);
+            NEO_PROFILE_SCOPE(mPassZones[index]);
+            if (const auto& execute = mPasses[pass].Execute)
+            {
+                execute(*this, commandHandle);
+            }
+        }
+        const auto end = mExecutedPasses.size();
+        FlushBarriers(context, commandHandle, mBarrierOffsets[end], mBarrierOffsets[end + 1]);
+        UpdateTargetStates();
+    }
+
+    std::span<const CommandHandle> RenderGraph::ExecuteParallel(IRenderContext& context,
+                                                                const CommandHandle commandHandle)
+    {
+        if (!mCompiled)
+        {
+            Log::Error("RenderGraph: Executed before being compiled");
+            return {};
+        }
+        mSubmitCommands.clear();
+        for (const auto& [index, pass] : std::views::enumerate(mExecutedPasses))
+        {
+            const auto command = context.GetSecondaryCommand(static_cast<u32>(index));
+            context.BeginCommand(command);
+            context.SetupGraphicsCommand(command);
+            FlushBarriers(context, command, mBarrierOffsets[index], mBarrierOffsets[index + 1]);
+            mSubmitCommands.emplace_back(command);
+        }
+
+        const auto indices = std::views::iota(0uz, mSubmitCommands.size());
+        std::for_each(std::execution::par, indices.begin(), indices.end(), [&](const size_t index)
+        {
+            const auto command = mSubmitCommands[index];
+            NEO_PROFILE_SCOPE(mPassZones[index]);
+            if (const auto& execute = mPasses[mExecutedPasses[index]].Execute)
+            {
+                execute(*this, command);
+            }
+            context.EndCommand(command);
+        });
+
+        const auto end = mExecutedPasses.size();
+        FlushBarriers(context, commandHandle, mBarrierOffsets[end], mBarrierOffsets[end + 1]);
+        mSubmitCommands.emplace_back(commandHandle);
+        UpdateTargetStates();
+        return mSubmitCommands;
+    }
+
+    void RenderGraph::Release(IRenderContext& context)
+    {
+        for (const auto& physicalTarget : mPhysicalTargets)
+        {
+            context.DestroyRenderTarget(physicalTarget.RenderTarget);
+        }
+        mPhysicalTargets.clear();
+        mCompiled = false;
+    }
+
+    RenderTargetHandle RenderGraph::GetRenderTarget(const RenderGraphResource resource) const
+    {
+        const auto index = static_cast<u32>(resource);
+        if (index >= mResources.size()) return RenderTargetHandle::eNull;
+        if (mResources[index].Imported) return mResources[index].RenderTarget;
+        const auto physical = mPhysicalIndices[index];
+        return physical == kNoPhysical ? RenderTargetHandle::eNull : mPhysicalTargets[physical].RenderTarget;
+    }
+
+    size_t RenderGraph::GetTransientCount() const
+    {
+        return std::ranges::count(mResources, false, &Resource::Imported);
+    }
+
+    // Everything compiling depends on, but not the imported handles, since the swapchain target changes every frame
+    u64 RenderGraph::HashTopology() const
+    {
+        auto hash = HashValue(mResources.size(), HashBytes(nullptr, 0));
+        for (const auto& resource : mResources)
+        {
+            hash = HashValue(resource.Desc.Size, hash);
+            hash = HashValue(resource.Desc.Format, hash);
+            hash = HashValue(resource.Imported, hash);
+            hash = HashValue(resource.InitialState, hash);
+            hash = HashValue(resource.FinalState, hash);
+        }
+        hash = HashValue(mPasses.size(), hash);
+        for (const auto& pass : mPasses)
+        {
+            hash = HashBytes(pass.Name.data(), pass.Name.size(), hash);
+            hash = HashValue(pass.SideEffect, hash);
+            hash = HashValue(pass.Accesses.size(), hash);
+            for (const auto& [resource, state, write] : pass.Accesses)
+            {
+                hash = HashValue(resource, hash);
+                hash = HashValue(state, hash);
+                hash = HashValue(write, hash);
+            }
+        }
+        return hash;
+    }
+
+    // Walks the passes backwards, keeping a pass if it has side effects, writes an imported resource or writes
+    // something a kept pass reads
+    void RenderGraph::Cull()
+    {
+        std::pmr::vector<bool> needed(mResources.size(), false, mMemory);
+        std::pmr::vector<bool> live(mPasses.size(), false, mMemory);
+        for (auto pass = mPasses.size(); pass-- > 0;)
+        {
+            const auto& [name, accesses, execute, sideEffect] = mPasses[pass];
+            auto isLive = sideEffect;
+            for (const auto& [resource, state, write] : accesses)
+            {
+                isLive |= write && (IsImported(resource) || needed[static_cast<u32>(resource)]);
+            }
+            if (!isLive) continue;
+
+            live[pass] = true;
+            for (const auto& [resource, state, write] : accesses)
+            {
+                if (!write) needed[static_cast<u32>(resource)] = true;
+            }
+        }
+
+        mExecutedPasses.clear();
+        for (u32 pass = 0; pass < mPasses.size(); pass++)
+        {
+            if (live[pass]) mExecutedPasses.emplace_back(pass);
+        }
+    }
+
+    // Greedy interval allocation: transients ordered by their first use take the first physical target of the
+    // same size and format that is free again by then
+    void RenderGraph::Alias(IRenderContext& context)
+    {
+        const auto resourceCount = mResources.size();
+        std::pmr::vector<u32> firstUse(resourceCount, std::numeric_limits<u32>::max(), mMemory);
+        std::pmr::vector<u32> lastUse(resourceCount, 0, mMemory);
+        for (const auto& [order, pass] : std::views::enumerate(mExecutedPasses))
+        {
+            for (const auto& access : mPasses[pass].Accesses)
+            {
+                const auto resource = static_cast<u32>(access.Resource);
+                firstUse[resource] = std::min(firstUse[resource], static_cast<u32>(order));
+                lastUse[resource] = std::max(lastUse[resource], static_cast<u32>(order));
+            }
+        }
+
+        std::pmr::vector<u32> transients(mMemory);
+        for (u32 resource = 0; resource < resourceCount; resource++)
+        {
+            if (!mResources[resource].Imported && firstUse[resource] != std::numeric_limits<u32>::max())
+            {
+                transients.emplace_back(resource);
+            }
+        }
+        std::ranges::stable_sort(transients, {}, [&](const u32 resource) { return firstUse[resource]; });
+
+        struct Slot
+        {
+            RenderGraphTextureDesc Desc;
+            u32 LastUse;
+        };
+        std::pmr::vector<Slot> slots(mMemory);
+        mPhysicalIndices.assign(resourceCount, kNoPhysical);
+        for (const auto resource : transients)
+        {
+            const auto& desc = mResources[resource].Desc;
+            const auto slot = std::ranges::find_if(slots, [&](const Slot& candidate)
+            {
+                return candidate.Desc == desc && candidate.LastUse < firstUse[resource];
+            });
+            if (slot != slots.end())
+            {
+                slot->LastUse = lastUse[resource];
+                mPhysicalIndices[resource] = static_cast<u32>(slot - slots.begin());
+            }
+            else
+            {
+                mPhysicalIndices[resource] = static_cast<u32>(slots.size());
+                slots.emplace_back(Slot{desc, lastUse[resource]});
+            }
+        }
+
+        // Keep the targets of the last compile that still fit, so a change elsewhere does not recreate them all
+        std::vector<PhysicalTarget> physicalTargets;
+        physicalTargets.reserve(slots.size());
+        for (const auto& [index, slot] : std::views::enumerate(slots))
+        {
+            const auto existing = std::ranges::find(mPhysicalTargets, slot.Desc, &PhysicalTarget::Desc);
+            if (existing != mPhysicalTargets.end())
+            {
+                physicalTargets.emplace_back(*existing);
+                mPhysicalTargets.erase(existing);
+                continue;
+            }
+            const RenderTargetCreateInfo createInfo{
+                .Size = slot.Desc.Size,
+                .Format = slot.Desc.Format,
+                .ViewType = ViewType::eTexture2D,
+            };
+            physicalTargets.emplace_back(PhysicalTarget{
+                slot.Desc, context.CreateRenderTarget(createInfo, fmt::format("RenderGraph Target {}", index))
+            });
+        }
+        for (const auto& unused : mPhysicalTargets)
+        {
+            context.DestroyRenderTarget(unused.RenderTarget);
+        }
+        mPhysicalTargets = std::move(physicalTargets);
+    }
+
+    // Imported resources start the frame in their initial state. A physical target starts in the state the last
+    // executed frame left it in, which is undefined for a new one, and may be another plan's for a kept one
+    void RenderGraph::PlanBarriers()
+    {
+        std::pmr::vector<ResourceState> importedStates(mResources.size(), ResourceState::eUndefined, mMemory);
+        for (const auto& [index, resource] : std::views::enumerate(mResources))
+        {
+            if (resource.Imported) importedStates[index] = resource.InitialState;
+        }
+        std::pmr::vector<ResourceState> physicalStates(mMemory);
+        physicalStates.reserve(mPhysicalTargets.size());
+        for (const auto& target : mPhysicalTargets)
+        {
+            physicalStates.emplace_back(target.State);
+        }
+
+        auto getState = [&](const RenderGraphResource resource) -> ResourceState&
+        {
+            const auto index = static_cast<u32>(resource);
+            return mResources[index].Imported ? importedStates[index] : physicalStates[mPhysicalIndices[index]];
+        };
+
+        mBarriers.clear();
+        mBarrierOffsets.clear();
+        for (const auto pass : mExecutedPasses)
+        {
+            mBarrierOffsets.emplace_back(static_cast<u32>(mBarriers.size()));
+            for (const auto& [resource, state, write] : mPasses[pass].Accesses)
+            {
+                auto& current = getState(resource);
+                if (current == state) continue;
+                mBarriers.emplace_back(Barrier{resource, current, state});
+                current = state;
+            }
+        }
+        mBarrierOffsets.emplace_back(static_cast<u32>(mBarriers.size()));
+        for (const auto& [index, resource] : std::views::enumerate(mResources))
+        {
+            if (!resource.Imported || importedStates[index] == resource.FinalState) continue;
+            mBarriers.emplace_back(Barrier{
+                static_cast<RenderGraphResource>(index), importedStates[index], resource.FinalState
+            });
+        }
+        mBarrierOffsets.emplace_back(static_cast<u32>(mBarriers.size()));
+
+        for (size_t index = 0; index < mPhysicalTargets.size(); index++)
+        {
+            mPhysicalTargets[index].PlannedState = physicalStates[index];
+        }
+    }
+
+    // The first frame of a plan may start its targets in states the plan does not leave them in. Once it ran, the
+    // barriers are planned again for the frames that reuse the plan, which start where it ends
+    void RenderGraph::UpdateTargetStates()
+    {
+        bool replan = false;
+        for (auto& target : mPhysicalTargets)
+        {
+            replan |= target.State != target.PlannedState;
+            target.State = target.PlannedState;
+        }
+        if (replan) PlanBarriers();
+    }
+
+    void RenderGraph::FlushBarriers(IRenderContext& context,
+                                    const CommandHandle commandHandle,
+                                    const u32 first,
+                                    const u32 last)
+    {
+        if (first == last) return;
+        mBarrierScratch.clear();
+        for (u32 index = first; index < last; index++)
+        {
+            const auto& [resource, before, after] = mBarriers[index];
+            const auto renderTarget = GetRenderTarget(resource);
+            if (renderTarget == RenderTargetHandle::eNull) continue;
+            mBarrierScratch.emplace_back(ResourceBarrier{context.GetResourceHandle(renderTarget), before, after});
+        }
+        context.Barrier(commandHandle, mBarrierScratch);
+    }
+} // namespace FS
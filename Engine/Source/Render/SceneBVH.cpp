@@ -0,0 +1,102 @@
+#include "Render/SceneBVH.hpp"
+#include "Core/ECS.hpp"
+#include "Core/Resources.hpp"
+#include "Tools/Metrics.hpp"
+#include "Tools/Profiler.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+namespace
+{
+    const Neo::Gauge kObjects("SceneBVH/Objects");
+    const Neo::Gauge kNodes("SceneBVH/Nodes");
+}
+
+namespace Neo
+{
+    glm::mat4 GetWorldMatrix(const Transform& transform)
+    {
+        return glm::translate(glm::mat4(1.f), transform.Position) * glm::mat4_cast(glm::quat(transform.Rotation)) *
+            glm::scale(glm::mat4(1.f), transform.Scale);
+    }
+
+    void SceneBVH::Attach(World& world)
+    {
+        world.on_construct<MeshRenderer>().connect<&SceneBVH::OnChanged>(this);
+        world.on_update<MeshRenderer>().connect<&SceneBVH::OnChanged>(this);
+        world.on_update<Transform>().connect<&SceneBVH::OnChanged>(this);
+        world.on_destroy<MeshRenderer>().connect<&SceneBVH::OnDestroyed>(this);
+    }
+
+    void SceneBVH::Sync(const ECS& ecs, const Resources& resources)
+    {
+        NEO_PROFILE_FUNCTION();
+        mPending.clear();
+        for (const auto entity : mDirty)
+        {
+            // Transforms change on entities without a MeshRenderer too
+            if (!ecs.Has<Transform, MeshRenderer>(entity)) continue;
+
+            const auto [transform, renderer] = ecs.Get<Transform, MeshRenderer>(entity);
+            const auto* mesh = resources.Get(renderer.Mesh);
+            if (!mesh || mesh->Primitives.empty())
+            {
+                mPending.emplace_back(entity);
+                continue;
+            }
+
+            const auto world = GetWorldMatrix(transform);
+            Bounds bounds{.Min = glm::vec3(std::numeric_limits<float>::max()),
+                          .Max = glm::vec3(std::numeric_limits<float>::lowest())};
+            for (const auto& primitive : mesh->Primitives)
+            {
+                const auto primitiveBounds = TransformBounds(primitive.Bounds, world);
+                bounds.Min = glm::min(bounds.Min, primitiveBounds.Min);
+                bounds.Max = glm::max(bounds.Max, primitiveBounds.Max);
+            }
+
+            if (const auto proxy = mProxies.find(entity); proxy != mProxies.end())
+            {
+                mBVH.Update(proxy->second, bounds);
+            }
+            else
+            {
+                mProxies.emplace(entity, mBVH.Insert(bounds, entt::to_integral(entity)));
+            }
+            mChanges++;
+        }
+        mDirty.clear();
+        mDirty.insert(mPending.begin(), mPending.end());
+
+        // Refits and inserts loosen the tree, and rebuilding once most of it changed keeps queries fast
+        if (mChanges > mBVH.GetCount() / 2)
+        {
+            mBVH.Build();
+            mChanges = 0;
+        }
+        kObjects.Set(mBVH.GetCount());
+        kNodes.Set(mBVH.GetNodeCount());
+    }
+
+    Entity SceneBVH::Raycast(const glm::vec3 origin, const glm::vec3 direction, const float maxDistance) const
+    {
+        const auto hit = mBVH.Raycast(origin, direction, maxDistance);
+        return hit ? static_cast<Entity>(hit->Value) : NullEntity;
+    }
+
+    void SceneBVH::OnChanged(World&, const Entity entity)
+    {
+        mDirty.emplace(entity);
+    }
+
+    void SceneBVH::OnDestroyed(World&, const Entity entity)
+    {
+        mDirty.erase(entity);
+        if (const auto proxy = mProxies.find(entity); proxy != mProxies.end())
+        {
+            mBVH.Remove(proxy->second);
+            mProxies.erase(proxy);
+            mChanges++;
+        }
+    }
+}
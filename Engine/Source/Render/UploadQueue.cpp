@@ -0,0 +1,207 @@
+#include "Render/UploadQueue.hpp"
+#include "Tools/Metrics.hpp"
+#include "Tools/Profiler.hpp"
+
+namespace
+{
+    const Neo::Counter kUploadedBytes("UploadQueue/Bytes");
+    const Neo::Gauge kPendingBytes("UploadQueue/Pending");
+    const Neo::Gauge kPages("UploadQueue/Pages");
+}
+
+namespace Neo
+{
+    UploadQueue::UploadQueue(IRenderContext& context, const u64 pageSize, const u32 maxPages)
+        : mContext(context), mPageSize(pageSize), mMaxPages(std::max(maxPages, 1u))
+    {
+    }
+
+    UploadQueue::~UploadQueue()
+    {
+        for (const auto& page : mPages)
+        {
+            mContext.UnmapBuffer(page.Buffer);
+            mContext.DestroyBuffer(page.Buffer);
+        }
+    }
+
+    UploadTicket UploadQueue::Upload(const BufferHandle destination,
+                                     const u64 destinationOffset,
+                                     const std::span<const std::byte> data,
+                                     std::function<void()> onComplete)
+    {
+        const auto ticket = static_cast<UploadTicket>(mNextTicket++);
+        if (onComplete)
+        {
+            mCallbacks.emplace_back(Callback{.Ticket = ticket, .Function = std::move(onComplete)});
+        }
+        mPendingBytes += data.size();
+        kUploadedBytes.Add(static_cast<i64>(data.size()));
+
+        // Once something waits, everything after it waits too, so uploads stay in order, empty ones included
+        u64 written = 0;
+        if (mBacklog.empty())
+        {
+            written = Write(destination, destinationOffset, data);
+            if (written == data.size())
+            {
+                mWritten = ticket;
+                return ticket;
+            }
+        }
+        const auto rest = data.subspan(written);
+        mBacklog.emplace_back(Backlog{
+            .Ticket = ticket,
+            .Destination = destination,
+            .DestinationOffset = destinationOffset + written,
+            .Data = std::vector(rest.begin(), rest.end()),
+        });
+        return ticket;
+    }
+
+    void UploadQueue::Submit()
+    {
+        NEO_PROFILE_FUNCTION();
+        Retire();
+
+        while (!mBacklog.empty())
+        {
+            auto& backlog = mBacklog.front();
+            const auto written = Write(backlog.Destination, backlog.DestinationOffset, backlog.Data);
+            if (written < backlog.Data.size())
+            {
+                // Erasing from the front of the waiting data is rare and only happens once per Submit
+                backlog.Data.erase(backlog.Data.begin(), backlog.Data.begin() + static_cast<i64>(written));
+                backlog.DestinationOffset += written;
+                break;
+            }
+            mWritten = backlog.Ticket;
+            mBacklog.pop_front();
+        }
+        kPendingBytes.Set(static_cast<i64>(mPendingBytes));
+        kPages.Set(static_cast<i64>(mPages.size()));
+        if (mFilledPages.empty()) return;
+
+        Batch batch{.LastTicket = mWritten, .Bytes = mFilledBytes};
+        if (mFreeCommands.empty())
+        {
+            batch.Command = mContext.CreateCommand(QueueType::eTransfer, "Upload Queue");
+        }
+        else
+        {
+            batch.Command = mFreeCommands.back();
+            mFreeCommands.pop_back();
+        }
+
+        mContext.BeginCommand(batch.Command);
+        for (const auto index : mFilledPages)
+        {
+            const auto& page = mPages[index];
+            for (const auto& copy : page.Copies)
+            {
+                mContext.CopyBuffer(
+                    batch.Command, page.Buffer, copy.Destination, copy.SourceOffset, copy.DestinationOffset, copy.Size);
+            }
+        }
+        mContext.EndCommand(batch.Command);
+        mContext.Submit(std::array{batch.Command}, QueueType::eTransfer);
+        batch.FenceValue = mContext.SignalTransfer();
+
+        // A page is not written again until the batch is done, even if there is room left in it
+        batch.Pages = std::move(mFilledPages);
+        mFilledPages.clear();
+        mFilledBytes = 0;
+        mBatches.emplace_back(std::move(batch));
+    }
+
+    u64 UploadQueue::Write(const BufferHandle destination,
+                           const u64 destinationOffset,
+                           const std::span<const std::byte> data)
+    {
+        u64 written = 0;
+        while (written < data.size())
+        {
+            auto* const page = GetOpenPage();
+            if (!page) break;
+
+            const auto size = std::min(data.size() - written, mPageSize - page->Used);
+            std::memcpy(page->Data + page->Used, data.data() + written, size);
+            page->Copies.emplace_back(Copy{
+                .Destination = destination,
+                .SourceOffset = page->Used,
+                .DestinationOffset = destinationOffset + written,
+                .Size = size,
+            });
+            page->Used += size;
+            written += size;
+        }
+        mFilledBytes += written;
+        return written;
+    }
+
+    UploadQueue::Page* UploadQueue::GetOpenPage()
+    {
+        if (!mFilledPages.empty())
+        {
+            auto& page = mPages[mFilledPages.back()];
+            if (page.Used < mPageSize) return &page;
+        }
+
+        u32 index = 0;
+        if (!mFreePages.empty())
+        {
+            index = mFreePages.back();
+            mFreePages.pop_back();
+        }
+        else if (mPages.size() < mMaxPages)
+        {
+            index = static_cast<u32>(mPages.size());
+            const BufferCreateInfo createInfo{
+                .FirstElement = 0,
+                .NumElements = static_cast<u32>((mPageSize + sizeof(u32) - 1) / sizeof(u32)),
+                .Stride = sizeof(u32),
+                .Type = BufferType::eStaging,
+            };
+            auto& page = mPages.emplace_back();
+            page.Buffer = mContext.CreateBuffer(createInfo, fmt::format("Upload Page {}", index));
+            // Staging memory stays mapped for as long as the page lives
+            page.Data = static_cast<std::byte*>(mContext.MapBuffer(page.Buffer));
+        }
+        else
+        {
+            return nullptr;
+        }
+        mFilledPages.emplace_back(index);
+        return &mPages[index];
+    }
+
+    void UploadQueue::Retire()
+    {
+        const auto completed = mContext.GetCompletedTransfer();
+        while (!mBatches.empty() && mBatches.front().FenceValue <= completed)
+        {
+            auto& batch = mBatches.front();
+            for (const auto index : batch.Pages)
+            {
+                auto& page = mPages[index];
+                page.Used = 0;
+                page.Copies.clear();
+                mFreePages.emplace_back(index);
+            }
+            mFreeCommands.emplace_back(batch.Command);
+            mCompleted = batch.LastTicket;
+            mPendingBytes -= batch.Bytes;
+            mBatches.pop_front();
+        }
+        // Uploads without data never make it into a batch
+        if (mBatches.empty() && mFilledPages.empty()) mCompleted = mWritten;
+
+        while (!mCallbacks.empty() && mCallbacks.front().Ticket <= mCompleted)
+        {
+            // Taken out first, so a callback may upload again
+            const auto callback = std::move(mCallbacks.front().Function);
+            mCallbacks.pop_front();
+            callback();
+        }
+    }
+}
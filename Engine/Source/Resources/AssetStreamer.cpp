@@ -0,0 +1,155 @@
+#include "Resources/AssetStreamer.hpp"
+#include "Tools/Serializer.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Tools/Profiler.hpp"
+
+namespace
+{
+    template <typename T>
+    Neo::Opt<Neo::StreamedAsset> Decode(const std::string& path)
+    {
+        T desc;
+        if (!Neo::BinarySerializer::Deserialize(desc, path)) return std::nullopt;
+        return Neo::StreamedAsset(std::move(desc));
+    }
+
+    Neo::Opt<Neo::StreamedAsset> DecodeMips(const std::string& path, const Neo::MipRange& mips)
+    {
+        using namespace Neo;
+        // Pixels is the last member of TextureDesc and BEVE writes byte arrays as they are, so the payload ends
+        // with the mip chain, largest mip first
+        const auto chainSize = GetMipChainSize(mips.Width, mips.Height, mips.MipLevels, 0);
+        const auto begin = GetMipOffset(mips.Width, mips.Height, mips.FirstMip);
+        const auto end = GetMipOffset(mips.Width, mips.Height, mips.EndMip);
+        const auto pixels = AssetFile::ReadTail(
+            path, GetAssetTypeHash<TextureDesc>(), AssetTraits<TextureDesc>::Version, chainSize - begin, end - begin);
+        if (!pixels)
+        {
+            Log::Error("Failed to load mips of {}: {}", path, magic_enum::enum_name(pixels.error()));
+            return std::nullopt;
+        }
+        return StreamedAsset(TextureMipsDesc{
+            .FirstMip = mips.FirstMip,
+            .EndMip = mips.EndMip,
+            .Pixels = std::vector<u8>(pixels->begin(), pixels->end()),
+        });
+    }
+}
+
+namespace Neo
+{
+    AssetStreamer::AssetStreamer(const u32 workerCount)
+    {
+        mWorkers.reserve(workerCount);
+        for (u32 i = 0; i < workerCount; i++)
+        {
+            mWorkers.emplace_back([this](const std::stop_token& stopToken) { Work(stopToken); });
+        }
+    }
+
+    AssetStreamer::~AssetStreamer()
+    {
+        for (auto& worker : mWorkers)
+        {
+            worker.request_stop();
+        }
+        mRequestCondition.notify_all();
+    }
+
+    void AssetStreamer::Request(const AssetID& id, const AssetType type, std::string path, const float priority)
+    {
+        Push(StreamRequest{.ID = id, .Type = type, .Path = std::move(path), .Priority = priority});
+    }
+
+    void AssetStreamer::RequestMips(const AssetID& id, std::string path, const MipRange& mips, const float priority)
+    {
+        Push(StreamRequest{
+            .ID = id,
+            .Type = AssetType::eTexture,
+            .Path = std::move(path),
+            .Priority = priority,
+            .Mips = mips,
+        });
+    }
+
+    void AssetStreamer::Push(StreamRequest&& request)
+    {
+        {
+            std::scoped_lock lock(mRequestMutex);
+            // Its result is on the way already
+            if (mInFlight.contains(request.ID)) return;
+            if (const auto it = mPending.find(request.ID); it != mPending.end())
+            {
+                if (request.Priority <= it->second) return;
+                it->second = request.Priority;
+            }
+            else
+            {
+                mPending.emplace(request.ID, request.Priority);
+            }
+            // A raised priority leaves the old entry behind, workers skip it since its priority no longer matches
+            request.Sequence = mSequence++;
+            mRequests.emplace(std::move(request));
+        }
+        mRequestCondition.notify_one();
+    }
+
+    bool AssetStreamer::PopResult(StreamResult& result)
+    {
+        std::scoped_lock lock(mResultMutex);
+        if (mResults.empty()) return false;
+        result = std::move(mResults.front());
+        mResults.pop_front();
+        return true;
+    }
+
+    size_t AssetStreamer::GetPendingCount() const
+    {
+        std::scoped_lock lock(mRequestMutex);
+        return mPending.size() + mInFlight.size();
+    }
+
+    void AssetStreamer::Work(const std::stop_token& stopToken)
+    {
+        Profiler::SetThreadName("Asset Streamer");
+        while (!stopToken.stop_requested())
+        {
+            StreamRequest request;
+            {
+                std::unique_lock lock(mRequestMutex);
+                if (!mRequestCondition.wait(lock, stopToken, [&] { return !mRequests.empty(); })) return;
+
+                request = mRequests.top();
+                mRequests.pop();
+                const auto it = mPending.find(request.ID);
+                if (it == mPending.end() || it->second != request.Priority) continue;
+                mPending.erase(it);
+                mInFlight.emplace(request.ID);
+            }
+
+            NEO_PROFILE_SCOPE("AssetStreamer::Decode");
+            StreamResult result{.ID = request.ID, .Type = request.Type, .Priority = request.Priority};
+            switch (request.Type)
+            {
+            case AssetType::eTexture:
+                result.Asset = request.Mips ? DecodeMips(request.Path, request.Mips.value())
+                                            : Decode<TextureDesc>(request.Path);
+                break;
+            case AssetType::eMaterial:
+                result.Asset = Decode<MaterialDesc>(request.Path);
+                break;
+            case AssetType::eMesh:
+                result.Asset = Decode<MeshDesc>(request.Path);
+                break;
+            }
+
+            {
+                std::scoped_lock lock(mResultMutex);
+                mResults.emplace_back(std::move(result));
+            }
+            // Only once the result can be popped, so a request in between does not decode the asset again
+            std::scoped_lock lock(mRequestMutex);
+            mInFlight.erase(request.ID);
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#include "Resources/MaterialTable.hpp"
+
+namespace Neo
+{
+    u32 MaterialTable::Add(const MaterialParams& params)
+    {
+        if (const auto it = mLookup.find(params); it != mLookup.end())
+        {
+            mRefCounts[it->second]++;
+            return it->second;
+        }
+
+        u32 index;
+        if (!mFreeSlots.empty())
+        {
+            index = mFreeSlots.back();
+            mFreeSlots.pop_back();
+            mParams[index] = params;
+            mRefCounts[index] = 1;
+        }
+        else
+        {
+            index = static_cast<u32>(mParams.size());
+            mParams.emplace_back(params);
+            mRefCounts.emplace_back(1);
+        }
+        mLookup.emplace(params, index);
+        mVersion++;
+        return index;
+    }
+
+    void MaterialTable::Release(const u32 index)
+    {
+        if (index >= mRefCounts.size() || mRefCounts[index] == 0) return;
+        if (--mRefCounts[index] > 0) return;
+
+        mLookup.erase(mParams[index]);
+        mParams[index] = MaterialParams{};
+        mFreeSlots.emplace_back(index);
+        mVersion++;
+    }
+
+    void MaterialTable::Clear()
+    {
+        mParams.clear();
+        mRefCounts.clear();
+        mFreeSlots.clear();
+        mLookup.clear();
+        mVersion++;
+    }
+}
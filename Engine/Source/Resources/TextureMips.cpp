@@ -0,0 +1,44 @@
+#include "Resources/TextureMips.hpp"
+
+namespace Neo
+{
+    std::vector<u8> GenerateMips(const std::span<const u8> pixels, const u32 width, const u32 height)
+    {
+        const auto mipLevels = GetMipCount(width, height);
+        std::vector<u8> chain(GetMipChainSize(width, height, mipLevels, 0));
+        std::memcpy(chain.data(), pixels.data(), std::min<size_t>(pixels.size(), GetMipSize(width, height, 0)));
+
+        for (u16 mip = 1; mip < mipLevels; mip++)
+        {
+            const auto* source = chain.data() + GetMipOffset(width, height, mip - 1);
+            auto* destination = chain.data() + GetMipOffset(width, height, mip);
+            const auto sourceWidth = GetMipExtent(width, mip - 1);
+            const auto sourceHeight = GetMipExtent(height, mip - 1);
+            const auto mipWidth = GetMipExtent(width, mip);
+            const auto mipHeight = GetMipExtent(height, mip);
+
+            // Odd sizes clamp to the last row and column instead of reading past the edge
+            for (u32 y = 0; y < mipHeight; y++)
+            {
+                const auto y0 = std::min(y * 2, sourceHeight - 1);
+                const auto y1 = std::min(y * 2 + 1, sourceHeight - 1);
+                for (u32 x = 0; x < mipWidth; x++)
+                {
+                    const auto x0 = std::min(x * 2, sourceWidth - 1);
+                    const auto x1 = std::min(x * 2 + 1, sourceWidth - 1);
+                    for (u32 channel = 0; channel < kTextureBytesPerPixel; channel++)
+                    {
+                        const auto sample = [&](const u32 sx, const u32 sy)
+                        {
+                            return static_cast<u32>(source[(sy * sourceWidth + sx) * kTextureBytesPerPixel + channel]);
+                        };
+                        const auto sum = sample(x0, y0) + sample(x1, y0) + sample(x0, y1) + sample(x1, y1);
+                        const auto index = (y * mipWidth + x) * kTextureBytesPerPixel + channel;
+                        destination[index] = static_cast<u8>((sum + 2) / 4);
+                    }
+                }
+            }
+        }
+        return chain;
+    }
+}
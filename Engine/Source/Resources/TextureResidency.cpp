@@ -0,0 +1,193 @@
+#include "Resources/TextureResidency.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Memory/ScratchAllocator.hpp"
+
+namespace Neo
+{
+    void TextureResidency::Register(const AssetHandle<Texture> texture,
+                                    const u32 width,
+                                    const u32 height,
+                                    const u16 mipLevels,
+                                    const u16 residentMip)
+    {
+        if (texture.IsNull()) return;
+        Unregister(texture);
+
+        const auto index = texture.GetIndex();
+        if (index >= mEntries.size())
+        {
+            mEntries.resize(index + 1);
+        }
+
+        const auto mips = std::max<u16>(mipLevels, 1);
+        const auto resident = std::min<u16>(residentMip, mips - 1);
+        mEntries[index] = Entry{
+            .Texture = texture,
+            .Width = width,
+            .Height = height,
+            .MipLevels = mips,
+            .ResidentMip = resident,
+            .TargetMip = resident,
+        };
+        mResidentSize += GetMipChainSize(width, height, mips, resident);
+    }
+
+    void TextureResidency::Unregister(const AssetHandle<Texture> texture)
+    {
+        auto* entry = Find(texture);
+        if (!entry) return;
+
+        mResidentSize -= GetMipChainSize(entry->Width, entry->Height, entry->MipLevels, entry->ResidentMip);
+        *entry = Entry{};
+    }
+
+    void TextureResidency::Clear()
+    {
+        mEntries.clear();
+        mResidentSize = 0;
+    }
+
+    void TextureResidency::ReportUsage(const AssetHandle<Texture> texture, const float screenSize)
+    {
+        if (auto* entry = Find(texture))
+        {
+            entry->ScreenSize = std::max(entry->ScreenSize, screenSize);
+        }
+    }
+
+    void TextureResidency::Update(std::vector<MipRequest>& streamIn, std::vector<MipRequest>& evict)
+    {
+        streamIn.clear();
+        evict.clear();
+
+        u64 targetSize = 0;
+        for (auto& entry : mEntries)
+        {
+            if (entry.Texture.IsNull()) continue;
+            // Nothing may have been drawn with a texture that was just loaded, that is no reason to drop it
+            entry.TargetMip = entry.Fresh && entry.ScreenSize <= 0.f
+                                  ? entry.ResidentMip
+                                  : ComputeRequiredMip(entry.Width, entry.Height, entry.MipLevels, entry.ScreenSize);
+            targetSize += GetMipChainSize(entry.Width, entry.Height, entry.MipLevels, entry.TargetMip);
+        }
+
+        // Over budget, take detail away from the textures with the fewest screen pixels per texel first,
+        // as they are the ones where a lower mip is the least visible
+        if (targetSize > mBudget)
+        {
+            struct Candidate
+            {
+                float Density;
+                u32 Index;
+
+                bool operator<(const Candidate& other) const { return Density > other.Density; }
+            };
+
+            const auto getDensity = [](const Entry& entry)
+            {
+                const auto extent = GetMipExtent(std::max(entry.Width, entry.Height), entry.TargetMip);
+                return entry.ScreenSize / static_cast<float>(extent);
+            };
+
+            ScratchScope scratch;
+            std::priority_queue candidates(std::less<Candidate>{},
+                                           std::pmr::vector<Candidate>(scratch.GetResource()));
+            for (u32 index = 0; index < mEntries.size(); index++)
+            {
+                const auto& entry = mEntries[index];
+                if (!entry.Texture.IsNull() && entry.TargetMip + 1 < entry.MipLevels)
+                {
+                    candidates.emplace(getDensity(entry), index);
+                }
+            }
+
+            while (targetSize > mBudget && !candidates.empty())
+            {
+                auto& entry = mEntries[candidates.top().Index];
+                candidates.pop();
+                targetSize -= GetMipSize(entry.Width, entry.Height, entry.TargetMip);
+                entry.TargetMip++;
+                if (entry.TargetMip + 1 < entry.MipLevels)
+                {
+                    candidates.emplace(getDensity(entry), entry.Texture.GetIndex());
+                }
+            }
+        }
+
+        for (auto& entry : mEntries)
+        {
+            if (entry.Texture.IsNull()) continue;
+
+            if (entry.TargetMip > entry.ResidentMip)
+            {
+                mResidentSize -= GetMipChainSize(entry.Width, entry.Height, entry.MipLevels, entry.ResidentMip) -
+                    GetMipChainSize(entry.Width, entry.Height, entry.MipLevels, entry.TargetMip);
+                entry.ResidentMip = entry.TargetMip;
+                evict.emplace_back(entry.Texture, entry.TargetMip, entry.ScreenSize);
+            }
+            else if (entry.TargetMip < entry.ResidentMip && !entry.Requested)
+            {
+                entry.Requested = true;
+                streamIn.emplace_back(entry.Texture, entry.TargetMip, entry.ScreenSize);
+            }
+            entry.ScreenSize = 0.f;
+            entry.Fresh = false;
+        }
+
+        std::ranges::sort(streamIn, std::greater{}, &MipRequest::ScreenSize);
+    }
+
+    void TextureResidency::OnMipsLoaded(const AssetHandle<Texture> texture, const u16 mip)
+    {
+        auto* entry = Find(texture);
+        if (!entry) return;
+        entry->Requested = false;
+        if (mip >= entry->ResidentMip) return;
+
+        mResidentSize += GetMipChainSize(entry->Width, entry->Height, entry->MipLevels, mip) -
+            GetMipChainSize(entry->Width, entry->Height, entry->MipLevels, entry->ResidentMip);
+        entry->ResidentMip = mip;
+    }
+
+    u16 TextureResidency::GetResidentMip(const AssetHandle<Texture> texture) const
+    {
+        const auto* entry = Find(texture);
+        return entry ? entry->ResidentMip : 0;
+    }
+
+    u16 TextureResidency::GetTargetMip(const AssetHandle<Texture> texture) const
+    {
+        const auto* entry = Find(texture);
+        return entry ? entry->TargetMip : 0;
+    }
+
+    u16 TextureResidency::ComputeRequiredMip(const u32 width, const u32 height, const u16 mipLevels,
+                                             const float screenSize)
+    {
+        const auto lastMip = static_cast<u16>(std::max<u16>(mipLevels, 1) - 1);
+        if (screenSize <= 0.f) return lastMip;
+
+        const auto ratio = static_cast<float>(std::max(width, height)) / screenSize;
+        if (ratio <= 1.f) return 0;
+        return std::min(static_cast<u16>(std::floor(std::log2(ratio))), lastMip);
+    }
+
+    float TextureResidency::EstimateScreenSize(const float radius, const float distance, const float fovY,
+                                               const float viewportHeight)
+    {
+        if (distance <= radius) return viewportHeight;
+        return radius / (distance * std::tan(fovY * 0.5f)) * viewportHeight;
+    }
+
+    TextureResidency::Entry* TextureResidency::Find(const AssetHandle<Texture> texture)
+    {
+        if (texture.IsNull() || texture.GetIndex() >= mEntries.size()) return nullptr;
+        auto& entry = mEntries[texture.GetIndex()];
+        return entry.Texture == texture ? &entry : nullptr;
+    }
+
+    const TextureResidency::Entry* TextureResidency::Find(const AssetHandle<Texture> texture) const
+    {
+        return const_cast<TextureResidency*>(this)->Find(texture);
+    }
+}
@@ -0,0 +1,191 @@
+#include "Tools/AssetFile.hpp"
+#include "Core/FileIO.hpp"
+
+namespace
+{
+    std::unordered_map<u64, Neo::AssetUpgrader::Function>& GetUpgrades()
+    {
+        static std::unordered_map<u64, Neo::AssetUpgrader::Function> upgrades;
+        return upgrades;
+    }
+
+    u64 GetUpgradeKey(const u32 typeHash, const u32 fromVersion)
+    {
+        return static_cast<u64>(typeHash) << 32 | fromVersion;
+    }
+
+    Neo::Exp<void, Neo::AssetFile::Error> CheckHeader(const Neo::AssetHeader& header,
+                                                      const u64 fileSize,
+                                                      const u32 typeHash,
+                                                      const u32 version)
+    {
+        using Error = Neo::AssetFile::Error;
+        if (header.Magic != Neo::kAssetMagic || header.PayloadSize != fileSize - sizeof(Neo::AssetHeader))
+        {
+            return std::unexpected(Error::eInvalidHeader);
+        }
+        if (header.TypeHash != typeHash)
+        {
+            return std::unexpected(Error::eTypeMismatch);
+        }
+        if (header.SchemaVersion != version && !Neo::AssetUpgrader::CanUpgrade(typeHash, header.SchemaVersion, version))
+        {
+            return std::unexpected(Error::eUnsupportedVersion);
+        }
+        return {};
+    }
+
+    // Reads and checks the header, leaving the file at the start of the payload
+    Neo::Exp<Neo::AssetHeader, Neo::AssetFile::Error> ReadHeader(std::ifstream& file,
+                                                                const u32 typeHash,
+                                                                const u32 version)
+    {
+        using Error = Neo::AssetFile::Error;
+        if (!file.is_open()) return std::unexpected(Error::eFileNotFound);
+
+        file.seekg(0, std::ios::end);
+        const auto fileSize = static_cast<u64>(file.tellg());
+        if (fileSize < sizeof(Neo::AssetHeader)) return std::unexpected(Error::eInvalidHeader);
+
+        Neo::AssetHeader header;
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (const auto result = CheckHeader(header, fileSize, typeHash, version); !result)
+        {
+            return std::unexpected(result.error());
+        }
+        return header;
+    }
+}
+
+namespace Neo
+{
+    void AssetUpgrader::Register(const u32 typeHash, const u32 fromVersion, Function function)
+    {
+        GetUpgrades()[GetUpgradeKey(typeHash, fromVersion)] = std::move(function);
+    }
+
+    bool AssetUpgrader::CanUpgrade(const u32 typeHash, const u32 fromVersion, const u32 toVersion)
+    {
+        if (fromVersion > toVersion) return false;
+        for (u32 version = fromVersion; version < toVersion; version++)
+        {
+            if (!GetUpgrades().contains(GetUpgradeKey(typeHash, version))) return false;
+        }
+        return true;
+    }
+
+    bool AssetUpgrader::Upgrade(const u32 typeHash, const u32 fromVersion, const u32 toVersion,
+                                std::vector<char>& payload)
+    {
+        if (!CanUpgrade(typeHash, fromVersion, toVersion)) return false;
+        for (u32 version = fromVersion; version < toVersion; version++)
+        {
+            if (!GetUpgrades().at(GetUpgradeKey(typeHash, version))(payload))
+            {
+                Log::Error("AssetUpgrader: Failed to upgrade from version {} to {}", version, version + 1);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool AssetFile::Write(const std::string_view path,
+                          const u32 typeHash,
+                          const u32 version,
+                          const Compression compression,
+                          const std::span<const char> payload)
+    {
+        std::ofstream file(path.data(), std::ios::binary);
+        if (!file.is_open())
+        {
+            Log::Error("File {} could not be opened for writing!", path);
+            return false;
+        }
+
+        // The payload is compressed straight into the file, so the header is written again once its size and
+        // checksum are known
+        AssetHeader header{.TypeHash = typeHash, .SchemaVersion = version};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        CompressedWriter writer(file, compression);
+        writer.Write(payload);
+        if (!writer.Finish()) return false;
+
+        header.PayloadSize = writer.GetSize();
+        header.Checksum = writer.GetChecksum();
+        file.seekp(0, std::ios::beg);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return file.good();
+    }
+
+    Exp<AssetHeader, AssetFile::Error> AssetFile::Validate(const std::string_view path,
+                                                           const u32 typeHash,
+                                                           const u32 version)
+    {
+        std::ifstream file(path.data(), std::ios::binary);
+        return ReadHeader(file, typeHash, version);
+    }
+
+    Exp<std::vector<char>, AssetFile::Error> AssetFile::Read(const std::string_view path,
+                                                             const u32 typeHash,
+                                                             const u32 version)
+    {
+        const auto data = FileIO::ReadBinaryFile(path);
+        if (data.empty()) return std::unexpected(Error::eFileNotFound);
+        if (data.size() < sizeof(AssetHeader)) return std::unexpected(Error::eInvalidHeader);
+
+        AssetHeader header;
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (const auto result = CheckHeader(header, data.size(), typeHash, version); !result)
+        {
+            return std::unexpected(result.error());
+        }
+
+        const auto compressed = std::span(data).subspan(sizeof(AssetHeader));
+        if (Compressor::Checksum(compressed) != header.Checksum)
+        {
+            return std::unexpected(Error::eChecksumMismatch);
+        }
+
+        auto payload = Compressor::Decompress(compressed);
+        if (!payload) return std::unexpected(Error::eCorruptPayload);
+
+        if (header.SchemaVersion != version &&
+            !AssetUpgrader::Upgrade(typeHash, header.SchemaVersion, version, payload.value()))
+        {
+            return std::unexpected(Error::eUpgradeFailed);
+        }
+        return std::move(payload.value());
+    }
+
+    Exp<std::vector<char>, AssetFile::Error> AssetFile::ReadTail(const std::string_view path,
+                                                                 const u32 typeHash,
+                                                                 const u32 version,
+                                                                 const u64 endOffset,
+                                                                 const u64 size)
+    {
+        std::ifstream file(path.data(), std::ios::binary);
+        const auto header = ReadHeader(file, typeHash, version);
+        if (!header) return std::unexpected(header.error());
+        if (header->SchemaVersion != version) return std::unexpected(Error::eUnsupportedVersion);
+
+        // Only the block table and the blocks the range is in are read. The checksum of the whole file would need
+        // every block, so each block read is checked on its own instead
+        CompressedReader reader(file);
+        const auto rawSize = reader.GetSize();
+        if (!rawSize || endOffset > rawSize.value() || size > endOffset)
+        {
+            return std::unexpected(Error::eCorruptPayload);
+        }
+
+        auto payload = reader.ReadRange(rawSize.value() - endOffset, size);
+        if (!payload)
+        {
+            return std::unexpected(payload.error() == Compressor::Error::eChecksumMismatch
+                                       ? Error::eChecksumMismatch
+                                       : Error::eCorruptPayload);
+        }
+        return std::move(payload.value());
+    }
+}
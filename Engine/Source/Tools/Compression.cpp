@@ -0,0 +1,613 @@
+#include "Tools/Compression.hpp"
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+#include "lz4.h"
+#include "zstd.h"
+
+#include "sstream"
+
+namespace
+{
+    using Block = Neo::Compressor::Block;
+
+    constexpr u32 kStreamMagic = 0x5A4F454E; // NEOZ
+    constexpr u32 kTableMagic = 0x544F454E; // NEOT
+    constexpr u8 kStreamVersion = 2;
+    constexpr size_t kParallelBlockCount = 4;
+    // Whole blocks the writer compresses at once, which bounds what it holds on to for large writes
+    constexpr size_t kWriteBatchBlockCount = 32;
+
+    struct StreamHeader
+    {
+        u32 Magic = kStreamMagic;
+        Neo::Compression Compression = Neo::Compression::eNone;
+        u8 Version = kStreamVersion;
+        u16 Reserved = 0;
+        u32 BlockSize = 0;
+    };
+
+    // A block whose stored size equals its raw size is stored uncompressed.
+    // A block with a raw size of zero marks the end of the stream.
+    struct BlockHeader
+    {
+        u32 StoredSize = 0;
+        u32 RawSize = 0;
+        u64 Checksum = 0;
+    };
+
+    // Ends the stream, after the end marker and a table that repeats the header of every block, so a reader can
+    // find any block from the end of the stream without walking the ones before it
+    struct StreamFooter
+    {
+        u64 BlockCount = 0;
+        u32 Magic = kTableMagic;
+        u32 Reserved = 0;
+    };
+
+    size_t CompressBound(const Neo::Compression compression, const size_t size)
+    {
+        switch (compression)
+        {
+        case Neo::Compression::eNone:
+            return 0;
+        case Neo::Compression::eLZ4:
+            return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+        case Neo::Compression::eZstd:
+            return ZSTD_compressBound(size);
+        }
+        return 0;
+    }
+
+    // Returns the bytes that should be stored for this block, which is the raw data if compressing did not help
+    std::span<const char> EncodeBlock(const Neo::Compression compression,
+                                      const std::span<const char> raw,
+                                      std::vector<char>& scratch)
+    {
+        scratch.resize(CompressBound(compression, raw.size()));
+        size_t storedSize = 0;
+        switch (compression)
+        {
+        case Neo::Compression::eNone:
+            break;
+        case Neo::Compression::eLZ4:
+            storedSize = static_cast<size_t>(LZ4_compress_default(raw.data(), scratch.data(),
+                                                                  static_cast<int>(raw.size()),
+                                                                  static_cast<int>(scratch.size())));
+            break;
+        case Neo::Compression::eZstd:
+            {
+                const auto result = ZSTD_compress(scratch.data(), scratch.size(), raw.data(), raw.size(),
+                                                  Neo::kZstdLevel);
+                storedSize = ZSTD_isError(result) ? 0 : result;
+                break;
+            }
+        }
+
+        if (storedSize == 0 || storedSize >= raw.size())
+        {
+            return raw;
+        }
+        return {scratch.data(), storedSize};
+    }
+
+    bool DecodeBlock(const Neo::Compression compression, const std::span<const char> stored, const std::span<char> raw)
+    {
+        if (stored.size() == raw.size())
+        {
+            std::memcpy(raw.data(), stored.data(), raw.size());
+            return true;
+        }
+
+        switch (compression)
+        {
+        case Neo::Compression::eNone:
+            return false;
+        case Neo::Compression::eLZ4:
+            {
+                const auto result = LZ4_decompress_safe(stored.data(), raw.data(), static_cast<int>(stored.size()),
+                                                        static_cast<int>(raw.size()));
+                return result == static_cast<int>(raw.size());
+            }
+        case Neo::Compression::eZstd:
+            {
+                const auto result = ZSTD_decompress(raw.data(), raw.size(), stored.data(), stored.size());
+                return !ZSTD_isError(result) && result == raw.size();
+            }
+        }
+        return false;
+    }
+
+    bool IsValid(const StreamHeader& header)
+    {
+        return header.Magic == kStreamMagic && header.Version == kStreamVersion &&
+            magic_enum::enum_contains(header.Compression) && header.BlockSize > 0 &&
+            header.BlockSize <= Neo::kMaxCompressionBlockSize;
+    }
+
+    // The sizes come from the file, so they have to fit the stream's block size before anything is allocated for
+    // them. The table is checked this far before any block is read
+    bool IsValidSize(const StreamHeader& header, const BlockHeader& block)
+    {
+        return block.RawSize <= header.BlockSize && block.StoredSize > 0 && block.StoredSize <= block.RawSize;
+    }
+
+    // The raw size also has to be reachable from the stored bytes
+    bool IsValid(const StreamHeader& header, const BlockHeader& block, const std::span<const char> stored)
+    {
+        if (!IsValidSize(header, block)) return false;
+        if (block.StoredSize == block.RawSize) return true;
+
+        switch (header.Compression)
+        {
+        case Neo::Compression::eNone:
+            return false;
+        case Neo::Compression::eLZ4:
+            // A single LZ4 sequence expands to at most 255 bytes per stored byte
+            return block.RawSize <= static_cast<u64>(block.StoredSize) * 255;
+        case Neo::Compression::eZstd:
+            // Every frame written by EncodeBlock records its content size
+            return ZSTD_getFrameContentSize(stored.data(), stored.size()) == block.RawSize;
+        }
+        return false;
+    }
+
+    bool Matches(const BlockHeader& header, const Block& block)
+    {
+        return header.StoredSize == block.StoredSize && header.RawSize == block.RawSize &&
+            header.Checksum == block.Checksum;
+    }
+
+    struct StreamLayout
+    {
+        StreamHeader Header;
+        std::vector<Block> Blocks;
+        size_t RawSize = 0;
+    };
+
+    // Walking the block headers is cheap, and gives every block its place in the output up front
+    Neo::Opt<StreamLayout> ReadLayout(const std::span<const char> data)
+    {
+        StreamLayout layout;
+        if (data.size() < sizeof(layout.Header)) return std::nullopt;
+        std::memcpy(&layout.Header, data.data(), sizeof(layout.Header));
+        if (!IsValid(layout.Header)) return std::nullopt;
+
+        size_t offset = sizeof(layout.Header);
+        while (true)
+        {
+            BlockHeader blockHeader;
+            if (offset + sizeof(blockHeader) > data.size()) return std::nullopt;
+            std::memcpy(&blockHeader, data.data() + offset, sizeof(blockHeader));
+            offset += sizeof(blockHeader);
+
+            if (blockHeader.RawSize == 0) break;
+            if (offset + blockHeader.StoredSize > data.size() ||
+                !IsValid(layout.Header, blockHeader, data.subspan(offset, blockHeader.StoredSize)) ||
+                layout.RawSize + blockHeader.RawSize > Neo::kMaxDecompressedSize)
+            {
+                return std::nullopt;
+            }
+
+            layout.Blocks.emplace_back(offset, layout.RawSize, blockHeader.StoredSize, blockHeader.RawSize,
+                                       blockHeader.Checksum);
+            offset += blockHeader.StoredSize;
+            layout.RawSize += blockHeader.RawSize;
+        }
+        return layout;
+    }
+
+    // Decode the blocks that overlap the output placed at offset in the decompressed stream. Blocks inside it are
+    // decoded in place, the ones it only partly covers into a block of their own first
+    Neo::Opt<Neo::Compressor::Error> DecodeRange(const std::span<const char> data,
+                                                 const Neo::Compression compression,
+                                                 const std::span<const Block> allBlocks,
+                                                 const size_t offset,
+                                                 const std::span<char> output)
+    {
+        const auto end = offset + output.size();
+        // From the last block starting at or before the offset to the last one starting before the end
+        const auto after = std::ranges::upper_bound(allBlocks, offset, {}, &Block::Destination);
+        const auto last = std::ranges::lower_bound(allBlocks, end, {}, &Block::Destination);
+        const auto first = std::max(after - allBlocks.begin() - 1, std::ptrdiff_t{0});
+        const auto blocks = allBlocks.subspan(static_cast<size_t>(first),
+                                              static_cast<size_t>(last - allBlocks.begin() - first));
+
+        std::atomic checksumFailed = false;
+        std::atomic codecFailed = false;
+        const auto decode = [&](const Block& block)
+        {
+            if (block.Destination >= end || block.Destination + block.RawSize <= offset) return;
+
+            const auto stored = data.subspan(block.Source, block.StoredSize);
+            if (Neo::Compressor::Checksum(stored) != block.Checksum)
+            {
+                checksumFailed = true;
+                return;
+            }
+
+            const auto begin = std::max<size_t>(block.Destination, offset);
+            const auto size = std::min<size_t>(block.Destination + block.RawSize, end) - begin;
+            if (size == block.RawSize)
+            {
+                if (!DecodeBlock(compression, stored, output.subspan(begin - offset, size)))
+                {
+                    codecFailed = true;
+                }
+                return;
+            }
+            std::vector<char> raw(block.RawSize);
+            if (!DecodeBlock(compression, stored, raw))
+            {
+                codecFailed = true;
+                return;
+            }
+            std::memcpy(output.data() + (begin - offset), raw.data() + (begin - block.Destination), size);
+        };
+
+        if (blocks.size() >= kParallelBlockCount)
+        {
+            std::for_each(std::execution::par, blocks.begin(), blocks.end(), decode);
+        }
+        else
+        {
+            std::ranges::for_each(blocks, decode);
+        }
+
+        if (checksumFailed) return Neo::Compressor::Error::eChecksumMismatch;
+        if (codecFailed) return Neo::Compressor::Error::eCodecError;
+        return std::nullopt;
+    }
+
+    void Append(std::vector<char>& buffer, const void* data, const size_t size)
+    {
+        const auto* bytes = static_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+}
+
+namespace Neo
+{
+    u64 Compressor::Checksum(const std::span<const char> data) { return XXH64(data.data(), data.size(), 0); }
+
+    std::vector<char> Compressor::Compress(const std::span<const char> data,
+                                           const Compression compression,
+                                           const u32 blockSize)
+    {
+        std::ostringstream stream(std::ios::binary);
+        CompressedWriter writer(stream, compression, blockSize);
+        writer.Write(data);
+        if (!writer.Finish()) return {};
+
+        const auto compressed = stream.view();
+        return {compressed.begin(), compressed.end()};
+    }
+
+    Exp<std::vector<char>, Compressor::Error> Compressor::Decompress(const std::span<const char> data)
+    {
+        const auto layout = ReadLayout(data);
+        if (!layout) return std::unexpected(Error::eInvalidStream);
+
+        std::vector<char> result(layout->RawSize);
+        if (const auto error = DecodeRange(data, layout->Header.Compression, layout->Blocks, 0, result))
+        {
+            return std::unexpected(error.value());
+        }
+        return result;
+    }
+
+    CompressedWriter::CompressedWriter(std::ostream& stream, const Compression compression, const u32 blockSize)
+        : mStream(stream), mCompression(compression), mBlockSize(blockSize), mChecksumState(XXH64_createState())
+    {
+        XXH64_reset(static_cast<XXH64_state_t*>(mChecksumState), 0);
+        if (blockSize == 0 || blockSize > kMaxCompressionBlockSize)
+        {
+            Log::Error("CompressedWriter: Invalid block size {}", blockSize);
+            mFailed = true;
+            return;
+        }
+
+        mBlock.reserve(blockSize);
+        mScratch.resize(kWriteBatchBlockCount);
+        const StreamHeader header{.Compression = compression, .BlockSize = blockSize};
+        WriteBytes(&header, sizeof(header));
+    }
+
+    CompressedWriter::~CompressedWriter()
+    {
+        if (!mFinished)
+        {
+            [[maybe_unused]] const auto result = Finish();
+        }
+        XXH64_freeState(static_cast<XXH64_state_t*>(mChecksumState));
+    }
+
+    void CompressedWriter::Write(std::span<const char> data)
+    {
+        if (mFailed || mFinished) return;
+
+        if (!mBlock.empty())
+        {
+            const auto count = std::min<size_t>(data.size(), mBlockSize - mBlock.size());
+            mBlock.insert(mBlock.end(), data.begin(), data.begin() + static_cast<std::ptrdiff_t>(count));
+            data = data.subspan(count);
+            if (mBlock.size() < mBlockSize) return;
+
+            WriteBlocks(mBlock);
+            mBlock.clear();
+        }
+
+        // Whole blocks are compressed straight from the data, without copying them into the block first
+        const auto whole = data.size() - data.size() % mBlockSize;
+        WriteBlocks(data.first(whole));
+        mBlock.assign(data.begin() + static_cast<std::ptrdiff_t>(whole), data.end());
+    }
+
+    bool CompressedWriter::Finish()
+    {
+        if (!mFinished && !mFailed)
+        {
+            WriteBlocks(mBlock);
+            mBlock.clear();
+
+            constexpr BlockHeader endMarker{};
+            WriteBytes(&endMarker, sizeof(endMarker));
+            WriteBytes(mTable.data(), mTable.size());
+            const StreamFooter footer{.BlockCount = mTable.size() / sizeof(BlockHeader)};
+            WriteBytes(&footer, sizeof(footer));
+        }
+        mFinished = true;
+        return !mFailed && mStream.good();
+    }
+
+    u64 CompressedWriter::GetChecksum() const
+    {
+        return XXH64_digest(static_cast<const XXH64_state_t*>(mChecksumState));
+    }
+
+    void CompressedWriter::WriteBlocks(const std::span<const char> data)
+    {
+        const size_t blockCount = (data.size() + mBlockSize - 1) / mBlockSize;
+        std::array<BlockHeader, kWriteBatchBlockCount> headers;
+        std::array<std::span<const char>, kWriteBatchBlockCount> blocks;
+
+        for (size_t batch = 0; batch < blockCount; batch += kWriteBatchBlockCount)
+        {
+            const auto count = std::min(kWriteBatchBlockCount, blockCount - batch);
+            const auto encode = [&](const size_t index)
+            {
+                const auto first = (batch + index) * mBlockSize;
+                const auto raw = data.subspan(first, std::min<size_t>(mBlockSize, data.size() - first));
+                blocks[index] = EncodeBlock(mCompression, raw, mScratch[index]);
+                headers[index] = BlockHeader{
+                    .StoredSize = static_cast<u32>(blocks[index].size()),
+                    .RawSize = static_cast<u32>(raw.size()),
+                    .Checksum = Compressor::Checksum(blocks[index]),
+                };
+            };
+
+            const auto indices = std::views::iota(0uz, count);
+            if (count >= kParallelBlockCount)
+            {
+                std::for_each(std::execution::par, indices.begin(), indices.end(), encode);
+            }
+            else
+            {
+                std::ranges::for_each(indices, encode);
+            }
+
+            for (size_t index = 0; index < count; index++)
+            {
+                WriteBytes(&headers[index], sizeof(BlockHeader));
+                WriteBytes(blocks[index].data(), blocks[index].size());
+                Append(mTable, &headers[index], sizeof(BlockHeader));
+            }
+        }
+    }
+
+    void CompressedWriter::WriteBytes(const void* data, const size_t size)
+    {
+        mStream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        XXH64_update(static_cast<XXH64_state_t*>(mChecksumState), data, size);
+        mSize += size;
+    }
+
+    CompressedReader::CompressedReader(std::istream& stream) : mStream(stream), mStart(stream.tellg())
+    {
+        StreamHeader header;
+        if (!mStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || !IsValid(header))
+        {
+            Log::Error("CompressedReader: Invalid stream header");
+            mFailed = true;
+            return;
+        }
+        mCompression = header.Compression;
+        mBlockSize = header.BlockSize;
+    }
+
+    size_t CompressedReader::Read(const std::span<char> data)
+    {
+        size_t read = 0;
+        while (read < data.size())
+        {
+            if (mBlockOffset == mBlock.size() && !ReadBlock())
+            {
+                break;
+            }
+            const auto count = std::min(data.size() - read, mBlock.size() - mBlockOffset);
+            std::memcpy(data.data() + read, mBlock.data() + mBlockOffset, count);
+            mBlockOffset += count;
+            read += count;
+        }
+        return read;
+    }
+
+    bool CompressedReader::ReadBlock()
+    {
+        if (mFinished || mFailed) return false;
+
+        BlockHeader header;
+        if (!mStream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        {
+            mFailed = true;
+            return false;
+        }
+
+        if (header.RawSize == 0)
+        {
+            mFinished = true;
+            return false;
+        }
+
+        const StreamHeader streamHeader{.Compression = mCompression, .BlockSize = mBlockSize};
+        if (!IsValidSize(streamHeader, header))
+        {
+            mFailed = true;
+            return false;
+        }
+        mScratch.resize(header.StoredSize);
+        if (!mStream.read(mScratch.data(), static_cast<std::streamsize>(mScratch.size())) ||
+            !IsValid(streamHeader, header, mScratch))
+        {
+            mFailed = true;
+            return false;
+        }
+
+        if (Compressor::Checksum(mScratch) != header.Checksum)
+        {
+            Log::Error("CompressedReader: Block checksum mismatch");
+            mFailed = true;
+            return false;
+        }
+
+        mBlock.resize(header.RawSize);
+        mBlockOffset = 0;
+        if (!DecodeBlock(mCompression, mScratch, mBlock))
+        {
+            Log::Error("CompressedReader: Failed to decode block");
+            mFailed = true;
+            return false;
+        }
+        return true;
+    }
+
+    Exp<u64, Compressor::Error> CompressedReader::GetSize()
+    {
+        if (const auto error = ReadTable()) return std::unexpected(error.value());
+        return mTable.empty() ? 0 : mTable.back().Destination + mTable.back().RawSize;
+    }
+
+    Exp<std::vector<char>, Compressor::Error> CompressedReader::ReadRange(const u64 offset, const u64 size)
+    {
+        const auto rawSize = GetSize();
+        if (!rawSize) return std::unexpected(rawSize.error());
+        if (offset > rawSize.value() || size > rawSize.value() - offset)
+        {
+            return std::unexpected(Compressor::Error::eInvalidStream);
+        }
+
+        std::vector<char> result(size);
+        if (size == 0) return result;
+
+        // The blocks the range is in lie next to each other in the stream, so they are read in one go, from the
+        // header of the first one to the end of the last one
+        const auto after = std::ranges::upper_bound(mTable, offset, {}, &Block::Destination);
+        const auto last = std::ranges::lower_bound(mTable, offset + size, {}, &Block::Destination);
+        std::vector<Block> blocks(after - 1, last);
+        const auto begin = blocks.front().Source - sizeof(BlockHeader);
+        std::vector<char> data(blocks.back().Source + blocks.back().StoredSize - begin);
+
+        mStream.clear();
+        const auto position = mStream.tellg();
+        mStream.seekg(mStart + static_cast<std::streamoff>(begin));
+        const auto read = static_cast<bool>(mStream.read(data.data(), static_cast<std::streamsize>(data.size())));
+        mStream.clear();
+        mStream.seekg(position);
+        if (!read) return std::unexpected(Compressor::Error::eInvalidStream);
+
+        // The table only says where the blocks are, the headers in front of them still have to agree with it
+        const StreamHeader streamHeader{.Compression = mCompression, .BlockSize = mBlockSize};
+        for (auto& block : blocks)
+        {
+            block.Source -= begin;
+            BlockHeader header;
+            std::memcpy(&header, data.data() + block.Source - sizeof(header), sizeof(header));
+            if (!Matches(header, block) ||
+                !IsValid(streamHeader, header, std::span(data).subspan(block.Source, block.StoredSize)))
+            {
+                return std::unexpected(Compressor::Error::eInvalidStream);
+            }
+        }
+
+        if (const auto error = DecodeRange(data, mCompression, blocks, offset, result))
+        {
+            return std::unexpected(error.value());
+        }
+        return result;
+    }
+
+    Opt<Compressor::Error> CompressedReader::ReadTable()
+    {
+        if (mFailed) return Compressor::Error::eInvalidStream;
+        if (mTableRead) return std::nullopt;
+
+        mStream.clear();
+        const auto position = mStream.tellg();
+        const auto restore = [&]
+        {
+            mStream.clear();
+            mStream.seekg(position);
+        };
+
+        mStream.seekg(0, std::ios::end);
+        const auto streamSize = static_cast<u64>(mStream.tellg() - mStart);
+        constexpr auto kMinStreamSize = sizeof(StreamHeader) + sizeof(BlockHeader) + sizeof(StreamFooter);
+        StreamFooter footer;
+        if (streamSize < kMinStreamSize)
+        {
+            restore();
+            return Compressor::Error::eInvalidStream;
+        }
+        mStream.seekg(mStart + static_cast<std::streamoff>(streamSize - sizeof(footer)));
+        // Every block takes up its header, its entry in the table and at least one stored byte
+        if (!mStream.read(reinterpret_cast<char*>(&footer), sizeof(footer)) || footer.Magic != kTableMagic ||
+            footer.BlockCount > (streamSize - kMinStreamSize) / (2 * sizeof(BlockHeader) + 1))
+        {
+            restore();
+            return Compressor::Error::eInvalidStream;
+        }
+
+        const auto tableOffset = streamSize - sizeof(footer) - footer.BlockCount * sizeof(BlockHeader);
+        std::vector<BlockHeader> headers(footer.BlockCount);
+        mStream.seekg(mStart + static_cast<std::streamoff>(tableOffset));
+        const auto read = static_cast<bool>(
+            mStream.read(reinterpret_cast<char*>(headers.data()),
+                         static_cast<std::streamsize>(headers.size() * sizeof(BlockHeader))));
+        restore();
+        if (!read) return Compressor::Error::eInvalidStream;
+
+        const StreamHeader streamHeader{.Compression = mCompression, .BlockSize = mBlockSize};
+        u64 source = sizeof(StreamHeader) + sizeof(BlockHeader);
+        u64 destination = 0;
+        std::vector<Block> table;
+        table.reserve(headers.size());
+        for (const auto& header : headers)
+        {
+            if (!IsValidSize(streamHeader, header) || destination + header.RawSize > kMaxDecompressedSize)
+            {
+                return Compressor::Error::eInvalidStream;
+            }
+            table.emplace_back(source, destination, header.StoredSize, header.RawSize, header.Checksum);
+            source += header.StoredSize + sizeof(BlockHeader);
+            destination += header.RawSize;
+        }
+        // The last block has to end right at the end marker, which the table follows
+        if (source != tableOffset)
+        {
+            return Compressor::Error::eInvalidStream;
+        }
+
+        mTable = std::move(table);
+        mTableRead = true;
+        return std::nullopt;
+    }
+}
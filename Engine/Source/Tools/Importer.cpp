@@ -4,14 +4,61 @@
 #include "stb_image.h"
 #include "Core/FileIO.hpp"
 #include "Tools/Serializer.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Memory/ScratchAllocator.hpp"
+#include "Memory/MemoryTracker.hpp"
+#include "Tools/Profiler.hpp"
 
 namespace
 {
     fastgltf::Parser gParser;
+
+    // Everything that makes two materials render the same, their name and id aside
+    u64 HashMaterial(const Neo::MaterialDesc& material)
+    {
+        auto hash = Neo::HashBytes(&material.Params, sizeof(material.Params));
+        for (const auto* texture : {&material.BaseColorTextureID, &material.NormalTextureID,
+                                    &material.MetallicRoughnessTextureID, &material.OcclusionTextureID,
+                                    &material.EmissiveTextureID})
+        {
+            const auto bytes = texture->value_or(Neo::AssetID{}).as_bytes();
+            hash = Neo::HashBytes(bytes.data(), bytes.size(), hash);
+        }
+        return hash;
+    }
+
+    bool IsCooked(const std::string& path, const u32 typeHash)
+    {
+        if (typeHash == Neo::GetAssetTypeHash<Neo::TextureDesc>())
+        {
+            return Neo::BinarySerializer::Validate<Neo::TextureDesc>(path);
+        }
+        if (typeHash == Neo::GetAssetTypeHash<Neo::MaterialDesc>())
+        {
+            return Neo::BinarySerializer::Validate<Neo::MaterialDesc>(path);
+        }
+        if (typeHash == Neo::GetAssetTypeHash<Neo::MeshDesc>())
+        {
+            return Neo::BinarySerializer::Validate<Neo::MeshDesc>(path);
+        }
+        return false;
+    }
+
+    bool IsSameMaterial(const Neo::MaterialDesc& a, const Neo::MaterialDesc& b)
+    {
+        return a.Params == b.Params &&
+            a.BaseColorTextureID == b.BaseColorTextureID &&
+            a.NormalTextureID == b.NormalTextureID &&
+            a.MetallicRoughnessTextureID == b.MetallicRoughnessTextureID &&
+            a.OcclusionTextureID == b.OcclusionTextureID &&
+            a.EmissiveTextureID == b.EmissiveTextureID;
+    }
 }
 
 Neo::Exp<void, Neo::Importer::Error> Neo::Importer::ImportGLTF(const std::string_view inPath, std::string_view outPath)
 {
+    MemoryTagScope tag(MemoryTag::eImporter);
+    NEO_PROFILE_FUNCTION();
     auto expMappedFile = fastgltf::MappedGltfFile::FromPath(inPath);
     if (!expMappedFile)
     {
@@ -38,12 +85,63 @@ Neo::Exp<void, Neo::Importer::Error> Neo::Importer::ImportGLTF(const std::string
     if (!meshes) return std::unexpected(meshes.error());
     const auto model = ImportModel(asset);
 
+    // Merge into the registry of the output folder, other models may have been imported into it before
+    const auto registryPath = std::string(outPath) + '/' + std::string(kAssetRegistryName);
+    AssetRegistry registry;
+    if (FileIO::Exists(registryPath) && !JsonSerializer::Deserialize(registry, registryPath))
+    {
+        Log::Warn("Asset registry {} could not be read and will be rewritten", registryPath);
+    }
+    const auto addToRegistry = [&](const auto& descs)
+    {
+        for (const auto& desc : descs)
+        {
+            const auto key = uuids::to_string(desc.ID);
+            registry.Paths[key] = desc.Name;
+            registry.Types[key] = GetAssetTypeHash<std::ranges::range_value_t<decltype(descs)>>();
+        }
+    };
+    addToRegistry(textures.value());
+    addToRegistry(materials.value());
+    addToRegistry(meshes.value());
+    registry.Sources[std::filesystem::path(inPath).filename().generic_string()] = FileIO::LastModified(inPath);
+    if (!JsonSerializer::Serialize(registry, registryPath)) return std::unexpected(Error::eWriteFailed);
+
     return {};
 }
 
+bool Neo::Importer::IsImported(const std::string_view inPath, const std::string_view outPath)
+{
+    NEO_PROFILE_FUNCTION();
+    const auto registryPath = std::string(outPath) + '/' + std::string(kAssetRegistryName);
+    AssetRegistry registry;
+    if (!FileIO::Exists(inPath) || !FileIO::Exists(registryPath) ||
+        !JsonSerializer::Deserialize(registry, registryPath))
+    {
+        return false;
+    }
+
+    const auto source = registry.Sources.find(std::filesystem::path(inPath).filename().generic_string());
+    if (source == registry.Sources.end() || source->second != FileIO::LastModified(inPath)) return false;
+
+    // Only the headers are read, a version or type mismatch in any file means the folder is cooked again
+    for (const auto& [key, file] : registry.Paths)
+    {
+        const auto type = registry.Types.find(key);
+        const auto path = std::string(outPath) + '/' + file;
+        if (type == registry.Types.end() || !IsCooked(path, type->second))
+        {
+            Log::Info("Importer: {} is out of date and will be imported again", path);
+            return false;
+        }
+    }
+    return true;
+}
+
 Neo::Exp<std::vector<Neo::MeshDesc>, Neo::Importer::Error> Neo::Importer::ImportMeshes(
     const fastgltf::Asset& asset, const std::span<const MaterialDesc> materials, const std::string_view outPath)
 {
+    NEO_PROFILE_FUNCTION();
     std::vector<MeshDesc> meshes;
     for (const auto& mesh : asset.meshes)
     {
@@ -62,7 +160,8 @@ Neo::Exp<std::vector<Neo::MeshDesc>, Neo::Importer::Error> Neo::Importer::Import
             {
             case fastgltf::ComponentType::UnsignedShort:
                 {
-                    std::vector<uint16_t> shortIndices(indexAccessor.count);
+                    ScratchScope scratch;
+                    const auto shortIndices = scratch.AllocateArray<uint16_t>(indexAccessor.count);
                     fastgltf::copyFromAccessor<uint16_t>(asset, indexAccessor, shortIndices.data());
                     std::ranges::copy(shortIndices, p.Indices.begin());
                     break;
@@ -114,9 +213,10 @@ Neo::Exp<std::vector<Neo::MeshDesc>, Neo::Importer::Error> Neo::Importer::Import
             {
                 p.MaterialID = materials[primitive.materialIndex.value()].ID;
             }
+            p.Bounds = ComputeBounds(p.Vertices);
             m.Primitives.emplace_back(std::move(p));
         }
-        BinarySerializer::Serialize(m, std::string(outPath) + std::string(m.Name));
+        BinarySerializer::Serialize(m, std::string(outPath) + '/' + std::string(m.Name));
         meshes.emplace_back(std::move(m));
     }
     return meshes;
@@ -125,7 +225,10 @@ Neo::Exp<std::vector<Neo::MeshDesc>, Neo::Importer::Error> Neo::Importer::Import
 Neo::Exp<std::vector<Neo::MaterialDesc>, Neo::Importer::Error> Neo::Importer::ImportMaterials(
     const fastgltf::Asset& asset, const std::span<const TextureDesc> textures, const std::string_view outPath)
 {
+    NEO_PROFILE_FUNCTION();
     std::vector<MaterialDesc> materials;
+    ScratchScope scratch;
+    std::pmr::unordered_multimap<u64, size_t> uniqueMaterials(scratch.GetResource());
     for (const auto& material : asset.materials)
     {
         const auto& [baseColorFactor, metallicFactor, roughnessFactor, baseColorTexture, metallicRoughnessTexture] =
@@ -133,18 +236,18 @@ Neo::Exp<std::vector<Neo::MaterialDesc>, Neo::Importer::Error> Neo::Importer::Im
         MaterialDesc m;
         m.Name = material.name;
         m.ID = GenerateUUID();
-        m.BaseColorFactor = glm::make_vec4(baseColorFactor.data());
+        m.Params.BaseColorFactor = glm::make_vec4(baseColorFactor.data());
         if (baseColorTexture)
         {
             m.BaseColorTextureID = textures[baseColorTexture->textureIndex].ID;
         }
-        m.MetallicFactor = metallicFactor;
+        m.Params.MetallicFactor = metallicFactor;
         if (metallicRoughnessTexture)
         {
             m.MetallicRoughnessTextureID = textures[metallicRoughnessTexture->textureIndex].ID;
         }
-        m.RoughnessFactor = roughnessFactor;
-        m.EmissiveFactor = glm::make_vec3(material.emissiveFactor.data());
+        m.Params.RoughnessFactor = roughnessFactor;
+        m.Params.EmissiveFactor = glm::make_vec3(material.emissiveFactor.data());
         if (material.emissiveTexture)
         {
             m.EmissiveTextureID = textures[material.emissiveTexture->textureIndex].ID;
@@ -152,24 +255,43 @@ Neo::Exp<std::vector<Neo::MaterialDesc>, Neo::Importer::Error> Neo::Importer::Im
 
         if (material.normalTexture)
         {
-            m.NormalFactor = material.normalTexture->scale;
+            m.Params.NormalFactor = material.normalTexture->scale;
             m.NormalTextureID = textures[material.normalTexture->textureIndex].ID;
         }
 
         if (material.occlusionTexture)
         {
-            m.OcclusionFactor = material.occlusionTexture->strength;
+            m.Params.OcclusionFactor = material.occlusionTexture->strength;
             m.OcclusionTextureID = textures[material.occlusionTexture->textureIndex].ID;
         }
-        BinarySerializer::Serialize(m, std::string(outPath) + '/' + std::string(m.Name));
+
+        // Identical materials share one cooked file, primitives still look them up by their glTF index
+        const auto hash = HashMaterial(m);
+        const auto [first, last] = uniqueMaterials.equal_range(hash);
+        const auto original = std::find_if(first, last, [&](const auto& entry)
+        {
+            return IsSameMaterial(materials[entry.second], m);
+        });
+        if (original != last)
+        {
+            m.ID = materials[original->second].ID;
+            m.Name = materials[original->second].Name;
+        }
+        else
+        {
+            uniqueMaterials.emplace(hash, materials.size());
+            BinarySerializer::Serialize(m, std::string(outPath) + '/' + std::string(m.Name));
+        }
         materials.emplace_back(std::move(m));
     }
+    Log::Info("Importer: {} materials, {} unique", materials.size(), uniqueMaterials.size());
     return materials;
 }
 
 Neo::Exp<std::vector<Neo::TextureDesc>, Neo::Importer::Error> Neo::Importer::ImportTextures(
     const fastgltf::Asset& asset, const std::string_view inPath, const std::string_view outPath)
 {
+    NEO_PROFILE_FUNCTION();
     std::vector<TextureDesc> textures;
     for (const auto& [index, texture] : std::views::enumerate(asset.textures))
     {
@@ -182,6 +304,7 @@ Neo::Exp<std::vector<Neo::TextureDesc>, Neo::Importer::Error> Neo::Importer::Imp
         t.ID = GenerateUUID();
         if (texture.imageIndex)
         {
+            NEO_PROFILE_SCOPE("Importer::LoadImage");
             const auto& [data, name] = asset.images.at(texture.imageIndex.value());
             std::vector<char> rawData;
             if (std::holds_alternative<fastgltf::sources::URI>(data))
@@ -198,7 +321,8 @@ Neo::Exp<std::vector<Neo::TextureDesc>, Neo::Importer::Error> Neo::Importer::Imp
 
             t.Width = static_cast<uint32_t>(width);
             t.Height = static_cast<uint32_t>(height);
-            t.Pixels.assign(pixels, pixels + t.Width * t.Height * 4);
+            t.MipLevels = GetMipCount(t.Width, t.Height);
+            t.Pixels = GenerateMips(std::span(pixels, t.Width * t.Height * kTextureBytesPerPixel), t.Width, t.Height);
             stbi_image_free(pixels);
         }
         else if (texture.ddsImageIndex)
@@ -213,6 +337,7 @@ Neo::Exp<std::vector<Neo::TextureDesc>, Neo::Importer::Error> Neo::Importer::Imp
 
 Neo::Exp<Neo::Model, Neo::Importer::Error> Neo::Importer::ImportModel(const fastgltf::Asset& asset)
 {
+    NEO_PROFILE_FUNCTION();
     std::vector<NodeDesc> nodes(asset.nodes.size());
     std::ranges::transform(asset.nodes, nodes.begin(), [&](const fastgltf::Node& node)
     {
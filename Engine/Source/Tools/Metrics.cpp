@@ -0,0 +1,120 @@
+#include "Tools/Metrics.hpp"
+
+namespace
+{
+    // One past the last metric, where registrations over the limit write without being sampled
+    constexpr u32 kOverflowID = Neo::Metrics::kMaxMetrics;
+
+    struct alignas(64) Shard
+    {
+        std::array<std::atomic<i64>, Neo::Metrics::kMaxMetrics + 1> Values{};
+    };
+
+    struct MetricsState
+    {
+        std::mutex Mutex;
+        std::array<std::string, Neo::Metrics::kMaxMetrics> Names;
+        std::array<Neo::MetricType, Neo::Metrics::kMaxMetrics> Types{};
+        std::atomic<u32> Count = 0;
+
+        std::array<Shard, Neo::Metrics::kShardCount> Shards;
+        // Gauges are set from anywhere and rarely, so they skip the shards
+        std::array<std::atomic<i64>, Neo::Metrics::kMaxMetrics + 1> Gauges{};
+
+        std::vector<Neo::MetricSample> Samples;
+    };
+
+    MetricsState& GetState()
+    {
+        static MetricsState state;
+        return state;
+    }
+
+    std::atomic<u32> gNextShard = 0;
+
+    Shard& GetThreadShard()
+    {
+        thread_local auto& shard =
+            GetState().Shards[gNextShard.fetch_add(1, std::memory_order_relaxed) % Neo::Metrics::kShardCount];
+        return shard;
+    }
+}
+
+namespace Neo
+{
+    u32 Metrics::Register(const std::string_view name, const MetricType type)
+    {
+        auto& state = GetState();
+        std::scoped_lock lock(state.Mutex);
+        const auto count = state.Count.load(std::memory_order_relaxed);
+        for (u32 id = 0; id < count; id++)
+        {
+            if (state.Names[id] == name) return id;
+        }
+
+        if (count == kMaxMetrics)
+        {
+            Log::Error("Metrics: Too many metrics, {} is not recorded", name);
+            return kOverflowID;
+        }
+        state.Names[count] = name;
+        state.Types[count] = type;
+        state.Count.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    void Metrics::Add(const u32 id, const i64 value)
+    {
+        auto& state = GetState();
+        if (id < kMaxMetrics && state.Types[id] == MetricType::eGauge)
+        {
+            state.Gauges[id].fetch_add(value, std::memory_order_relaxed);
+            return;
+        }
+        GetThreadShard().Values[id].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void Metrics::Set(const u32 id, const i64 value)
+    {
+        GetState().Gauges[id].store(value, std::memory_order_relaxed);
+    }
+
+    void Metrics::BeginFrame()
+    {
+        auto& state = GetState();
+        const auto count = state.Count.load(std::memory_order_acquire);
+        for (auto id = static_cast<u32>(state.Samples.size()); id < count; id++)
+        {
+            state.Samples.emplace_back(MetricSample{.Name = state.Names[id], .Type = state.Types[id]});
+        }
+
+        for (u32 id = 0; id < count; id++)
+        {
+            auto& sample = state.Samples[id];
+            if (sample.Type == MetricType::eGauge)
+            {
+                sample.Value = state.Gauges[id].load(std::memory_order_relaxed);
+                sample.Total = std::max(sample.Total, sample.Value);
+                continue;
+            }
+
+            i64 value = 0;
+            for (auto& shard : state.Shards)
+            {
+                value += shard.Values[id].exchange(0, std::memory_order_relaxed);
+            }
+            sample.Value = value;
+            sample.Total += value;
+        }
+    }
+
+    std::span<const MetricSample> Metrics::GetSamples() { return GetState().Samples; }
+
+    Opt<MetricSample> Metrics::Find(const std::string_view name)
+    {
+        const auto samples = GetSamples();
+        const auto it = std::ranges::find(samples, name, &MetricSample::Name);
+        if (it == samples.end()) return std::nullopt;
+        return *it;
+    }
+}
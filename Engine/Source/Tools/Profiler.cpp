@@ -0,0 +1,272 @@
+#include "Tools/Profiler.hpp"
+#include "Core/FileIO.hpp"
+
+namespace
+{
+    constexpr u64 kRingCapacity = 1 << 14;
+
+    // Single producer ring, only the owning thread pushes and only the main thread drains
+    class EventRing
+    {
+    public:
+        bool Push(const Neo::ProfileEvent& event)
+        {
+            const auto head = mHead.load(std::memory_order_relaxed);
+            if (head - mTail.load(std::memory_order_acquire) == kRingCapacity) return false;
+            mEvents[head & (kRingCapacity - 1)] = event;
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        template <typename Func>
+        void Drain(Func&& func)
+        {
+            const auto tail = mTail.load(std::memory_order_relaxed);
+            const auto head = mHead.load(std::memory_order_acquire);
+            for (auto index = tail; index != head; index++)
+            {
+                func(mEvents[index & (kRingCapacity - 1)]);
+            }
+            mTail.store(head, std::memory_order_release);
+        }
+
+    private:
+        std::array<Neo::ProfileEvent, kRingCapacity> mEvents{};
+        // Separate cache lines so the producer and the consumer do not fight over them
+        alignas(64) std::atomic<u64> mHead = 0;
+        alignas(64) std::atomic<u64> mTail = 0;
+    };
+
+    struct ThreadData
+    {
+        EventRing Ring;
+        std::string Name;
+        u32 Index = 0;
+        u32 Depth = 0;
+    };
+
+    struct ProfilerState
+    {
+        // Guards Threads and Names, which other threads add to
+        std::mutex Mutex;
+        std::vector<std::unique_ptr<ThreadData>> Threads;
+        // Node based, so interned names never move
+        std::unordered_set<std::string> Names;
+        std::atomic<u64> DroppedEvents = 0;
+
+        Neo::ProfileFrame LastFrame;
+        u64 FrameStart = 0;
+        u64 FrameIndex = 0;
+
+        bool Capturing = false;
+        std::vector<Neo::ProfileEvent> CaptureEvents;
+        std::vector<u64> CaptureFrameStarts;
+        // Set from the environment for headless captures
+        std::string AutoCapturePath;
+        u64 AutoCaptureFrames = 0;
+    };
+
+    ProfilerState& GetState()
+    {
+        static ProfilerState state;
+        return state;
+    }
+
+    const auto gEpoch = std::chrono::steady_clock::now();
+    thread_local ThreadData* tThread = nullptr;
+
+    ThreadData& GetThread()
+    {
+        if (!tThread)
+        {
+            auto& state = GetState();
+            std::scoped_lock lock(state.Mutex);
+            auto& thread = state.Threads.emplace_back(std::make_unique<ThreadData>());
+            thread->Index = static_cast<u32>(state.Threads.size() - 1);
+            thread->Name = fmt::format("Thread {}", thread->Index);
+            tThread = thread.get();
+        }
+        return *tThread;
+    }
+
+    void WriteEscaped(std::string& json, const std::string_view text)
+    {
+        for (const auto character : text)
+        {
+            switch (character)
+            {
+            case '"': json += "\\\"";
+                break;
+            case '\\': json += "\\\\";
+                break;
+            default:
+                if (static_cast<u8>(character) < 0x20) fmt::format_to(std::back_inserter(json), "\\u{:04x}", character);
+                else json += character;
+            }
+        }
+    }
+}
+
+namespace Neo
+{
+    void Profiler::Init()
+    {
+        auto& state = GetState();
+        state.FrameStart = Now();
+        SetThreadName("Main");
+
+        state.AutoCapturePath = ReadEnvironment("NEO_PROFILE_CAPTURE");
+        if (!state.AutoCapturePath.empty())
+        {
+            const auto frames = ReadEnvironment("NEO_PROFILE_FRAMES");
+            std::from_chars(frames.data(), frames.data() + frames.size(), state.AutoCaptureFrames);
+            Log::Info("Profiler: Capturing to {}", state.AutoCapturePath);
+            BeginCapture();
+        }
+    }
+
+    void Profiler::Shutdown()
+    {
+        auto& state = GetState();
+        if (state.Capturing && !state.AutoCapturePath.empty())
+        {
+            BeginFrame();
+            (void)EndCapture(state.AutoCapturePath);
+        }
+    }
+
+    void Profiler::BeginFrame()
+    {
+        auto& state = GetState();
+        const auto now = Now();
+        auto& frame = state.LastFrame;
+        frame.Index = state.FrameIndex++;
+        frame.Start = state.FrameStart;
+        frame.End = now;
+        frame.Events.clear();
+        state.FrameStart = now;
+
+        {
+            std::scoped_lock lock(state.Mutex);
+            for (const auto& thread : state.Threads)
+            {
+                thread->Ring.Drain([&](const ProfileEvent& event) { frame.Events.emplace_back(event); });
+            }
+        }
+        std::ranges::sort(frame.Events, [](const ProfileEvent& a, const ProfileEvent& b)
+        {
+            return std::tie(a.Thread, a.Start, a.Depth) < std::tie(b.Thread, b.Start, b.Depth);
+        });
+
+        if (!state.Capturing) return;
+        state.CaptureEvents.insert(state.CaptureEvents.end(), frame.Events.begin(), frame.Events.end());
+        state.CaptureFrameStarts.emplace_back(frame.Start);
+        if (!state.AutoCapturePath.empty() && state.AutoCaptureFrames != 0 &&
+            state.CaptureFrameStarts.size() >= state.AutoCaptureFrames)
+        {
+            (void)EndCapture(state.AutoCapturePath);
+        }
+    }
+
+    const ProfileFrame& Profiler::GetLastFrame() { return GetState().LastFrame; }
+
+    void Profiler::BeginCapture()
+    {
+        auto& state = GetState();
+        state.CaptureEvents.clear();
+        state.CaptureFrameStarts.clear();
+        state.Capturing = true;
+    }
+
+    bool Profiler::EndCapture(const std::string_view path)
+    {
+        auto& state = GetState();
+        if (!state.Capturing) return false;
+        state.Capturing = false;
+
+        std::string json = R"({"displayTimeUnit":"ns","traceEvents":[)";
+        auto out = std::back_inserter(json);
+        {
+            std::scoped_lock lock(state.Mutex);
+            for (const auto& thread : state.Threads)
+            {
+                fmt::format_to(out, R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")",
+                               thread->Index);
+                WriteEscaped(json, thread->Name);
+                json += "\"}},";
+            }
+        }
+        for (const auto start : state.CaptureFrameStarts)
+        {
+            fmt::format_to(out, R"({{"name":"Frame","ph":"i","s":"g","pid":1,"tid":0,"ts":{:.3f}}},)",
+                           static_cast<f64>(start) / 1000.0);
+        }
+        for (const auto& event : state.CaptureEvents)
+        {
+            json += R"({"name":")";
+            WriteEscaped(json, event.Name);
+            fmt::format_to(out, R"(","cat":"Neo","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}},)",
+                           event.Thread, static_cast<f64>(event.Start) / 1000.0,
+                           static_cast<f64>(event.End - event.Start) / 1000.0);
+        }
+        if (json.back() == ',') json.pop_back();
+        json += "]}";
+
+        const auto frames = state.CaptureFrameStarts.size();
+        state.CaptureEvents = {};
+        state.CaptureFrameStarts = {};
+        if (!FileIO::WriteTextFile(path, json))
+        {
+            Log::Error("Profiler: Failed to write capture to {}", path);
+            return false;
+        }
+        Log::Info("Profiler: Wrote {} frames to {}", frames, path);
+        return true;
+    }
+
+    bool Profiler::IsCapturing() { return GetState().Capturing; }
+
+    void Profiler::SetThreadName(const std::string_view name)
+    {
+        auto& thread = GetThread();
+        std::scoped_lock lock(GetState().Mutex);
+        thread.Name = name;
+    }
+
+    std::string Profiler::GetThreadName(const u32 thread)
+    {
+        auto& state = GetState();
+        std::scoped_lock lock(state.Mutex);
+        return thread < state.Threads.size() ? state.Threads[thread]->Name : std::string{};
+    }
+
+    const char* Profiler::InternName(const std::string_view name)
+    {
+        auto& state = GetState();
+        std::scoped_lock lock(state.Mutex);
+        return state.Names.emplace(name).first->c_str();
+    }
+
+    u64 Profiler::GetDroppedEvents() { return GetState().DroppedEvents.load(std::memory_order_relaxed); }
+
+    u64 Profiler::Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - gEpoch).
+            count();
+    }
+
+    void Profiler::EnterZone() { GetThread().Depth++; }
+
+    void Profiler::LeaveZone(const char* name, const u64 start)
+    {
+        auto& thread = GetThread();
+        thread.Depth--;
+        const ProfileEvent event{
+            .Name = name, .Start = start, .End = Now(), .Depth = thread.Depth, .Thread = thread.Index
+        };
+        if (!thread.Ring.Push(event))
+        {
+            GetState().DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,248 @@
+#include "Tools/SceneStream.hpp"
+
+namespace
+{
+    struct SceneHeader
+    {
+        u32 Version = 0;
+    };
+
+    constexpr std::string_view kEntityField = "Entity";
+    constexpr u32 kEntityDepth = 2;
+}
+
+namespace Neo
+{
+    JsonSceneWriter::JsonSceneWriter(std::ostream& stream, const size_t bufferSize)
+        : mStream(stream), mBufferSize(bufferSize)
+    {
+        mBuffer.reserve(bufferSize);
+        Append(fmt::format("{{\n    \"Version\": {},\n    \"Entities\": [\n", kSceneVersion));
+    }
+
+    JsonSceneWriter::~JsonSceneWriter()
+    {
+        if (!mFinished)
+        {
+            [[maybe_unused]] const auto result = Finish();
+        }
+    }
+
+    void JsonSceneWriter::BeginEntity(const Entity entity)
+    {
+        Append(mEntityCount++ == 0 ? "        {" : ",\n        {");
+        mFirstField = true;
+        WriteField(kEntityField, std::to_string(entt::to_integral(entity)));
+    }
+
+    void JsonSceneWriter::EndEntity() { Append("}"); }
+
+    bool JsonSceneWriter::Finish()
+    {
+        if (!mFinished)
+        {
+            Append(mEntityCount == 0 ? "    ]\n}\n" : "\n    ]\n}\n");
+            Flush();
+            mFinished = true;
+        }
+        return !mFailed;
+    }
+
+    void JsonSceneWriter::WriteField(const std::string_view name, const std::string_view json)
+    {
+        if (!mFirstField)
+        {
+            Append(", ");
+        }
+        mFirstField = false;
+        Append("\"");
+        Append(name);
+        Append("\": ");
+        Append(json);
+    }
+
+    void JsonSceneWriter::Append(const std::string_view text)
+    {
+        mBuffer.append(text);
+        if (mBuffer.size() >= mBufferSize)
+        {
+            Flush();
+        }
+    }
+
+    void JsonSceneWriter::Flush()
+    {
+        mStream.write(mBuffer.data(), static_cast<std::streamsize>(mBuffer.size()));
+        mBuffer.clear();
+        if (!mStream.good())
+        {
+            mFailed = true;
+        }
+    }
+
+    JsonSceneReader::JsonSceneReader(std::istream& stream, const size_t bufferSize)
+        : mStream(stream), mBufferSize(bufferSize)
+    {
+        mBuffer.reserve(bufferSize);
+        if (!ReadHeader())
+        {
+            Log::Error("JsonSceneReader: Invalid scene header");
+            mFailed = true;
+        }
+    }
+
+    bool JsonSceneReader::NextEntity()
+    {
+        if (mFinished || mFailed) return false;
+
+        const auto object = NextObject();
+        if (!object) return false;
+
+        // Copied so the parser gets a null terminated buffer that stays valid while the next chunk is read
+        mObject.assign(*object);
+        mFields.clear();
+        if (glz::read_json(mFields, mObject).ec != glz::error_code::none)
+        {
+            Log::Error("JsonSceneReader: Malformed entity");
+            mFailed = true;
+            return false;
+        }
+
+        const auto it = mFields.find(kEntityField);
+        std::underlying_type_t<Entity> id = 0;
+        if (it == mFields.end() || glz::read_json(id, it->second.str).ec != glz::error_code::none)
+        {
+            Log::Error("JsonSceneReader: Entity without an id");
+            mFailed = true;
+            return false;
+        }
+        mEntity = Entity{id};
+        mFields.erase(it);
+        return true;
+    }
+
+    // The header is everything before the entity array. Closing it off with an empty array gives a complete
+    // document that can be parsed on its own.
+    bool JsonSceneReader::ReadHeader()
+    {
+        mObjectStart = 0;
+        while (true)
+        {
+            while (mScan < mBuffer.size())
+            {
+                const char c = mBuffer[mScan++];
+                if (!IsStructural(c)) continue;
+
+                if (c == '[' && mDepth == kEntityDepth)
+                {
+                    const auto text = mBuffer.substr(0, mScan) + "]}";
+                    mObjectStart = std::string::npos;
+                    SceneHeader header;
+                    if (glz::read<glz::opts{.error_on_unknown_keys = false}>(header, text).ec != glz::error_code::none)
+                    {
+                        return false;
+                    }
+                    mVersion = header.Version;
+                    if (mVersion != kSceneVersion)
+                    {
+                        Log::Error("JsonSceneReader: Unsupported scene version {}", mVersion);
+                        return false;
+                    }
+                    return true;
+                }
+            }
+            if (!Fill()) return false;
+        }
+    }
+
+    bool JsonSceneReader::Fill()
+    {
+        // Drop everything that has been consumed, keeping a partially read object
+        const auto keep = mObjectStart != std::string::npos ? mObjectStart : mScan;
+        mBuffer.erase(0, keep);
+        mScan -= keep;
+        if (mObjectStart != std::string::npos)
+        {
+            mObjectStart = 0;
+        }
+
+        const auto size = mBuffer.size();
+        mBuffer.resize(size + mBufferSize);
+        mStream.read(mBuffer.data() + size, static_cast<std::streamsize>(mBufferSize));
+        const auto read = static_cast<size_t>(mStream.gcount());
+        mBuffer.resize(size + read);
+        return read > 0;
+    }
+
+    bool JsonSceneReader::IsStructural(const char c)
+    {
+        if (mInString)
+        {
+            if (mEscape)
+            {
+                mEscape = false;
+            }
+            else if (c == '\\')
+            {
+                mEscape = true;
+            }
+            else if (c == '"')
+            {
+                mInString = false;
+            }
+            return false;
+        }
+
+        switch (c)
+        {
+        case '"':
+            mInString = true;
+            return false;
+        case '{':
+        case '[':
+            mDepth++;
+            return true;
+        case '}':
+        case ']':
+            mDepth--;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    Opt<std::string_view> JsonSceneReader::NextObject()
+    {
+        while (true)
+        {
+            while (mScan < mBuffer.size())
+            {
+                const char c = mBuffer[mScan++];
+                if (!IsStructural(c)) continue;
+
+                if (c == '{' && mDepth == kEntityDepth + 1)
+                {
+                    mObjectStart = mScan - 1;
+                }
+                else if (c == '}' && mDepth == kEntityDepth && mObjectStart != std::string::npos)
+                {
+                    const auto object = std::string_view(mBuffer).substr(mObjectStart, mScan - mObjectStart);
+                    mObjectStart = std::string::npos;
+                    return object;
+                }
+                else if (c == ']' && mDepth == kEntityDepth - 1)
+                {
+                    mFinished = true;
+                    return std::nullopt;
+                }
+            }
+
+            if (!Fill())
+            {
+                Log::Error("JsonSceneReader: Unexpected end of scene");
+                mFailed = true;
+                return std::nullopt;
+            }
+        }
+    }
+}
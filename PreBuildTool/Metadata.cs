@@ -15,6 +15,7 @@ public class Metadata
         sb.AppendLine("#pragma once");
         sb.AppendLine("// This file was generated by PreBuildTool");
         sb.AppendLine("// Do not modify.");
+        sb.AppendLine("#include \"Tools/BinaryStream.hpp\"");
 
         sb.AppendLine("namespace Neo");
         sb.AppendLine("{");
@@ -35,7 +36,7 @@ public class Metadata
             sb.AppendLine("}");
             sb.AppendLine();
         }
-        
+
         sb.AppendLine();
         sb.AppendLine("inline void RegisterMeta() {");
         foreach (var s in _structs)
@@ -43,10 +44,69 @@ public class Metadata
             sb.AppendLine($"    Register{s.Name}();");
         }
         sb.AppendLine("}");
+
+        foreach (var s in _structs)
+        {
+            GenerateSerialize(sb, s);
+        }
+
+        sb.AppendLine();
+        var types = string.Join(", ", _structs.Select(s => s.Name));
+        sb.AppendLine($"using SerializedTypes = std::tuple<{types}>;");
         sb.AppendLine("}");
 
         return sb.ToString();
     }
-    
+
+    // Fields declared next to each other are written as a run, which BinaryStream copies with a single memcpy
+    // when their C++ types have no padding bytes, containers are written as length prefixed blocks
+    private static void GenerateSerialize(StringBuilder sb, StructInfo s)
+    {
+        var runs = GetRuns(s);
+
+        sb.AppendLine();
+        sb.AppendLine($"inline void Serialize(BinaryWriter& writer, const {s.Name}& value)");
+        sb.AppendLine("{");
+        foreach (var run in runs)
+        {
+            sb.AppendLine(run.Count == 1
+                ? $"    writer.Write(value.{run[0]});"
+                : $"    writer.WriteRun<{GetMembers(s, run)}>(value);");
+        }
+        sb.AppendLine("}");
+
+        sb.AppendLine();
+        sb.AppendLine($"inline void Deserialize(BinaryReader& reader, {s.Name}& value)");
+        sb.AppendLine("{");
+        foreach (var run in runs)
+        {
+            sb.AppendLine(run.Count == 1
+                ? $"    reader.Read(value.{run[0]});"
+                : $"    reader.ReadRun<{GetMembers(s, run)}>(value);");
+        }
+        sb.AppendLine("}");
+    }
+
+    private static string GetMembers(StructInfo s, List<string> run)
+    {
+        return string.Join(", ", run.Select(field => $"&{s.Name}::{field}"));
+    }
+
+    // Whether a field can be copied as raw bytes depends on its C++ type, which only the compiler knows
+    private static List<List<string>> GetRuns(StructInfo s)
+    {
+        var runs = new List<List<string>>();
+        foreach (var field in s.SerializedFields)
+        {
+            var last = runs.Count > 0 ? runs[^1] : null;
+            if (last != null && s.Fields.IndexOf(field) == s.Fields.IndexOf(last[^1]) + 1)
+                last.Add(field);
+            else
+                runs.Add([field]);
+        }
+
+        return runs;
+    }
+
     private readonly List<StructInfo> _structs;
-}
\ No newline at end of file
+}
@@ -26,6 +26,7 @@ internal partial class Parser
                 var type = fieldMatch.Groups[2].Value;
                 var name = fieldMatch.Groups[3].Value;
 
+                structInfo.Fields.Add(name);
                 structInfo.FieldTypes[name] = type;
                 if (!string.IsNullOrEmpty(isSerialized))
                     structInfo.SerializedFields.Add(name);
@@ -21,6 +21,7 @@ File.WriteAllText(args[1], generatedCode);
 public class StructInfo
 {
     public string Name = "";
+    public readonly List<string> Fields = [];
     public readonly List<string> SerializedFields = [];
     public readonly Dictionary<string, string> FieldTypes = [];
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+import argparse
+import json
+import sys
+from pathlib import Path
+
+def load_results(path : str) -> tuple[dict, dict]:
+    data = json.loads(Path(path).read_text())
+    results = {}
+    for benchmark in data.get('benchmarks', []):
+        # Aggregates from --benchmark_repetitions are compared by their mean only
+        if benchmark.get('run_type') == 'aggregate' and benchmark.get('aggregate_name') != 'mean':
+            continue
+        if benchmark.get('error_occurred'):
+            continue
+        results[benchmark['run_name']] = benchmark
+    return data.get('context', {}), results
+
+def compare(baseline_path : str, current_path : str, threshold : float) -> int:
+    baseline_context, baseline = load_results(baseline_path)
+    current_context, current = load_results(current_path)
+    print("Baseline: {} ({})".format(baseline_path, baseline_context.get('neo_commit', 'unknown commit')))
+    print("Current:  {} ({})".format(current_path, current_context.get('neo_commit', 'unknown commit')))
+    print()
+
+    regressions = []
+    name_width = max([len(name) for name in current] + [9])
+    print("{:<{}} {:>14} {:>14} {:>9}".format('Benchmark', name_width, 'Baseline', 'Current', 'Change'))
+    for name, result in current.items():
+        if name not in baseline:
+            print("{:<{}} {:>14} {:>14.3f} {:>9}".format(name, name_width, '-', result['real_time'], 'new'))
+            continue
+
+        before = baseline[name]['real_time']
+        after = result['real_time']
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        marker = ''
+        if change > threshold:
+            marker = ' slower'
+            regressions.append(name)
+        elif change < -threshold:
+            marker = ' faster'
+        print("{:<{}} {:>14.3f} {:>14.3f} {:>+8.1f}%{}".format(name, name_width, before, after, change, marker))
+
+    for name in baseline:
+        if name not in current:
+            print("{:<{}} {:>14.3f} {:>14} {:>9}".format(name, name_width, baseline[name]['real_time'], '-',
+                                                        'removed'))
+
+    print()
+    if regressions:
+        print("{} benchmarks regressed by more than {}%".format(len(regressions), threshold))
+        return 1
+    print("No regressions over {}%".format(threshold))
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two NeoBenchmarks JSON results')
+    parser.add_argument('baseline', help='Results of the reference commit')
+    parser.add_argument('current', help='Results of the commit being checked')
+    parser.add_argument('-threshold', type=float, default=5.0,
+                        help='Percentage a benchmark may slow down before it counts as a regression')
+    args = parser.parse_args()
+    sys.exit(compare(args.baseline, args.current, args.threshold))
+
+main()
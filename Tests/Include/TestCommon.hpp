@@ -0,0 +1,10 @@
+#pragma once
+#include "gtest/gtest.h"
+
+namespace Neo::Test
+{
+    /// <summary>
+    /// Directory for the files tests write, emptied once at the start of the run.
+    /// </summary>
+    [[nodiscard]] const std::filesystem::path& GetTempDirectory();
+}
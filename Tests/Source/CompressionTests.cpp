@@ -0,0 +1,118 @@
+#include "TestCommon.hpp"
+#include "sstream"
+#include "Tools/AssetFile.hpp"
+#include "Tools/Compression.hpp"
+
+namespace
+{
+    constexpr u32 kBlockSize = 1000;
+    // The stream header and the header of the first block come before its stored bytes
+    constexpr size_t kFirstBlockOffset = 32;
+
+    std::vector<char> MakeData(const size_t size)
+    {
+        std::vector<char> data(size);
+        for (size_t index = 0; index < size; index++)
+        {
+            data[index] = static_cast<char>(index * 7 % 251);
+        }
+        return data;
+    }
+
+    std::string Compress(const std::span<const char> data, const Neo::Compression compression)
+    {
+        std::ostringstream stream(std::ios::binary);
+        Neo::CompressedWriter writer(stream, compression, kBlockSize);
+        writer.Write(data);
+        EXPECT_TRUE(writer.Finish());
+        return stream.str();
+    }
+}
+
+TEST(CompressionTest, StreamsInPieces)
+{
+    const auto data = MakeData(3500);
+    std::ostringstream output(std::ios::binary);
+    Neo::CompressedWriter writer(output, Neo::Compression::eZstd, kBlockSize);
+    size_t written = 0;
+    for (const size_t size : {1, 999, 1700, 800})
+    {
+        writer.Write(std::span(data).subspan(written, size));
+        written += size;
+    }
+    ASSERT_TRUE(writer.Finish());
+    const auto compressed = output.str();
+    EXPECT_EQ(writer.GetSize(), compressed.size());
+    EXPECT_EQ(writer.GetChecksum(), Neo::Compressor::Checksum(compressed));
+    // Where the writes split the data does not change the stream
+    const auto whole = Neo::Compressor::Compress(data, Neo::Compression::eZstd, kBlockSize);
+    EXPECT_TRUE(std::ranges::equal(compressed, whole));
+
+    std::istringstream input(compressed, std::ios::binary);
+    Neo::CompressedReader reader(input);
+    std::vector<char> read(data.size() + 1);
+    EXPECT_EQ(reader.Read(std::span(read).first(333)), 333);
+    // Range reads leave the position of Read alone
+    const auto range = reader.ReadRange(2900, 200);
+    ASSERT_TRUE(range.has_value());
+    EXPECT_TRUE(std::ranges::equal(range.value(), std::span(data).subspan(2900, 200)));
+    EXPECT_EQ(reader.Read(std::span(read).subspan(333)), data.size() - 333);
+    EXPECT_FALSE(reader.Failed());
+    EXPECT_TRUE(std::ranges::equal(std::span(read).first(data.size()), data));
+}
+
+TEST(CompressionTest, RangesReadOnlyTheirBlocks)
+{
+    const auto data = MakeData(3500);
+    auto compressed = Compress(data, Neo::Compression::eNone);
+    // Corrupt the first block, which only reads that reach into it notice
+    compressed[kFirstBlockOffset + 500] ^= 1;
+
+    std::istringstream input(compressed, std::ios::binary);
+    Neo::CompressedReader reader(input);
+    EXPECT_EQ(reader.GetSize(), data.size());
+
+    const auto tail = reader.ReadRange(1500, 2000);
+    ASSERT_TRUE(tail.has_value());
+    EXPECT_TRUE(std::ranges::equal(tail.value(), std::span(data).subspan(1500)));
+    EXPECT_EQ(reader.ReadRange(900, 200), std::unexpected(Neo::Compressor::Error::eChecksumMismatch));
+    EXPECT_EQ(reader.ReadRange(3000, 501), std::unexpected(Neo::Compressor::Error::eInvalidStream));
+}
+
+TEST(CompressionTest, RejectsATruncatedBlockTable)
+{
+    const auto data = MakeData(2500);
+    auto compressed = Compress(data, Neo::Compression::eZstd);
+    compressed.pop_back();
+
+    std::istringstream input(compressed, std::ios::binary);
+    Neo::CompressedReader reader(input);
+    EXPECT_FALSE(reader.GetSize().has_value());
+    EXPECT_FALSE(reader.ReadRange(0, 1).has_value());
+    // The blocks themselves are still fine to read one after the other
+    std::vector<char> read(data.size());
+    EXPECT_EQ(reader.Read(read), data.size());
+    EXPECT_TRUE(std::ranges::equal(read, data));
+}
+
+TEST(CompressionTest, AssetTailsSkipTheBlocksBeforeThem)
+{
+    constexpr u32 kTypeHash = 1;
+    const auto data = MakeData(Neo::kCompressionBlockSize * 2 + 100);
+    const auto path = (Neo::Test::GetTempDirectory() / "Tail.asset").string();
+    ASSERT_TRUE(Neo::AssetFile::Write(path, kTypeHash, 1, Neo::Compression::eNone, data));
+    {
+        // Corrupt the first block, which the tail never reads
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(Neo::AssetHeader) + kFirstBlockOffset + 10);
+        file.put('x');
+    }
+
+    const auto tail = Neo::AssetFile::ReadTail(path, kTypeHash, 1, 1000, 600);
+    ASSERT_TRUE(tail.has_value());
+    EXPECT_TRUE(std::ranges::equal(tail.value(), std::span(data).subspan(data.size() - 1000, 600)));
+    EXPECT_EQ(Neo::AssetFile::Read(path, kTypeHash, 1),
+              std::unexpected(Neo::AssetFile::Error::eChecksumMismatch));
+    EXPECT_EQ(Neo::AssetFile::ReadTail(path, kTypeHash, 1, data.size(), 100),
+              std::unexpected(Neo::AssetFile::Error::eChecksumMismatch));
+}
@@ -0,0 +1,98 @@
+#include "TestCommon.hpp"
+#include "Core/ECS.hpp"
+#include "Core/Resources.hpp"
+#include "Render/DrawList.hpp"
+#include "Tools/Serializer.hpp"
+
+TEST(DrawListTest, PrimitivesOfAMeshBatchTogether)
+{
+    constexpr u32 kInstances = 64;
+    constexpr u32 kPrimitives = 3;
+    const auto shader = std::bit_cast<Neo::ShaderHandle>(1u);
+    const auto mesh = Neo::AssetHandle<Neo::Mesh>(5, 0);
+
+    // Every instance adds all of its primitives in a row, at depths that would interleave them without the
+    // primitive in the key
+    Neo::DrawList drawList;
+    drawList.Begin(Neo::DrawView{.Forward = glm::vec3(0.f, 0.f, -1.f), .Far = 1000.f});
+    for (u32 instance = 0; instance < kInstances; instance++)
+    {
+        auto world = glm::mat4(1.f);
+        world[3] = glm::vec4(0.f, 0.f, -static_cast<float>(instance) * 10.f, 1.f);
+        for (u32 primitive = 0; primitive < kPrimitives; primitive++)
+        {
+            drawList.Add(Neo::DrawPass::eOpaque, shader, 0, mesh, primitive, world);
+        }
+    }
+    drawList.Finish();
+
+    const auto batches = drawList.GetBatches();
+    ASSERT_EQ(batches.size(), kPrimitives);
+    for (u32 primitive = 0; primitive < kPrimitives; primitive++)
+    {
+        EXPECT_EQ(batches[primitive].Primitive, primitive);
+        EXPECT_EQ(batches[primitive].InstanceCount, kInstances);
+    }
+    EXPECT_EQ(drawList.GetStats().MeshChanges, kPrimitives);
+}
+
+TEST(DrawListTest, DrawsWaitForTheirMaterial)
+{
+    const auto makeID = [](const u32 value)
+    {
+        return uuids::uuid::from_string(fmt::format("00000000-0000-0000-0004-{:012}", value)).value();
+    };
+    Neo::Resources resources;
+    const auto cook = [&]<typename T>(T& desc, const std::string_view file)
+    {
+        const auto path = (Neo::Test::GetTempDirectory() / file).string();
+        ASSERT_TRUE(Neo::BinarySerializer::Serialize(desc, path));
+        resources.RegisterAsset(desc.ID, path);
+    };
+
+    // The first material takes the first params slot, which a draw waiting for its material used to borrow
+    Neo::MaterialDesc first{};
+    first.ID = makeID(1);
+    first.Params.RoughnessFactor = 0.5f;
+    cook(first, "First.asset");
+    Neo::MaterialDesc second{};
+    second.ID = makeID(2);
+    second.Params.RoughnessFactor = 0.75f;
+    cook(second, "Second.asset");
+    const auto brokenPath = (Neo::Test::GetTempDirectory() / "BrokenMaterial.asset").string();
+    std::ofstream(brokenPath, std::ios::binary) << "Not an asset";
+    resources.RegisterAsset(makeID(3), brokenPath);
+
+    const auto cookMesh = [&](const u32 id, const u32 material, const std::string_view file)
+    {
+        Neo::MeshDesc mesh{};
+        mesh.ID = makeID(id);
+        auto& primitive = mesh.Primitives.emplace_back();
+        primitive.Vertices.resize(3);
+        primitive.Indices = {0, 1, 2};
+        primitive.MaterialID = makeID(material);
+        primitive.Bounds = {.Min = glm::vec3(-1.f), .Max = glm::vec3(1.f), .Radius = std::sqrt(3.f)};
+        cook(mesh, file);
+        return resources.LoadMesh(mesh.ID);
+    };
+    ASSERT_FALSE(resources.LoadMaterial(first.ID).IsNull());
+    const auto loaded = cookMesh(4, 2, "Loaded.asset");
+    const auto waiting = cookMesh(5, 3, "Waiting.asset");
+
+    Neo::ECS ecs;
+    for (const auto mesh : {loaded, waiting})
+    {
+        ecs.Add<Neo::MeshRenderer>(ecs.CreateNamelessEntity(), Neo::MeshRenderer{.Mesh = mesh});
+    }
+    Neo::DrawList drawList;
+    drawList.Begin(Neo::DrawView{});
+    drawList.Extract(ecs, resources);
+    drawList.Finish();
+
+    const auto* material = resources.Get(resources.Get(loaded)->Primitives.front().Material);
+    ASSERT_NE(material, nullptr);
+    const auto batches = drawList.GetBatches();
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches.front().Material, material->ParamsIndex);
+    EXPECT_NE(batches.front().Material, 0);
+}
@@ -0,0 +1,160 @@
+#include "TestCommon.hpp"
+#include "Core/ECS.hpp"
+#include "Core/Renderer.hpp"
+#include "Core/Resources.hpp"
+#include "Memory/MemoryTracker.hpp"
+#include "Render/Null/RenderContextNull.hpp"
+#include "Tools/Serializer.hpp"
+
+namespace
+{
+    constexpr u32 kDraws = 4'096;
+    constexpr u32 kSceneEntities = 64;
+    // The scene is drawn from the third frame on, once its mesh is uploaded, and every frame in flight records
+    // into a command of its own that has to grow once
+    constexpr u32 kWarmUpFrames = 8;
+    constexpr u32 kFrames = 16;
+
+    constexpr Neo::RenderContextCreateInfo kNullCreateInfo{
+        .Backend = Neo::RenderBackend::eNull,
+        .Size = glm::uvec2(1280, 720),
+    };
+
+    // A transient target written by one pass and read by the next, so the graph declares targets every frame
+    void AddPasses(Neo::Renderer& renderer, Neo::RenderGraphResource& bloom)
+    {
+        renderer.AddRenderPass({
+            .Name = "Bloom Downsample With A Name Longer Than Short Strings",
+            .Setup = [&renderer, &bloom](Neo::RenderGraphBuilder& builder)
+            {
+                builder.Read(renderer.GetSceneResource());
+                bloom = builder.Write(builder.CreateRenderTarget("Bloom Target", {.Size = glm::uvec2(640, 360)}));
+            },
+            .Execute = [](const Neo::RenderGraph&, Neo::CommandHandle) {},
+        });
+        renderer.AddRenderPass({
+            .Name = "Bloom Composite",
+            .Setup = [&renderer, &bloom](Neo::RenderGraphBuilder& builder)
+            {
+                builder.Read(bloom);
+                builder.Write(renderer.GetBackbufferResource());
+            },
+            .Execute = [&renderer](const Neo::RenderGraph&, const Neo::CommandHandle command)
+            {
+                renderer.GetRenderContext()->Draw(command, 3, 1, 0, 0);
+            },
+        });
+    }
+
+    // The draws of a frame, spread over a few shaders, materials and meshes like a small scene
+    void FillDrawList(Neo::DrawList& drawList)
+    {
+        drawList.Begin(Neo::DrawView{.Far = 2000.f});
+        for (u32 draw = 0; draw < kDraws; draw++)
+        {
+            auto world = glm::mat4(1.f);
+            world[3] = glm::vec4(static_cast<float>(draw % 64), static_cast<float>(draw / 64), -10.f, 1.f);
+            drawList.Add(draw % 10 == 0 ? Neo::DrawPass::eTransparent : Neo::DrawPass::eOpaque,
+                         std::bit_cast<Neo::ShaderHandle>(draw % 4), draw % 32,
+                         Neo::AssetHandle<Neo::Mesh>(draw % 128, 0), 0, world);
+        }
+        drawList.Finish();
+    }
+
+    // A camera looking at a row of entities sharing one mesh, which the renderer extracts through its scene BVH
+    bool CookScene(Neo::ECS& ecs, Neo::Resources& resources)
+    {
+        Neo::MaterialDesc material{};
+        material.ID = uuids::uuid::from_string("00000000-0000-0000-0006-000000000001").value();
+        Neo::MeshDesc mesh{};
+        mesh.ID = uuids::uuid::from_string("00000000-0000-0000-0006-000000000002").value();
+        auto& primitive = mesh.Primitives.emplace_back();
+        primitive.Vertices.resize(3);
+        primitive.Indices = {0, 1, 2};
+        primitive.MaterialID = material.ID;
+        primitive.Bounds = {.Min = glm::vec3(-1.f), .Max = glm::vec3(1.f), .Radius = std::sqrt(3.f)};
+        const auto materialPath = (Neo::Test::GetTempDirectory() / "SceneMaterial.asset").string();
+        const auto meshPath = (Neo::Test::GetTempDirectory() / "SceneMesh.asset").string();
+        if (!Neo::BinarySerializer::Serialize(material, materialPath)) return false;
+        if (!Neo::BinarySerializer::Serialize(mesh, meshPath)) return false;
+        resources.RegisterAsset(material.ID, materialPath);
+        resources.RegisterAsset(mesh.ID, meshPath);
+
+        const auto handle = resources.LoadMesh(mesh.ID);
+        ecs.Add<Neo::Camera>(ecs.CreateNamelessEntity(), Neo::Camera{});
+        for (u32 entity = 0; entity < kSceneEntities; entity++)
+        {
+            const auto created = ecs.CreateNamelessEntity();
+            ecs.Modify<Neo::Transform>(created, [entity](Neo::Transform& transform)
+            {
+                transform.Position = glm::vec3(static_cast<float>(entity % 8) * 3.f - 12.f,
+                                               static_cast<float>(entity / 8) - 4.f, -30.f);
+            });
+            ecs.Add<Neo::MeshRenderer>(created, Neo::MeshRenderer{.Mesh = handle});
+        }
+        return !handle.IsNull();
+    }
+}
+
+TEST(FrameAllocatorTest, KeepsThePreviousFrame)
+{
+    Neo::FrameAllocator frameAllocator(256);
+    frameAllocator.BeginFrame();
+    const auto previous = frameAllocator.AllocateArray<u32>(16);
+    std::ranges::fill(previous, 7u);
+
+    frameAllocator.BeginFrame();
+    const auto current = frameAllocator.AllocateArray<u32>(16);
+    std::ranges::fill(current, 9u);
+    EXPECT_TRUE(std::ranges::all_of(previous, [](const u32 value) { return value == 7; }));
+
+    // Two flips later the arena of the first frame is handed out again
+    frameAllocator.BeginFrame();
+    EXPECT_EQ(frameAllocator.AllocateArray<u32>(16).data(), previous.data());
+}
+
+TEST(FrameAllocatorTest, WarmFramesDoNotAllocate)
+{
+#ifndef NEO_MEMORY_TRACKING
+    GTEST_SKIP() << "Needs the memory tracker to count heap allocations";
+#endif
+    auto bloom = Neo::RenderGraphResource::eNull;
+    Neo::Renderer renderer(kNullCreateInfo);
+    // Worker threads of the parallel algorithms allocate on their own the first times they run
+    renderer.SetParallelRecording(false);
+    AddPasses(renderer, bloom);
+    Neo::FrameAllocator frameAllocator;
+    Neo::DrawList drawList;
+    Neo::ECS ecs;
+    Neo::Resources resources;
+    resources.SetRenderContext(renderer.GetRenderContext().get());
+    resources.SetUploadQueue(&renderer.GetUploadQueue());
+    renderer.GetSceneBVH().Attach(ecs.GetWorld());
+    ASSERT_TRUE(CookScene(ecs, resources));
+
+    const auto runFrame = [&]
+    {
+        frameAllocator.BeginFrame();
+        FillDrawList(drawList);
+        renderer.ExtractDraws(ecs, resources);
+        renderer.Update(0.f, frameAllocator);
+    };
+    for (u32 frame = 0; frame < kWarmUpFrames; frame++)
+    {
+        runFrame();
+    }
+
+    const auto allocations = Neo::MemoryTracker::GetAllocationCount();
+    for (u32 frame = 0; frame < kFrames; frame++)
+    {
+        runFrame();
+    }
+    EXPECT_EQ(Neo::MemoryTracker::GetAllocationCount() - allocations, 0);
+    // Once before the mesh is uploaded, and once more when the pass drawing it starts
+    EXPECT_EQ(renderer.GetRenderGraph().GetCompileCount(), 2);
+    EXPECT_GT(drawList.GetBatches().size(), 0);
+    EXPECT_EQ(renderer.GetDrawList().GetStats().Draws, kSceneEntities);
+    const auto& context = static_cast<const Neo::RenderContextNull&>(*renderer.GetRenderContext());
+    EXPECT_GT(context.GetCallCount(Neo::NullCall::eDrawIndexed), 0);
+    resources.CleanupResources();
+}
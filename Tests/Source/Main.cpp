@@ -0,0 +1,25 @@
+#include "TestCommon.hpp"
+
+namespace Neo::Test
+{
+    const std::filesystem::path& GetTempDirectory()
+    {
+        static const auto directory = []
+        {
+            auto path = std::filesystem::temp_directory_path() / "NeoTests";
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+            return path;
+        }();
+        return directory;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // The serializers log every file, which would drown the results
+    spdlog::set_level(spdlog::level::warn);
+
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
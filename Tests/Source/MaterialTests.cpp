@@ -0,0 +1,117 @@
+#include "TestCommon.hpp"
+#include "Core/Resources.hpp"
+#include "Render/Null/RenderContextNull.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Tools/Serializer.hpp"
+
+namespace
+{
+    Neo::AssetID MakeID(const u32 value)
+    {
+        return uuids::uuid::from_string(fmt::format("00000000-0000-0000-0001-{:012}", value)).value();
+    }
+
+    class MaterialTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            mResources.SetRenderContext(&mContext);
+
+            Neo::TextureDesc texture{};
+            texture.Name = "Albedo";
+            texture.ID = MakeID(1);
+            texture.Width = 4;
+            texture.Height = 4;
+            texture.MipLevels = 3;
+            texture.Pixels.resize(Neo::GetMipChainSize(4, 4, 3, 0), 0x7F);
+            Cook(texture, "Albedo.asset");
+
+            Neo::MaterialDesc material{};
+            material.Name = "Material";
+            material.ID = MakeID(2);
+            material.BaseColorTextureID = texture.ID;
+            material.Params.RoughnessFactor = 0.25f;
+            Cook(material, "Material.asset");
+        }
+
+        template <typename T>
+        void Cook(T& desc, const std::string_view file)
+        {
+            const auto path = (Neo::Test::GetTempDirectory() / file).string();
+            ASSERT_TRUE(Neo::BinarySerializer::Serialize(desc, path));
+            mResources.RegisterAsset(desc.ID, path);
+        }
+
+        void ExpectResolved(const Neo::AssetHandle<Neo::Material> handle)
+        {
+            const auto* material = mResources.Get(handle);
+            ASSERT_NE(material, nullptr);
+            const auto* texture = mResources.Get(material->BaseColorTexture);
+            ASSERT_NE(texture, nullptr);
+            ASSERT_NE(texture->GPUTexture, Neo::TextureHandle::eNull);
+
+            const auto& params = mResources.GetMaterialTable().Get(material->ParamsIndex);
+            EXPECT_EQ(params.BaseColorTexture, mContext.GetGPUAddress(texture->GPUTexture));
+            EXPECT_EQ(params.NormalTexture, Neo::kNoTextureDescriptor);
+            EXPECT_EQ(params.EmissiveTexture, Neo::kNoTextureDescriptor);
+            EXPECT_EQ(params.RoughnessFactor, 0.25f);
+        }
+
+        Neo::RenderContextNull mContext{Neo::RenderContextCreateInfo{.Backend = Neo::RenderBackend::eNull}};
+        Neo::Resources mResources;
+    };
+}
+
+TEST_F(MaterialTest, TextureSlotsHoldDescriptorIndices)
+{
+    const auto handle = mResources.LoadMaterial(MakeID(2));
+    ExpectResolved(handle);
+    EXPECT_EQ(mContext.GetCallCount(Neo::NullCall::eCreateTexture), 1);
+
+    mResources.CleanupResources();
+    EXPECT_EQ(mContext.GetCallCount(Neo::NullCall::eDestroyTexture), 1);
+}
+
+TEST_F(MaterialTest, StreamedTexturesAreResolvedOnceLoaded)
+{
+    // The material finishes first and streams its texture, which is filled in when it arrives
+    const auto handle = mResources.RequestMaterial(MakeID(2), 1.f);
+    for (u32 frame = 0; frame < 1000 && !mResources.Get(handle); frame++)
+    {
+        mResources.Update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_NE(mResources.Get(handle), nullptr);
+    EXPECT_EQ(mResources.GetMaterialTable().Get(mResources.Get(handle)->ParamsIndex).BaseColorTexture,
+              Neo::kNoTextureDescriptor);
+
+    const auto texture = mResources.Get(handle)->BaseColorTexture;
+    for (u32 frame = 0; frame < 1000 && !mResources.IsLoaded(texture); frame++)
+    {
+        mResources.Update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ExpectResolved(handle);
+}
+
+TEST_F(MaterialTest, FailedLoadsLeaveLiveMaterialsAlone)
+{
+    const auto live = mResources.LoadMaterial(MakeID(2));
+    ExpectResolved(live);
+
+    const auto path = (Neo::Test::GetTempDirectory() / "Broken.asset").string();
+    std::ofstream(path, std::ios::binary) << "Not an asset";
+    mResources.RegisterAsset(MakeID(3), path);
+    const auto broken = mResources.RequestMaterial(MakeID(3), 1.f);
+    for (u32 frame = 0; frame < 1000 && mResources.IsValid(broken); frame++)
+    {
+        mResources.Update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_FALSE(mResources.IsValid(broken));
+
+    // Dropping the failed load took nothing away from the params entry of the live material
+    EXPECT_EQ(mResources.GetMaterialTable().GetCount(), 1);
+    ExpectResolved(live);
+}
@@ -0,0 +1,67 @@
+#include "TestCommon.hpp"
+#include "Core/Renderer.hpp"
+#include "Render/Null/RenderContextNull.hpp"
+#include "Tools/Metrics.hpp"
+
+namespace
+{
+    constexpr u32 kDraws = 5;
+
+    i64 GetLastFrame(const std::string_view name)
+    {
+        const auto sample = Neo::Metrics::Find(name);
+        return sample ? sample->Value : 0;
+    }
+}
+
+TEST(MetricsTest, NullBackendCountsDrawsAndUploads)
+{
+    Neo::Renderer renderer(Neo::RenderContextCreateInfo{.Backend = Neo::RenderBackend::eNull});
+    renderer.AddRenderPass({
+        .Name = "Triangles",
+        .Setup = [&renderer](Neo::RenderGraphBuilder& builder)
+        {
+            builder.Write(renderer.GetBackbufferResource());
+        },
+        .Execute = [&renderer](const Neo::RenderGraph&, const Neo::CommandHandle command)
+        {
+            for (u32 draw = 0; draw < kDraws; draw++)
+            {
+                renderer.GetRenderContext()->Draw(command, 6, 2, 0, 0);
+            }
+            renderer.GetRenderContext()->DrawIndexed(command, 36, 1, 0, 0, 0);
+        },
+    });
+
+    Neo::FrameAllocator frameAllocator;
+    // Closes the frame of whatever ran before
+    Neo::Metrics::BeginFrame();
+    for (u32 frame = 0; frame < 2; frame++)
+    {
+        frameAllocator.BeginFrame();
+        renderer.Update(0.f, frameAllocator);
+        Neo::Metrics::BeginFrame();
+
+        // A headless run reports the same per frame numbers a DX12 frame would, with the triangle the renderer
+        // draws into the scene on top
+        EXPECT_EQ(GetLastFrame("Render/DrawCalls"), kDraws + 2);
+        EXPECT_EQ(GetLastFrame("Render/Triangles"), kDraws * 4 + 12 + 1);
+    }
+}
+
+TEST(MetricsTest, NullBackendCountsCopiedBytes)
+{
+    Neo::RenderContextNull context(Neo::RenderContextCreateInfo{.Backend = Neo::RenderBackend::eNull});
+    const Neo::BufferCreateInfo createInfo{.FirstElement = 0, .NumElements = 256, .Stride = 4};
+    const auto source = context.CreateBuffer(createInfo, "Source");
+    const auto destination = context.CreateBuffer(createInfo, "Destination");
+    const auto command = context.CreateCommand(Neo::QueueType::eTransfer, "Transfer");
+
+    Neo::Metrics::BeginFrame();
+    context.BeginCommand(command);
+    context.CopyBuffer(command, source, destination, 0, 0, 1000);
+    context.CopyBuffer(command, source, destination, 0, 0, 24);
+    context.EndCommand(command);
+    Neo::Metrics::BeginFrame();
+    EXPECT_EQ(GetLastFrame("Render/UploadBytes"), 1024);
+}
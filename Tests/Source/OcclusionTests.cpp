@@ -0,0 +1,70 @@
+#include "TestCommon.hpp"
+#include "Render/Occlusion.hpp"
+
+namespace
+{
+    // A 10 by 10 wall facing the camera 10 units down -Z, the camera at the origin looking down -Z
+    constexpr float kWallDistance = 10.f;
+    constexpr float kWallHalfSize = 5.f;
+
+    Neo::Bounds MakeBox(const glm::vec3 center, const glm::vec3 extents)
+    {
+        return {.Min = center - extents, .Max = center + extents, .Center = center, .Radius = glm::length(extents)};
+    }
+
+    class OcclusionTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            const auto projection = glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f);
+            const auto view = glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f));
+
+            std::array<Neo::Vertex, 4> vertices{};
+            vertices[0].Position = glm::vec3(-kWallHalfSize, -kWallHalfSize, -kWallDistance);
+            vertices[1].Position = glm::vec3(kWallHalfSize, -kWallHalfSize, -kWallDistance);
+            vertices[2].Position = glm::vec3(kWallHalfSize, kWallHalfSize, -kWallDistance);
+            vertices[3].Position = glm::vec3(-kWallHalfSize, kWallHalfSize, -kWallDistance);
+            constexpr std::array<u32, 6> indices{0, 1, 2, 0, 2, 3};
+
+            mCuller.Begin(projection * view);
+            mCuller.AddOccluder(vertices, indices, glm::mat4(1.f));
+            mCuller.Rasterize();
+        }
+
+        Neo::OcclusionCuller mCuller;
+    };
+}
+
+TEST_F(OcclusionTest, BoxesBehindTheWallAreOccluded)
+{
+    ASSERT_EQ(mCuller.GetTriangleCount(), 2);
+    EXPECT_FALSE(mCuller.IsVisible(MakeBox(glm::vec3(0.f, 0.f, -15.f), glm::vec3(1.f))));
+    // The wall covers more of the view the farther a box is behind it
+    EXPECT_FALSE(mCuller.IsVisible(MakeBox(glm::vec3(6.f, 0.f, -50.f), glm::vec3(2.f))));
+    EXPECT_FALSE(mCuller.IsVisible(MakeBox(glm::vec3(0.f, 0.f, -90.f), glm::vec3(5.f))));
+    // Inside the silhouette of the wall, close to its edge
+    EXPECT_FALSE(mCuller.IsVisible(MakeBox(glm::vec3(3.5f, 3.5f, -12.f), glm::vec3(0.5f))));
+}
+
+TEST_F(OcclusionTest, BoxesNotBehindTheWallAreVisible)
+{
+    // In front of the wall
+    EXPECT_TRUE(mCuller.IsVisible(MakeBox(glm::vec3(0.f, 0.f, -5.f), glm::vec3(1.f))));
+    // Beside it
+    EXPECT_TRUE(mCuller.IsVisible(MakeBox(glm::vec3(10.f, 0.f, -15.f), glm::vec3(1.f))));
+    // Behind it, but sticking out over its edge
+    EXPECT_TRUE(mCuller.IsVisible(MakeBox(glm::vec3(5.f, 0.f, -12.f), glm::vec3(1.f))));
+    // Through it
+    EXPECT_TRUE(mCuller.IsVisible(MakeBox(glm::vec3(0.f, 0.f, -10.f), glm::vec3(1.f))));
+    // Behind the camera, which crosses the near plane for the culler to leave to the frustum
+    EXPECT_TRUE(mCuller.IsVisible(MakeBox(glm::vec3(0.f, 0.f, 5.f), glm::vec3(1.f))));
+}
+
+TEST_F(OcclusionTest, NothingIsOccludedWithoutOccluders)
+{
+    mCuller.Begin(glm::mat4(1.f));
+    mCuller.Rasterize();
+    EXPECT_FALSE(mCuller.HasOccluders());
+    EXPECT_TRUE(mCuller.IsVisible(MakeBox(glm::vec3(0.f, 0.f, -15.f), glm::vec3(1.f))));
+}
@@ -0,0 +1,123 @@
+#include "TestCommon.hpp"
+#include "random"
+#include "Memory/OffsetAllocator.hpp"
+
+namespace
+{
+    constexpr u64 kSize = 64ull * 1024 * 1024;
+    constexpr u64 kGranularity = 256;
+
+    struct Live
+    {
+        Neo::OffsetAllocation Allocation;
+        u64 Alignment;
+    };
+
+    // Checks the live allocations against each other and the stats, sorting them by offset on the way
+    void ExpectConsistent(const Neo::OffsetAllocator& allocator, std::vector<Live>& live)
+    {
+        std::ranges::sort(live, {}, [](const Live& entry) { return entry.Allocation.Offset; });
+        u64 used = 0;
+        for (size_t index = 0; index < live.size(); index++)
+        {
+            const auto& allocation = live[index].Allocation;
+            ASSERT_EQ(allocation.Offset % live[index].Alignment, 0);
+            ASSERT_EQ(allocation.Size % kGranularity, 0);
+            ASSERT_LE(allocation.Offset + allocation.Size, kSize);
+            if (index > 0)
+            {
+                const auto& previous = live[index - 1].Allocation;
+                ASSERT_LE(previous.Offset + previous.Size, allocation.Offset) << "Allocations overlap";
+            }
+            used += allocation.Size;
+        }
+
+        const auto stats = allocator.GetStats();
+        EXPECT_EQ(stats.Used, used);
+        EXPECT_EQ(stats.Free, kSize - used);
+        EXPECT_EQ(stats.Allocations, live.size());
+        EXPECT_LE(stats.LargestFree, stats.Free);
+    }
+}
+
+TEST(OffsetAllocatorTest, RandomTraceMergesBackIntoOneRegion)
+{
+    constexpr u32 kOperations = 20'000;
+    auto random = std::mt19937(0x4E454F);
+    std::uniform_int_distribution<u64> smallSize(1, 64 * 1024);
+    std::uniform_int_distribution<u64> largeSize(1024 * 1024, 8 * 1024 * 1024);
+    std::uniform_int_distribution<u32> kind(0, 15);
+    std::uniform_int_distribution<u32> alignmentShift(0, 22);
+
+    Neo::OffsetAllocator allocator(kSize, kGranularity);
+    std::vector<Live> live;
+    u32 failures = 0;
+    for (u32 operation = 0; operation < kOperations; operation++)
+    {
+        // Allocating a bit more often than freeing fills the heap up until allocations start failing
+        if (live.empty() || kind(random) < 9)
+        {
+            const auto size = kind(random) == 0 ? largeSize(random) : smallSize(random);
+            const auto alignment = 1ull << alignmentShift(random);
+            if (const auto allocation = allocator.Allocate(size, alignment))
+            {
+                EXPECT_GE(allocation->Size, size);
+                live.emplace_back(Live{.Allocation = *allocation, .Alignment = alignment});
+            }
+            else
+            {
+                failures++;
+            }
+        }
+        else
+        {
+            std::uniform_int_distribution<size_t> pick(0, live.size() - 1);
+            const auto index = pick(random);
+            allocator.Free(live[index].Allocation);
+            live[index] = live.back();
+            live.pop_back();
+        }
+
+        if (operation % 1000 == 0)
+        {
+            ExpectConsistent(allocator, live);
+            if (HasFatalFailure()) return;
+        }
+    }
+    EXPECT_GT(failures, 0);
+    ExpectConsistent(allocator, live);
+
+    // Freed in random order, every region merges with its neighbours until the heap is one piece again
+    std::ranges::shuffle(live, random);
+    for (const auto& entry : live)
+    {
+        allocator.Free(entry.Allocation);
+    }
+    const auto stats = allocator.GetStats();
+    EXPECT_EQ(stats.Used, 0);
+    EXPECT_EQ(stats.Allocations, 0);
+    EXPECT_EQ(stats.FreeRegions, 1);
+    EXPECT_EQ(stats.LargestFree, kSize);
+    EXPECT_EQ(stats.GetFragmentation(), 0.f);
+}
+
+TEST(OffsetAllocatorTest, DeferredFreesWaitForTheirFence)
+{
+    Neo::OffsetAllocator allocator(4 * kGranularity, kGranularity);
+    const auto first = allocator.Allocate(2 * kGranularity);
+    const auto second = allocator.Allocate(2 * kGranularity);
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(allocator.Allocate(1), std::nullopt);
+
+    allocator.FreeDeferred(*first, 1);
+    allocator.FreeDeferred(*second, 2);
+    EXPECT_EQ(allocator.GetStats().Deferred, 4 * kGranularity);
+    allocator.Collect(0);
+    EXPECT_EQ(allocator.Allocate(1), std::nullopt);
+
+    allocator.Collect(1);
+    EXPECT_EQ(allocator.GetStats().Free, 2 * kGranularity);
+    allocator.Collect(2);
+    EXPECT_EQ(allocator.GetStats().FreeRegions, 1);
+    EXPECT_EQ(allocator.GetStats().LargestFree, 4 * kGranularity);
+}
@@ -0,0 +1,106 @@
+#include "TestCommon.hpp"
+#include "Render/RenderGraph.hpp"
+#include "Render/Null/RenderContextNull.hpp"
+
+namespace
+{
+    class RenderGraphTest : public testing::Test
+    {
+    protected:
+        // Writes a transient target, and reads it in a second pass if asked to
+        Neo::RenderGraphResource Declare(const bool read)
+        {
+            mGraph.Reset();
+            auto target = Neo::RenderGraphResource::eNull;
+            mGraph.AddPass("Write", [&](Neo::RenderGraphBuilder& builder)
+            {
+                target = builder.Write(builder.CreateRenderTarget("Scene", {.Size = {64, 64}}));
+                builder.SideEffect();
+            }, {});
+            if (read)
+            {
+                mGraph.AddPass("Read", [&](Neo::RenderGraphBuilder& builder)
+                {
+                    builder.Read(target);
+                    builder.SideEffect();
+                }, {});
+            }
+            mGraph.Compile(mContext);
+            return target;
+        }
+
+        void Execute()
+        {
+            const auto command = mContext.GetFrameData().CommandHandle;
+            mContext.BeginCommand(command);
+            mGraph.Execute(mContext, command);
+            mContext.EndCommand(command);
+        }
+
+        [[nodiscard]] bool HasBarrier(const Neo::RenderGraphResource resource,
+                                      const Neo::ResourceState before,
+                                      const Neo::ResourceState after) const
+        {
+            return std::ranges::any_of(mGraph.GetBarriers(), [&](const Neo::RenderGraph::Barrier& barrier)
+            {
+                return barrier.Resource == resource && barrier.Before == before && barrier.After == after;
+            });
+        }
+
+        void TearDown() override { mGraph.Release(mContext); }
+
+        Neo::RenderContextNull mContext{Neo::RenderContextCreateInfo{.Backend = Neo::RenderBackend::eNull}};
+        Neo::RenderGraph mGraph;
+    };
+}
+
+TEST_F(RenderGraphTest, NewTargetsGetABarrierBeforeTheirFirstUse)
+{
+    // The only use of the target is also where the plan leaves it, which a new target is not in yet
+    const auto target = Declare(false);
+    EXPECT_TRUE(HasBarrier(target, Neo::ResourceState::eUndefined, Neo::ResourceState::eRenderTarget));
+    Execute();
+
+    // From then on every frame starts with the target where the last one left it
+    Declare(false);
+    EXPECT_EQ(mGraph.GetCompileCount(), 1);
+    EXPECT_TRUE(mGraph.GetBarriers().empty());
+}
+
+TEST_F(RenderGraphTest, KeptTargetsStartWhereTheLastPlanLeftThem)
+{
+    auto target = Declare(true);
+    Execute();
+    Declare(true);
+    Execute();
+    ASSERT_EQ(mGraph.GetBarriers().size(), 2);
+    EXPECT_TRUE(HasBarrier(target, Neo::ResourceState::eShaderRead, Neo::ResourceState::eRenderTarget));
+    EXPECT_TRUE(HasBarrier(target, Neo::ResourceState::eRenderTarget, Neo::ResourceState::eShaderRead));
+
+    // The new plan keeps the target, which the old one left in the shader read state
+    const auto created = mContext.GetCallCount(Neo::NullCall::eCreateRenderTarget);
+    target = Declare(false);
+    EXPECT_EQ(mGraph.GetCompileCount(), 2);
+    EXPECT_EQ(mContext.GetCallCount(Neo::NullCall::eCreateRenderTarget), created);
+    EXPECT_TRUE(HasBarrier(target, Neo::ResourceState::eShaderRead, Neo::ResourceState::eRenderTarget));
+    Execute();
+
+    Declare(false);
+    EXPECT_TRUE(mGraph.GetBarriers().empty());
+}
+
+TEST_F(RenderGraphTest, PassesNothingNeedsAreCulled)
+{
+    // A target no pass reads, a pass that declares nothing and one kept for its side effects
+    mGraph.Reset();
+    mGraph.AddPass("Unused", [](Neo::RenderGraphBuilder& builder)
+    {
+        builder.Write(builder.CreateRenderTarget("Unused", {.Size = {64, 64}}));
+    }, {});
+    mGraph.AddPass("Empty", {}, {});
+    mGraph.AddPass("Kept", [](Neo::RenderGraphBuilder& builder) { builder.SideEffect(); }, {});
+    mGraph.Compile(mContext);
+
+    ASSERT_EQ(mGraph.GetExecutedPasses().size(), 1);
+    EXPECT_EQ(mGraph.GetExecutedPasses().front(), 2);
+}
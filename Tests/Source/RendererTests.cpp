@@ -0,0 +1,113 @@
+#include "TestCommon.hpp"
+#include "Core/ECS.hpp"
+#include "Core/Renderer.hpp"
+#include "Core/Resources.hpp"
+#include "Render/Null/RenderContextNull.hpp"
+#include "Tools/Serializer.hpp"
+
+namespace
+{
+    bool HasCopies(const Neo::RenderContextNull& context, const Neo::CommandHandle command)
+    {
+        return std::ranges::any_of(context.GetCommands(command), [](const Neo::NullCommand& recorded)
+        {
+            return recorded.Call == Neo::NullCall::eCopyBuffer;
+        });
+    }
+
+    std::vector<Neo::NullCommand> GetSubmittedCalls(const Neo::RenderContextNull& context, const Neo::NullCall call)
+    {
+        std::vector<Neo::NullCommand> calls;
+        for (const auto command : context.GetSubmitted())
+        {
+            for (const auto& recorded : context.GetCommands(command))
+            {
+                if (recorded.Call == call) calls.emplace_back(recorded);
+            }
+        }
+        return calls;
+    }
+}
+
+TEST(RendererTest, UploadsAreSubmittedBeforeParallelPasses)
+{
+    Neo::Renderer renderer(Neo::RenderContextCreateInfo{.Backend = Neo::RenderBackend::eNull});
+    renderer.SetParallelRecording(true);
+    auto& context = static_cast<Neo::RenderContextNull&>(*renderer.GetRenderContext());
+
+    // The renderer uploads its triangle on creation, which the first frame copies before drawing it
+    const auto frameCommand = context.GetFrameData().CommandHandle;
+    Neo::FrameAllocator frameAllocator;
+    frameAllocator.BeginFrame();
+    renderer.Update(0.f, frameAllocator);
+
+    const auto submitted = context.GetSubmitted();
+    ASSERT_GE(submitted.size(), 3);
+    EXPECT_TRUE(HasCopies(context, submitted.front()));
+    for (const auto command : submitted.subspan(1))
+    {
+        EXPECT_FALSE(HasCopies(context, command));
+    }
+    EXPECT_EQ(submitted.back(), frameCommand);
+}
+
+TEST(RendererTest, BatchesAreDrawnOnceTheirMeshIsUploaded)
+{
+    constexpr u32 kInstances = 3;
+    Neo::Renderer renderer(Neo::RenderContextCreateInfo{.Backend = Neo::RenderBackend::eNull});
+    auto& context = static_cast<Neo::RenderContextNull&>(*renderer.GetRenderContext());
+    Neo::Resources resources;
+    resources.SetRenderContext(&context);
+    resources.SetUploadQueue(&renderer.GetUploadQueue());
+
+    Neo::MaterialDesc material{};
+    material.ID = uuids::uuid::from_string("00000000-0000-0000-0005-000000000001").value();
+    Neo::MeshDesc mesh{};
+    mesh.ID = uuids::uuid::from_string("00000000-0000-0000-0005-000000000002").value();
+    auto& primitive = mesh.Primitives.emplace_back();
+    primitive.Vertices.resize(3);
+    primitive.Indices = {0, 1, 2};
+    primitive.MaterialID = material.ID;
+    primitive.Bounds = {.Min = glm::vec3(-1.f), .Max = glm::vec3(1.f), .Radius = std::sqrt(3.f)};
+    const auto materialPath = (Neo::Test::GetTempDirectory() / "DrawnMaterial.asset").string();
+    const auto meshPath = (Neo::Test::GetTempDirectory() / "DrawnMesh.asset").string();
+    ASSERT_TRUE(Neo::BinarySerializer::Serialize(material, materialPath));
+    ASSERT_TRUE(Neo::BinarySerializer::Serialize(mesh, meshPath));
+    resources.RegisterAsset(material.ID, materialPath);
+    resources.RegisterAsset(mesh.ID, meshPath);
+    const auto handle = resources.LoadMesh(mesh.ID);
+
+    Neo::ECS ecs;
+    renderer.GetSceneBVH().Attach(ecs.GetWorld());
+    for (u32 instance = 0; instance < kInstances; instance++)
+    {
+        ecs.Add<Neo::MeshRenderer>(ecs.CreateNamelessEntity(), Neo::MeshRenderer{.Mesh = handle});
+    }
+
+    Neo::FrameAllocator frameAllocator;
+    const auto frame = [&]
+    {
+        renderer.ExtractDraws(ecs, resources);
+        frameAllocator.BeginFrame();
+        renderer.Update(0.f, frameAllocator);
+        return GetSubmittedCalls(context, Neo::NullCall::eDrawIndexed);
+    };
+    // The first frame submits the upload of the mesh, so only the frames after it draw the batch
+    const auto& loaded = resources.Get(handle)->Primitives.front();
+    EXPECT_TRUE(frame().empty());
+    auto draws = frame();
+    for (u32 retry = 0; retry < 2 && draws.empty(); retry++)
+    {
+        draws = frame();
+    }
+    ASSERT_EQ(renderer.GetDrawList().GetBatches().size(), 1);
+    ASSERT_EQ(draws.size(), 1);
+    EXPECT_EQ(draws.front().Args[0], 3);
+    EXPECT_EQ(draws.front().Args[1], kInstances);
+    EXPECT_EQ(draws.front().Args[4], renderer.GetFirstInstance());
+    const auto indexBuffers = GetSubmittedCalls(context, Neo::NullCall::eBindIndexBuffer);
+    ASSERT_EQ(indexBuffers.size(), 1);
+    EXPECT_EQ(indexBuffers.front().Args[0], std::bit_cast<u32>(loaded.IndexBuffer));
+
+    resources.CleanupResources();
+}
@@ -0,0 +1,89 @@
+#include "TestCommon.hpp"
+#include "random"
+#include "Memory/RingAllocator.hpp"
+
+namespace
+{
+    struct Range
+    {
+        u64 Offset;
+        u64 Size;
+    };
+
+    bool Overlaps(const Range& a, const Range& b)
+    {
+        return a.Offset < b.Offset + b.Size && b.Offset < a.Offset + a.Size;
+    }
+}
+
+TEST(RingAllocatorTest, WrapsOnceTheOldestFrameIsDone)
+{
+    Neo::RingAllocator ring(1024);
+    ring.BeginFrame(0);
+    EXPECT_EQ(ring.Allocate(600), 0);
+    ring.EndFrame();
+
+    // Frame 0 is still in flight, and the rest of the lap is too small
+    ring.BeginFrame(1);
+    EXPECT_EQ(ring.Allocate(600), std::nullopt);
+    EXPECT_EQ(ring.Allocate(400), 608);
+    ring.EndFrame();
+    ring.BeginFrame(2);
+    ring.EndFrame();
+
+    // Beginning frame 0 again frees what it used, which the next allocation wraps into
+    ring.BeginFrame(0);
+    EXPECT_EQ(ring.Allocate(600), 0);
+    // Frame 1, the unused end of the lap and the new allocation fill the ring exactly
+    EXPECT_EQ(ring.GetUsed(), 1024);
+    ring.EndFrame();
+}
+
+TEST(RingAllocatorTest, NeverHandsOutMemoryOfFramesInFlight)
+{
+    constexpr u64 kCapacity = 32 * 1024;
+    constexpr u32 kFrames = 1000;
+    auto random = std::mt19937(0x4E454F);
+    std::uniform_int_distribution<u64> size(1, 4 * 1024);
+    std::uniform_int_distribution<u32> count(0, 12);
+    std::uniform_int_distribution<u32> alignmentShift(0, 8);
+
+    Neo::RingAllocator ring(kCapacity);
+    std::array<std::vector<Range>, Neo::kFrameCount> inFlight;
+    u32 failures = 0;
+    for (u32 frame = 0; frame < kFrames; frame++)
+    {
+        const auto frameIndex = frame % Neo::kFrameCount;
+        ring.BeginFrame(frameIndex);
+        inFlight[frameIndex].clear();
+
+        const auto allocations = count(random);
+        for (u32 allocation = 0; allocation < allocations; allocation++)
+        {
+            const auto alignment = 1ull << alignmentShift(random);
+            const auto bytes = size(random);
+            const auto offset = ring.Allocate(bytes, alignment);
+            if (!offset)
+            {
+                failures++;
+                continue;
+            }
+            EXPECT_EQ(*offset % alignment, 0);
+            EXPECT_LE(*offset + bytes, kCapacity);
+            const Range allocated{.Offset = *offset, .Size = bytes};
+            for (const auto& frameRanges : inFlight)
+            {
+                for (const auto& other : frameRanges)
+                {
+                    ASSERT_FALSE(Overlaps(allocated, other)) << "Frame " << frame;
+                }
+            }
+            inFlight[frameIndex].emplace_back(allocated);
+        }
+        EXPECT_LE(ring.GetUsed(), kCapacity);
+        ring.EndFrame();
+    }
+    // The frames ask for a bit more than a third of the ring on average, so some allocations are turned away
+    EXPECT_GT(failures, 0);
+    EXPECT_LT(failures, kFrames * 6);
+}
@@ -0,0 +1,191 @@
+#include "TestCommon.hpp"
+#include "Core/Components.hpp"
+#include "Core/Resources.hpp"
+#include "Render/DrawList.hpp"
+#include "Resources/TextureMips.hpp"
+#include "Tools/Metrics.hpp"
+#include "Tools/Serializer.hpp"
+
+namespace
+{
+    constexpr u32 kTextureSize = 256;
+    constexpr u32 kTextureCount = 4;
+    // Textures sit on unit spheres this far apart along -Z, the camera looks down -Z from positive Z
+    constexpr float kSpacing = 10.f;
+    constexpr glm::uvec2 kViewport{1280, 720};
+
+    struct CookedTexture
+    {
+        Neo::AssetID ID;
+        std::vector<u8> Pixels;
+        Neo::Bounds Bounds;
+    };
+
+    // Every texture gets its own pattern, so mips spliced into the wrong texture or place show up
+    std::vector<CookedTexture> CookTextures(Neo::Resources& resources)
+    {
+        std::vector<CookedTexture> textures;
+        for (u32 index = 0; index < kTextureCount; index++)
+        {
+            std::vector<u8> image(static_cast<size_t>(kTextureSize) * kTextureSize * Neo::kTextureBytesPerPixel);
+            for (size_t byte = 0; byte < image.size(); byte++)
+            {
+                image[byte] = static_cast<u8>(byte * (index + 3) / 7);
+            }
+
+            auto& texture = textures.emplace_back();
+            texture.ID = uuids::uuid::from_string(fmt::format("00000000-0000-0000-0000-{:012}", index + 1)).value();
+            texture.Pixels = Neo::GenerateMips(image, kTextureSize, kTextureSize);
+            const auto center = glm::vec3(0.f, 0.f, -static_cast<float>(index) * kSpacing);
+            texture.Bounds = {.Min = center - 1.f, .Max = center + 1.f, .Center = center, .Radius = 1.f};
+
+            Neo::TextureDesc desc{};
+            desc.Name = fmt::format("Texture{}", index);
+            desc.ID = texture.ID;
+            desc.Width = kTextureSize;
+            desc.Height = kTextureSize;
+            desc.MipLevels = Neo::GetMipCount(kTextureSize, kTextureSize);
+            desc.Pixels = texture.Pixels;
+            const auto path = (Neo::Test::GetTempDirectory() / fmt::format("Texture{}.asset", index)).string();
+            EXPECT_TRUE(Neo::BinarySerializer::Serialize(desc, path));
+            resources.RegisterAsset(texture.ID, path);
+        }
+        return textures;
+    }
+
+    i64 GetMipRequests()
+    {
+        Neo::Metrics::BeginFrame();
+        const auto sample = Neo::Metrics::Find("Resources/MipRequests");
+        return sample ? sample->Total : 0;
+    }
+
+    class TextureStreamingTest : public testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            // Finishing loads should never be cut short by a slow machine
+            mResources.SetFrameBudget(std::chrono::seconds(10));
+            mTextures = CookTextures(mResources);
+            for (const auto& texture : mTextures)
+            {
+                mHandles.emplace_back(mResources.LoadTexture(texture.ID));
+                ASSERT_TRUE(mResources.IsLoaded(mHandles.back()));
+            }
+        }
+
+        // Report every texture as seen from the camera position, like the draw list does, and update
+        void RunFrame(const glm::vec3 position)
+        {
+            const Neo::Camera camera{.FieldOfView = 60.f, .Far = 1000.f};
+            const auto view = Neo::MakeDrawView(Neo::Transform{.Position = position, .Scale = glm::vec3(1.f)}, camera,
+                                                kViewport);
+            for (u32 index = 0; index < kTextureCount; index++)
+            {
+                mResources.ReportTextureUsage(mHandles[index], view.GetScreenSize(mTextures[index].Bounds));
+            }
+            mResources.Update();
+            // Requests for the same texture are never queued twice
+            EXPECT_LE(mResources.GetPendingCount(), kTextureCount);
+        }
+
+        // Run frames at the position until every texture has the mips it should, then check their pixels
+        void Settle(const glm::vec3 position)
+        {
+            const auto& residency = mResources.GetTextureResidency();
+            for (u32 frame = 0; frame < 1000; frame++)
+            {
+                RunFrame(position);
+                const auto settled = std::ranges::all_of(mHandles, [&](const auto handle)
+                {
+                    return residency.GetResidentMip(handle) == residency.GetTargetMip(handle);
+                });
+                if (settled && mResources.GetPendingCount() == 0)
+                {
+                    for (u32 index = 0; index < kTextureCount; index++)
+                    {
+                        ExpectResidentPixels(index);
+                    }
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            FAIL() << "Textures did not settle";
+        }
+
+        void ExpectResidentPixels(const u32 index)
+        {
+            const auto* texture = mResources.Get(mHandles[index]);
+            ASSERT_NE(texture, nullptr);
+            const auto offset = Neo::GetMipOffset(kTextureSize, kTextureSize, texture->ResidentMip);
+            const auto expected = std::span(mTextures[index].Pixels).subspan(offset);
+            EXPECT_TRUE(std::ranges::equal(texture->Pixels, expected)) << "Texture " << index;
+        }
+
+        Neo::Resources mResources;
+        std::vector<CookedTexture> mTextures;
+        std::vector<Neo::AssetHandle<Neo::Texture>> mHandles;
+    };
+}
+
+TEST_F(TextureStreamingTest, KeepsNewTexturesUntilTheyAreDrawn)
+{
+    // Nothing was drawn with the textures yet, which must not evict them
+    mResources.Update();
+    for (const auto handle : mHandles)
+    {
+        EXPECT_EQ(mResources.GetTextureResidency().GetResidentMip(handle), 0);
+    }
+}
+
+TEST_F(TextureStreamingTest, CameraPath)
+{
+    const auto& residency = mResources.GetTextureResidency();
+    const auto lastMip = static_cast<u16>(Neo::GetMipCount(kTextureSize, kTextureSize) - 1);
+
+    // Far away every texture covers less than a pixel and drops all but its last mip
+    const glm::vec3 far(0.f, 0.f, 2000.f);
+    Settle(far);
+    for (const auto handle : mHandles)
+    {
+        EXPECT_EQ(residency.GetResidentMip(handle), lastMip);
+    }
+
+    // Walking up to the first texture brings detail back step by step, most to the nearest texture
+    std::vector<u16> previous(kTextureCount, lastMip);
+    for (const auto z : {500.f, 120.f, 30.f, 8.f, 2.f})
+    {
+        Settle(glm::vec3(0.f, 0.f, z));
+        for (u32 index = 0; index < kTextureCount; index++)
+        {
+            const auto mip = residency.GetResidentMip(mHandles[index]);
+            EXPECT_LE(mip, previous[index]);
+            if (index > 0)
+            {
+                EXPECT_GE(mip, previous[index - 1]);
+            }
+            previous[index] = mip;
+        }
+    }
+    EXPECT_EQ(previous[0], 0);
+    EXPECT_LT(previous[kTextureCount - 1], lastMip);
+
+    // Walking away drops the mips again without reading anything
+    auto requests = GetMipRequests();
+    Settle(far);
+    for (const auto handle : mHandles)
+    {
+        EXPECT_EQ(residency.GetResidentMip(handle), lastMip);
+    }
+    EXPECT_EQ(GetMipRequests(), requests);
+
+    // Jumping back reads the missing mips of each texture once, however many frames that takes
+    requests = GetMipRequests();
+    Settle(glm::vec3(0.f, 0.f, 2.f));
+    for (u32 index = 0; index < kTextureCount; index++)
+    {
+        EXPECT_EQ(residency.GetResidentMip(mHandles[index]), previous[index]);
+    }
+    EXPECT_EQ(GetMipRequests() - requests, kTextureCount);
+}
@@ -0,0 +1,105 @@
+#include "TestCommon.hpp"
+#include "Core/Resources.hpp"
+#include "Render/Null/RenderContextNull.hpp"
+#include "Render/UploadQueue.hpp"
+#include "Tools/Serializer.hpp"
+
+namespace
+{
+    constexpr u64 kPageSize = 256;
+
+    class UploadQueueTest : public testing::Test
+    {
+    protected:
+        Neo::BufferHandle CreateDestination(const u32 size)
+        {
+            return mContext.CreateBuffer({.FirstElement = 0, .NumElements = size, .Stride = 1}, "Destination");
+        }
+
+        std::span<const std::byte> GetData(const Neo::BufferHandle buffer, const size_t size)
+        {
+            return {static_cast<const std::byte*>(mContext.MapBuffer(buffer)), size};
+        }
+
+        Neo::RenderContextNull mContext{Neo::RenderContextCreateInfo{.Backend = Neo::RenderBackend::eNull}};
+    };
+}
+
+TEST_F(UploadQueueTest, EmptyUploadsWaitForTheBacklog)
+{
+    // One page, so the second half of the first upload waits for the first half to be done
+    Neo::UploadQueue uploads(mContext, kPageSize, 1);
+    const std::vector data(kPageSize * 2, std::byte{7});
+    const auto destination = CreateDestination(kPageSize * 2);
+    std::vector<u32> completed;
+    // Callbacks run before Submit writes more of the backlog, so any of them too early sees half the data
+    const auto onComplete = [&](const u32 upload)
+    {
+        return [&, upload]
+        {
+            EXPECT_TRUE(std::ranges::equal(GetData(destination, data.size()), data)) << "Upload " << upload;
+            completed.emplace_back(upload);
+        };
+    };
+    const auto first = uploads.Upload(destination, 0, data, onComplete(1));
+    const auto empty = uploads.Upload(destination, 0, {}, onComplete(2));
+
+    for (u32 frame = 0; frame < 8 && !uploads.IsComplete(empty); frame++)
+    {
+        uploads.Submit();
+    }
+    EXPECT_TRUE(uploads.IsComplete(first));
+    EXPECT_TRUE(uploads.IsComplete(empty));
+    EXPECT_EQ(completed, (std::vector<u32>{1, 2}));
+}
+
+TEST_F(UploadQueueTest, EmptyUploadsWithNothingWaitingCompleteRightAway)
+{
+    Neo::UploadQueue uploads(mContext, kPageSize, 1);
+    const auto empty = uploads.Upload(CreateDestination(16), 0, {});
+    uploads.Submit();
+    EXPECT_TRUE(uploads.IsComplete(empty));
+    EXPECT_EQ(mContext.GetCallCount(Neo::NullCall::eSignalTransfer), 0);
+}
+
+TEST_F(UploadQueueTest, MeshesAreUploadedWhenLoaded)
+{
+    Neo::MeshDesc desc{};
+    desc.Name = "Triangle";
+    desc.ID = uuids::uuid::from_string("00000000-0000-0000-0003-000000000001").value();
+    auto& primitive = desc.Primitives.emplace_back();
+    primitive.Vertices = {
+        Neo::Vertex{.Position = glm::vec3(0.f, 0.f, 0.f)},
+        Neo::Vertex{.Position = glm::vec3(1.f, 0.f, 0.f)},
+        Neo::Vertex{.Position = glm::vec3(0.f, 1.f, 0.f)},
+    };
+    primitive.Indices = {0, 1, 2};
+    const auto path = (Neo::Test::GetTempDirectory() / "Triangle.asset").string();
+    ASSERT_TRUE(Neo::BinarySerializer::Serialize(desc, path));
+
+    Neo::UploadQueue uploads(mContext);
+    Neo::Resources resources;
+    resources.SetRenderContext(&mContext);
+    resources.SetUploadQueue(&uploads);
+    resources.RegisterAsset(desc.ID, path);
+
+    const auto handle = resources.LoadMesh(desc.ID);
+    const auto* mesh = resources.Get(handle);
+    ASSERT_NE(mesh, nullptr);
+    const auto& loaded = mesh->Primitives.front();
+    ASSERT_NE(loaded.VertexBuffer, Neo::BufferHandle::eNull);
+    ASSERT_NE(loaded.IndexBuffer, Neo::BufferHandle::eNull);
+    // Nothing goes to the GPU before the queue submits
+    EXPECT_FALSE(uploads.IsComplete(loaded.Upload));
+
+    uploads.Submit();
+    uploads.Submit();
+    ASSERT_TRUE(uploads.IsComplete(loaded.Upload));
+    EXPECT_TRUE(std::ranges::equal(GetData(loaded.VertexBuffer, sizeof(Neo::Vertex) * 3),
+                                   std::as_bytes(std::span(primitive.Vertices))));
+    EXPECT_TRUE(std::ranges::equal(GetData(loaded.IndexBuffer, sizeof(u32) * 3),
+                                   std::as_bytes(std::span(primitive.Indices))));
+
+    resources.CleanupResources();
+    EXPECT_EQ(mContext.GetCallCount(Neo::NullCall::eDestroyBuffer), 2);
+}